@@ -0,0 +1,528 @@
+/*
+ * udpjsonmeta 热路径微基准
+ *
+ * 链接核心库与元素，经公开接口测量：
+ *   parse_and_cache   每种负载形态的 udpjson_ingest_parse_and_cache
+ *   cache_update      不同表大小下的 udpjson_ingest_cache_update（覆盖已有键）
+ *   cuav_parse        每种报文的 cuav_parser_parse
+ *   transform_ip      合成批次元数据（源数 x 目标数）上的 gst_udpjson_meta_process_batch
+ *
+ * 每个用例一行输出（JSON Lines 或 CSV），便于不同版本间比较：
+ *   ./udpjsonmeta_bench > new.jsonl
+ *   python3 python_tools/bench_compare.py old.jsonl new.jsonl
+ */
+#include "gstudpjsonmeta.h"
+#include "gstnvdsmeta.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 每个用例的默认最短测量时间(毫秒) */
+#define BENCH_DEFAULT_MIN_TIME_MS 200
+/* 预热时间(毫秒) */
+#define BENCH_WARMUP_MS 20
+/* 轮换的目标ID数，保证负载不是同一份字节 */
+#define BENCH_KEY_SPACE 1024
+/* cache_update 每个样本包含的操作数，摊薄计时开销 */
+#define BENCH_CACHE_OPS_PER_SAMPLE 16
+/* cuav_parse 报文的收发系统号与设备编号（与元素默认值相同） */
+#define BENCH_CUAV_SYS_ID 999
+#define BENCH_CUAV_DEV_ID 999
+
+/**
+ * @brief 运行参数
+ */
+typedef struct
+{
+    gchar *filter;            /* 只运行名称包含该子串的用例 */
+    gint min_time_ms;         /* 每个用例的最短测量时间 */
+    gchar *format;            /* 输出格式 jsonl/csv */
+    gchar *transform_shapes;  /* transform_ip 形态列表 "源数x目标数,..." */
+    gchar *cache_sizes;       /* cache_update 表大小列表 */
+    gboolean list;            /* 只列出用例名 */
+} BenchOptions;
+
+/**
+ * @brief 一个用例
+ */
+typedef struct
+{
+    const gchar *bench;       /* 基准名 */
+    gchar *name;              /* 用例名 */
+    guint ops_per_sample;     /* 每次 run 调用的操作数 */
+    /* 执行一个样本；返回 FALSE 表示用例无法运行 */
+    gboolean (*run)(gpointer data);
+    /* 每个样本前的准备，不计时（可为 NULL） */
+    void (*prepare)(gpointer data);
+    /* 每个样本后的清理，不计时（可为 NULL） */
+    void (*finish)(gpointer data);
+    gpointer data;
+} BenchCase;
+
+static BenchOptions bench_opts = {NULL, BENCH_DEFAULT_MIN_TIME_MS, NULL, NULL, NULL, FALSE};
+/* 借用 UDPJSON_HIST_TRANSFORM 直方图统计每个用例的样本 */
+static UdpJsonStats *bench_stats = NULL;
+static gboolean bench_header_done = FALSE;
+
+/* ---------------------------------------------------------------------------------------- */
+/* parse_and_cache                                                                          */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 一种负载形态的预生成报文
+ */
+typedef struct
+{
+    UdpJsonIngest *ingest;
+    gchar *payloads[BENCH_KEY_SPACE]; /* 目标ID各不相同的报文 */
+    gsize lens[BENCH_KEY_SPACE];
+    guint next;
+} BenchParseCase;
+
+/**
+ * @brief 生成一条报文
+ *
+ * @param shape 负载形态
+ * @param object_id 目标ID
+ * @return 报文，调用方释放
+ */
+static gchar *bench_make_payload(const gchar *shape, guint object_id)
+{
+    if (g_str_equal(shape, "minimal"))
+        return g_strdup_printf("{\"object_id\":%u,\"value\":1}", object_id);
+    if (g_str_equal(shape, "flat"))
+        return g_strdup_printf(
+            "{\"source_id\":%u,\"object_id\":%u,\"value\":{\"cls\":\"uav\",\"conf\":0.93,"
+            "\"lat\":31.2304,\"lon\":121.4737,\"alt\":152.5,\"vx\":3.1,\"vy\":-0.4,"
+            "\"vz\":0.2,\"rcs\":0.01,\"tar_id\":%u}}",
+            object_id % 4, object_id, 1000 + object_id);
+    if (g_str_equal(shape, "nested"))
+        return g_strdup_printf(
+            "{\"source_id\":%u,\"object_id\":\"%u\",\"tar_id\":%u,\"value\":{"
+            "\"track\":{\"pos\":{\"lat\":31.2304,\"lon\":121.4737,\"alt\":152.5},"
+            "\"vel\":[3.1,-0.4,0.2],\"cov\":[[1,0,0],[0,1,0],[0,0,1]]},"
+            "\"sensors\":[{\"id\":1,\"snr\":12.5},{\"id\":2,\"snr\":9.1}],"
+            "\"label\":{\"cls\":\"uav\",\"conf\":0.93,\"attrs\":[\"quad\",\"small\"]}}}",
+            object_id % 4, object_id, 1000 + object_id);
+    if (g_str_equal(shape, "large"))
+    {
+        GString *s = g_string_new(NULL);
+        g_string_append_printf(s, "{\"source_id\":%u,\"object_id\":%u,\"value\":{\"points\":[",
+                               object_id % 4, object_id);
+        for (guint i = 0; i < 128; i++)
+            g_string_append_printf(s, "%s[%u.125,%u.5,%u]", i ? "," : "", i, i * 3, i * 7);
+        g_string_append(s, "]}}");
+        return g_string_free(s, FALSE);
+    }
+    if (g_str_equal(shape, "invalid"))
+        return g_strdup_printf("{\"source_id\":0,\"object_id\":%u,\"value\":{\"lat\":31.2", object_id);
+    if (g_str_equal(shape, "missing"))
+        return g_strdup_printf("{\"source_id\":0,\"id\":%u,\"value\":1}", object_id);
+    return NULL;
+}
+
+static gboolean bench_parse_run(gpointer data)
+{
+    BenchParseCase *c = (BenchParseCase *)data;
+    guint i = c->next++ & (BENCH_KEY_SPACE - 1);
+
+    udpjson_ingest_parse_and_cache(c->ingest, c->payloads[i], (gssize)c->lens[i],
+                                   udpjson_now_ns(), 0);
+    return TRUE;
+}
+
+/* ---------------------------------------------------------------------------------------- */
+/* cache_update                                                                             */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 固定表大小下的缓存覆盖写
+ */
+typedef struct
+{
+    UdpJsonIngest *ingest;
+    guint table_size;         /* 表中的条目数 */
+    guint next;
+} BenchCacheCase;
+
+static gboolean bench_cache_run(gpointer data)
+{
+    BenchCacheCase *c = (BenchCacheCase *)data;
+
+    for (guint k = 0; k < BENCH_CACHE_OPS_PER_SAMPLE; k++)
+    {
+        /* 乘以奇数打散访问顺序，避免顺序访问桶带来的缓存友好假象 */
+        guint id = (c->next++ * 2654435761u) % c->table_size;
+        udpjson_ingest_cache_update(c->ingest, id & 3, id, "{\"conf\":0.93}", 0);
+    }
+    return TRUE;
+}
+
+/* ---------------------------------------------------------------------------------------- */
+/* cuav_parse                                                                               */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 一种 C-UAV 报文
+ */
+typedef struct
+{
+    CUAVParser *parser;
+    gchar buf[2048];          /* 编码后的报文 */
+    gsize len;
+} BenchCuavCase;
+
+static gboolean bench_cuav_run(gpointer data)
+{
+    BenchCuavCase *c = (BenchCuavCase *)data;
+
+    cuav_parser_parse(c->parser, c->buf, (gssize)c->len);
+    return TRUE;
+}
+
+/* ---------------------------------------------------------------------------------------- */
+/* transform_ip                                                                             */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 合成批次上的 transform_ip
+ */
+typedef struct
+{
+    GstUdpJsonMeta *self;
+    guint sources;            /* 批次中的帧数（每帧一个源） */
+    guint objects;            /* 每帧目标数 */
+    gboolean hit;             /* 缓存中是否有全部目标 */
+    GstBuffer *buf;           /* 本样本的批次 */
+} BenchTransformCase;
+
+/**
+ * @brief 释放批次元数据（gst_buffer_add_nvds_meta 的释放回调）
+ */
+static void bench_batch_release(gpointer data, gpointer user_data)
+{
+    nvds_destroy_batch_meta((NvDsBatchMeta *)data);
+}
+
+/**
+ * @brief 每个样本重建批次，避免上一样本附加的用户元数据累积
+ */
+static void bench_transform_prepare(gpointer data)
+{
+    BenchTransformCase *c = (BenchTransformCase *)data;
+    NvDsBatchMeta *batch = nvds_create_batch_meta(c->sources);
+    NvDsMeta *meta = NULL;
+
+    for (guint s = 0; s < c->sources; s++)
+    {
+        NvDsFrameMeta *frame = nvds_acquire_frame_meta_from_pool(batch);
+        frame->source_id = s;
+        frame->batch_id = s;
+        nvds_add_frame_meta_to_batch(batch, frame);
+        for (guint o = 0; o < c->objects; o++)
+        {
+            NvDsObjectMeta *obj = nvds_acquire_obj_meta_from_pool(batch);
+            /* 未命中用例使用缓存中不存在的目标ID */
+            obj->object_id = c->hit ? o : (guint64)o + BENCH_KEY_SPACE * 16;
+            obj->unique_component_id = 1;
+            nvds_add_obj_meta_to_frame(frame, obj, NULL);
+        }
+    }
+
+    c->buf = gst_buffer_new();
+    meta = gst_buffer_add_nvds_meta(c->buf, batch, NULL, NULL, bench_batch_release);
+    meta->meta_type = NVDS_BATCH_GST_META;
+}
+
+static gboolean bench_transform_run(gpointer data)
+{
+    BenchTransformCase *c = (BenchTransformCase *)data;
+
+    return gst_udpjson_meta_process_batch(c->self, c->buf) == GST_FLOW_OK;
+}
+
+static void bench_transform_finish(gpointer data)
+{
+    BenchTransformCase *c = (BenchTransformCase *)data;
+
+    gst_buffer_unref(c->buf);
+    c->buf = NULL;
+}
+
+/* ---------------------------------------------------------------------------------------- */
+/* 运行与输出                                                                               */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 执行样本直到达到指定时长
+ *
+ * @param c 用例
+ * @param duration_ns 时长
+ * @param record 是否记录样本
+ * @return 执行的样本数，用例失败返回 0
+ */
+static guint64 bench_loop(BenchCase *c, guint64 duration_ns, gboolean record)
+{
+    guint64 begin_ns = udpjson_now_ns();
+    guint64 samples = 0;
+
+    do
+    {
+        guint64 t0 = 0;
+        guint64 t1 = 0;
+        gboolean ok = FALSE;
+
+        if (c->prepare)
+            c->prepare(c->data);
+        t0 = udpjson_now_ns();
+        ok = c->run(c->data);
+        t1 = udpjson_now_ns();
+        if (c->finish)
+            c->finish(c->data);
+        if (!ok)
+            return 0;
+        if (record)
+            udpjson_stats_record(bench_stats, UDPJSON_HIST_TRANSFORM,
+                                 (t1 - t0) / c->ops_per_sample);
+        samples++;
+    } while (udpjson_now_ns() - begin_ns < duration_ns);
+
+    return samples;
+}
+
+/**
+ * @brief 运行一个用例并输出一行结果
+ */
+static void bench_run_case(BenchCase *c)
+{
+    UdpJsonHistSummary summary; /* 每操作耗时汇总 */
+    gboolean csv = g_strcmp0(bench_opts.format, "csv") == 0;
+    guint64 ops = 0;
+
+    if (bench_opts.filter)
+    {
+        gchar *full = g_strdup_printf("%s/%s", c->bench, c->name);
+        gboolean match = strstr(full, bench_opts.filter) != NULL;
+        g_free(full);
+        if (!match)
+            return;
+    }
+    if (bench_opts.list)
+    {
+        g_print("%s/%s\n", c->bench, c->name);
+        return;
+    }
+
+    if (bench_loop(c, (guint64)BENCH_WARMUP_MS * 1000000, FALSE) == 0)
+    {
+        g_printerr("%s/%s: failed\n", c->bench, c->name);
+        return;
+    }
+    udpjson_stats_reset_histograms(bench_stats);
+    ops = bench_loop(c, (guint64)bench_opts.min_time_ms * 1000000, TRUE) * c->ops_per_sample;
+    udpjson_stats_hist_summary(bench_stats, UDPJSON_HIST_TRANSFORM, &summary);
+
+    if (csv)
+    {
+        if (!bench_header_done)
+            g_print("bench,case,ops,mean_ns,p50_ns,p90_ns,p99_ns,max_ns,ops_per_sec\n");
+        g_print("%s,%s,%" G_GUINT64_FORMAT ",%.1f,%" G_GUINT64_FORMAT ",%" G_GUINT64_FORMAT
+                ",%" G_GUINT64_FORMAT ",%" G_GUINT64_FORMAT ",%.0f\n",
+                c->bench, c->name, ops, summary.mean, summary.p50, summary.p90, summary.p99,
+                summary.max, summary.mean > 0 ? 1e9 / summary.mean : 0.0);
+    }
+    else
+    {
+        g_print("{\"bench\":\"%s\",\"case\":\"%s\",\"ops\":%" G_GUINT64_FORMAT
+                ",\"mean_ns\":%.1f,\"p50_ns\":%" G_GUINT64_FORMAT ",\"p90_ns\":%" G_GUINT64_FORMAT
+                ",\"p99_ns\":%" G_GUINT64_FORMAT ",\"max_ns\":%" G_GUINT64_FORMAT
+                ",\"ops_per_sec\":%.0f}\n",
+                c->bench, c->name, ops, summary.mean, summary.p50, summary.p90, summary.p99,
+                summary.max, summary.mean > 0 ? 1e9 / summary.mean : 0.0);
+    }
+    bench_header_done = TRUE;
+}
+
+/**
+ * @brief 创建一个未启动的元素（不打开套接字）
+ */
+static GstUdpJsonMeta *bench_element_new(guint max_cache_size)
+{
+    /* 样本间隔可能超过 TTL，关闭过期判断使命中用例稳定命中 */
+    return GST_UDPJSON_META(g_object_new(GST_TYPE_UDPJSON_META, "max-cache-size", max_cache_size,
+                                         "cache-ttl-ms", 0, NULL));
+}
+
+static void bench_parse_and_cache(void)
+{
+    static const gchar *shapes[] = {"minimal", "flat", "nested", "large", "invalid", "missing"};
+    UdpJsonIngest *ingest = udpjson_ingest_new(NULL);
+
+    for (guint s = 0; s < G_N_ELEMENTS(shapes); s++)
+    {
+        BenchParseCase pc;
+        BenchCase c = {"parse_and_cache", g_strdup(shapes[s]), 1, bench_parse_run, NULL, NULL, &pc};
+
+        pc.ingest = ingest;
+        pc.next = 0;
+        for (guint i = 0; i < BENCH_KEY_SPACE; i++)
+        {
+            pc.payloads[i] = bench_make_payload(shapes[s], i);
+            pc.lens[i] = strlen(pc.payloads[i]);
+        }
+        bench_run_case(&c);
+        for (guint i = 0; i < BENCH_KEY_SPACE; i++)
+            g_free(pc.payloads[i]);
+        g_free(c.name);
+    }
+    udpjson_ingest_free(ingest);
+}
+
+static void bench_cache_update(void)
+{
+    gchar **sizes = g_strsplit(bench_opts.cache_sizes, ",", -1);
+
+    for (guint i = 0; sizes[i]; i++)
+    {
+        guint size = (guint)g_ascii_strtoull(sizes[i], NULL, 10);
+        UdpJsonIngest *ingest = NULL;
+        BenchCacheCase cc;
+        BenchCase c = {"cache_update", NULL, BENCH_CACHE_OPS_PER_SAMPLE, bench_cache_run, NULL,
+                       NULL, &cc};
+
+        if (size == 0)
+            continue;
+        ingest = udpjson_ingest_new(NULL);
+        cc.ingest = ingest;
+        cc.table_size = size;
+        cc.next = 0;
+        for (guint id = 0; id < size; id++)
+            udpjson_ingest_cache_update(ingest, id & 3, id, "{\"conf\":0.93}", 0);
+        c.name = g_strdup_printf("entries-%u", size);
+        bench_run_case(&c);
+        g_free(c.name);
+        udpjson_ingest_free(ingest);
+    }
+    g_strfreev(sizes);
+}
+
+static void bench_cuav_parse(void)
+{
+    CUAVAddressing addressing = {BENCH_CUAV_SYS_ID, 1, BENCH_CUAV_DEV_ID, 999,
+                                 BENCH_CUAV_SYS_ID, 1, BENCH_CUAV_DEV_ID, 999};
+    CUAVEncoder *encoder = cuav_encoder_new(&addressing);
+    CUAVParser *parser = cuav_parser_new();
+
+    for (guint i = 0; i < CUAV_MSG_INDEX_COUNT; i++)
+    {
+        const CUAVMessageDesc *desc = &cuav_message_descs[i];
+        CUAVMessageUnion msg;
+        BenchCuavCase cc;
+        BenchCase c = {"cuav_parse", NULL, 1, bench_cuav_run, NULL, NULL, &cc};
+
+        memset(&msg, 0, sizeof(msg));
+        cc.parser = parser;
+        cc.len = cuav_encode_message(encoder, desc->msg_id, CUAV_MSG_TYPE_STREAM, &msg, cc.buf,
+                                     sizeof(cc.buf));
+        if (cc.len == 0)
+            continue;
+        c.name = g_strdup_printf("0x%04X-%s", desc->msg_id, desc->name);
+        bench_run_case(&c);
+        g_free(c.name);
+    }
+    cuav_parser_free(parser);
+    cuav_encoder_free(encoder);
+}
+
+static void bench_transform_ip(void)
+{
+    gchar **shapes = g_strsplit(bench_opts.transform_shapes, ",", -1);
+
+    for (guint i = 0; shapes[i]; i++)
+    {
+        guint sources = 0;
+        guint objects = 0;
+        GstUdpJsonMeta *self = NULL;
+
+        if (sscanf(shapes[i], "%ux%u", &sources, &objects) != 2 || sources == 0)
+        {
+            g_printerr("invalid transform shape '%s'\n", shapes[i]);
+            continue;
+        }
+        self = bench_element_new(0);
+        for (guint s = 0; s < sources; s++)
+        {
+            for (guint o = 0; o < objects; o++)
+                udpjson_ingest_cache_update(self->ingest, s, o, "{\"conf\":0.93}", 0);
+        }
+        for (gint hit = 1; hit >= 0; hit--)
+        {
+            BenchTransformCase tc = {self, sources, objects, hit, NULL};
+            BenchCase c = {"transform_ip", NULL, 1, bench_transform_run, bench_transform_prepare,
+                           bench_transform_finish, &tc};
+
+            c.name = g_strdup_printf("%ux%u-%s", sources, objects, hit ? "hit" : "miss");
+            bench_run_case(&c);
+            g_free(c.name);
+        }
+        gst_object_unref(self);
+    }
+    g_strfreev(shapes);
+}
+
+int main(int argc, char *argv[])
+{
+    GOptionEntry entries[] = {
+        {"filter", 'f', 0, G_OPTION_ARG_STRING, &bench_opts.filter,
+         "Only run cases whose bench/case name contains this string", "STR"},
+        {"min-time-ms", 't', 0, G_OPTION_ARG_INT, &bench_opts.min_time_ms,
+         "Minimum measuring time per case (default 200)", "MS"},
+        {"format", 0, 0, G_OPTION_ARG_STRING, &bench_opts.format,
+         "Output format: jsonl (default) or csv", "FMT"},
+        {"transform-shapes", 0, 0, G_OPTION_ARG_STRING, &bench_opts.transform_shapes,
+         "transform_ip batch shapes, sources x objects (default 1x16,4x64,16x256)", "LIST"},
+        {"cache-sizes", 0, 0, G_OPTION_ARG_STRING, &bench_opts.cache_sizes,
+         "cache_update table sizes (default 16,1024,65536)", "LIST"},
+        {"list", 'l', 0, G_OPTION_ARG_NONE, &bench_opts.list, "List cases and exit", NULL},
+        {NULL}};
+    GOptionContext *ctx = g_option_context_new("- udpjsonmeta microbenchmarks");
+    GError *error = NULL;
+
+    g_option_context_add_main_entries(ctx, entries, NULL);
+    g_option_context_add_group(ctx, gst_init_get_option_group());
+    if (!g_option_context_parse(ctx, &argc, &argv, &error))
+    {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(ctx);
+        return 1;
+    }
+    g_option_context_free(ctx);
+    gst_init(NULL, NULL);
+    /* 与插件加载时相同的初始化：调试分类、追踪器与元素注册 */
+    gst_plugin_register_static(GST_VERSION_MAJOR, GST_VERSION_MINOR, "udpjsonmeta",
+                               "udpjsonmeta microbenchmark", gst_udpjson_meta_register, "1.0",
+                               "Proprietary", "udpjsonmeta_bench", "udpjsonmeta_bench",
+                               "http://nvidia.com");
+
+    if (!bench_opts.transform_shapes)
+        bench_opts.transform_shapes = g_strdup("1x16,4x64,16x256");
+    if (!bench_opts.cache_sizes)
+        bench_opts.cache_sizes = g_strdup("16,1024,65536");
+    if (bench_opts.min_time_ms <= 0)
+        bench_opts.min_time_ms = BENCH_DEFAULT_MIN_TIME_MS;
+
+    bench_stats = udpjson_stats_new();
+    bench_parse_and_cache();
+    bench_cache_update();
+    bench_cuav_parse();
+    bench_transform_ip();
+    udpjson_stats_free(bench_stats);
+
+    g_free(bench_opts.filter);
+    g_free(bench_opts.format);
+    g_free(bench_opts.transform_shapes);
+    g_free(bench_opts.cache_sizes);
+    return 0;
+}
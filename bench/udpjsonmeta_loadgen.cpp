@@ -0,0 +1,811 @@
+/*
+ * udpjsonmeta 负载发生器
+ *
+ * 用预格式化的报文模板和 sendmmsg 向目标 JSON 端口与 C-UAV 端口发送组播，
+ * 按速率均匀发送（每批不超过 1 毫秒的报文量），可按步进逐级提速直到接收端丢包：
+ *   ./udpjsonmeta_loadgen --rate 200000 --duration 10 --mix flat=8,nested=1,0x7201=1
+ *   ./udpjsonmeta_loadgen --ramp-start 20000 --ramp-step 20000 --metrics tcp:9464
+ *
+ * 模板中的 source_id/object_id/msg_sn 写成定宽（前导空格，仍是合法 JSON），
+ * 发送时只覆盖这几个字段，不做格式化。每一级输出一行 JSON；丢包按本机
+ * /proc/net/udp 中接收套接字的 drops 计数，给出 --metrics 时再用元素
+ * 指标服务的收包计数核对。
+ */
+#include "gstudpjsonmeta_cuav.h"
+#include "gstudpjsonmeta_cuav_msgs.h"
+#include "gstudpjsonmeta_cuav_sender.h"
+#include "gstudpjsonmeta_stats.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+/* sendmmsg 每批最多报文数 */
+#define LOADGEN_MAX_BATCH 1024
+/* 按权重展开的发送顺序表长度 */
+#define LOADGEN_SCHEDULE_SIZE 4096
+/* 可变字段宽度：source_id / object_id / msg_sn */
+#define LOADGEN_SOURCE_WIDTH 5
+#define LOADGEN_OBJECT_WIDTH 10
+#define LOADGEN_SN_WIDTH 10
+/* 落后计划超过该值时放弃追赶（纳秒），避免突发 */
+#define LOADGEN_MAX_LAG_NS (50 * 1000000ull)
+/* 实际速率低于目标的该比例时认为发生器自身已饱和 */
+#define LOADGEN_SATURATED_RATIO 0.95
+
+/**
+ * @brief 运行参数
+ */
+typedef struct
+{
+    gchar *group;             /* 组播地址 */
+    gint port;                /* 目标 JSON 端口 */
+    gint cuav_port;           /* C-UAV 端口 */
+    gchar *iface;             /* 出口网卡名 */
+    gint ttl;                 /* 组播 TTL，0 表示只发本机 */
+    gint sndbuf;              /* 发送缓冲区大小，0 表示系统默认 */
+    gchar *mix;               /* 报文组合 "名称=权重,..." */
+    gint sources;             /* 轮换的 source_id 数 */
+    gint objects;             /* 每个源轮换的 object_id 数 */
+    gdouble rate;             /* 固定速率(报文/秒)，0 表示不限速 */
+    gdouble duration;         /* 固定速率的持续时间(秒) */
+    gint batch;               /* sendmmsg 每批最多报文数 */
+    gdouble ramp_start;       /* 逐级提速的起始速率，0 表示不提速 */
+    gdouble ramp_step;        /* 每级增加的速率 */
+    gdouble ramp_max;         /* 最高速率 */
+    gdouble step_secs;        /* 每级持续时间(秒) */
+    gdouble drop_threshold;   /* 认为开始丢包的丢包比例 */
+    gint settle_ms;           /* 每级结束后等待接收端处理完的时间 */
+    gchar *metrics;           /* 元素指标服务地址（unix:/path、tcp:PORT 或 PORT） */
+} LoadgenOptions;
+
+/**
+ * @brief 一种报文模板
+ */
+typedef struct
+{
+    gchar *name;              /* 模板名（负载形态或 C-UAV 报文ID） */
+    gchar *data;              /* 预格式化报文 */
+    gsize len;                /* 报文长度 */
+    gsize source_off;         /* source_id 字段偏移，0 表示无 */
+    gsize object_off;         /* object_id 字段偏移，0 表示无 */
+    gsize sn_off;             /* msg_sn 字段偏移，0 表示无 */
+    guint weight;             /* 组合权重 */
+    gboolean cuav;            /* 发往 C-UAV 端口 */
+} LoadgenTemplate;
+
+/**
+ * @brief 累计发送计数
+ */
+typedef struct
+{
+    guint64 json;             /* 发往目标 JSON 端口的报文数 */
+    guint64 cuav;             /* 发往 C-UAV 端口的报文数 */
+    guint64 errors;           /* sendmmsg 未能发出的报文数 */
+    guint64 lag_resets;       /* 落后计划过多而放弃追赶的次数 */
+} LoadgenSent;
+
+/**
+ * @brief 发生器状态
+ */
+typedef struct
+{
+    gint fd;                  /* 发送套接字 */
+    struct sockaddr_in json_addr; /* 目标 JSON 端口地址 */
+    struct sockaddr_in cuav_addr; /* C-UAV 端口地址 */
+    GPtrArray *templates;     /* LoadgenTemplate* */
+    guint16 schedule[LOADGEN_SCHEDULE_SIZE]; /* 模板发送顺序 */
+    guint schedule_pos;       /* 下一个顺序表位置 */
+    gsize slot_size;          /* 每个报文槽的大小 */
+    gchar *slots;             /* 每批报文的发送缓冲 */
+    struct mmsghdr msgs[LOADGEN_MAX_BATCH];
+    struct iovec iovs[LOADGEN_MAX_BATCH];
+    guint64 seq;              /* 目标报文序号，用于轮换 source_id/object_id */
+    guint32 msg_sn;           /* C-UAV 报文计数 */
+    LoadgenSent sent;         /* 累计发送计数 */
+} Loadgen;
+
+static LoadgenOptions loadgen_opts = {
+    NULL, 6000, 8013, NULL, 0, 0, NULL, 4, 256, 10000, 10, 64, 0, 0, 0, 2, 0.001, 300, NULL};
+
+/* ---------------------------------------------------------------------------------------- */
+/* 报文模板                                                                                 */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 把数值右对齐写入定宽字段（前导空格）
+ */
+static inline void loadgen_write_field(gchar *dst, guint width, guint64 value)
+{
+    gchar *p = dst + width;
+
+    do
+    {
+        *--p = (gchar)('0' + value % 10);
+        value /= 10;
+    } while (value && p > dst);
+    while (p > dst)
+        *--p = ' ';
+}
+
+/**
+ * @brief 查找 "key": 之后的字段偏移
+ *
+ * @return 偏移，未找到返回 0
+ */
+static gsize loadgen_field_offset(const gchar *data, const gchar *key)
+{
+    gchar *needle = g_strdup_printf("\"%s\":", key);
+    const gchar *p = strstr(data, needle);
+    gsize off = p ? (gsize)(p - data) + strlen(needle) : 0;
+
+    g_free(needle);
+    return off;
+}
+
+/**
+ * @brief 生成目标 JSON 模板
+ *
+ * @param shape 负载形态 minimal/flat/nested/large
+ * @return 模板，未知形态返回 NULL
+ */
+static LoadgenTemplate *loadgen_json_template(const gchar *shape)
+{
+    LoadgenTemplate *t = NULL;
+    gchar *data = NULL;
+
+    /* %5u/%10u 先占住定宽字段，发送时原位覆盖 */
+    if (g_str_equal(shape, "minimal"))
+        data = g_strdup_printf("{\"source_id\":%5u,\"object_id\":%10u,\"value\":1}", 0, 0);
+    else if (g_str_equal(shape, "flat"))
+        data = g_strdup_printf(
+            "{\"source_id\":%5u,\"object_id\":%10u,\"value\":{\"cls\":\"uav\",\"conf\":0.93,"
+            "\"lat\":31.2304,\"lon\":121.4737,\"alt\":152.5,\"vx\":3.1,\"vy\":-0.4,"
+            "\"vz\":0.2,\"rcs\":0.01}}",
+            0, 0);
+    else if (g_str_equal(shape, "nested"))
+        data = g_strdup_printf(
+            "{\"source_id\":%5u,\"object_id\":%10u,\"value\":{"
+            "\"track\":{\"pos\":{\"lat\":31.2304,\"lon\":121.4737,\"alt\":152.5},"
+            "\"vel\":[3.1,-0.4,0.2],\"cov\":[[1,0,0],[0,1,0],[0,0,1]]},"
+            "\"sensors\":[{\"id\":1,\"snr\":12.5},{\"id\":2,\"snr\":9.1}],"
+            "\"label\":{\"cls\":\"uav\",\"conf\":0.93,\"attrs\":[\"quad\",\"small\"]}}}",
+            0, 0);
+    else if (g_str_equal(shape, "large"))
+    {
+        GString *s = g_string_new(NULL);
+        g_string_append_printf(s, "{\"source_id\":%5u,\"object_id\":%10u,\"value\":{\"points\":[",
+                               0, 0);
+        for (guint i = 0; i < 128; i++)
+            g_string_append_printf(s, "%s[%u.125,%u.5,%u]", i ? "," : "", i, i * 3, i * 7);
+        g_string_append(s, "]}}");
+        data = g_string_free(s, FALSE);
+    }
+    if (!data)
+        return NULL;
+
+    t = g_new0(LoadgenTemplate, 1);
+    t->name = g_strdup(shape);
+    t->data = data;
+    t->len = strlen(data);
+    t->source_off = loadgen_field_offset(data, "source_id");
+    t->object_off = loadgen_field_offset(data, "object_id");
+    return t;
+}
+
+/**
+ * @brief 生成 C-UAV 报文模板（字段全 0 的数据流报文，msg_sn 改为定宽）
+ *
+ * @param encoder 编码器
+ * @param msg_id 报文ID
+ * @return 模板，未知报文返回 NULL
+ */
+static LoadgenTemplate *loadgen_cuav_template(CUAVEncoder *encoder, guint16 msg_id)
+{
+    CUAVMessageUnion msg;
+    gchar buf[4096];
+    gsize len = 0;
+    gsize off = 0;
+    gsize end = 0;
+    LoadgenTemplate *t = NULL;
+    GString *s = NULL;
+
+    memset(&msg, 0, sizeof(msg));
+    len = cuav_encode_message(encoder, msg_id, CUAV_MSG_TYPE_STREAM, &msg, buf, sizeof(buf) - 1);
+    if (len == 0)
+        return NULL;
+    buf[len] = '\0';
+    off = loadgen_field_offset(buf, "msg_sn");
+    if (off == 0)
+        return NULL;
+    for (end = off; end < len && g_ascii_isdigit(buf[end]); end++)
+        ;
+
+    s = g_string_new_len(buf, (gssize)off);
+    g_string_append_printf(s, "%*u", LOADGEN_SN_WIDTH, 0);
+    g_string_append_len(s, buf + end, (gssize)(len - end));
+
+    t = g_new0(LoadgenTemplate, 1);
+    t->name = g_strdup_printf("0x%04X", msg_id);
+    t->len = s->len;
+    t->data = g_string_free(s, FALSE);
+    t->sn_off = off;
+    t->cuav = TRUE;
+    return t;
+}
+
+static void loadgen_template_free(gpointer data)
+{
+    LoadgenTemplate *t = (LoadgenTemplate *)data;
+
+    g_free(t->name);
+    g_free(t->data);
+    g_free(t);
+}
+
+/**
+ * @brief 解析 --mix，生成模板列表
+ *
+ * 每项为 "名称[=权重]"：名称是负载形态 (minimal/flat/nested/large) 或
+ * C-UAV 报文ID（如 0x7201）；"cuav" 表示全部已定义的 C-UAV 报文各一份。
+ *
+ * @return 模板列表，出错返回 NULL
+ */
+static GPtrArray *loadgen_parse_mix(const gchar *mix)
+{
+    static const CUAVAddressing addressing = {1, 2, 1, CUAV_BROADCAST_ID,
+                                              CUAV_BROADCAST_ID, CUAV_BROADCAST_ID,
+                                              CUAV_BROADCAST_ID, CUAV_BROADCAST_ID};
+    GPtrArray *templates = g_ptr_array_new_with_free_func(loadgen_template_free);
+    CUAVEncoder *encoder = cuav_encoder_new(&addressing);
+    gchar **items = g_strsplit(mix, ",", -1);
+    gboolean ok = TRUE;
+
+    for (guint i = 0; items[i] && ok; i++)
+    {
+        gchar **kv = g_strsplit(g_strstrip(items[i]), "=", 2);
+        guint weight = kv[1] ? (guint)g_ascii_strtoull(kv[1], NULL, 10) : 1;
+
+        if (!kv[0] || !*kv[0] || weight == 0)
+        {
+            g_printerr("invalid mix entry '%s'\n", items[i]);
+            ok = FALSE;
+        }
+        else if (g_str_equal(kv[0], "cuav"))
+        {
+            for (guint m = 0; m < CUAV_MSG_INDEX_COUNT; m++)
+            {
+                LoadgenTemplate *t = loadgen_cuav_template(encoder, cuav_message_descs[m].msg_id);
+                if (!t)
+                    continue;
+                t->weight = weight;
+                g_ptr_array_add(templates, t);
+            }
+        }
+        else
+        {
+            LoadgenTemplate *t = NULL;
+            if (g_str_has_prefix(kv[0], "0x") || g_str_has_prefix(kv[0], "0X"))
+                t = loadgen_cuav_template(encoder, (guint16)g_ascii_strtoull(kv[0] + 2, NULL, 16));
+            else
+                t = loadgen_json_template(kv[0]);
+            if (!t)
+            {
+                g_printerr("unknown payload '%s'\n", kv[0]);
+                ok = FALSE;
+            }
+            else
+            {
+                t->weight = weight;
+                g_ptr_array_add(templates, t);
+            }
+        }
+        g_strfreev(kv);
+    }
+    g_strfreev(items);
+    cuav_encoder_free(encoder);
+
+    if (!ok || templates->len == 0 || templates->len > G_MAXUINT16)
+    {
+        g_ptr_array_free(templates, TRUE);
+        return NULL;
+    }
+    return templates;
+}
+
+/**
+ * @brief 按权重展开发送顺序（平滑加权轮询，同类报文尽量分散）
+ */
+static void loadgen_build_schedule(Loadgen *lg)
+{
+    gint64 *current = g_new0(gint64, lg->templates->len);
+    gint64 total = 0;
+
+    for (guint i = 0; i < lg->templates->len; i++)
+        total += ((LoadgenTemplate *)g_ptr_array_index(lg->templates, i))->weight;
+
+    for (guint n = 0; n < LOADGEN_SCHEDULE_SIZE; n++)
+    {
+        guint best = 0;
+        for (guint i = 0; i < lg->templates->len; i++)
+        {
+            current[i] += ((LoadgenTemplate *)g_ptr_array_index(lg->templates, i))->weight;
+            if (current[i] > current[best])
+                best = i;
+        }
+        current[best] -= total;
+        lg->schedule[n] = (guint16)best;
+    }
+    g_free(current);
+}
+
+/* ---------------------------------------------------------------------------------------- */
+/* 发送                                                                                     */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 填充目的地址
+ */
+static gboolean loadgen_set_addr(struct sockaddr_in *addr, const gchar *group, gint port)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons((guint16)port);
+    return inet_pton(AF_INET, group, &addr->sin_addr) == 1;
+}
+
+/**
+ * @brief 创建发送套接字（组播回环打开，TTL 默认 0 只发本机）
+ */
+static gboolean loadgen_open_socket(Loadgen *lg)
+{
+    guchar ttl = (guchar)CLAMP(loadgen_opts.ttl, 0, 255);
+    guchar loop = 1;
+
+    if (!loadgen_set_addr(&lg->json_addr, loadgen_opts.group, loadgen_opts.port) ||
+        !loadgen_set_addr(&lg->cuav_addr, loadgen_opts.group, loadgen_opts.cuav_port))
+    {
+        g_printerr("invalid group address %s\n", loadgen_opts.group);
+        return FALSE;
+    }
+
+    lg->fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (lg->fd < 0)
+    {
+        g_printerr("socket: %s\n", strerror(errno));
+        return FALSE;
+    }
+    setsockopt(lg->fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+    setsockopt(lg->fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+    if (loadgen_opts.sndbuf > 0 &&
+        setsockopt(lg->fd, SOL_SOCKET, SO_SNDBUF, &loadgen_opts.sndbuf,
+                   sizeof(loadgen_opts.sndbuf)) < 0)
+        g_printerr("SO_SNDBUF %d: %s\n", loadgen_opts.sndbuf, strerror(errno));
+    if (loadgen_opts.iface && *loadgen_opts.iface)
+    {
+        struct ip_mreqn mreq; /* 出口网卡 */
+        memset(&mreq, 0, sizeof(mreq));
+        mreq.imr_ifindex = (gint)if_nametoindex(loadgen_opts.iface);
+        if (mreq.imr_ifindex == 0 ||
+            setsockopt(lg->fd, IPPROTO_IP, IP_MULTICAST_IF, &mreq, sizeof(mreq)) < 0)
+        {
+            g_printerr("IP_MULTICAST_IF %s: %s\n", loadgen_opts.iface, strerror(errno));
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**
+ * @brief 填充并发送一批报文
+ *
+ * @param lg 发生器
+ * @param n 报文数（不超过 LOADGEN_MAX_BATCH）
+ */
+static void loadgen_send_batch(Loadgen *lg, guint n)
+{
+    guint done = 0;
+
+    for (guint i = 0; i < n; i++)
+    {
+        const LoadgenTemplate *t = (const LoadgenTemplate *)g_ptr_array_index(
+            lg->templates, lg->schedule[lg->schedule_pos++ & (LOADGEN_SCHEDULE_SIZE - 1)]);
+        gchar *slot = lg->slots + (gsize)i * lg->slot_size;
+
+        memcpy(slot, t->data, t->len);
+        if (t->cuav)
+        {
+            loadgen_write_field(slot + t->sn_off, LOADGEN_SN_WIDTH, ++lg->msg_sn);
+            lg->msgs[i].msg_hdr.msg_name = &lg->cuav_addr;
+        }
+        else
+        {
+            guint64 seq = lg->seq++;
+            if (t->source_off)
+                loadgen_write_field(slot + t->source_off, LOADGEN_SOURCE_WIDTH,
+                                    seq % (guint64)loadgen_opts.sources);
+            loadgen_write_field(slot + t->object_off, LOADGEN_OBJECT_WIDTH,
+                                (seq / (guint64)loadgen_opts.sources) % (guint64)loadgen_opts.objects);
+            lg->msgs[i].msg_hdr.msg_name = &lg->json_addr;
+        }
+        lg->iovs[i].iov_len = t->len;
+    }
+
+    while (done < n)
+    {
+        gint r = sendmmsg(lg->fd, lg->msgs + done, n - done, 0);
+        if (r < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            /* ENOBUFS/EAGAIN：本批剩余报文计为发送失败，不重试以免打乱节奏 */
+            lg->sent.errors += n - done;
+            break;
+        }
+        for (gint i = 0; i < r; i++)
+        {
+            if (lg->msgs[done + i].msg_hdr.msg_name == &lg->cuav_addr)
+                lg->sent.cuav++;
+            else
+                lg->sent.json++;
+        }
+        done += (guint)r;
+    }
+}
+
+/**
+ * @brief 按速率发送一段时间
+ *
+ * 每批报文数取 1 毫秒的报文量（不超过 --batch），按绝对时刻睡眠，
+ * 落后计划超过 LOADGEN_MAX_LAG_NS 时从当前时刻重新计时。
+ *
+ * @param lg 发生器
+ * @param rate 报文/秒，0 表示不限速
+ * @param seconds 持续时间
+ * @return 实际持续时间(纳秒)
+ */
+static guint64 loadgen_run(Loadgen *lg, gdouble rate, gdouble seconds)
+{
+    guint64 begin_ns = udpjson_now_ns();
+    guint64 end_ns = begin_ns + (guint64)(seconds * 1e9);
+    guint batch = (guint)loadgen_opts.batch;
+    gdouble interval_ns = 0;
+    gdouble next_ns = (gdouble)begin_ns;
+    guint64 now_ns = begin_ns;
+
+    if (rate > 0)
+    {
+        batch = (guint)CLAMP(rate / 1000.0, 1.0, (gdouble)loadgen_opts.batch);
+        interval_ns = 1e9 / rate;
+    }
+
+    while (now_ns < end_ns)
+    {
+        if (rate > 0 && next_ns > (gdouble)now_ns)
+        {
+            struct timespec ts;
+            guint64 wake_ns = (guint64)next_ns;
+            ts.tv_sec = (time_t)(wake_ns / 1000000000ull);
+            ts.tv_nsec = (long)(wake_ns % 1000000000ull);
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+        }
+        else if (rate > 0 && (gdouble)now_ns - next_ns > (gdouble)LOADGEN_MAX_LAG_NS)
+        {
+            next_ns = (gdouble)now_ns;
+            lg->sent.lag_resets++;
+        }
+        loadgen_send_batch(lg, batch);
+        next_ns += batch * interval_ns;
+        now_ns = udpjson_now_ns();
+    }
+    return now_ns - begin_ns;
+}
+
+/* ---------------------------------------------------------------------------------------- */
+/* 接收端观测                                                                               */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 读取本机绑定指定端口的 UDP 套接字的 drops 计数之和
+ */
+static guint64 loadgen_kernel_drops(void)
+{
+    gchar *contents = NULL;
+    gchar **lines = NULL;
+    guint64 drops = 0;
+
+    if (!g_file_get_contents("/proc/net/udp", &contents, NULL, NULL))
+        return 0;
+    lines = g_strsplit(contents, "\n", -1);
+    /* 第一行是表头；列：sl local rem st queues tr retrnsmt uid timeout inode ref pointer drops */
+    for (guint i = 1; lines[i]; i++)
+    {
+        gchar **cols = g_strsplit_set(g_strstrip(lines[i]), " ", -1);
+        gchar *fields[13];
+        guint n = 0;
+
+        for (guint c = 0; cols[c] && n < G_N_ELEMENTS(fields); c++)
+        {
+            if (*cols[c])
+                fields[n++] = cols[c];
+        }
+        if (n == G_N_ELEMENTS(fields))
+        {
+            const gchar *colon = strchr(fields[1], ':');
+            gint port = colon ? (gint)g_ascii_strtoull(colon + 1, NULL, 16) : 0;
+            if (port == loadgen_opts.port || port == loadgen_opts.cuav_port)
+                drops += g_ascii_strtoull(fields[12], NULL, 10);
+        }
+        g_strfreev(cols);
+    }
+    g_strfreev(lines);
+    g_free(contents);
+    return drops;
+}
+
+/**
+ * @brief 从元素指标服务读取目标 JSON 与 C-UAV 端口的收包计数之和
+ *
+ * @param endpoint 指标服务地址
+ * @param received 输出收包数
+ * @return 读取成功返回 TRUE
+ */
+static gboolean loadgen_scrape_received(const gchar *endpoint, guint64 *received)
+{
+    static const gchar *metrics[] = {"udpjsonmeta_packets_total{socket=\"json\"} ",
+                                     "udpjsonmeta_packets_total{socket=\"cuav\"} "};
+    static const gchar request[] = "GET /metrics HTTP/1.0\r\n\r\n";
+    GString *body = g_string_new(NULL);
+    gchar buf[4096];
+    gssize n = 0;
+    gint fd = -1;
+    gboolean found = FALSE;
+
+    if (g_str_has_prefix(endpoint, "unix:"))
+    {
+        struct sockaddr_un addr; /* Unix 域地址 */
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        g_strlcpy(addr.sun_path, endpoint + 5, sizeof(addr.sun_path));
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+        {
+            close(fd);
+            fd = -1;
+        }
+    }
+    else
+    {
+        struct sockaddr_in addr; /* TCP 地址 */
+        const gchar *port = g_str_has_prefix(endpoint, "tcp:") ? endpoint + 4 : endpoint;
+        loadgen_set_addr(&addr, "127.0.0.1", (gint)g_ascii_strtoull(port, NULL, 10));
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+        {
+            close(fd);
+            fd = -1;
+        }
+    }
+    if (fd < 0)
+    {
+        g_string_free(body, TRUE);
+        return FALSE;
+    }
+
+    if (write(fd, request, sizeof(request) - 1) == (gssize)(sizeof(request) - 1))
+    {
+        while ((n = read(fd, buf, sizeof(buf))) > 0)
+            g_string_append_len(body, buf, n);
+    }
+    close(fd);
+
+    *received = 0;
+    for (guint i = 0; i < G_N_ELEMENTS(metrics); i++)
+    {
+        const gchar *p = strstr(body->str, metrics[i]);
+        if (p)
+        {
+            *received += (guint64)g_ascii_strtod(p + strlen(metrics[i]), NULL);
+            found = TRUE;
+        }
+    }
+    g_string_free(body, TRUE);
+    return found;
+}
+
+/**
+ * @brief 一级发送的结果
+ */
+typedef struct
+{
+    gdouble rate;             /* 目标速率 */
+    gdouble achieved;         /* 实际速率 */
+    guint64 sent;             /* 发出的报文数 */
+    guint64 kernel_drops;     /* 接收套接字的 drops 增量 */
+    gboolean have_received;   /* 是否读到元素收包计数 */
+    guint64 received;         /* 元素收包计数增量 */
+    gdouble loss;             /* 丢包比例 */
+} LoadgenStep;
+
+/**
+ * @brief 按一个速率发送并统计接收端丢包，输出一行 JSON
+ */
+static void loadgen_step(Loadgen *lg, gdouble rate, gdouble seconds, LoadgenStep *step)
+{
+    LoadgenSent before = lg->sent;
+    guint64 drops_before = loadgen_kernel_drops();
+    guint64 rx_before = 0;
+    guint64 rx_after = 0;
+    gboolean have_rx = loadgen_opts.metrics &&
+                       loadgen_scrape_received(loadgen_opts.metrics, &rx_before);
+    guint64 elapsed_ns = loadgen_run(lg, rate, seconds);
+    guint64 lost = 0;
+
+    g_usleep((gulong)loadgen_opts.settle_ms * 1000);
+
+    memset(step, 0, sizeof(*step));
+    step->rate = rate;
+    step->sent = (lg->sent.json - before.json) + (lg->sent.cuav - before.cuav);
+    step->achieved = elapsed_ns ? step->sent * 1e9 / (gdouble)elapsed_ns : 0;
+    step->kernel_drops = loadgen_kernel_drops() - drops_before;
+    if (have_rx && loadgen_scrape_received(loadgen_opts.metrics, &rx_after))
+    {
+        step->have_received = TRUE;
+        step->received = rx_after - rx_before;
+    }
+    lost = step->kernel_drops;
+    if (step->have_received && step->sent > step->received)
+        lost = MAX(lost, step->sent - step->received);
+    step->loss = step->sent ? (gdouble)lost / (gdouble)step->sent : 0;
+
+    g_print("{\"rate\":%.0f,\"achieved_pps\":%.0f,\"sent\":%" G_GUINT64_FORMAT
+            ",\"sent_json\":%" G_GUINT64_FORMAT ",\"sent_cuav\":%" G_GUINT64_FORMAT
+            ",\"send_errors\":%" G_GUINT64_FORMAT ",\"lag_resets\":%" G_GUINT64_FORMAT
+            ",\"kernel_drops\":%" G_GUINT64_FORMAT,
+            rate, step->achieved, step->sent, lg->sent.json - before.json,
+            lg->sent.cuav - before.cuav, lg->sent.errors - before.errors,
+            lg->sent.lag_resets - before.lag_resets, step->kernel_drops);
+    if (step->have_received)
+        g_print(",\"received\":%" G_GUINT64_FORMAT, step->received);
+    g_print(",\"loss\":%.6f}\n", step->loss);
+}
+
+/**
+ * @brief 逐级提速直到丢包、发生器饱和或达到最高速率
+ */
+static void loadgen_ramp(Loadgen *lg)
+{
+    gdouble clean = 0;
+    const gchar *result = "max-rate";
+
+    for (gdouble rate = loadgen_opts.ramp_start;
+         loadgen_opts.ramp_max <= 0 || rate <= loadgen_opts.ramp_max;
+         rate += loadgen_opts.ramp_step)
+    {
+        LoadgenStep step;
+
+        loadgen_step(lg, rate, loadgen_opts.step_secs, &step);
+        if (step.loss > loadgen_opts.drop_threshold)
+        {
+            result = "drop";
+            break;
+        }
+        if (step.achieved < rate * LOADGEN_SATURATED_RATIO)
+        {
+            result = "generator-limited";
+            break;
+        }
+        clean = rate;
+    }
+    g_print("{\"result\":\"%s\",\"max_clean_rate\":%.0f}\n", result, clean);
+}
+
+int main(int argc, char *argv[])
+{
+    GOptionEntry entries[] = {
+        {"group", 'g', 0, G_OPTION_ARG_STRING, &loadgen_opts.group,
+         "Multicast group (default 239.255.0.1)", "IP"},
+        {"port", 'p', 0, G_OPTION_ARG_INT, &loadgen_opts.port, "Object JSON port (default 6000)",
+         "PORT"},
+        {"cuav-port", 0, 0, G_OPTION_ARG_INT, &loadgen_opts.cuav_port,
+         "C-UAV port (default 8013)", "PORT"},
+        {"iface", 'i', 0, G_OPTION_ARG_STRING, &loadgen_opts.iface, "Outgoing interface", "NAME"},
+        {"ttl", 0, 0, G_OPTION_ARG_INT, &loadgen_opts.ttl,
+         "Multicast TTL (default 0, this host only)", "N"},
+        {"sndbuf", 0, 0, G_OPTION_ARG_INT, &loadgen_opts.sndbuf, "SO_SNDBUF in bytes", "BYTES"},
+        {"mix", 'm', 0, G_OPTION_ARG_STRING, &loadgen_opts.mix,
+         "Payload mix NAME[=WEIGHT],...; NAME is minimal/flat/nested/large, a C-UAV msg_id "
+         "such as 0x7201, or cuav for every C-UAV message (default flat)", "LIST"},
+        {"sources", 0, 0, G_OPTION_ARG_INT, &loadgen_opts.sources,
+         "Distinct source_id values (default 4)", "N"},
+        {"objects", 0, 0, G_OPTION_ARG_INT, &loadgen_opts.objects,
+         "Distinct object_id values per source (default 256)", "N"},
+        {"rate", 'r', 0, G_OPTION_ARG_DOUBLE, &loadgen_opts.rate,
+         "Packets per second, 0 = unpaced (default 10000)", "PPS"},
+        {"duration", 'd', 0, G_OPTION_ARG_DOUBLE, &loadgen_opts.duration,
+         "Seconds to send at --rate (default 10)", "SECS"},
+        {"batch", 'b', 0, G_OPTION_ARG_INT, &loadgen_opts.batch,
+         "Maximum packets per sendmmsg call (default 64)", "N"},
+        {"ramp-start", 0, 0, G_OPTION_ARG_DOUBLE, &loadgen_opts.ramp_start,
+         "Ramp mode: first rate in packets per second", "PPS"},
+        {"ramp-step", 0, 0, G_OPTION_ARG_DOUBLE, &loadgen_opts.ramp_step,
+         "Ramp mode: rate increment per step (default ramp-start)", "PPS"},
+        {"ramp-max", 0, 0, G_OPTION_ARG_DOUBLE, &loadgen_opts.ramp_max,
+         "Ramp mode: highest rate, 0 = until drops (default 0)", "PPS"},
+        {"step-secs", 0, 0, G_OPTION_ARG_DOUBLE, &loadgen_opts.step_secs,
+         "Ramp mode: seconds per step (default 2)", "SECS"},
+        {"drop-threshold", 0, 0, G_OPTION_ARG_DOUBLE, &loadgen_opts.drop_threshold,
+         "Ramp mode: loss ratio that ends the ramp (default 0.001)", "RATIO"},
+        {"settle-ms", 0, 0, G_OPTION_ARG_INT, &loadgen_opts.settle_ms,
+         "Wait after each step before reading receiver counters (default 300)", "MS"},
+        {"metrics", 0, 0, G_OPTION_ARG_STRING, &loadgen_opts.metrics,
+         "Element metrics-endpoint to cross-check received packets", "ENDPOINT"},
+        {NULL}};
+    GOptionContext *ctx = g_option_context_new("- udpjsonmeta load generator");
+    GError *error = NULL;
+    Loadgen lg;
+    gsize max_len = 0;
+
+    g_option_context_add_main_entries(ctx, entries, NULL);
+    if (!g_option_context_parse(ctx, &argc, &argv, &error))
+    {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(ctx);
+        return 1;
+    }
+    g_option_context_free(ctx);
+
+    if (!loadgen_opts.group)
+        loadgen_opts.group = g_strdup("239.255.0.1");
+    if (!loadgen_opts.mix)
+        loadgen_opts.mix = g_strdup("flat");
+    loadgen_opts.batch = CLAMP(loadgen_opts.batch, 1, LOADGEN_MAX_BATCH);
+    loadgen_opts.sources = MAX(loadgen_opts.sources, 1);
+    loadgen_opts.objects = MAX(loadgen_opts.objects, 1);
+    if (loadgen_opts.ramp_step <= 0)
+        loadgen_opts.ramp_step = loadgen_opts.ramp_start;
+
+    memset(&lg, 0, sizeof(lg));
+    lg.fd = -1;
+    lg.templates = loadgen_parse_mix(loadgen_opts.mix);
+    if (!lg.templates || !loadgen_open_socket(&lg))
+        return 1;
+    loadgen_build_schedule(&lg);
+
+    for (guint i = 0; i < lg.templates->len; i++)
+        max_len = MAX(max_len, ((LoadgenTemplate *)g_ptr_array_index(lg.templates, i))->len);
+    lg.slot_size = max_len;
+    lg.slots = (gchar *)g_malloc((gsize)loadgen_opts.batch * lg.slot_size);
+    for (gint i = 0; i < loadgen_opts.batch; i++)
+    {
+        lg.iovs[i].iov_base = lg.slots + (gsize)i * lg.slot_size;
+        lg.msgs[i].msg_hdr.msg_iov = &lg.iovs[i];
+        lg.msgs[i].msg_hdr.msg_iovlen = 1;
+        lg.msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    }
+
+    if (loadgen_opts.ramp_start > 0)
+        loadgen_ramp(&lg);
+    else
+    {
+        LoadgenStep step;
+        loadgen_step(&lg, loadgen_opts.rate, loadgen_opts.duration, &step);
+    }
+
+    close(lg.fd);
+    g_free(lg.slots);
+    g_ptr_array_free(lg.templates, TRUE);
+    g_free(loadgen_opts.group);
+    g_free(loadgen_opts.iface);
+    g_free(loadgen_opts.mix);
+    g_free(loadgen_opts.metrics);
+    return 0;
+}
@@ -0,0 +1,500 @@
+/*
+ * udpjsonmeta 抓包与接收日志回放
+ *
+ * 把 pcap/pcapng 中的 UDP 报文按目的端口、把接收日志 (journal-dir 写出的 .ujj)
+ * 中的报文按记录的套接字，直接送入 udpjson_ingest_parse_and_cache /
+ * udpjson_ingest_parse_cuav，不经过套接字。默认尽快回放（测吞吐），--speed 1 按
+ * 原始时间间隔回放，--speed N 为 N 倍速。每个文件（--merge 时为全部文件）输出
+ * 一行 JSON：吞吐、解析与缓存计数、缓存内容摘要 (cache_sha1)。字段与
+ * udpjsonmeta_bench 兼容，可直接比较：
+ *   ./udpjsonmeta_replay site.pcapng > new.jsonl
+ *   ./udpjsonmeta_replay --merge --speed 1 /var/log/udpjson/udpjsonmeta-*.ujj
+ *   python3 python_tools/bench_compare.py old.jsonl new.jsonl
+ */
+#include "gstudpjsonmeta_ingest.h"
+#include "gstudpjsonmeta_journal.h"
+#include "gstudpjsonmeta_pcap.h"
+
+#include <arpa/inet.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * @brief 运行参数
+ */
+typedef struct
+{
+    gint port;                /* 目标 JSON 端口 */
+    gint cuav_port;           /* C-UAV 端口 */
+    gint cuav_ctrl_port;      /* C-UAV 控制端口，0 表示不回放 */
+    gchar *group;             /* 只回放发往该地址的报文，NULL 表示不限 */
+    gdouble speed;            /* 回放倍速，0 表示尽快 */
+    gint loops;               /* 重复次数 */
+    gint max_cache_size;      /* 缓存上限，与元素 max-cache-size 相同 */
+    gchar *dump_cache;        /* 回放结束后写出缓存内容的文件 */
+    gboolean merge;           /* 按顺序把全部文件回放进同一缓存，只输出一行 */
+} ReplayOptions;
+
+static ReplayOptions replay_opts = {6000, 8013, 8003, NULL, 0, 1, 2048, NULL, FALSE};
+
+/**
+ * @brief 回放计数
+ */
+typedef struct
+{
+    guint64 json;             /* 送入目标 JSON 解析的报文数 */
+    guint64 cuav;             /* 送入 C-UAV 解析的报文数 */
+    guint64 skipped;          /* 端口或地址不匹配的报文数 */
+    guint64 bytes;            /* 送入解析的字节数 */
+    guint64 journal_dropped;  /* 接收日志记录时丢弃的报文数 */
+} ReplayCounts;
+
+/**
+ * @brief 一个回放文件（pcap/pcapng 或接收日志）
+ */
+typedef struct
+{
+    UdpJsonPcapReader *pcap;          /* 抓包读取器 */
+    UdpJsonJournalReader *journal;    /* 接收日志读取器 */
+} ReplaySource;
+
+/**
+ * @brief 待回放的一个报文
+ */
+typedef struct
+{
+    guint64 ts_ns;            /* 记录时间 */
+    UdpJsonFlightSocket socket; /* 送入的套接字 */
+    const gchar *payload;     /* 报文 */
+    gsize len;                /* 报文长度 */
+} ReplayDatagram;
+
+/**
+ * @brief 按原始时间间隔回放的时钟，每遍重新开始
+ */
+typedef struct
+{
+    gboolean started;         /* 已回放第一个报文 */
+    guint64 start_ns;         /* 第一个报文的回放时间 */
+    guint64 first_ts_ns;      /* 第一个报文的记录时间 */
+} ReplayClock;
+
+/**
+ * @brief 按 (source_id, object_id) 排序缓存条目
+ */
+static gint replay_key_cmp(gconstpointer a, gconstpointer b)
+{
+    const UdpJsonCacheKey *ka = *(const UdpJsonCacheKey *const *)a;
+    const UdpJsonCacheKey *kb = *(const UdpJsonCacheKey *const *)b;
+
+    if (ka->source_id != kb->source_id)
+        return ka->source_id < kb->source_id ? -1 : 1;
+    if (ka->object_id != kb->object_id)
+        return ka->object_id < kb->object_id ? -1 : 1;
+    return 0;
+}
+
+/**
+ * @brief 计算缓存内容摘要（不含接收时间），可选写出到文件
+ *
+ * @param ingest 接收实例
+ * @param dump_path 输出文件，NULL 表示不写
+ * @return SHA-1 十六进制字符串，调用方释放
+ */
+static gchar *replay_cache_digest(UdpJsonIngest *ingest, const gchar *dump_path)
+{
+    GPtrArray *keys = g_ptr_array_new();
+    GChecksum *sum = g_checksum_new(G_CHECKSUM_SHA1);
+    GString *line = g_string_new(NULL);
+    FILE *fp = dump_path ? fopen(dump_path, "w") : NULL;
+    GHashTableIter iter;
+    gpointer key = NULL;
+    gchar *digest = NULL;
+
+    if (dump_path && !fp)
+        g_printerr("cannot write %s\n", dump_path);
+
+    g_hash_table_iter_init(&iter, ingest->cache);
+    while (g_hash_table_iter_next(&iter, &key, NULL))
+        g_ptr_array_add(keys, key);
+    g_ptr_array_sort(keys, replay_key_cmp);
+
+    for (guint i = 0; i < keys->len; i++)
+    {
+        const UdpJsonCacheKey *k = (const UdpJsonCacheKey *)g_ptr_array_index(keys, i);
+        const UdpJsonCacheValue *v = (const UdpJsonCacheValue *)g_hash_table_lookup(ingest->cache, k);
+
+        g_string_printf(line, "%u\t%" G_GUINT64_FORMAT "\t%u\t%s\n", k->source_id, k->object_id,
+                        v->tar_id, v->value);
+        g_checksum_update(sum, (const guchar *)line->str, (gssize)line->len);
+        if (fp)
+            fputs(line->str, fp);
+    }
+
+    if (fp)
+        fclose(fp);
+    digest = g_strdup(g_checksum_get_string(sum));
+    g_string_free(line, TRUE);
+    g_checksum_free(sum);
+    g_ptr_array_free(keys, TRUE);
+    return digest;
+}
+
+/**
+ * @brief 打开回放文件，按文件头识别接收日志与 pcap/pcapng
+ *
+ * @return 成功返回 TRUE
+ */
+static gboolean replay_source_open(ReplaySource *src, const gchar *path)
+{
+    FILE *fp = fopen(path, "rb");
+    guint32 magic = 0;
+    gboolean is_journal = FALSE;
+
+    memset(src, 0, sizeof(*src));
+    if (!fp)
+    {
+        g_printerr("cannot open %s\n", path);
+        return FALSE;
+    }
+    is_journal = fread(&magic, sizeof(magic), 1, fp) == 1 && magic == UDPJSON_JOURNAL_MAGIC;
+    fclose(fp);
+
+    if (is_journal)
+        src->journal = udpjson_journal_reader_open(path);
+    else
+        src->pcap = udpjson_pcap_open(path);
+    if (!src->journal && !src->pcap)
+    {
+        g_printerr("cannot read %s as pcap/pcapng or journal\n", path);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * @brief 关闭回放文件
+ */
+static void replay_source_close(ReplaySource *src)
+{
+    udpjson_journal_reader_close(src->journal);
+    udpjson_pcap_close(src->pcap);
+}
+
+/**
+ * @brief 回到文件开头
+ */
+static void replay_source_rewind(ReplaySource *src)
+{
+    if (src->journal)
+        udpjson_journal_reader_rewind(src->journal);
+    else
+        udpjson_pcap_rewind(src->pcap);
+}
+
+/**
+ * @brief 取下一个要回放的报文
+ *
+ * 抓包按目的端口与 --group 选择套接字，不匹配的计入 skipped；接收日志使用
+ * 记录的套接字，--cuav-ctrl-port 为 0 时跳过控制端口的记录。
+ *
+ * @param src 回放文件
+ * @param group 目的地址过滤（网络字节序），0 表示不限
+ * @param dgram 输出报文
+ * @param counts 累计计数
+ * @return 文件结束返回 FALSE
+ */
+static gboolean replay_source_next(ReplaySource *src, guint32 group, ReplayDatagram *dgram,
+                                   ReplayCounts *counts)
+{
+    UdpJsonPcapDatagram pkt;
+
+    if (src->journal)
+    {
+        UdpJsonJournalRecord rec;
+
+        while (udpjson_journal_reader_next(src->journal, &rec))
+        {
+            counts->journal_dropped += rec.dropped;
+            if (rec.socket > UDPJSON_FR_SOCKET_CUAV_CTRL ||
+                (rec.socket == UDPJSON_FR_SOCKET_CUAV_CTRL && replay_opts.cuav_ctrl_port <= 0))
+            {
+                counts->skipped++;
+                continue;
+            }
+            dgram->ts_ns = rec.ts_ns;
+            dgram->socket = (UdpJsonFlightSocket)rec.socket;
+            dgram->payload = rec.payload;
+            dgram->len = rec.len;
+            return TRUE;
+        }
+        return FALSE;
+    }
+
+    while (udpjson_pcap_next(src->pcap, &pkt))
+    {
+        gboolean matched = !group || pkt.dst_addr == group;
+
+        if (matched && pkt.dst_port == replay_opts.port)
+            dgram->socket = UDPJSON_FR_SOCKET_JSON;
+        else if (matched && replay_opts.cuav_ctrl_port > 0 &&
+                 pkt.dst_port == replay_opts.cuav_ctrl_port)
+            dgram->socket = UDPJSON_FR_SOCKET_CUAV_CTRL;
+        else if (matched && pkt.dst_port == replay_opts.cuav_port)
+            dgram->socket = UDPJSON_FR_SOCKET_CUAV;
+        else
+        {
+            counts->skipped++;
+            continue;
+        }
+        dgram->ts_ns = pkt.ts_ns;
+        dgram->payload = pkt.payload;
+        dgram->len = pkt.len;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/**
+ * @brief --speed 大于 0 时等到报文按原始间隔应回放的时刻
+ */
+static void replay_wait(ReplayClock *clock, guint64 ts_ns)
+{
+    guint64 due_ns = 0;
+
+    if (replay_opts.speed <= 0)
+        return;
+    if (!clock->started)
+    {
+        clock->started = TRUE;
+        clock->start_ns = udpjson_now_ns();
+        clock->first_ts_ns = ts_ns;
+    }
+    due_ns = clock->start_ns +
+             (guint64)((gdouble)(ts_ns - MIN(ts_ns, clock->first_ts_ns)) / replay_opts.speed);
+    if (due_ns > udpjson_now_ns())
+    {
+        struct timespec ts;
+        ts.tv_sec = (time_t)(due_ns / 1000000000ull);
+        ts.tv_nsec = (long)(due_ns % 1000000000ull);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    }
+}
+
+/**
+ * @brief 回放一遍文件
+ *
+ * @param ingest 接收实例
+ * @param src 回放文件（已回到开头）
+ * @param group 目的地址过滤（网络字节序），0 表示不限
+ * @param clock 回放时钟
+ * @param counts 累计计数
+ */
+static void replay_pass(UdpJsonIngest *ingest, ReplaySource *src, guint32 group,
+                        ReplayClock *clock, ReplayCounts *counts)
+{
+    /* 与接收线程相同的收包计数，按 UdpJsonFlightSocket 索引 */
+    static const UdpJsonStat packets_stat[] = {UDPJSON_STAT_JSON_PACKETS, UDPJSON_STAT_CUAV_PACKETS,
+                                               UDPJSON_STAT_CUAV_CTRL_PACKETS};
+    static const UdpJsonStat bytes_stat[] = {UDPJSON_STAT_JSON_BYTES, UDPJSON_STAT_CUAV_BYTES,
+                                             UDPJSON_STAT_CUAV_CTRL_BYTES};
+    ReplayDatagram dgram;
+
+    while (replay_source_next(src, group, &dgram, counts))
+    {
+        replay_wait(clock, dgram.ts_ns);
+
+        udpjson_stats_add(ingest->stats, UDPJSON_STATS_SHARD_RECV, packets_stat[dgram.socket], 1);
+        udpjson_stats_add(ingest->stats, UDPJSON_STATS_SHARD_RECV, bytes_stat[dgram.socket],
+                          dgram.len);
+        if (dgram.socket == UDPJSON_FR_SOCKET_JSON)
+        {
+            udpjson_ingest_parse_and_cache(ingest, dgram.payload, (gssize)dgram.len,
+                                           udpjson_now_ns(), 0);
+            counts->json++;
+        }
+        else
+        {
+            udpjson_ingest_parse_cuav(ingest, dgram.payload, (gssize)dgram.len);
+            counts->cuav++;
+        }
+        counts->bytes += dgram.len;
+    }
+}
+
+/**
+ * @brief 把一组文件依次回放进同一缓存并输出一行结果
+ *
+ * @param paths 文件路径
+ * @param n_paths 文件数
+ * @param group 目的地址过滤（网络字节序），0 表示不限
+ * @return 文件均可读返回 TRUE
+ */
+static gboolean replay_files(gchar **paths, gint n_paths, guint32 group)
+{
+    ReplaySource *srcs = g_new0(ReplaySource, n_paths);
+    UdpJsonIngest *ingest = NULL;
+    CUAVParser *parser = NULL;
+    ReplayCounts counts;
+    UdpJsonPcapStats pcap_stats;
+    UdpJsonHistSummary parse;
+    guint64 totals[UDPJSON_STAT_COUNT];
+    guint64 elapsed_ns = 0;
+    guint64 datagrams = 0;
+    gchar *digest = NULL;
+    gchar *base = NULL;
+    gchar *name = NULL;
+    gboolean ok = TRUE;
+
+    for (gint i = 0; i < n_paths && ok; i++)
+        ok = replay_source_open(&srcs[i], paths[i]);
+    if (!ok)
+    {
+        for (gint i = 0; i < n_paths; i++)
+            replay_source_close(&srcs[i]);
+        g_free(srcs);
+        return FALSE;
+    }
+
+    /* 不启动接收线程：owner 为空，不打开套接字、不发布总线消息 */
+    parser = cuav_parser_new();
+    ingest = udpjson_ingest_new(NULL);
+    ingest->max_cache_size = (guint)MAX(replay_opts.max_cache_size, 0);
+    ingest->enable_cuav_parser = TRUE;
+    ingest->cuav_parser = parser;
+
+    memset(&counts, 0, sizeof(counts));
+    elapsed_ns = udpjson_now_ns();
+    for (gint loop = 0; loop < replay_opts.loops; loop++)
+    {
+        ReplayClock clock = {FALSE, 0, 0};
+
+        for (gint i = 0; i < n_paths; i++)
+        {
+            /* 抓包为系统时间、接收日志为单调时钟，换格式时重新计时 */
+            if (i > 0 && !srcs[i].journal != !srcs[i - 1].journal)
+                clock.started = FALSE;
+            replay_source_rewind(&srcs[i]);
+            replay_pass(ingest, &srcs[i], group, &clock, &counts);
+        }
+    }
+    elapsed_ns = udpjson_now_ns() - elapsed_ns;
+    datagrams = counts.json + counts.cuav;
+
+    memset(&pcap_stats, 0, sizeof(pcap_stats));
+    for (gint i = 0; i < n_paths; i++)
+    {
+        UdpJsonPcapStats s;
+
+        if (!srcs[i].pcap)
+            continue;
+        udpjson_pcap_get_stats(srcs[i].pcap, &s);
+        pcap_stats.non_udp += s.non_udp;
+        pcap_stats.fragments += s.fragments;
+        pcap_stats.truncated += s.truncated;
+    }
+    udpjson_stats_sum(ingest->stats, totals);
+    udpjson_stats_hist_summary(ingest->stats, UDPJSON_HIST_RECV_PARSE, &parse);
+    digest = replay_cache_digest(ingest, replay_opts.dump_cache);
+    base = g_path_get_basename(paths[0]);
+    name = n_paths > 1 ? g_strdup_printf("%s+%d", base, n_paths - 1) : g_strdup(base);
+
+    /* mean_ns 为每报文墙钟时间，分位数为 recv->parse 直方图 */
+    g_print("{\"bench\":\"replay\",\"case\":\"%s\",\"ops\":%" G_GUINT64_FORMAT
+            ",\"mean_ns\":%.1f,\"p50_ns\":%" G_GUINT64_FORMAT ",\"p90_ns\":%" G_GUINT64_FORMAT
+            ",\"p99_ns\":%" G_GUINT64_FORMAT ",\"max_ns\":%" G_GUINT64_FORMAT
+            ",\"ops_per_sec\":%.0f,\"mbytes_per_sec\":%.2f,\"speed\":%g,\"loops\":%d"
+            ",\"json\":%" G_GUINT64_FORMAT ",\"cuav\":%" G_GUINT64_FORMAT
+            ",\"skipped\":%" G_GUINT64_FORMAT ",\"pcap_non_udp\":%" G_GUINT64_FORMAT
+            ",\"pcap_fragments\":%" G_GUINT64_FORMAT ",\"pcap_truncated\":%" G_GUINT64_FORMAT
+            ",\"journal_dropped\":%" G_GUINT64_FORMAT
+            ",\"parse_ok\":%" G_GUINT64_FORMAT ",\"parse_failures\":%" G_GUINT64_FORMAT
+            ",\"parse_missing\":%" G_GUINT64_FORMAT ",\"cuav_parsed\":%" G_GUINT64_FORMAT
+            ",\"cuav_failures\":%" G_GUINT64_FORMAT ",\"cache_updates\":%" G_GUINT64_FORMAT
+            ",\"cache_evictions\":%" G_GUINT64_FORMAT ",\"cache_entries\":%u"
+            ",\"cache_sha1\":\"%s\"}\n",
+            name, datagrams, datagrams ? (gdouble)elapsed_ns / (gdouble)datagrams : 0.0,
+            parse.p50, parse.p90, parse.p99, parse.max,
+            elapsed_ns ? datagrams * 1e9 / (gdouble)elapsed_ns : 0.0,
+            elapsed_ns ? counts.bytes * 1e3 / (gdouble)elapsed_ns : 0.0, replay_opts.speed,
+            replay_opts.loops, counts.json, counts.cuav, counts.skipped, pcap_stats.non_udp,
+            pcap_stats.fragments, pcap_stats.truncated, counts.journal_dropped,
+            totals[UDPJSON_STAT_PARSE_OK],
+            totals[UDPJSON_STAT_PARSE_FAILURES], totals[UDPJSON_STAT_PARSE_MISSING],
+            totals[UDPJSON_STAT_CUAV_PARSED], totals[UDPJSON_STAT_CUAV_FAILURES],
+            totals[UDPJSON_STAT_CACHE_UPDATES], totals[UDPJSON_STAT_CACHE_EVICTIONS],
+            g_hash_table_size(ingest->cache), digest);
+
+    g_free(name);
+    g_free(base);
+    g_free(digest);
+    udpjson_ingest_free(ingest);
+    cuav_parser_free(parser);
+    for (gint i = 0; i < n_paths; i++)
+        replay_source_close(&srcs[i]);
+    g_free(srcs);
+    return TRUE;
+}
+
+int main(int argc, char *argv[])
+{
+    GOptionEntry entries[] = {
+        {"port", 'p', 0, G_OPTION_ARG_INT, &replay_opts.port,
+         "Object JSON destination port (default 6000)", "PORT"},
+        {"cuav-port", 0, 0, G_OPTION_ARG_INT, &replay_opts.cuav_port,
+         "C-UAV destination port (default 8013)", "PORT"},
+        {"cuav-ctrl-port", 0, 0, G_OPTION_ARG_INT, &replay_opts.cuav_ctrl_port,
+         "C-UAV control destination port, 0 = ignore (default 8003)", "PORT"},
+        {"group", 'g', 0, G_OPTION_ARG_STRING, &replay_opts.group,
+         "Only replay datagrams sent to this address", "IP"},
+        {"speed", 's', 0, G_OPTION_ARG_DOUBLE, &replay_opts.speed,
+         "0 = as fast as possible (default), 1 = original timing, N = N times faster", "X"},
+        {"loops", 'n', 0, G_OPTION_ARG_INT, &replay_opts.loops,
+         "Replay each file this many times (default 1)", "N"},
+        {"max-cache-size", 0, 0, G_OPTION_ARG_INT, &replay_opts.max_cache_size,
+         "Cache limit as the element's max-cache-size (default 2048)", "N"},
+        {"dump-cache", 0, 0, G_OPTION_ARG_STRING, &replay_opts.dump_cache,
+         "Write the final cache, sorted by key, to this file", "FILE"},
+        {"merge", 'm', 0, G_OPTION_ARG_NONE, &replay_opts.merge,
+         "Replay all files in order into one cache (rotated journals or captures)", NULL},
+        {NULL}};
+    GOptionContext *ctx = g_option_context_new("FILE... - replay captures or journals into the ingest path");
+    GError *error = NULL;
+    guint32 group = 0;
+    gint rc = 0;
+
+    g_option_context_add_main_entries(ctx, entries, NULL);
+    if (!g_option_context_parse(ctx, &argc, &argv, &error))
+    {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(ctx);
+        return 1;
+    }
+    g_option_context_free(ctx);
+    gst_init(NULL, NULL);
+
+    if (argc < 2)
+    {
+        g_printerr("usage: %s [OPTION...] FILE...\n", argv[0]);
+        return 1;
+    }
+    if (replay_opts.group && inet_pton(AF_INET, replay_opts.group, &group) != 1)
+    {
+        g_printerr("invalid group address %s\n", replay_opts.group);
+        return 1;
+    }
+    replay_opts.loops = MAX(replay_opts.loops, 1);
+
+    if (replay_opts.merge)
+        rc = replay_files(argv + 1, argc - 1, group) ? 0 : 1;
+    for (gint i = 1; i < argc && !replay_opts.merge; i++)
+    {
+        if (!replay_files(argv + i, 1, group))
+            rc = 1;
+    }
+
+    g_free(replay_opts.group);
+    g_free(replay_opts.dump_cache);
+    return rc;
+}
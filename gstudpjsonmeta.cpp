@@ -30,6 +30,30 @@ GST_DEBUG_CATEGORY_STATIC(gst_udpjson_meta_debug);
 /* C-UAV 协议默认配置 */
 #define DEFAULT_CUAV_MULTICAST_PORT 8013
 #define DEFAULT_CUAV_CTRL_PORT 8003
+#define DEFAULT_CUAV_SEND_PORT 0
+#define DEFAULT_CUAV_SYS_ID 999
+#define DEFAULT_CUAV_DEV_TYPE 1
+#define DEFAULT_CUAV_DEV_ID 999
+
+/* 引导航迹融合默认配置 */
+#define DEFAULT_FUSION_GATE_M 0.0
+#define DEFAULT_FUSION_VELOCITY_GATE 15.0
+
+/* 脱靶量伺服输出默认配置 */
+#define DEFAULT_SERVO_OBJECT_ID G_MAXUINT64
+#define DEFAULT_SERVO_MAX_RATE 25.0
+#define DEFAULT_SERVO_SMOOTHING 0.5
+
+/* 每 64 个附加的目标采样一次 attach 探针 */
+#define DEFAULT_TRACE_ATTACH_INTERVAL 64
+
+/* 飞行记录器默认配置 */
+#define DEFAULT_FLIGHT_RECORDER_SIZE 4096
+#define DEFAULT_FLIGHT_RECORDER_DIR "/tmp"
+
+/* 接收日志默认配置：64 MiB x 8 个文件 */
+#define DEFAULT_JOURNAL_FILE_SIZE (64u << 20)
+#define DEFAULT_JOURNAL_MAX_FILES 8
 
 /* 用户元数据结构体 */
 typedef struct
@@ -39,34 +63,61 @@ typedef struct
     guint64 recv_ts_us; /* 接收时间(微秒) */
 } UdpJsonObjMeta;
 
-/* 缓存键 */
-typedef struct
-{
-    guint source_id; /* 源ID */
-    guint64 object_id; /* 目标ID */
-} UdpJsonCacheKey;
-
-/* 缓存值 */
-typedef struct
-{
-    gchar *value; /* JSON 值字符串 */
-    guint64 recv_ts_us; /* 接收时间(微秒) */
-} UdpJsonCacheValue;
-
 enum
 {
     PROP_0,
     PROP_MULTICAST_IP,
     PROP_PORT,
     PROP_IFACE,
+    PROP_ENDPOINTS,
     PROP_RECV_BUF_SIZE,
     PROP_CACHE_TTL_MS,
     PROP_MAX_CACHE_SIZE,
+    PROP_SHARED_RECEIVER,
+    PROP_DEMAND_INTERVAL,
+    PROP_DEDUP_WINDOW_MS,
     /* C-UAV 协议属性 */
     PROP_ENABLE_CUAV_PARSER,
     PROP_CUAV_MULTICAST_PORT,
     PROP_CUAV_CTRL_PORT,
-    PROP_CUAV_DEBUG
+    PROP_CUAV_DEBUG,
+    PROP_CUAV_DROP_DUPLICATES,
+    PROP_CACHE_DEBUG,
+    PROP_DEBUG_SAMPLE,
+    PROP_CUAV_ACCEPT_MSG_IDS,
+    PROP_CUAV_FILTER_RX,
+    PROP_CUAV_SEND_IP,
+    PROP_CUAV_SEND_PORT,
+    PROP_CUAV_SYS_ID,
+    PROP_CUAV_DEV_TYPE,
+    PROP_CUAV_DEV_ID,
+    PROP_CUAV_DST_SYS_ID,
+    PROP_CUAV_DST_DEV_ID,
+    PROP_EO_SOURCE_MAP,
+    PROP_FUSION_GATE,
+    PROP_FUSION_VELOCITY_GATE,
+    PROP_FUSION_SUPPRESS_DUPLICATES,
+    /* 脱靶量伺服输出属性 */
+    PROP_SERVO_ENABLE,
+    PROP_SERVO_SOURCE_ID,
+    PROP_SERVO_OBJECT_ID,
+    PROP_SERVO_MAX_RATE,
+    PROP_SERVO_SMOOTHING,
+    PROP_SERVO_DEV_ID,
+    PROP_SERVO_MODE,
+    PROP_SERVO_LATENCY_US,
+    PROP_STATS,
+    PROP_STATS_INTERVAL_MS,
+    PROP_METRICS_ENDPOINT,
+    PROP_TRACE_ATTACH_INTERVAL,
+    PROP_FLIGHT_RECORDER_SIZE,
+    PROP_FLIGHT_RECORDER_DIR,
+    PROP_FLIGHT_RECORDER_FAIL_RATIO,
+    PROP_FLIGHT_RECORDER_DUMP_ON_FLUSH,
+    PROP_FLIGHT_RECORDER_SIGNAL,
+    PROP_JOURNAL_DIR,
+    PROP_JOURNAL_FILE_SIZE,
+    PROP_JOURNAL_MAX_FILES
 };
 
 static GstStaticPadTemplate sink_factory = GST_STATIC_PAD_TEMPLATE(
@@ -74,73 +125,30 @@ static GstStaticPadTemplate sink_factory = GST_STATIC_PAD_TEMPLATE(
 static GstStaticPadTemplate src_factory = GST_STATIC_PAD_TEMPLATE(
     "src", GST_PAD_SRC, GST_PAD_ALWAYS, GST_STATIC_CAPS("ANY"));
 
-#define gst_udpjson_meta_parent_class parent_class
-G_DEFINE_TYPE(GstUdpJsonMeta, gst_udpjson_meta, GST_TYPE_BASE_TRANSFORM);
-
-/**
- * @brief 计算缓存键的哈希值。
- *
- * @param key 缓存键指针。
- * @return 哈希值。
- */
-static guint udpjson_cache_key_hash(gconstpointer key)
+enum
 {
-    const UdpJsonCacheKey *ckey = (const UdpJsonCacheKey *)key; /* 缓存键指针 */
-    guint hash = 0; /* 哈希值 */
-    hash = g_direct_hash(GINT_TO_POINTER(ckey->source_id));
-    hash ^= g_int64_hash(&ckey->object_id);
-    return hash;
-}
+    SIGNAL_RESET_STATS,
+    SIGNAL_DUMP_FLIGHT_RECORDER,
+    LAST_SIGNAL
+};
 
-/**
- * @brief 判断两个缓存键是否相等。
- *
- * @param a 缓存键A。
- * @param b 缓存键B。
- * @return 相等返回 TRUE。
- */
-static gboolean udpjson_cache_key_equal(gconstpointer a, gconstpointer b)
-{
-    const UdpJsonCacheKey *ka = (const UdpJsonCacheKey *)a; /* 缓存键A */
-    const UdpJsonCacheKey *kb = (const UdpJsonCacheKey *)b; /* 缓存键B */
-    return (ka->source_id == kb->source_id) && (ka->object_id == kb->object_id);
-}
+static guint udpjson_signals[LAST_SIGNAL] = {0};
 
-/**
- * @brief 释放缓存键。
- *
- * @param data 缓存键指针。
- */
-static void udpjson_cache_key_free(gpointer data)
-{
-    UdpJsonCacheKey *key = (UdpJsonCacheKey *)data; /* 缓存键 */
-    g_free(key);
-}
-
-/**
- * @brief 释放缓存值。
- *
- * @param data 缓存值指针。
- */
-static void udpjson_cache_value_free(gpointer data)
-{
-    UdpJsonCacheValue *val = (UdpJsonCacheValue *)data; /* 缓存值 */
-    if (!val)
-        return;
-    g_free(val->value);
-    g_free(val);
-}
+#define gst_udpjson_meta_parent_class parent_class
+G_DEFINE_TYPE(GstUdpJsonMeta, gst_udpjson_meta, GST_TYPE_BASE_TRANSFORM);
 
 /**
  * @brief 复制用户元数据。
  *
- * @param data 用户元数据指针。
+ * @param data NvDsUserMeta 指针。
  * @param user_data 用户自定义数据。
  * @return 新的用户元数据指针。
  */
 static gpointer udpjson_obj_meta_copy(gpointer data, gpointer user_data)
 {
-    const UdpJsonObjMeta *src = (const UdpJsonObjMeta *)data; /* 源数据 */
+    const NvDsUserMeta *user_meta = (const NvDsUserMeta *)data; /* 源用户元数据 */
+    const UdpJsonObjMeta *src =
+        user_meta ? (const UdpJsonObjMeta *)user_meta->user_meta_data : NULL; /* 源数据 */
     UdpJsonObjMeta *dst = (UdpJsonObjMeta *)g_malloc0(sizeof(UdpJsonObjMeta)); /* 新元数据 */
     if (!src || !dst)
         return dst;
@@ -153,633 +161,507 @@ static gpointer udpjson_obj_meta_copy(gpointer data, gpointer user_data)
 /**
  * @brief 释放用户元数据。
  *
- * @param data 用户元数据指针。
+ * @param data NvDsUserMeta 指针。
  * @param user_data 用户自定义数据。
  */
 static void udpjson_obj_meta_release(gpointer data, gpointer user_data)
 {
-    UdpJsonObjMeta *meta = (UdpJsonObjMeta *)data; /* 用户元数据 */
+    NvDsUserMeta *user_meta = (NvDsUserMeta *)data; /* 用户元数据 */
+    UdpJsonObjMeta *meta =
+        user_meta ? (UdpJsonObjMeta *)user_meta->user_meta_data : NULL; /* 附加数据 */
     if (!meta)
         return;
     g_free(meta->key);
     g_free(meta->value);
     g_free(meta);
+    user_meta->user_meta_data = NULL;
 }
 
 /**
- * @brief 从 JSON 节点解析无符号整数。
+ * @brief 取 iface 列表 "eth0,eth1" 中的第一个网卡名。
  *
- * @param node JSON 节点。
- * @param out 输出的整数。
- * @return 解析成功返回 TRUE。
+ * @param iface 网卡名或逗号分隔的网卡列表，可为 NULL。
+ * @return 新分配的网卡名，没有时返回 NULL。
  */
-static gboolean udpjson_parse_uint64(JsonNode *node, guint64 *out)
+static gchar *udpjson_first_iface(const gchar *iface)
 {
-    GType vtype = 0; /* 值类型 */
-    if (!node || !out)
-        return FALSE;
+    gchar **ifaces = NULL; /* 网卡列表 */
+    gchar *first = NULL; /* 第一个网卡 */
 
-    vtype = json_node_get_value_type(node);
-    if (vtype == G_TYPE_STRING)
-    {
-        const gchar *str = json_node_get_string(node); /* 字符串 */
-        if (!str)
-            return FALSE;
-        *out = g_ascii_strtoull(str, NULL, 10);
-        return TRUE;
-    }
-    if (vtype == G_TYPE_INT64)
-    {
-        *out = (guint64)json_node_get_int(node);
-        return TRUE;
-    }
-    if (vtype == G_TYPE_DOUBLE)
-    {
-        *out = (guint64)json_node_get_double(node);
-        return TRUE;
-    }
-    if (vtype == G_TYPE_UINT64)
+    if (!iface)
+        return NULL;
+    ifaces = g_strsplit(iface, ",", -1);
+    for (guint i = 0; ifaces[i] && !first; i++)
     {
-        GValue val = G_VALUE_INIT; /* 临时值 */
-        json_node_get_value(node, &val);
-        *out = g_value_get_uint64(&val);
-        g_value_unset(&val);
-        return TRUE;
+        g_strstrip(ifaces[i]);
+        if (ifaces[i][0] != '\0')
+            first = g_strdup(ifaces[i]);
     }
-    return FALSE;
+    g_strfreev(ifaces);
+    return first;
 }
 
 /**
- * @brief 将 JSON 节点转换为字符串。
+ * @brief 按当前配置创建 C-UAV 报文发送器并替换旧的（未配置发送端口时不创建）。
+ *
+ * 创建失败时旧发送器同样释放，避免继续发往已失效的地址。
  *
- * @param node JSON 节点。
- * @return 新分配的字符串，需调用 g_free 释放。
+ * @param self 插件实例。
  */
-static gchar *udpjson_node_to_string(JsonNode *node)
+static void udpjson_setup_cuav_sender(GstUdpJsonMeta *self)
 {
-    GType vtype = 0; /* 值类型 */
-    if (!node)
-        return NULL;
+    CUAVSender *sender = NULL; /* 发送器 */
+    CUAVSender *old = NULL; /* 被替换的发送器 */
+    gchar *dest_ip = NULL; /* 目的地址 */
+    gchar *iface = NULL; /* 发送网卡 */
 
-    if (!JSON_NODE_HOLDS_VALUE(node))
-    {
-        return json_to_string(node, FALSE);
-    }
-
-    vtype = json_node_get_value_type(node);
-    if (vtype == G_TYPE_STRING)
-        return g_strdup(json_node_get_string(node));
-    if (vtype == G_TYPE_INT64)
-        return g_strdup_printf("%" G_GINT64_FORMAT, json_node_get_int(node));
-    if (vtype == G_TYPE_DOUBLE)
-        return g_strdup_printf("%f", json_node_get_double(node));
-    if (vtype == G_TYPE_BOOLEAN)
-        return g_strdup(json_node_get_boolean(node) ? "true" : "false");
-    if (vtype == G_TYPE_UINT64)
-    {
-        GValue val = G_VALUE_INIT; /* 临时值 */
-        guint64 out = 0; /* 解析值 */
-        json_node_get_value(node, &val);
-        out = g_value_get_uint64(&val);
-        g_value_unset(&val);
-        return g_strdup_printf("%" G_GUINT64_FORMAT, out);
-    }
+    if (!self || self->cuav_send_port == 0)
+        return;
 
-    return json_to_string(node, FALSE);
+    g_mutex_lock(&self->ingest->config_lock);
+    dest_ip = g_strdup((self->cuav_send_ip && strlen(self->cuav_send_ip) > 0)
+                           ? self->cuav_send_ip
+                           : self->ingest->multicast_ip);
+    /* iface 为冗余接收的网卡列表时只从第一个网卡发送 */
+    iface = udpjson_first_iface(self->ingest->iface);
+    g_mutex_unlock(&self->ingest->config_lock);
+
+    sender = cuav_sender_new(dest_ip, self->cuav_send_port, iface, &self->cuav_addressing);
+    if (!sender)
+        GST_WARNING("C-UAV sender disabled: cannot send to %s:%u", dest_ip, self->cuav_send_port);
+
+    g_mutex_lock(&self->cuav_sender_lock);
+    old = self->cuav_sender;
+    self->cuav_sender = sender;
+    g_mutex_unlock(&self->cuav_sender_lock);
+
+    cuav_sender_free(old);
+    g_free(dest_ip);
+    g_free(iface);
 }
 
 /**
- * @brief 更新缓存中的目标值。
+ * @brief 释放 C-UAV 报文发送器。
  *
  * @param self 插件实例。
- * @param source_id 源ID。
- * @param object_id 目标ID。
- * @param value JSON 值字符串。
  */
-static void udpjson_cache_update(GstUdpJsonMeta *self, guint source_id,
-                                 guint64 object_id, const gchar *value)
+static void udpjson_teardown_cuav_sender(GstUdpJsonMeta *self)
 {
-    UdpJsonCacheKey *key = NULL; /* 缓存键 */
-    UdpJsonCacheValue *val = NULL; /* 缓存值 */
-    guint64 now_us = 0; /* 当前时间(微秒) */
+    CUAVSender *sender = NULL; /* 发送器 */
 
-    if (!self || !value)
+    if (!self)
         return;
 
-    now_us = (guint64)g_get_monotonic_time();
-
-    g_rw_lock_writer_lock(&self->cache_lock);
-
-    if (self->max_cache_size > 0 && g_hash_table_size(self->cache) >= self->max_cache_size)
-    {
-        g_hash_table_remove_all(self->cache);
-    }
-
-    key = (UdpJsonCacheKey *)g_malloc0(sizeof(UdpJsonCacheKey));
-    key->source_id = source_id;
-    key->object_id = object_id;
+    g_mutex_lock(&self->cuav_sender_lock);
+    sender = self->cuav_sender;
+    self->cuav_sender = NULL;
+    g_mutex_unlock(&self->cuav_sender_lock);
 
-    val = (UdpJsonCacheValue *)g_malloc0(sizeof(UdpJsonCacheValue));
-    val->value = g_strdup(value);
-    val->recv_ts_us = now_us;
-
-    g_hash_table_replace(self->cache, key, val);
-    g_rw_lock_writer_unlock(&self->cache_lock);
+    cuav_sender_free(sender);
 }
 
 /**
- * @brief 解析 JSON 并更新缓存。
+ * @brief 运行中且开启了任一调试事件时启动事件日志后台线程。
  *
  * @param self 插件实例。
- * @param data JSON 数据。
- * @param len 数据长度。
  */
-static void udpjson_parse_and_cache(GstUdpJsonMeta *self, const gchar *data, gssize len)
+static void udpjson_sync_event_log(GstUdpJsonMeta *self)
 {
-    JsonParser *parser = NULL; /* JSON 解析器 */
-    JsonNode *root = NULL; /* 根节点 */
-    JsonObject *obj = NULL; /* JSON 对象 */
-    JsonNode *obj_id_node = NULL; /* 目标ID节点 */
-    JsonNode *src_id_node = NULL; /* 源ID节点 */
-    JsonNode *val_node = NULL; /* 值节点 */
-    guint64 object_id = 0; /* 目标ID */
-    guint64 source_id64 = 0; /* 源ID */
-    gchar *value_str = NULL; /* 值字符串 */
-
-    if (!self || !data || len <= 0)
-        return;
-
-    parser = json_parser_new();
-    if (!json_parser_load_from_data(parser, data, len, NULL))
-    {
-        g_object_unref(parser);
-        return;
-    }
-
-    root = json_parser_get_root(parser);
-    if (!root || !JSON_NODE_HOLDS_OBJECT(root))
-    {
-        g_object_unref(parser);
-        return;
-    }
-
-    obj = json_node_get_object(root);
-    if (!obj)
-    {
-        g_object_unref(parser);
-        return;
-    }
-
-    if (json_object_has_member(obj, "object_id"))
-        obj_id_node = json_object_get_member(obj, "object_id");
-    if (json_object_has_member(obj, "source_id"))
-        src_id_node = json_object_get_member(obj, "source_id");
-    if (json_object_has_member(obj, "value"))
-        val_node = json_object_get_member(obj, "value");
-
-    if (!obj_id_node || !val_node)
+    if ((self->cuav_debug || self->ingest->cache_debug) && udpjson_ingest_running(self->ingest))
     {
-        g_object_unref(parser);
-        return;
+        udpjson_event_log_start(self->event_log);
     }
+}
 
-    if (!udpjson_parse_uint64(obj_id_node, &object_id))
-    {
-        g_object_unref(parser);
+/**
+ * @brief 修改套接字配置后请求切换（运行中生效，否则在下次启动时生效）。
+ *
+ * @param self 插件实例。
+ * @param json_endpoint 是否修改了目标 JSON 的组播地址、端口或网卡。
+ */
+static void udpjson_socket_config_changed(GstUdpJsonMeta *self, gboolean json_endpoint)
+{
+    if (!udpjson_ingest_running(self->ingest))
         return;
-    }
-
-    if (src_id_node && udpjson_parse_uint64(src_id_node, &source_id64))
-    {
-        /* 使用解析到的 source_id */
-    }
-    else
-    {
-        source_id64 = 0;
-    }
-
-    value_str = udpjson_node_to_string(val_node);
-    if (value_str)
-    {
-        udpjson_cache_update(self, (guint)source_id64, object_id, value_str);
-        g_free(value_str);
-    }
-
-    g_object_unref(parser);
+    if (json_endpoint && self->ingest->shared_json)
+        GST_WARNING_OBJECT(self, "shared receiver endpoint changes apply at next start");
+    udpjson_ingest_request_reconfigure(self->ingest);
+    /* 未设置 cuav-send-ip 时发送器沿用目标 JSON 的组播地址与网卡，须随之重建 */
+    if (json_endpoint && !(self->cuav_send_ip && strlen(self->cuav_send_ip) > 0))
+        udpjson_setup_cuav_sender(self);
 }
 
 /**
- * @brief UDP 接收线程入口。
+ * @brief 持配置锁修改字符串型套接字配置。
  *
- * @param data 插件实例。
- * @return 线程返回值。
+ * @param self 插件实例。
+ * @param field 配置字段。
+ * @param value 新值。
  */
-static gpointer udpjson_recv_thread(gpointer data)
+static void udpjson_set_socket_string(GstUdpJsonMeta *self, gchar **field, const GValue *value)
 {
-    GstUdpJsonMeta *self = (GstUdpJsonMeta *)data; /* 插件实例 */
-    struct pollfd pfds[3]; /* poll 结构数组 */
-    guint num_fds = 1; /* 监听的 socket 数量 */
-    int idx_cuav = -1;
-    int idx_ctrl = -1;
-    gchar buf[8192]; /* 接收缓冲区 */
-
-    if (!self)
-        return NULL;
-
-    /* 初始化主 socket 的 poll 结构 */
-    memset(pfds, 0, sizeof(pfds));
-    pfds[0].fd = self->sockfd;
-    pfds[0].events = POLLIN;
-
-    /* 如果启用了 C-UAV 解析，监听 C-UAV socket */
-    if (self->enable_cuav_parser && self->cuav_sockfd >= 0)
-    {
-        idx_cuav = (int)num_fds;
-        pfds[idx_cuav].fd = self->cuav_sockfd;
-        pfds[idx_cuav].events = POLLIN;
-        num_fds++;
-    }
-    if (self->enable_cuav_parser && self->cuav_ctrl_sockfd >= 0)
-    {
-        idx_ctrl = (int)num_fds;
-        pfds[idx_ctrl].fd = self->cuav_ctrl_sockfd;
-        pfds[idx_ctrl].events = POLLIN;
-        num_fds++;
-    }
-
-    while (!g_atomic_int_get(&self->stop_flag))
-    {
-        int ret = poll(pfds, num_fds, 100); /* 100ms 轮询 */
-        if (ret <= 0)
-            continue;
-
-        /* 检查主 socket 是否有数据 */
-        if (pfds[0].revents & POLLIN)
-        {
-            ssize_t len = recvfrom(self->sockfd, buf, sizeof(buf) - 1, 0, NULL, NULL); /* 读取长度 */
-            if (len > 0)
-            {
-                buf[len] = '\0';
-                /* 只解析 JSON 元数据，不进行 C-UAV 解析（因为 C-UAV 有独立端口） */
-                udpjson_parse_and_cache(self, buf, len);
-            }
-        }
-
-        /* 检查 C-UAV socket 是否有数据 */
-        if (idx_cuav >= 0 && (pfds[idx_cuav].revents & POLLIN))
-        {
-            ssize_t len = recvfrom(self->cuav_sockfd, buf, sizeof(buf) - 1, 0, NULL, NULL);
-            if (len > 0)
-            {
-                buf[len] = '\0';
-                /* 解析 C-UAV 协议 */
-                if (self->enable_cuav_parser && self->cuav_parser)
-                {
-                    cuav_parser_parse(self->cuav_parser, buf, len);
-                }
-            }
-        }
-        if (idx_ctrl >= 0 && (pfds[idx_ctrl].revents & POLLIN))
-        {
-            ssize_t len = recvfrom(self->cuav_ctrl_sockfd, buf, sizeof(buf) - 1, 0, NULL, NULL);
-            if (len > 0)
-            {
-                buf[len] = '\0';
-                if (self->enable_cuav_parser && self->cuav_parser)
-                {
-                    cuav_parser_parse(self->cuav_parser, buf, len);
-                }
-            }
-        }
-    }
+    g_mutex_lock(&self->ingest->config_lock);
+    g_free(*field);
+    *field = g_value_dup_string(value);
+    g_mutex_unlock(&self->ingest->config_lock);
+}
 
-    return NULL;
+/**
+ * @brief 持配置锁读取字符串型套接字配置（运行中可能被 set_property 替换）。
+ *
+ * @param self 插件实例。
+ * @param field 配置字段。
+ * @param value 输出属性值（复制字符串）。
+ */
+static void udpjson_get_socket_string(GstUdpJsonMeta *self, gchar **field, GValue *value)
+{
+    g_mutex_lock(&self->ingest->config_lock);
+    g_value_set_string(value, *field);
+    g_mutex_unlock(&self->ingest->config_lock);
 }
 
 /**
- * @brief 初始化 UDP 套接字并加入组播。
+ * @brief 持配置锁修改整数型套接字配置。
  *
  * @param self 插件实例。
- * @return 成功返回 TRUE。
+ * @param field 配置字段。
+ * @param value 新值。
  */
-static gboolean udpjson_setup_socket(GstUdpJsonMeta *self)
+static void udpjson_set_socket_uint(GstUdpJsonMeta *self, guint *field, const GValue *value)
 {
-    struct sockaddr_in addr; /* 绑定地址 */
-    struct ip_mreq mreq; /* 组播请求 */
-    int reuse = 1; /* 复用标记 */
-    int flags = 0; /* socket 标志 */
+    g_mutex_lock(&self->ingest->config_lock);
+    *field = g_value_get_uint(value);
+    g_mutex_unlock(&self->ingest->config_lock);
+}
 
-    if (!self)
-        return FALSE;
+/**
+ * @brief GstBaseTransform: 启动插件。
+ *
+ * @param trans 基类指针。
+ * @return 成功返回 TRUE。
+ */
+static gboolean gst_udpjson_meta_start(GstBaseTransform *trans)
+{
+    GstUdpJsonMeta *self = GST_UDPJSON_META(trans); /* 插件实例 */
 
-    self->sockfd = socket(AF_INET, SOCK_DGRAM, 0);
-    if (self->sockfd < 0)
-    {
-        GST_ERROR("Failed to create UDP socket: %s", strerror(errno));
+    if (!udpjson_ingest_start(self->ingest))
         return FALSE;
-    }
 
-    if (setsockopt(self->sockfd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0)
-    {
-        GST_WARNING("Failed to set SO_REUSEADDR: %s", strerror(errno));
-    }
+    udpjson_setup_cuav_sender(self);
+    udpjson_sync_event_log(self);
+    return TRUE;
+}
 
-    if (self->recv_buf_size > 0)
-    {
-        int rcvbuf = (int)self->recv_buf_size; /* 接收缓冲区 */
-        if (setsockopt(self->sockfd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf)) < 0)
-        {
-            GST_WARNING("Failed to set SO_RCVBUF: %s", strerror(errno));
-        }
-    }
+/**
+ * @brief GstBaseTransform: 停止插件。
+ *
+ * @param trans 基类指针。
+ * @return 成功返回 TRUE。
+ */
+static gboolean gst_udpjson_meta_stop(GstBaseTransform *trans)
+{
+    GstUdpJsonMeta *self = GST_UDPJSON_META(trans); /* 插件实例 */
 
-    memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_addr.s_addr = htonl(INADDR_ANY);
-    addr.sin_port = htons((guint16)self->port);
+    udpjson_ingest_stop(self->ingest);
+    udpjson_teardown_cuav_sender(self);
 
-    if (bind(self->sockfd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    udpjson_event_log_stop(self->event_log);
+    if (self->cuav_debug || self->ingest->cache_debug)
     {
-        GST_ERROR("Failed to bind UDP socket: %s", strerror(errno));
-        close(self->sockfd);
-        self->sockfd = -1;
-        return FALSE;
+        UdpJsonEventLogStats ev; /* 调试事件统计 */
+        udpjson_event_log_get_stats(self->event_log, &ev);
+        GST_INFO_OBJECT(self, "debug events: written=%" G_GUINT64_FORMAT
+                        " formatted=%" G_GUINT64_FORMAT " overwritten=%" G_GUINT64_FORMAT
+                        " sampled_out=%" G_GUINT64_FORMAT,
+                        ev.written, ev.formatted, ev.overwritten, ev.sampled_out);
     }
 
-    memset(&mreq, 0, sizeof(mreq));
-    mreq.imr_multiaddr.s_addr = inet_addr(self->multicast_ip);
-    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
-
-    if (self->iface && strlen(self->iface) > 0)
+    if (self->ingest->enable_cuav_parser && self->cuav_parser)
     {
-        struct ifreq ifr; /* 网卡信息 */
-        memset(&ifr, 0, sizeof(ifr));
-        strncpy(ifr.ifr_name, self->iface, IFNAMSIZ - 1);
-        if (ioctl(self->sockfd, SIOCGIFADDR, &ifr) == 0)
-        {
-            struct sockaddr_in *sin = (struct sockaddr_in *)&ifr.ifr_addr; /* 网卡地址 */
-            mreq.imr_interface = sin->sin_addr;
-        }
-        if (setsockopt(self->sockfd, SOL_SOCKET, SO_BINDTODEVICE, self->iface,
-                       strlen(self->iface)) < 0)
-        {
-            GST_WARNING("Failed to bind device %s: %s", self->iface, strerror(errno));
-        }
+        CUAVSeqStats seq; /* 序号统计 */
+        cuav_parser_get_seq_stats(self->cuav_parser, &seq);
+        GST_INFO_OBJECT(self, "C-UAV seq: senders=%u received=%" G_GUINT64_FORMAT
+                        " lost=%" G_GUINT64_FORMAT " reordered=%" G_GUINT64_FORMAT
+                        " duplicates=%" G_GUINT64_FORMAT " resets=%" G_GUINT64_FORMAT,
+                        seq.senders, seq.received, seq.lost, seq.reordered, seq.duplicates,
+                        seq.resets);
+
+        CUAVFilterStats filter; /* 预过滤统计 */
+        cuav_parser_get_filter_stats(self->cuav_parser, &filter);
+        GST_INFO_OBJECT(self, "C-UAV prefilter: passed=%" G_GUINT64_FORMAT
+                        " msg_id=%" G_GUINT64_FORMAT " rx_sys=%" G_GUINT64_FORMAT
+                        " rx_dev=%" G_GUINT64_FORMAT " no_header=%" G_GUINT64_FORMAT,
+                        filter.passed, filter.rejected_msg_id, filter.rejected_rx_sys,
+                        filter.rejected_rx_dev, filter.rejected_no_header);
     }
 
-    if (setsockopt(self->sockfd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0)
+    if (self->fusion_config.gate_m > 0)
     {
-        GST_ERROR("Failed to join multicast group %s:%u: %s", self->multicast_ip,
-                  self->port, strerror(errno));
-        close(self->sockfd);
-        self->sockfd = -1;
-        return FALSE;
+        CUAVFusionStats fusion; /* 融合统计 */
+        cuav_fusion_get_stats(self->fusion, &fusion);
+        GST_INFO_OBJECT(self, "guidance fusion: updates=%" G_GUINT64_FORMAT
+                        " tracks=%u fused=%u merges=%" G_GUINT64_FORMAT
+                        " splits=%" G_GUINT64_FORMAT " expired=%" G_GUINT64_FORMAT
+                        " candidates=%" G_GUINT64_FORMAT,
+                        fusion.updates, fusion.tracks, fusion.fused_tracks, fusion.merges,
+                        fusion.splits, fusion.expired, fusion.candidates);
     }
 
-    flags = fcntl(self->sockfd, F_GETFL, 0);
-    if (flags >= 0)
+    if (self->servo_stage.commands > 0)
     {
-        if (fcntl(self->sockfd, F_SETFL, flags | O_NONBLOCK) < 0)
-        {
-            GST_WARNING("Failed to set UDP socket non-blocking: %s", strerror(errno));
-        }
+        GST_INFO_OBJECT(self, "servo commands=%" G_GUINT64_FORMAT " latency avg=%" G_GUINT64_FORMAT
+                        "us max=%" G_GUINT64_FORMAT "us",
+                        self->servo_stage.commands,
+                        self->servo_stage.sum_latency_us / self->servo_stage.commands,
+                        self->servo_stage.max_latency_us);
     }
-
+    udpjson_servo_stage_reset(&self->servo_stage);
     return TRUE;
 }
 
 /**
- * @brief 设置 C-UAV 协议的 UDP 套接字。
+ * @brief 为目标附加用户元数据。
  *
  * @param self 插件实例。
- * @return 成功返回 TRUE。
+ * @param batch_meta 批次元数据。
+ * @param obj_meta 目标元数据。
+ * @param value JSON 值字符串。
+ * @param recv_ts_us 接收时间。
+ * @return 成功附加返回 TRUE。
  */
-static gboolean udpjson_setup_cuav_socket(GstUdpJsonMeta *self)
+static gboolean udpjson_attach_obj_meta(GstUdpJsonMeta *self, NvDsBatchMeta *batch_meta,
+                                    NvDsObjectMeta *obj_meta, const gchar *value,
+                                    guint64 recv_ts_us)
 {
-    struct sockaddr_in addr; /* 绑定地址 */
-    int reuse = 1; /* 复用标记 */
-    int flags = 0; /* socket 标志 */
+    NvDsUserMeta *user_meta = NULL; /* 用户元数据 */
+    UdpJsonObjMeta *meta = NULL; /* 用户数据 */
 
-    if (!self)
+    if (!self || !batch_meta || !obj_meta || !value)
         return FALSE;
 
-    /* 如果未启用 C-UAV 解析，不创建 socket */
-    if (!self->enable_cuav_parser)
-    {
-        self->cuav_sockfd = -1;
-        return TRUE;
-    }
-
-    self->cuav_sockfd = socket(AF_INET, SOCK_DGRAM, 0);
-    if (self->cuav_sockfd < 0)
-    {
-        GST_ERROR("Failed to create C-UAV UDP socket: %s", strerror(errno));
+    user_meta = nvds_acquire_user_meta_from_pool(batch_meta);
+    if (!user_meta)
         return FALSE;
-    }
 
-    if (setsockopt(self->cuav_sockfd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0)
-    {
-        GST_WARNING("Failed to set SO_REUSEADDR for C-UAV: %s", strerror(errno));
-    }
+    meta = (UdpJsonObjMeta *)g_malloc0(sizeof(UdpJsonObjMeta));
+    meta->key = g_strdup("value");
+    meta->value = g_strdup(value);
+    meta->recv_ts_us = recv_ts_us;
 
-    memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_addr.s_addr = htonl(INADDR_ANY);
-    addr.sin_port = htons((guint16)self->cuav_multicast_port);
+    user_meta->user_meta_data = meta;
+    user_meta->base_meta.meta_type = self->meta_type;
+    user_meta->base_meta.copy_func = udpjson_obj_meta_copy;
+    user_meta->base_meta.release_func = udpjson_obj_meta_release;
+    user_meta->base_meta.batch_meta = batch_meta;
 
-    if (bind(self->cuav_sockfd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
-    {
-        GST_ERROR("Failed to bind C-UAV UDP socket to port %u: %s",
-                  self->cuav_multicast_port, strerror(errno));
-        close(self->cuav_sockfd);
-        self->cuav_sockfd = -1;
-        return FALSE;
-    }
+    nvds_add_user_meta_to_obj(obj_meta, user_meta);
+    return TRUE;
+}
 
-    flags = fcntl(self->cuav_sockfd, F_GETFL, 0);
-    if (flags >= 0)
-    {
-        if (fcntl(self->cuav_sockfd, F_SETFL, flags | O_NONBLOCK) < 0)
-        {
-            GST_WARNING("Failed to set C-UAV UDP socket non-blocking: %s", strerror(errno));
-        }
-    }
+/**
+ * @brief 复制光电设备状态帧元数据。
+ *
+ * @param data NvDsUserMeta 指针。
+ * @param user_data 用户自定义数据。
+ * @return 新的用户元数据指针。
+ */
+static gpointer udpjson_eo_meta_copy(gpointer data, gpointer user_data)
+{
+    const NvDsUserMeta *user_meta = (const NvDsUserMeta *)data; /* 源用户元数据 */
+    UdpJsonEoFrameMeta *dst = (UdpJsonEoFrameMeta *)g_malloc0(sizeof(UdpJsonEoFrameMeta)); /* 新元数据 */
+    if (user_meta && user_meta->user_meta_data)
+        memcpy(dst, user_meta->user_meta_data, sizeof(UdpJsonEoFrameMeta));
+    return dst;
+}
 
-    /* 加入 C-UAV 组播组 */
-    struct ip_mreq mreq;
-    memset(&mreq, 0, sizeof(mreq));
-    mreq.imr_multiaddr.s_addr = inet_addr(self->multicast_ip);  /* 使用配置的组播地址 */
-    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
-    if (setsockopt(self->cuav_sockfd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0)
-    {
-        GST_WARNING("Failed to join C-UAV multicast group %s: %s", self->multicast_ip, strerror(errno));
-    }
-    else
-    {
-        GST_INFO("Joined C-UAV multicast group %s", self->multicast_ip);
-    }
+/**
+ * @brief 释放光电设备状态帧元数据。
+ *
+ * @param data NvDsUserMeta 指针。
+ * @param user_data 用户自定义数据。
+ */
+static void udpjson_eo_meta_release(gpointer data, gpointer user_data)
+{
+    NvDsUserMeta *user_meta = (NvDsUserMeta *)data; /* 用户元数据 */
+    if (!user_meta)
+        return;
+    g_free(user_meta->user_meta_data);
+    user_meta->user_meta_data = NULL;
+}
 
-    GST_INFO("C-UAV socket bound to port %u", self->cuav_multicast_port);
-    /* 初始化控制/引导端口 socket */
-    if (self->cuav_ctrl_port == 0)
-    {
-        self->cuav_ctrl_sockfd = -1;
-        return TRUE;
-    }
+/**
+ * @brief 将映射到该源的光电设备状态挂到帧元数据。
+ *
+ * @param self 插件实例。
+ * @param batch_meta 批次元数据。
+ * @param frame_meta 帧元数据。
+ * @return 附加了光电状态返回 TRUE。
+ */
+static gboolean udpjson_attach_eo_meta(GstUdpJsonMeta *self, NvDsBatchMeta *batch_meta,
+                                   NvDsFrameMeta *frame_meta)
+{
+    NvDsUserMeta *user_meta = NULL; /* 用户元数据 */
+    UdpJsonEoFrameMeta *meta = NULL; /* 用户数据 */
+    gint slot = -1; /* 设备状态槽位 */
 
-    self->cuav_ctrl_sockfd = socket(AF_INET, SOCK_DGRAM, 0);
-    if (self->cuav_ctrl_sockfd < 0)
-    {
-        GST_ERROR("Failed to create C-UAV CTRL UDP socket: %s", strerror(errno));
+    if (frame_meta->source_id >= UDPJSON_MAX_EO_SOURCES)
         return FALSE;
-    }
-    if (setsockopt(self->cuav_ctrl_sockfd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0)
-    {
-        GST_WARNING("Failed to set SO_REUSEADDR for C-UAV CTRL: %s", strerror(errno));
-    }
-    memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_addr.s_addr = htonl(INADDR_ANY);
-    addr.sin_port = htons((guint16)self->cuav_ctrl_port);
-    if (bind(self->cuav_ctrl_sockfd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
-    {
-        GST_ERROR("Failed to bind C-UAV CTRL UDP socket to port %u: %s",
-                  self->cuav_ctrl_port, strerror(errno));
-        close(self->cuav_ctrl_sockfd);
-        self->cuav_ctrl_sockfd = -1;
+    slot = g_atomic_int_get(&self->eo_source_slot[frame_meta->source_id]);
+    if (slot < 0)
         return FALSE;
-    }
-    flags = fcntl(self->cuav_ctrl_sockfd, F_GETFL, 0);
-    if (flags >= 0)
+
+    meta = (UdpJsonEoFrameMeta *)g_malloc0(sizeof(UdpJsonEoFrameMeta));
+    if (!cuav_parser_read_device(self->cuav_parser, slot, &meta->state))
     {
-        if (fcntl(self->cuav_ctrl_sockfd, F_SETFL, flags | O_NONBLOCK) < 0)
-        {
-            GST_WARNING("Failed to set C-UAV CTRL socket non-blocking: %s", strerror(errno));
-        }
+        g_free(meta);
+        return FALSE;
     }
-    memset(&mreq, 0, sizeof(mreq));
-    mreq.imr_multiaddr.s_addr = inet_addr(self->multicast_ip);
-    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
-    if (setsockopt(self->cuav_ctrl_sockfd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0)
+    meta->source_id = frame_meta->source_id;
+    /* ntp_timestamp 需要 nvstreammux attach-sys-ts 或 NTP 同步才有效 */
+    if (frame_meta->ntp_timestamp > 0)
     {
-        GST_WARNING("Failed to join C-UAV CTRL multicast group %s: %s",
-                    self->multicast_ip, strerror(errno));
+        /* 指向采样按接收时的单调时钟记录，帧时间从 UTC 换算过去 */
+        gint64 mono_offset_ns = (g_get_real_time() - g_get_monotonic_time()) * 1000;
+
+        meta->pointing_result = cuav_parser_interpolate_pointing(
+            self->cuav_parser, slot, (gint64)frame_meta->ntp_timestamp - mono_offset_ns,
+            &meta->pointing);
+        meta->pointing.ts_ns = (gint64)frame_meta->ntp_timestamp;
     }
-    else
+
+    user_meta = nvds_acquire_user_meta_from_pool(batch_meta);
+    if (!user_meta)
     {
-        GST_INFO("Joined C-UAV CTRL multicast group %s", self->multicast_ip);
+        g_free(meta);
+        return FALSE;
     }
-    GST_INFO("C-UAV CTRL socket bound to port %u", self->cuav_ctrl_port);
+
+    user_meta->user_meta_data = meta;
+    user_meta->base_meta.meta_type = self->eo_meta_type;
+    user_meta->base_meta.copy_func = udpjson_eo_meta_copy;
+    user_meta->base_meta.release_func = udpjson_eo_meta_release;
+    user_meta->base_meta.batch_meta = batch_meta;
+
+    nvds_add_user_meta_to_frame(frame_meta, user_meta);
     return TRUE;
 }
 
 /**
- * @brief 释放 UDP 套接字。
+ * @brief 判断目标是否为伺服跟踪目标。
+ *
+ * 配置了 servo-object-id 时按 object_id 选择，否则按引导批号与缓存中的 tar_id 关联。
  *
  * @param self 插件实例。
+ * @param obj_meta 目标元数据。
+ * @param cached 目标的缓存值（可为 NULL）。
+ * @param guide_tar_id 当前引导批号。
+ * @return 是跟踪目标返回 TRUE。
  */
-static void udpjson_teardown_socket(GstUdpJsonMeta *self)
+static gboolean udpjson_servo_match(GstUdpJsonMeta *self, NvDsObjectMeta *obj_meta,
+                                    const UdpJsonCacheValue *cached, guint32 guide_tar_id)
 {
-    if (!self)
-        return;
-    if (self->sockfd >= 0)
-    {
-        close(self->sockfd);
-        self->sockfd = -1;
-    }
-    if (self->cuav_sockfd >= 0)
-    {
-        close(self->cuav_sockfd);
-        self->cuav_sockfd = -1;
-    }
-    if (self->cuav_ctrl_sockfd >= 0)
-    {
-        close(self->cuav_ctrl_sockfd);
-        self->cuav_ctrl_sockfd = -1;
-    }
+    if (self->servo_object_id != DEFAULT_SERVO_OBJECT_ID)
+        return obj_meta->object_id == self->servo_object_id;
+    return guide_tar_id != 0 && cached && cached->tar_id == guide_tar_id;
 }
 
 /**
- * @brief GstBaseTransform: 启动插件。
+ * @brief 计算帧从采集到当前经过的时间。
  *
- * @param trans 基类指针。
- * @return 成功返回 TRUE。
+ * 优先使用 ntp_timestamp（UTC，需要 nvstreammux attach-sys-ts 或 NTP 同步），其次把
+ * buf_pts 换算为流水线时钟时间；都不可用时退回到本批次进入 transform_ip 的时间。
+ *
+ * @param self 插件实例。
+ * @param frame_meta 帧元数据。
+ * @param entry_us 本批次进入 transform_ip 的单调时间(微秒)。
+ * @return 经过的时间(微秒)。
  */
-static gboolean gst_udpjson_meta_start(GstBaseTransform *trans)
+static guint64 udpjson_frame_age_us(GstUdpJsonMeta *self, NvDsFrameMeta *frame_meta,
+                                    guint64 entry_us)
 {
-    GstUdpJsonMeta *self = GST_UDPJSON_META(trans); /* 插件实例 */
-
-    g_atomic_int_set(&self->stop_flag, 0);
-    if (!udpjson_setup_socket(self))
-        return FALSE;
+    GstClock *clock = NULL; /* 流水线时钟 */
 
-    /* 设置 C-UAV socket（如果启用） */
-    if (!udpjson_setup_cuav_socket(self))
+    if (frame_meta->ntp_timestamp > 0)
     {
-        udpjson_teardown_socket(self);
-        return FALSE;
+        gint64 age_ns = g_get_real_time() * 1000 - (gint64)frame_meta->ntp_timestamp; /* 帧龄 */
+        if (age_ns >= 0)
+            return (guint64)age_ns / 1000;
     }
 
-    self->recv_thread = g_thread_new("udpjson-recv", udpjson_recv_thread, self);
-    return TRUE;
-}
-
-/**
- * @brief GstBaseTransform: 停止插件。
- *
- * @param trans 基类指针。
- * @return 成功返回 TRUE。
- */
-static gboolean gst_udpjson_meta_stop(GstBaseTransform *trans)
-{
-    GstUdpJsonMeta *self = GST_UDPJSON_META(trans); /* 插件实例 */
-
-    g_atomic_int_set(&self->stop_flag, 1);
-    if (self->recv_thread)
+    if (GST_CLOCK_TIME_IS_VALID(frame_meta->buf_pts) &&
+        (clock = gst_element_get_clock(GST_ELEMENT(self))) != NULL)
     {
-        g_thread_join(self->recv_thread);
-        self->recv_thread = NULL;
+        guint64 running = gst_segment_to_running_time(&GST_BASE_TRANSFORM(self)->segment,
+                                                      GST_FORMAT_TIME, frame_meta->buf_pts);
+        GstClockTime now = gst_clock_get_time(clock); /* 时钟当前时间 */
+        GstClockTime capture = GST_CLOCK_TIME_NONE; /* 帧的时钟时间 */
+
+        gst_object_unref(clock);
+        if (GST_CLOCK_TIME_IS_VALID(running))
+            capture = gst_element_get_base_time(GST_ELEMENT(self)) + running;
+        if (GST_CLOCK_TIME_IS_VALID(capture) && now >= capture)
+            return (now - capture) / GST_USECOND;
     }
 
-    udpjson_teardown_socket(self);
-    return TRUE;
+    return (guint64)g_get_monotonic_time() - entry_us;
 }
 
 /**
- * @brief 为目标附加用户元数据。
+ * @brief 计算跟踪目标的脱靶量并按速率输出伺服控制。
+ *
+ * 脱靶量为目标框中心相对图像中心的偏移，换算到源分辨率像素，右/下为正。
  *
  * @param self 插件实例。
- * @param batch_meta 批次元数据。
- * @param obj_meta 目标元数据。
- * @param value JSON 值字符串。
- * @param recv_ts_us 接收时间。
+ * @param frame_meta 帧元数据。
+ * @param target 跟踪目标，NULL 表示本帧未找到。
+ * @param entry_us 本批次进入 transform_ip 的时间(微秒)，帧没有采集时间时作为延迟起点。
  */
-static void udpjson_attach_obj_meta(GstUdpJsonMeta *self, NvDsBatchMeta *batch_meta,
-                                    NvDsObjectMeta *obj_meta, const gchar *value,
-                                    guint64 recv_ts_us)
+static void udpjson_servo_process(GstUdpJsonMeta *self, NvDsFrameMeta *frame_meta,
+                                  NvDsObjectMeta *target, guint64 entry_us)
 {
-    NvDsUserMeta *user_meta = NULL; /* 用户元数据 */
-    UdpJsonObjMeta *meta = NULL; /* 用户数据 */
+    CUAVServoControl servo; /* 伺服控制 */
+    gdouble width = 0; /* 检测坐标系宽度 */
+    gdouble height = 0; /* 检测坐标系高度 */
+    gdouble err_h = 0; /* 水平脱靶量 */
+    gdouble err_v = 0; /* 垂直脱靶量 */
+    guint64 now_us = 0; /* 当前时间 */
+    guint64 latency_us = 0; /* 帧采集到指令发出的延迟 */
 
-    if (!self || !batch_meta || !obj_meta || !value)
+    if (!target)
+    {
+        udpjson_servo_stage_reset(&self->servo_stage);
         return;
+    }
 
-    user_meta = nvds_acquire_user_meta_from_pool(batch_meta);
-    if (!user_meta)
+    width = frame_meta->pipeline_width ? frame_meta->pipeline_width
+                                       : frame_meta->source_frame_width;
+    height = frame_meta->pipeline_height ? frame_meta->pipeline_height
+                                         : frame_meta->source_frame_height;
+    if (width <= 0 || height <= 0)
         return;
 
-    meta = (UdpJsonObjMeta *)g_malloc0(sizeof(UdpJsonObjMeta));
-    meta->key = g_strdup("value");
-    meta->value = g_strdup(value);
-    meta->recv_ts_us = recv_ts_us;
+    err_h = target->rect_params.left + target->rect_params.width / 2.0 - width / 2.0;
+    err_v = target->rect_params.top + target->rect_params.height / 2.0 - height / 2.0;
+    if (frame_meta->source_frame_width > 0 && frame_meta->source_frame_height > 0)
+    {
+        err_h *= frame_meta->source_frame_width / width;
+        err_v *= frame_meta->source_frame_height / height;
+    }
 
-    user_meta->user_meta_data = meta;
-    user_meta->base_meta.meta_type = self->meta_type;
-    user_meta->base_meta.copy_func = udpjson_obj_meta_copy;
-    user_meta->base_meta.release_func = udpjson_obj_meta_release;
-    user_meta->base_meta.batch_meta = batch_meta;
+    now_us = (guint64)g_get_monotonic_time();
+    if (!udpjson_servo_stage_update(&self->servo_stage, err_h, err_v, self->servo_smoothing,
+                                    self->servo_max_rate, (guint8)self->servo_dev_id,
+                                    (guint8)self->servo_mode, now_us, &servo))
+        return;
 
-    nvds_add_user_meta_to_obj(obj_meta, user_meta);
+    if (!gst_udpjson_meta_send_servo_control(self, &servo))
+        return;
+
+    latency_us = udpjson_frame_age_us(self, frame_meta, entry_us);
+    udpjson_servo_stage_record_latency(&self->servo_stage, latency_us);
+    GST_LOG_OBJECT(self, "servo offset_h=%d offset_v=%d object_id=%" G_GUINT64_FORMAT
+                   " latency=%" G_GUINT64_FORMAT "us",
+                   servo.offset_h, servo.offset_v, target->object_id, latency_us);
 }
 
 /**
@@ -794,6 +676,10 @@ static GstFlowReturn gst_udpjson_meta_transform_ip(GstBaseTransform *trans, GstB
     GstUdpJsonMeta *self = GST_UDPJSON_META(trans); /* 插件实例 */
     NvDsBatchMeta *batch_meta = NULL; /* 批次元数据 */
     guint64 now_us = 0; /* 当前时间 */
+    guint64 counts[UDPJSON_STAT_COUNT] = {0}; /* 本批次计数，结束时一次性累加 */
+    guint64 start_ns = 0; /* 处理开始时间 */
+    guint64 end_ns = 0; /* 处理结束时间 */
+    UdpJsonIngest *json = NULL; /* 提供目标 JSON 缓存的实例 */
 
     if (!self || !buf)
         return GST_FLOW_OK;
@@ -802,24 +688,38 @@ static GstFlowReturn gst_udpjson_meta_transform_ip(GstBaseTransform *trans, GstB
     if (!batch_meta)
         return GST_FLOW_OK;
 
-    now_us = (guint64)g_get_monotonic_time();
+    json = self->ingest->json_ingest;
+    start_ns = udpjson_now_ns();
+    now_us = start_ns / 1000;
+    UDPJSON_PROBE1(transform_start, batch_meta->num_frames_in_batch);
 
     for (NvDsMetaList *l_frame = batch_meta->frame_meta_list; l_frame; l_frame = l_frame->next)
     {
         NvDsFrameMeta *frame_meta = (NvDsFrameMeta *)l_frame->data; /* 帧元数据 */
         guint source_id = frame_meta->source_id; /* 源ID */
+        gboolean servo_frame = FALSE; /* 本帧是否输出脱靶量 */
+        guint32 guide_tar_id = 0; /* 当前引导批号 */
+        NvDsObjectMeta *servo_target = NULL; /* 伺服跟踪目标 */
 
         if (!frame_meta)
             continue;
 
-        g_rw_lock_reader_lock(&self->cache_lock);
+        counts[UDPJSON_STAT_FRAMES]++;
+        if (udpjson_attach_eo_meta(self, batch_meta, frame_meta))
+            counts[UDPJSON_STAT_EO_METAS]++;
+
+        servo_frame = self->servo_enable && source_id == self->servo_source_id;
+        if (servo_frame)
+            guide_tar_id = cuav_parser_get_guidance_tar_id(self->cuav_parser);
+
+        g_rw_lock_reader_lock(&json->cache_lock);
 
         for (NvDsMetaList *l_obj = frame_meta->obj_meta_list; l_obj; l_obj = l_obj->next)
         {
             NvDsObjectMeta *obj_meta = (NvDsObjectMeta *)l_obj->data; /* 目标元数据 */
             UdpJsonCacheKey lookup_key; /* 查找键 */
             UdpJsonCacheValue *cached = NULL; /* 缓存值 */
-            guint64 age_ms = 0; /* 过期时间 */
+            guint64 age_us = 0; /* 缓存值年龄(微秒) */
 
             if (!obj_meta)
                 continue;
@@ -829,26 +729,186 @@ static GstFlowReturn gst_udpjson_meta_transform_ip(GstBaseTransform *trans, GstB
             lookup_key.source_id = source_id;
             lookup_key.object_id = obj_meta->object_id;
 
-            cached = (UdpJsonCacheValue *)g_hash_table_lookup(self->cache, &lookup_key);
+            if (self->ingest->demand)
+                udpjson_demand_add(self->ingest->demand, source_id, obj_meta->object_id);
+            counts[UDPJSON_STAT_OBJECTS]++;
+            cached = (UdpJsonCacheValue *)g_hash_table_lookup(json->cache, &lookup_key);
+            if (servo_frame && !servo_target &&
+                udpjson_servo_match(self, obj_meta, cached, guide_tar_id))
+                servo_target = obj_meta;
             if (!cached)
+            {
+                counts[UDPJSON_STAT_CACHE_MISSES]++;
                 continue;
+            }
 
-            if (self->cache_ttl_ms > 0)
+            age_us = now_us > cached->recv_ts_us ? now_us - cached->recv_ts_us : 0;
+            if (self->cache_ttl_ms > 0 && age_us / 1000 > self->cache_ttl_ms)
             {
-                age_ms = (now_us - cached->recv_ts_us) / 1000;
-                if (age_ms > self->cache_ttl_ms)
-                    continue;
+                counts[UDPJSON_STAT_CACHE_STALE]++;
+                continue;
             }
 
-            udpjson_attach_obj_meta(self, batch_meta, obj_meta, cached->value, cached->recv_ts_us);
+            counts[UDPJSON_STAT_CACHE_HITS]++;
+            udpjson_stats_record(self->ingest->stats, UDPJSON_HIST_ATTACH_AGE, age_us * 1000);
+            if (self->trace_attach_interval > 0 &&
+                ++self->trace_attach_count >= self->trace_attach_interval)
+            {
+                self->trace_attach_count = 0;
+                UDPJSON_PROBE3(attach, source_id, obj_meta->object_id, age_us * 1000);
+                udpjson_trace_stage(GST_ELEMENT(self), UDPJSON_TRACE_STAGE_ATTACH_AGE,
+                                    age_us * 1000);
+            }
+            if (udpjson_attach_obj_meta(self, batch_meta, obj_meta, cached->value,
+                                        cached->recv_ts_us))
+                counts[UDPJSON_STAT_ATTACHED_METAS]++;
         }
 
-        g_rw_lock_reader_unlock(&self->cache_lock);
+        g_rw_lock_reader_unlock(&json->cache_lock);
+
+        if (servo_frame)
+            udpjson_servo_process(self, frame_meta, servo_target, now_us);
     }
+    if (self->ingest->demand)
+        udpjson_demand_batch_done(self->ingest->demand, (gint64)now_us);
+
+    for (guint i = UDPJSON_STAT_FRAMES; i <= UDPJSON_STAT_EO_METAS; i++)
+    {
+        if (counts[i])
+            udpjson_stats_add(self->ingest->stats, UDPJSON_STATS_SHARD_STREAM, (UdpJsonStat)i, counts[i]);
+    }
+    end_ns = udpjson_now_ns();
+    udpjson_stats_record(self->ingest->stats, UDPJSON_HIST_TRANSFORM, end_ns - start_ns);
+    UDPJSON_PROBE2(transform_end, batch_meta->num_frames_in_batch, end_ns - start_ns);
+    udpjson_trace_stage(GST_ELEMENT(self), UDPJSON_TRACE_STAGE_TRANSFORM, end_ns - start_ns);
 
     return GST_FLOW_OK;
 }
 
+/**
+ * @brief 将 msg_id 列表字符串应用到 C-UAV 解析器。
+ *
+ * @param self 插件实例。
+ */
+static void udpjson_apply_cuav_msg_id_filter(GstUdpJsonMeta *self)
+{
+    gchar **tokens = NULL; /* 分割后的 msg_id */
+    guint16 ids[64]; /* 解析后的 msg_id */
+    guint n_ids = 0; /* msg_id 数量 */
+
+    if (!self->cuav_parser)
+        return;
+
+    if (self->cuav_accept_msg_ids)
+        tokens = g_strsplit_set(self->cuav_accept_msg_ids, ",; ", -1);
+    for (guint i = 0; tokens && tokens[i] && n_ids < G_N_ELEMENTS(ids); i++)
+    {
+        gchar *end = NULL; /* 解析结束位置 */
+        guint64 id = 0; /* msg_id */
+        if (tokens[i][0] == '\0')
+            continue;
+        id = g_ascii_strtoull(tokens[i], &end, 0);
+        if (end == tokens[i] || id > G_MAXUINT16)
+        {
+            GST_WARNING_OBJECT(self, "Ignoring invalid C-UAV msg_id '%s'", tokens[i]);
+            continue;
+        }
+        ids[n_ids++] = (guint16)id;
+    }
+    g_strfreev(tokens);
+
+    cuav_parser_set_msg_id_filter(self->cuav_parser, ids, n_ids);
+}
+
+/**
+ * @brief 将本机地址过滤配置应用到 C-UAV 解析器。
+ *
+ * @param self 插件实例。
+ */
+static void udpjson_apply_cuav_rx_filter(GstUdpJsonMeta *self)
+{
+    if (self->cuav_parser)
+    {
+        cuav_parser_set_rx_filter(self->cuav_parser, self->cuav_filter_rx,
+                                  self->cuav_addressing.tx_sys_id,
+                                  self->cuav_addressing.tx_dev_id);
+    }
+}
+
+/**
+ * @brief 将光电设备到源的映射应用到槽位表。
+ *
+ * 格式为逗号分隔的 "tx_dev_id:source_id"，每个设备在解析器中预留状态槽位，
+ * transform_ip 按 source_id 直接索引槽位。
+ *
+ * @param self 插件实例。
+ */
+static void udpjson_apply_eo_source_map(GstUdpJsonMeta *self)
+{
+    gchar **tokens = NULL; /* 分割后的映射条目 */
+
+    for (guint i = 0; i < UDPJSON_MAX_EO_SOURCES; i++)
+        g_atomic_int_set(&self->eo_source_slot[i], -1);
+
+    if (self->eo_source_map)
+        tokens = g_strsplit_set(self->eo_source_map, ",; ", -1);
+    for (guint i = 0; tokens && tokens[i]; i++)
+    {
+        gchar *colon = strchr(tokens[i], ':'); /* 分隔符 */
+        gchar *end = NULL; /* 解析结束位置 */
+        guint64 dev_id = 0; /* 设备编号 */
+        guint64 source_id = 0; /* 源ID */
+        gint slot = -1; /* 设备状态槽位 */
+
+        if (tokens[i][0] == '\0')
+            continue;
+        if (!colon)
+        {
+            GST_WARNING_OBJECT(self, "Ignoring invalid eo-source-map entry '%s'", tokens[i]);
+            continue;
+        }
+        *colon = '\0';
+        dev_id = g_ascii_strtoull(tokens[i], &end, 0);
+        if (end == tokens[i] || dev_id > G_MAXUINT16)
+        {
+            GST_WARNING_OBJECT(self, "Ignoring invalid tx_dev_id '%s'", tokens[i]);
+            continue;
+        }
+        source_id = g_ascii_strtoull(colon + 1, &end, 0);
+        if (end == colon + 1 || source_id >= UDPJSON_MAX_EO_SOURCES)
+        {
+            GST_WARNING_OBJECT(self, "Ignoring invalid source_id '%s' (max %u)", colon + 1,
+                               UDPJSON_MAX_EO_SOURCES - 1);
+            continue;
+        }
+
+        slot = cuav_parser_register_device(self->cuav_parser, (guint16)dev_id);
+        if (slot < 0)
+        {
+            GST_WARNING_OBJECT(self, "No free EO device slot for tx_dev_id %u (max %d)",
+                               (guint)dev_id, CUAV_MAX_DEVICES);
+            continue;
+        }
+        g_atomic_int_set(&self->eo_source_slot[source_id], slot);
+    }
+    g_strfreev(tokens);
+}
+
+/**
+ * @brief 将引导航迹融合配置应用到融合实例和解析器。
+ *
+ * @param self 插件实例。
+ */
+static void udpjson_apply_fusion(GstUdpJsonMeta *self)
+{
+    gboolean enabled = self->fusion_config.gate_m > 0; /* 是否启用融合 */
+
+    /* 关闭融合时同样下发配置，由融合实例清空航迹 */
+    cuav_fusion_set_config(self->fusion, &self->fusion_config);
+    cuav_parser_set_fusion(self->cuav_parser, enabled ? self->fusion : NULL,
+                           self->fusion_suppress_duplicates);
+}
+
 /**
  * @brief 设置插件属性。
  *
@@ -865,41 +925,186 @@ static void gst_udpjson_meta_set_property(GObject *object, guint property_id,
     switch (property_id)
     {
     case PROP_MULTICAST_IP:
-        g_free(self->multicast_ip);
-        self->multicast_ip = g_value_dup_string(value);
+        udpjson_set_socket_string(self, &self->ingest->multicast_ip, value);
+        udpjson_socket_config_changed(self, TRUE);
+        break;
+    case PROP_PORT:
+        udpjson_set_socket_uint(self, &self->ingest->port, value);
+        udpjson_socket_config_changed(self, TRUE);
+        break;
+    case PROP_IFACE:
+        udpjson_set_socket_string(self, &self->ingest->iface, value);
+        udpjson_socket_config_changed(self, TRUE);
+        break;
+    case PROP_ENDPOINTS:
+        udpjson_set_socket_string(self, &self->ingest->endpoints, value);
+        udpjson_socket_config_changed(self, TRUE);
+        break;
+    case PROP_RECV_BUF_SIZE:
+        udpjson_set_socket_uint(self, &self->ingest->recv_buf_size, value);
+        udpjson_socket_config_changed(self, TRUE);
+        break;
+    case PROP_CACHE_TTL_MS:
+        self->cache_ttl_ms = g_value_get_uint(value);
+        break;
+    case PROP_MAX_CACHE_SIZE:
+        self->ingest->max_cache_size = g_value_get_uint(value);
+        break;
+    case PROP_SHARED_RECEIVER:
+        self->ingest->shared_json = g_value_get_boolean(value);
+        break;
+    case PROP_DEMAND_INTERVAL:
+        self->ingest->demand_interval = g_value_get_uint(value);
+        break;
+    case PROP_DEDUP_WINDOW_MS:
+        self->ingest->dedup_window_ms = g_value_get_uint(value);
+        break;
+    /* C-UAV 协议属性 */
+    case PROP_ENABLE_CUAV_PARSER:
+        self->ingest->enable_cuav_parser = g_value_get_boolean(value);
+        break;
+    case PROP_CUAV_MULTICAST_PORT:
+        udpjson_set_socket_uint(self, &self->ingest->cuav_multicast_port, value);
+        udpjson_socket_config_changed(self, FALSE);
+        break;
+    case PROP_CUAV_CTRL_PORT:
+        udpjson_set_socket_uint(self, &self->ingest->cuav_ctrl_port, value);
+        udpjson_socket_config_changed(self, FALSE);
+        break;
+    case PROP_CUAV_DEBUG:
+        self->cuav_debug = g_value_get_boolean(value);
+        if (self->cuav_parser)
+        {
+            cuav_parser_set_debug(self->cuav_parser, self->cuav_debug);
+        }
+        udpjson_sync_event_log(self);
+        break;
+    case PROP_CACHE_DEBUG:
+        self->ingest->cache_debug = g_value_get_boolean(value);
+        udpjson_sync_event_log(self);
+        break;
+    case PROP_DEBUG_SAMPLE:
+        g_free(self->debug_sample);
+        self->debug_sample = g_value_dup_string(value);
+        if (!udpjson_event_log_parse_sample(self->event_log, self->debug_sample))
+        {
+            GST_WARNING_OBJECT(self, "Invalid entries in debug-sample '%s'", self->debug_sample);
+        }
+        break;
+    case PROP_CUAV_DROP_DUPLICATES:
+        self->cuav_drop_duplicates = g_value_get_boolean(value);
+        if (self->cuav_parser)
+        {
+            cuav_parser_set_drop_duplicates(self->cuav_parser, self->cuav_drop_duplicates);
+        }
+        break;
+    case PROP_CUAV_ACCEPT_MSG_IDS:
+        g_free(self->cuav_accept_msg_ids);
+        self->cuav_accept_msg_ids = g_value_dup_string(value);
+        udpjson_apply_cuav_msg_id_filter(self);
+        break;
+    case PROP_CUAV_FILTER_RX:
+        self->cuav_filter_rx = g_value_get_boolean(value);
+        udpjson_apply_cuav_rx_filter(self);
+        break;
+    case PROP_CUAV_SEND_IP:
+        g_free(self->cuav_send_ip);
+        self->cuav_send_ip = g_value_dup_string(value);
+        break;
+    case PROP_CUAV_SEND_PORT:
+        self->cuav_send_port = g_value_get_uint(value);
+        break;
+    case PROP_CUAV_SYS_ID:
+        self->cuav_addressing.tx_sys_id = (guint16)g_value_get_uint(value);
+        udpjson_apply_cuav_rx_filter(self);
+        break;
+    case PROP_CUAV_DEV_TYPE:
+        self->cuav_addressing.tx_dev_type = (guint16)g_value_get_uint(value);
+        break;
+    case PROP_CUAV_DEV_ID:
+        self->cuav_addressing.tx_dev_id = (guint16)g_value_get_uint(value);
+        udpjson_apply_cuav_rx_filter(self);
+        break;
+    case PROP_CUAV_DST_SYS_ID:
+        self->cuav_addressing.rx_sys_id = (guint16)g_value_get_uint(value);
+        break;
+    case PROP_CUAV_DST_DEV_ID:
+        self->cuav_addressing.rx_dev_id = (guint16)g_value_get_uint(value);
+        break;
+    case PROP_STATS_INTERVAL_MS:
+        g_atomic_int_set(&self->ingest->stats_interval_ms, (gint)g_value_get_uint(value));
+        break;
+    case PROP_METRICS_ENDPOINT:
+        g_free(self->ingest->metrics_endpoint);
+        self->ingest->metrics_endpoint = g_value_dup_string(value);
         break;
-    case PROP_PORT:
-        self->port = g_value_get_uint(value);
+    case PROP_TRACE_ATTACH_INTERVAL:
+        self->trace_attach_interval = g_value_get_uint(value);
         break;
-    case PROP_IFACE:
-        g_free(self->iface);
-        self->iface = g_value_dup_string(value);
+    case PROP_FLIGHT_RECORDER_SIZE:
+        self->ingest->flight_recorder_size = g_value_get_uint(value);
         break;
-    case PROP_RECV_BUF_SIZE:
-        self->recv_buf_size = g_value_get_uint(value);
+    case PROP_FLIGHT_RECORDER_DIR:
+        g_free(self->ingest->flight_recorder_dir);
+        self->ingest->flight_recorder_dir = g_value_dup_string(value);
         break;
-    case PROP_CACHE_TTL_MS:
-        self->cache_ttl_ms = g_value_get_uint(value);
+    case PROP_FLIGHT_RECORDER_FAIL_RATIO:
+        self->ingest->flight_recorder_fail_ratio = g_value_get_double(value);
         break;
-    case PROP_MAX_CACHE_SIZE:
-        self->max_cache_size = g_value_get_uint(value);
+    case PROP_FLIGHT_RECORDER_DUMP_ON_FLUSH:
+        self->ingest->flight_recorder_dump_on_flush = g_value_get_boolean(value);
         break;
-    /* C-UAV 协议属性 */
-    case PROP_ENABLE_CUAV_PARSER:
-        self->enable_cuav_parser = g_value_get_boolean(value);
+    case PROP_FLIGHT_RECORDER_SIGNAL:
+        self->ingest->flight_recorder_signal = g_value_get_int(value);
         break;
-    case PROP_CUAV_MULTICAST_PORT:
-        self->cuav_multicast_port = g_value_get_uint(value);
+    case PROP_JOURNAL_DIR:
+        g_free(self->ingest->journal_dir);
+        self->ingest->journal_dir = g_value_dup_string(value);
         break;
-    case PROP_CUAV_CTRL_PORT:
-        self->cuav_ctrl_port = g_value_get_uint(value);
+    case PROP_JOURNAL_FILE_SIZE:
+        self->ingest->journal_file_size = g_value_get_uint(value);
         break;
-    case PROP_CUAV_DEBUG:
-        self->cuav_debug = g_value_get_boolean(value);
-        if (self->cuav_parser)
-        {
-            cuav_parser_set_debug(self->cuav_parser, self->cuav_debug);
-        }
+    case PROP_JOURNAL_MAX_FILES:
+        self->ingest->journal_max_files = g_value_get_uint(value);
+        break;
+    case PROP_EO_SOURCE_MAP:
+        g_free(self->eo_source_map);
+        self->eo_source_map = g_value_dup_string(value);
+        udpjson_apply_eo_source_map(self);
+        break;
+    case PROP_FUSION_GATE:
+        self->fusion_config.gate_m = g_value_get_double(value);
+        udpjson_apply_fusion(self);
+        break;
+    case PROP_FUSION_VELOCITY_GATE:
+        self->fusion_config.velocity_gate_mps = g_value_get_double(value);
+        udpjson_apply_fusion(self);
+        break;
+    case PROP_FUSION_SUPPRESS_DUPLICATES:
+        self->fusion_suppress_duplicates = g_value_get_boolean(value);
+        udpjson_apply_fusion(self);
+        break;
+    /* 脱靶量伺服输出属性 */
+    case PROP_SERVO_ENABLE:
+        self->servo_enable = g_value_get_boolean(value);
+        break;
+    case PROP_SERVO_SOURCE_ID:
+        self->servo_source_id = g_value_get_uint(value);
+        break;
+    case PROP_SERVO_OBJECT_ID:
+        self->servo_object_id = g_value_get_uint64(value);
+        break;
+    case PROP_SERVO_MAX_RATE:
+        self->servo_max_rate = g_value_get_double(value);
+        break;
+    case PROP_SERVO_SMOOTHING:
+        self->servo_smoothing = g_value_get_double(value);
+        break;
+    case PROP_SERVO_DEV_ID:
+        self->servo_dev_id = g_value_get_uint(value);
+        break;
+    case PROP_SERVO_MODE:
+        self->servo_mode = g_value_get_uint(value);
         break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
@@ -923,36 +1128,157 @@ static void gst_udpjson_meta_get_property(GObject *object, guint property_id,
     switch (property_id)
     {
     case PROP_MULTICAST_IP:
-        g_value_set_string(value, self->multicast_ip);
+        udpjson_get_socket_string(self, &self->ingest->multicast_ip, value);
         break;
     case PROP_PORT:
-        g_value_set_uint(value, self->port);
+        g_value_set_uint(value, self->ingest->port);
         break;
     case PROP_IFACE:
-        g_value_set_string(value, self->iface);
+        udpjson_get_socket_string(self, &self->ingest->iface, value);
+        break;
+    case PROP_ENDPOINTS:
+        udpjson_get_socket_string(self, &self->ingest->endpoints, value);
         break;
     case PROP_RECV_BUF_SIZE:
-        g_value_set_uint(value, self->recv_buf_size);
+        g_value_set_uint(value, self->ingest->recv_buf_size);
         break;
     case PROP_CACHE_TTL_MS:
         g_value_set_uint(value, self->cache_ttl_ms);
         break;
     case PROP_MAX_CACHE_SIZE:
-        g_value_set_uint(value, self->max_cache_size);
+        g_value_set_uint(value, self->ingest->max_cache_size);
+        break;
+    case PROP_SHARED_RECEIVER:
+        g_value_set_boolean(value, self->ingest->shared_json);
+        break;
+    case PROP_DEMAND_INTERVAL:
+        g_value_set_uint(value, self->ingest->demand_interval);
+        break;
+    case PROP_DEDUP_WINDOW_MS:
+        g_value_set_uint(value, self->ingest->dedup_window_ms);
         break;
     /* C-UAV 协议属性 */
     case PROP_ENABLE_CUAV_PARSER:
-        g_value_set_boolean(value, self->enable_cuav_parser);
+        g_value_set_boolean(value, self->ingest->enable_cuav_parser);
         break;
     case PROP_CUAV_MULTICAST_PORT:
-        g_value_set_uint(value, self->cuav_multicast_port);
+        g_value_set_uint(value, self->ingest->cuav_multicast_port);
         break;
     case PROP_CUAV_CTRL_PORT:
-        g_value_set_uint(value, self->cuav_ctrl_port);
+        g_value_set_uint(value, self->ingest->cuav_ctrl_port);
         break;
     case PROP_CUAV_DEBUG:
         g_value_set_boolean(value, self->cuav_debug);
         break;
+    case PROP_CACHE_DEBUG:
+        g_value_set_boolean(value, self->ingest->cache_debug);
+        break;
+    case PROP_DEBUG_SAMPLE:
+        g_value_set_string(value, self->debug_sample);
+        break;
+    case PROP_CUAV_DROP_DUPLICATES:
+        g_value_set_boolean(value, self->cuav_drop_duplicates);
+        break;
+    case PROP_CUAV_ACCEPT_MSG_IDS:
+        g_value_set_string(value, self->cuav_accept_msg_ids);
+        break;
+    case PROP_CUAV_FILTER_RX:
+        g_value_set_boolean(value, self->cuav_filter_rx);
+        break;
+    case PROP_CUAV_SEND_IP:
+        g_value_set_string(value, self->cuav_send_ip);
+        break;
+    case PROP_CUAV_SEND_PORT:
+        g_value_set_uint(value, self->cuav_send_port);
+        break;
+    case PROP_CUAV_SYS_ID:
+        g_value_set_uint(value, self->cuav_addressing.tx_sys_id);
+        break;
+    case PROP_CUAV_DEV_TYPE:
+        g_value_set_uint(value, self->cuav_addressing.tx_dev_type);
+        break;
+    case PROP_CUAV_DEV_ID:
+        g_value_set_uint(value, self->cuav_addressing.tx_dev_id);
+        break;
+    case PROP_CUAV_DST_SYS_ID:
+        g_value_set_uint(value, self->cuav_addressing.rx_sys_id);
+        break;
+    case PROP_CUAV_DST_DEV_ID:
+        g_value_set_uint(value, self->cuav_addressing.rx_dev_id);
+        break;
+    case PROP_EO_SOURCE_MAP:
+        g_value_set_string(value, self->eo_source_map);
+        break;
+    case PROP_FUSION_GATE:
+        g_value_set_double(value, self->fusion_config.gate_m);
+        break;
+    case PROP_FUSION_VELOCITY_GATE:
+        g_value_set_double(value, self->fusion_config.velocity_gate_mps);
+        break;
+    case PROP_FUSION_SUPPRESS_DUPLICATES:
+        g_value_set_boolean(value, self->fusion_suppress_duplicates);
+        break;
+    /* 脱靶量伺服输出属性 */
+    case PROP_SERVO_ENABLE:
+        g_value_set_boolean(value, self->servo_enable);
+        break;
+    case PROP_SERVO_SOURCE_ID:
+        g_value_set_uint(value, self->servo_source_id);
+        break;
+    case PROP_SERVO_OBJECT_ID:
+        g_value_set_uint64(value, self->servo_object_id);
+        break;
+    case PROP_SERVO_MAX_RATE:
+        g_value_set_double(value, self->servo_max_rate);
+        break;
+    case PROP_SERVO_SMOOTHING:
+        g_value_set_double(value, self->servo_smoothing);
+        break;
+    case PROP_SERVO_DEV_ID:
+        g_value_set_uint(value, self->servo_dev_id);
+        break;
+    case PROP_SERVO_MODE:
+        g_value_set_uint(value, self->servo_mode);
+        break;
+    case PROP_SERVO_LATENCY_US:
+        g_value_set_uint64(value, self->servo_stage.last_latency_us);
+        break;
+    case PROP_STATS:
+        g_value_take_boxed(value, udpjson_stats_to_structure(self->ingest->stats));
+        break;
+    case PROP_STATS_INTERVAL_MS:
+        g_value_set_uint(value, (guint)g_atomic_int_get(&self->ingest->stats_interval_ms));
+        break;
+    case PROP_METRICS_ENDPOINT:
+        g_value_set_string(value, self->ingest->metrics_endpoint);
+        break;
+    case PROP_TRACE_ATTACH_INTERVAL:
+        g_value_set_uint(value, self->trace_attach_interval);
+        break;
+    case PROP_FLIGHT_RECORDER_SIZE:
+        g_value_set_uint(value, self->ingest->flight_recorder_size);
+        break;
+    case PROP_FLIGHT_RECORDER_DIR:
+        g_value_set_string(value, self->ingest->flight_recorder_dir);
+        break;
+    case PROP_FLIGHT_RECORDER_FAIL_RATIO:
+        g_value_set_double(value, self->ingest->flight_recorder_fail_ratio);
+        break;
+    case PROP_FLIGHT_RECORDER_DUMP_ON_FLUSH:
+        g_value_set_boolean(value, self->ingest->flight_recorder_dump_on_flush);
+        break;
+    case PROP_FLIGHT_RECORDER_SIGNAL:
+        g_value_set_int(value, self->ingest->flight_recorder_signal);
+        break;
+    case PROP_JOURNAL_DIR:
+        g_value_set_string(value, self->ingest->journal_dir);
+        break;
+    case PROP_JOURNAL_FILE_SIZE:
+        g_value_set_uint(value, self->ingest->journal_file_size);
+        break;
+    case PROP_JOURNAL_MAX_FILES:
+        g_value_set_uint(value, self->ingest->journal_max_files);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
         break;
@@ -968,8 +1294,13 @@ static void gst_udpjson_meta_finalize(GObject *object)
 {
     GstUdpJsonMeta *self = GST_UDPJSON_META(object); /* 插件实例 */
 
-    g_free(self->multicast_ip);
-    g_free(self->iface);
+    g_free(self->cuav_send_ip);
+    g_free(self->cuav_accept_msg_ids);
+    g_free(self->debug_sample);
+    g_free(self->eo_source_map);
+
+    udpjson_teardown_cuav_sender(self);
+    g_mutex_clear(&self->cuav_sender_lock);
 
     /* 释放 C-UAV 解析器 */
     if (self->cuav_parser)
@@ -978,10 +1309,14 @@ static void gst_udpjson_meta_finalize(GObject *object)
         self->cuav_parser = NULL;
     }
 
-    if (self->cache)
-        g_hash_table_destroy(self->cache);
+    udpjson_event_log_free(self->event_log);
+    self->event_log = NULL;
 
-    g_rw_lock_clear(&self->cache_lock);
+    cuav_fusion_free(self->fusion);
+    self->fusion = NULL;
+
+    udpjson_ingest_free(self->ingest);
+    self->ingest = NULL;
 
     G_OBJECT_CLASS(parent_class)->finalize(object);
 }
@@ -1016,21 +1351,38 @@ static void gst_udpjson_meta_class_init(GstUdpJsonMetaClass *klass)
         gobject_class, PROP_MULTICAST_IP,
         g_param_spec_string("multicast-ip", "Multicast IP",
                             "UDP multicast group IP", DEFAULT_MULTICAST_IP,
-                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                          GST_PARAM_MUTABLE_PLAYING)));
     g_object_class_install_property(
         gobject_class, PROP_PORT,
         g_param_spec_uint("port", "Port", "UDP port", 1, 65535, DEFAULT_PORT,
-                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                        GST_PARAM_MUTABLE_PLAYING)));
     g_object_class_install_property(
         gobject_class, PROP_IFACE,
         g_param_spec_string("iface", "Interface",
-                            "Network interface name (e.g., eth0)", NULL,
-                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                            "Network interface name (e.g., eth0); a comma separated list "
+                            "(e.g., \"eth0,eth1\") joins the group on each interface as "
+                            "redundant paths, see dedup-window-ms; outgoing C-UAV commands use the "
+                            "first one", NULL,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                          GST_PARAM_MUTABLE_PLAYING)));
+    g_object_class_install_property(
+        gobject_class, PROP_ENDPOINTS,
+        g_param_spec_string("endpoints", "Endpoints",
+                            "Comma separated object JSON endpoints group:port[@iface][=source_id], "
+                            "received by one thread; source_id applies to payloads without one, "
+                            "e.g. \"239.1.1.1:5000@eth0=0,239.1.1.2:5000=1\". Replaces "
+                            "multicast-ip/port/iface for object JSON when set",
+                            NULL,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                          GST_PARAM_MUTABLE_PLAYING)));
     g_object_class_install_property(
         gobject_class, PROP_RECV_BUF_SIZE,
         g_param_spec_uint("recv-buf-size", "Recv Buffer Size",
                           "Socket receive buffer size", 0, G_MAXUINT,
-                          0, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                          0, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                           GST_PARAM_MUTABLE_PLAYING)));
     g_object_class_install_property(
         gobject_class, PROP_CACHE_TTL_MS,
         g_param_spec_uint("cache-ttl-ms", "Cache TTL(ms)",
@@ -1043,6 +1395,33 @@ static void gst_udpjson_meta_class_init(GstUdpJsonMetaClass *klass)
                           "Max number of cached objects", 0, G_MAXUINT,
                           DEFAULT_MAX_CACHE_SIZE,
                           (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_SHARED_RECEIVER,
+        g_param_spec_boolean("shared-receiver", "Shared Receiver",
+                             "Receive object JSON through one process-wide socket and cache "
+                             "shared by all elements with the same multicast-ip, port and iface "
+                             "(the first element's cache and receive settings apply; C-UAV "
+                             "sockets stay per element)",
+                             FALSE,
+                             (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_DEMAND_INTERVAL,
+        g_param_spec_uint("demand-interval", "Demand Interval",
+                          "Only parse and cache object JSON for objects seen in the last two "
+                          "periods of this many batches, plus object ids above the newest seen "
+                          "per source (0 = parse everything; ignored with shared-receiver)",
+                          0, 1000, 0,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_DEDUP_WINDOW_MS,
+        g_param_spec_uint("dedup-window-ms", "Dedup Window(ms)",
+                          "Keep only the first copy of identical object JSON datagrams arriving "
+                          "on different object JSON sockets within this window, for redundant "
+                          "paths (iface list or endpoints); a copy arriving again on a socket that "
+                          "already delivered it is a sender resend and is kept; "
+                          "per-path lead times are posted with the stats message (0 = no dedup)",
+                          0, 10000, 0,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 
     /* C-UAV 协议属性 */
     g_object_class_install_property(
@@ -1056,19 +1435,283 @@ static void gst_udpjson_meta_class_init(GstUdpJsonMetaClass *klass)
         g_param_spec_uint("cuav-port", "C-UAV Multicast Port",
                           "C-UAV protocol multicast port for EO system params (default 8013)",
                           1, 65535, DEFAULT_CUAV_MULTICAST_PORT,
-                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                        GST_PARAM_MUTABLE_PLAYING)));
     g_object_class_install_property(
         gobject_class, PROP_CUAV_CTRL_PORT,
         g_param_spec_uint("cuav-ctrl-port", "C-UAV Control Port",
                           "C-UAV protocol control/guidance multicast port (default 8003)",
                           0, 65535, DEFAULT_CUAV_CTRL_PORT,
-                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                                        GST_PARAM_MUTABLE_PLAYING)));
     g_object_class_install_property(
         gobject_class, PROP_CUAV_DEBUG,
         g_param_spec_boolean("cuav-debug", "C-UAV Debug",
-                             "Enable debug printing for C-UAV protocol messages",
+                             "Enable debug printing for C-UAV protocol messages "
+                             "(recorded to a ring and formatted off the receive thread)",
+                             FALSE,
+                             (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_CACHE_DEBUG,
+        g_param_spec_boolean("cache-debug", "Cache Debug",
+                             "Record cache update/flush debug events",
+                             FALSE,
+                             (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_DEBUG_SAMPLE,
+        g_param_spec_string("debug-sample", "Debug Sample",
+                            "Per event type sampling interval, e.g. "
+                            "\"guidance:10,eo-system:1,cache-update:100\" or \"5\" for all "
+                            "(types: guidance, eo-system, servo, other, cache-update, "
+                            "cache-flush; 0 disables a type)",
+                            NULL,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_CUAV_DROP_DUPLICATES,
+        g_param_spec_boolean("cuav-drop-duplicates", "C-UAV Drop Duplicates",
+                             "Drop C-UAV messages whose msg_sn was already seen from the same "
+                             "sender (redundant senders)",
+                             FALSE,
+                             (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_CUAV_ACCEPT_MSG_IDS,
+        g_param_spec_string("cuav-accept-msg-ids", "C-UAV Accepted Message IDs",
+                            "Comma separated msg_id accept-list checked before JSON parsing, "
+                            "e.g. \"0x7111,0x7201\" (empty = accept all)",
+                            NULL,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_CUAV_FILTER_RX,
+        g_param_spec_boolean("cuav-filter-rx", "C-UAV Filter Receiver",
+                             "Only parse C-UAV messages whose rx_sys_id/rx_dev_id match "
+                             "cuav-sys-id/cuav-dev-id or broadcast (999)",
+                             FALSE,
+                             (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_CUAV_SEND_IP,
+        g_param_spec_string("cuav-send-ip", "C-UAV Send IP",
+                            "Multicast group for outgoing C-UAV commands (empty = multicast-ip)",
+                            NULL,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_CUAV_SEND_PORT,
+        g_param_spec_uint("cuav-send-port", "C-UAV Send Port",
+                          "Port for outgoing C-UAV commands, e.g. 8003 (0 = sending disabled)",
+                          0, 65535, DEFAULT_CUAV_SEND_PORT,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_CUAV_SYS_ID,
+        g_param_spec_uint("cuav-sys-id", "C-UAV System ID",
+                          "tx_sys_id of outgoing C-UAV messages",
+                          0, G_MAXUINT16, DEFAULT_CUAV_SYS_ID,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_CUAV_DEV_TYPE,
+        g_param_spec_uint("cuav-dev-type", "C-UAV Device Type",
+                          "tx_dev_type of outgoing C-UAV messages",
+                          0, G_MAXUINT16, DEFAULT_CUAV_DEV_TYPE,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_CUAV_DEV_ID,
+        g_param_spec_uint("cuav-dev-id", "C-UAV Device ID",
+                          "tx_dev_id of outgoing C-UAV messages",
+                          0, G_MAXUINT16, DEFAULT_CUAV_DEV_ID,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_CUAV_DST_SYS_ID,
+        g_param_spec_uint("cuav-dst-sys-id", "C-UAV Destination System ID",
+                          "rx_sys_id of outgoing C-UAV messages (999 = broadcast)",
+                          0, G_MAXUINT16, DEFAULT_CUAV_SYS_ID,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_CUAV_DST_DEV_ID,
+        g_param_spec_uint("cuav-dst-dev-id", "C-UAV Destination Device ID",
+                          "rx_dev_id of outgoing C-UAV messages (999 = broadcast)",
+                          0, G_MAXUINT16, DEFAULT_CUAV_DEV_ID,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_EO_SOURCE_MAP,
+        g_param_spec_string("eo-source-map", "EO Source Map",
+                            "Comma separated tx_dev_id:source_id pairs; the latest state of "
+                            "each EO device is attached to frames of its source, e.g. \"1:0,2:1\"; "
+                            "only listed devices are tracked (at most 16)",
+                            NULL,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    /* 引导航迹融合属性 */
+    g_object_class_install_property(
+        gobject_class, PROP_FUSION_GATE,
+        g_param_spec_double("fusion-gate", "Fusion Gate(m)",
+                            "ECEF distance below which guidance tracks from different radars "
+                            "share a fused track ID (0 = fusion disabled)",
+                            0, 100000, DEFAULT_FUSION_GATE_M,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_FUSION_VELOCITY_GATE,
+        g_param_spec_double("fusion-velocity-gate", "Fusion Velocity Gate(m/s)",
+                            "Maximum ECEF velocity difference of fused tracks (0 = not checked)",
+                            0, 10000, DEFAULT_FUSION_VELOCITY_GATE,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_FUSION_SUPPRESS_DUPLICATES,
+        g_param_spec_boolean("fusion-suppress-duplicates", "Fusion Suppress Duplicates",
+                             "Only pass the primary track of each fused track to the guidance "
+                             "callback",
+                             FALSE,
+                             (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    /* 脱靶量伺服输出属性 */
+    g_object_class_install_property(
+        gobject_class, PROP_SERVO_ENABLE,
+        g_param_spec_boolean("servo-enable", "Servo Enable",
+                             "Compute per-frame miss distance and send 0x7204 servo control "
+                             "(requires cuav-send-port)",
+                             FALSE,
+                             (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_SERVO_SOURCE_ID,
+        g_param_spec_uint("servo-source-id", "Servo Source ID",
+                          "source_id of the EO camera driven by the servo output",
+                          0, G_MAXUINT, 0,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_SERVO_OBJECT_ID,
+        g_param_spec_uint64("servo-object-id", "Servo Object ID",
+                            "object_id to track (max = select by guidance tar_id association)",
+                            0, G_MAXUINT64, DEFAULT_SERVO_OBJECT_ID,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_SERVO_MAX_RATE,
+        g_param_spec_double("servo-max-rate", "Servo Max Rate",
+                            "Maximum servo command rate in Hz (0 = every frame)",
+                            0, 1000, DEFAULT_SERVO_MAX_RATE,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_SERVO_SMOOTHING,
+        g_param_spec_double("servo-smoothing", "Servo Smoothing",
+                            "Low-pass factor for miss distance (1 = no smoothing)",
+                            0.01, 1, DEFAULT_SERVO_SMOOTHING,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_SERVO_DEV_ID,
+        g_param_spec_uint("servo-dev-id", "Servo Device ID",
+                          "dev_id of 0x7204 servo control: 0=visible, 1=infrared, 2=both",
+                          0, 2, UDPJSON_SERVO_DEFAULT_DEV_ID,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_SERVO_MODE,
+        g_param_spec_uint("servo-mode", "Servo Mode",
+                          "mode_h/mode_v of 0x7204 servo control: 0=manual, 1=track",
+                          0, 1, UDPJSON_SERVO_DEFAULT_MODE,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_SERVO_LATENCY_US,
+        g_param_spec_uint64("servo-latency-us", "Servo Latency(us)",
+                            "Frame capture-to-command latency of the last servo command "
+                            "(from ntp_timestamp, else buffer PTS on the pipeline clock, else "
+                            "element entry)",
+                            0, G_MAXUINT64, 0,
+                            (GParamFlags)(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+
+    /* 动作信号：清零时延直方图，计数器保持单调递增 */
+    udpjson_signals[SIGNAL_RESET_STATS] = g_signal_new_class_handler(
+        "reset-stats", G_TYPE_FROM_CLASS(klass),
+        (GSignalFlags)(G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION),
+        G_CALLBACK(gst_udpjson_meta_reset_stats), NULL, NULL, NULL, G_TYPE_NONE, 0);
+
+    g_object_class_install_property(
+        gobject_class, PROP_STATS,
+        g_param_spec_boxed("stats", "Statistics",
+                           "Per-socket and per-stage counters and latency percentiles "
+                           "(udpjsonmeta-stats structure)",
+                           GST_TYPE_STRUCTURE,
+                           (GParamFlags)(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_STATS_INTERVAL_MS,
+        g_param_spec_uint("stats-interval-ms", "Stats Interval(ms)",
+                          "Post the stats structure as an element message on the bus at this "
+                          "interval (0 = disabled, 100 ms granularity)",
+                          0, G_MAXINT, 0,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_METRICS_ENDPOINT,
+        g_param_spec_string("metrics-endpoint", "Metrics Endpoint",
+                            "Serve Prometheus text from the receive thread on \"unix:/path\" or "
+                            "a localhost TCP port \"tcp:9464\" (applied on start)",
+                            NULL,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_TRACE_ATTACH_INTERVAL,
+        g_param_spec_uint("trace-attach-interval", "Trace Attach Interval",
+                          "Fire the attach tracepoint for every Nth attached object (0 = never)",
+                          0, G_MAXUINT, DEFAULT_TRACE_ATTACH_INTERVAL,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    /* 动作信号：把飞行记录器写入文件，参数为路径（NULL 自动命名），返回是否成功 */
+    udpjson_signals[SIGNAL_DUMP_FLIGHT_RECORDER] = g_signal_new_class_handler(
+        "dump-flight-recorder", G_TYPE_FROM_CLASS(klass),
+        (GSignalFlags)(G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION),
+        G_CALLBACK(gst_udpjson_meta_dump_flight_recorder), NULL, NULL, NULL, G_TYPE_BOOLEAN, 1,
+        G_TYPE_STRING);
+
+    g_object_class_install_property(
+        gobject_class, PROP_FLIGHT_RECORDER_SIZE,
+        g_param_spec_uint("flight-recorder-size", "Flight Recorder Size",
+                          "Number of recent ingest events kept in memory, rounded up to a "
+                          "power of two (0 = disabled, applied on start)",
+                          0, 1u << 24, DEFAULT_FLIGHT_RECORDER_SIZE,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_FLIGHT_RECORDER_DIR,
+        g_param_spec_string("flight-recorder-dir", "Flight Recorder Directory",
+                            "Directory for automatically named flight recorder dumps",
+                            DEFAULT_FLIGHT_RECORDER_DIR,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_FLIGHT_RECORDER_FAIL_RATIO,
+        g_param_spec_double("flight-recorder-fail-ratio", "Flight Recorder Fail Ratio",
+                            "Dump when more than this fraction of packets in one second fail to "
+                            "receive or parse (0 = disabled)",
+                            0, 1, 0,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_FLIGHT_RECORDER_DUMP_ON_FLUSH,
+        g_param_spec_boolean("flight-recorder-dump-on-flush", "Flight Recorder Dump On Flush",
+                             "Dump when the cache reaches max-cache-size and is flushed",
                              FALSE,
                              (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_FLIGHT_RECORDER_SIGNAL,
+        g_param_spec_int("flight-recorder-signal", "Flight Recorder Signal",
+                         "Install a process-wide handler for this signal number (e.g. 10 for "
+                         "SIGUSR1) that dumps the flight recorder; a previously installed "
+                         "handler is still called and is restored when the element is freed "
+                         "(0 = none, applied on start)",
+                         0, 64, 0,
+                         (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property(
+        gobject_class, PROP_JOURNAL_DIR,
+        g_param_spec_string("journal-dir", "Journal Directory",
+                            "Record every received datagram into rotating journal files in this "
+                            "directory (NULL = disabled, applied on start)",
+                            NULL,
+                            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_JOURNAL_FILE_SIZE,
+        g_param_spec_uint("journal-file-size", "Journal File Size",
+                          "Size in bytes of each journal file before rotation",
+                          UDPJSON_JOURNAL_MIN_FILE_SIZE, G_MAXINT, DEFAULT_JOURNAL_FILE_SIZE,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_JOURNAL_MAX_FILES,
+        g_param_spec_uint("journal-max-files", "Journal Max Files",
+                          "Number of journal files kept; the oldest is removed on rotation",
+                          1, 100000, DEFAULT_JOURNAL_MAX_FILES,
+                          (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
 }
 
 /**
@@ -1078,31 +1721,81 @@ static void gst_udpjson_meta_class_init(GstUdpJsonMetaClass *klass)
  */
 static void gst_udpjson_meta_init(GstUdpJsonMeta *self)
 {
-    self->multicast_ip = g_strdup(DEFAULT_MULTICAST_IP);
-    self->port = DEFAULT_PORT;
-    self->iface = NULL;
-    self->recv_buf_size = 0;
+    self->ingest = udpjson_ingest_new(GST_ELEMENT(self));
+    self->ingest->multicast_ip = g_strdup(DEFAULT_MULTICAST_IP);
+    self->ingest->port = DEFAULT_PORT;
+    self->ingest->iface = NULL;
+    self->ingest->endpoints = NULL;
+    self->ingest->recv_buf_size = 0;
     self->cache_ttl_ms = DEFAULT_CACHE_TTL_MS;
-    self->max_cache_size = DEFAULT_MAX_CACHE_SIZE;
+    self->ingest->max_cache_size = DEFAULT_MAX_CACHE_SIZE;
+    self->ingest->shared_json = FALSE;
+    self->ingest->demand_interval = 0;
+    self->ingest->dedup_window_ms = 0;
 
     /* C-UAV 协议解析配置 */
-    self->enable_cuav_parser = FALSE;
-    self->cuav_multicast_port = DEFAULT_CUAV_MULTICAST_PORT;
-    self->cuav_ctrl_port = DEFAULT_CUAV_CTRL_PORT;
+    self->ingest->enable_cuav_parser = FALSE;
+    self->ingest->cuav_multicast_port = DEFAULT_CUAV_MULTICAST_PORT;
+    self->ingest->cuav_ctrl_port = DEFAULT_CUAV_CTRL_PORT;
     self->cuav_debug = FALSE;
+    self->cuav_drop_duplicates = FALSE;
+    self->cuav_accept_msg_ids = NULL;
+    self->cuav_filter_rx = FALSE;
     self->cuav_parser = cuav_parser_new();
-
-    self->sockfd = -1;
-    self->cuav_sockfd = -1;
-    self->cuav_ctrl_sockfd = -1;
-    self->recv_thread = NULL;
-    self->stop_flag = 0;
-
-    g_rw_lock_init(&self->cache_lock);
-    self->cache = g_hash_table_new_full(udpjson_cache_key_hash, udpjson_cache_key_equal,
-                                        udpjson_cache_key_free, udpjson_cache_value_free);
+    self->ingest->cache_debug = FALSE;
+    self->debug_sample = NULL;
+    self->event_log = udpjson_event_log_new(UDPJSON_EVENT_LOG_DEFAULT_CAPACITY);
+    cuav_parser_set_event_log(self->cuav_parser, self->event_log);
+    self->ingest->cuav_parser = self->cuav_parser;
+    self->ingest->event_log = self->event_log;
+    self->eo_source_map = NULL;
+    for (guint i = 0; i < UDPJSON_MAX_EO_SOURCES; i++)
+        self->eo_source_slot[i] = -1;
+    self->fusion_config.gate_m = DEFAULT_FUSION_GATE_M;
+    self->fusion_config.velocity_gate_mps = DEFAULT_FUSION_VELOCITY_GATE;
+    self->fusion_config.timeout_ms = CUAV_FUSION_DEFAULT_TIMEOUT_MS;
+    self->fusion_suppress_duplicates = FALSE;
+    self->fusion = cuav_fusion_new(NULL);
+    self->ingest->stats_interval_ms = 0;
+    self->ingest->metrics_endpoint = NULL;
+    self->trace_attach_interval = DEFAULT_TRACE_ATTACH_INTERVAL;
+    self->trace_attach_count = 0;
+    self->ingest->flight_recorder_size = DEFAULT_FLIGHT_RECORDER_SIZE;
+    self->ingest->flight_recorder_dir = g_strdup(DEFAULT_FLIGHT_RECORDER_DIR);
+    self->ingest->flight_recorder_fail_ratio = 0;
+    self->ingest->flight_recorder_dump_on_flush = FALSE;
+    self->ingest->flight_recorder_signal = 0;
+    self->ingest->journal_dir = NULL;
+    self->ingest->journal_file_size = DEFAULT_JOURNAL_FILE_SIZE;
+    self->ingest->journal_max_files = DEFAULT_JOURNAL_MAX_FILES;
+
+    /* C-UAV 报文发送配置 */
+    self->cuav_send_ip = NULL;
+    self->cuav_send_port = DEFAULT_CUAV_SEND_PORT;
+    self->cuav_addressing.tx_sys_id = DEFAULT_CUAV_SYS_ID;
+    self->cuav_addressing.tx_dev_type = DEFAULT_CUAV_DEV_TYPE;
+    self->cuav_addressing.tx_dev_id = DEFAULT_CUAV_DEV_ID;
+    self->cuav_addressing.tx_subdev_id = 999;
+    self->cuav_addressing.rx_sys_id = DEFAULT_CUAV_SYS_ID;
+    self->cuav_addressing.rx_dev_type = 1;
+    self->cuav_addressing.rx_dev_id = DEFAULT_CUAV_DEV_ID;
+    self->cuav_addressing.rx_subdev_id = 999;
+    g_mutex_init(&self->cuav_sender_lock);
+    self->cuav_sender = NULL;
+
+    /* 脱靶量伺服输出配置 */
+    self->servo_enable = FALSE;
+    self->servo_source_id = 0;
+    self->servo_object_id = DEFAULT_SERVO_OBJECT_ID;
+    self->servo_max_rate = DEFAULT_SERVO_MAX_RATE;
+    self->servo_smoothing = DEFAULT_SERVO_SMOOTHING;
+    self->servo_dev_id = UDPJSON_SERVO_DEFAULT_DEV_ID;
+    self->servo_mode = UDPJSON_SERVO_DEFAULT_MODE;
+    memset(&self->servo_stage, 0, sizeof(self->servo_stage));
 
     self->meta_type = (NvDsMetaType)nvds_get_user_meta_type((gchar *)"NVDS_UDP_JSON_META");
+    self->eo_meta_type =
+        (NvDsMetaType)nvds_get_user_meta_type((gchar *)UDPJSON_EO_META_TYPE_NAME);
 
     gst_base_transform_set_in_place(GST_BASE_TRANSFORM(self), TRUE);
 }
@@ -1173,12 +1866,12 @@ void gst_udpjson_meta_enable_cuav_parser(GstUdpJsonMeta *element,
                                          guint port)
 {
     g_return_if_fail(GST_IS_UDPJSON_META(element));
-    element->enable_cuav_parser = enable;
+    element->ingest->enable_cuav_parser = enable;
     if (port > 0 && port <= 65535)
     {
-        element->cuav_multicast_port = port;
+        element->ingest->cuav_multicast_port = port;
     }
-    GST_INFO("C-UAV parser %s, port=%u", enable ? "enabled" : "disabled", element->cuav_multicast_port);
+    GST_INFO("C-UAV parser %s, port=%u", enable ? "enabled" : "disabled", element->ingest->cuav_multicast_port);
 }
 
 /**
@@ -1190,27 +1883,196 @@ void gst_udpjson_meta_enable_cuav_parser(GstUdpJsonMeta *element,
 void gst_udpjson_meta_set_cuav_debug(GstUdpJsonMeta *element, gboolean enable)
 {
     g_return_if_fail(GST_IS_UDPJSON_META(element));
+    element->cuav_debug = enable;
     if (element->cuav_parser)
     {
         cuav_parser_set_debug(element->cuav_parser, enable);
     }
+    udpjson_sync_event_log(element);
     GST_INFO("C-UAV debug %s", enable ? "enabled" : "disabled");
 }
 
 /**
- * @brief 初始化插件。
+ * @brief 获取 C-UAV 报文序号统计。
  *
- * @param plugin 插件指针。
- * @return 成功返回 TRUE。
+ * @param element GstUdpJsonMeta 元素
+ * @param stats 输出统计
  */
-static gboolean gst_udpjson_meta_plugin_init(GstPlugin *plugin)
+void gst_udpjson_meta_get_cuav_seq_stats(GstUdpJsonMeta *element, CUAVSeqStats *stats)
+{
+    g_return_if_fail(GST_IS_UDPJSON_META(element));
+    cuav_parser_get_seq_stats(element->cuav_parser, stats);
+}
+
+/**
+ * @brief 获取 C-UAV 报文头预过滤统计。
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param stats 输出统计
+ */
+void gst_udpjson_meta_get_cuav_filter_stats(GstUdpJsonMeta *element, CUAVFilterStats *stats)
+{
+    g_return_if_fail(GST_IS_UDPJSON_META(element));
+    cuav_parser_get_filter_stats(element->cuav_parser, stats);
+}
+
+/**
+ * @brief 获取映射到指定源的光电设备最新状态。
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param source_id 源ID
+ * @param state 输出设备状态
+ * @return 源已映射且收到过该设备的状态报文返回 TRUE
+ */
+gboolean gst_udpjson_meta_get_eo_state(GstUdpJsonMeta *element, guint source_id,
+                                       CUAVDeviceState *state)
+{
+    g_return_val_if_fail(GST_IS_UDPJSON_META(element), FALSE);
+    if (source_id >= UDPJSON_MAX_EO_SOURCES)
+        return FALSE;
+    return cuav_parser_read_device(element->cuav_parser,
+                                   g_atomic_int_get(&element->eo_source_slot[source_id]), state);
+}
+
+/**
+ * @brief 获取当前全部融合航迹。
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param tracks 输出数组
+ * @param max_tracks 数组容量
+ * @return 融合航迹总数
+ */
+guint gst_udpjson_meta_get_fused_tracks(GstUdpJsonMeta *element, CUAVFusedTrack *tracks,
+                                        guint max_tracks)
+{
+    g_return_val_if_fail(GST_IS_UDPJSON_META(element), 0);
+    if (element->fusion_config.gate_m <= 0)
+        return 0;
+    return cuav_fusion_snapshot(element->fusion, tracks, max_tracks);
+}
+
+/**
+ * @brief 查询雷达航迹的融合批号。
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param tx_sys_id 发送方系统号
+ * @param tx_dev_id 发送方设备编号
+ * @param tar_id 引导批号
+ * @return 融合批号
+ */
+guint32 gst_udpjson_meta_get_fused_id(GstUdpJsonMeta *element, guint16 tx_sys_id,
+                                      guint16 tx_dev_id, guint32 tar_id)
+{
+    g_return_val_if_fail(GST_IS_UDPJSON_META(element), 0);
+    if (element->fusion_config.gate_m <= 0)
+        return 0;
+    return cuav_fusion_lookup(element->fusion, tx_sys_id, tx_dev_id, tar_id);
+}
+
+/**
+ * @brief 清零时延直方图。
+ *
+ * @param element GstUdpJsonMeta 元素
+ */
+void gst_udpjson_meta_reset_stats(GstUdpJsonMeta *element)
+{
+    g_return_if_fail(GST_IS_UDPJSON_META(element));
+    udpjson_stats_reset_histograms(element->ingest->stats);
+}
+
+/**
+ * @brief 把飞行记录器写入文件。
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param path 文件路径，NULL 表示自动命名
+ * @return 写入成功返回 TRUE
+ */
+gboolean gst_udpjson_meta_dump_flight_recorder(GstUdpJsonMeta *element, const gchar *path)
+{
+    g_return_val_if_fail(GST_IS_UDPJSON_META(element), FALSE);
+    return udpjson_ingest_dump_flight_recorder(element->ingest, path, "request");
+}
+
+/**
+ * @brief 非阻塞发送光电伺服控制。
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param servo 伺服控制
+ * @return 报文已交给内核返回 TRUE
+ */
+gboolean gst_udpjson_meta_send_servo_control(GstUdpJsonMeta *element,
+                                             const CUAVServoControl *servo)
+{
+    gboolean ret = FALSE; /* 发送结果 */
+
+    g_return_val_if_fail(GST_IS_UDPJSON_META(element), FALSE);
+    g_mutex_lock(&element->cuav_sender_lock);
+    if (element->cuav_sender)
+        ret = cuav_sender_send_servo_control(element->cuav_sender, servo);
+    g_mutex_unlock(&element->cuav_sender_lock);
+    return ret;
+}
+
+/**
+ * @brief 非阻塞发送光电跟踪控制。
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param track 跟踪控制
+ * @return 报文已交给内核返回 TRUE
+ */
+gboolean gst_udpjson_meta_send_track_control(GstUdpJsonMeta *element,
+                                             const CUAVTrackControl *track)
+{
+    gboolean ret = FALSE; /* 发送结果 */
+
+    g_return_val_if_fail(GST_IS_UDPJSON_META(element), FALSE);
+    g_mutex_lock(&element->cuav_sender_lock);
+    if (element->cuav_sender)
+        ret = cuav_sender_send_track_control(element->cuav_sender, track);
+    g_mutex_unlock(&element->cuav_sender_lock);
+    return ret;
+}
+
+/**
+ * @brief 对一个批次执行 transform_ip 的处理，不经过流水线。
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param buf 带 NvDsBatchMeta 的批次缓冲区
+ * @return transform_ip 的返回值，element 无效时返回 GST_FLOW_ERROR
+ */
+GstFlowReturn gst_udpjson_meta_process_batch(GstUdpJsonMeta *element, GstBuffer *buf)
+{
+    g_return_val_if_fail(GST_IS_UDPJSON_META(element), GST_FLOW_ERROR);
+    return gst_udpjson_meta_transform_ip(GST_BASE_TRANSFORM(element), buf);
+}
+
+/**
+ * @brief 初始化调试分类，注册 udpjsonlatency 追踪器与 udpjsonmeta 元素。
+ *
+ * @param plugin 插件指针，静态注册时为 gst_plugin_register_static() 传入的插件。
+ * @return 元素注册成功返回 TRUE。
+ */
+gboolean gst_udpjson_meta_register(GstPlugin *plugin)
 {
     GST_DEBUG_CATEGORY_INIT(gst_udpjson_meta_debug, "udpjsonmeta", 0,
                             "udpjsonmeta plugin");
+    if (!udpjson_trace_register(plugin))
+        GST_WARNING("Failed to register udpjsonlatency tracer");
     return gst_element_register(plugin, "udpjsonmeta", GST_RANK_PRIMARY,
                                 GST_TYPE_UDPJSON_META);
 }
 
+/**
+ * @brief 初始化插件。
+ *
+ * @param plugin 插件指针。
+ * @return 成功返回 TRUE。
+ */
+static gboolean gst_udpjson_meta_plugin_init(GstPlugin *plugin)
+{
+    return gst_udpjson_meta_register(plugin);
+}
+
 #define PACKAGE "udpjsonmeta"
 
 GST_PLUGIN_DEFINE(GST_VERSION_MAJOR,
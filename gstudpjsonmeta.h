@@ -5,9 +5,32 @@
 #include <glib.h>
 #include "nvdsmeta.h"
 #include "gstudpjsonmeta_cuav.h"
+#include "gstudpjsonmeta_cuav_sender.h"
+#include "gstudpjsonmeta_eventlog.h"
+#include "gstudpjsonmeta_fusion.h"
+#include "gstudpjsonmeta_ingest.h"
+#include "gstudpjsonmeta_servo.h"
+#include "gstudpjsonmeta_trace.h"
 
 G_BEGIN_DECLS
 
+/* 按 source_id 映射光电设备状态的最大源数量 */
+#define UDPJSON_MAX_EO_SOURCES 64
+
+/* 光电设备状态帧元数据的用户元数据类型名 */
+#define UDPJSON_EO_META_TYPE_NAME "NVDS_UDP_JSON_EO_META"
+
+/**
+ * @brief 光电设备状态帧元数据（挂到 NvDsFrameMeta 的 frame_user_meta_list）
+ */
+typedef struct
+{
+    guint source_id;          /* 源ID */
+    CUAVDeviceState state;    /* 映射到该源的光电设备最新状态 */
+    CUAVPointingResult pointing_result; /* 指向插值结果，帧无 ntp_timestamp 时为 NONE */
+    CUAVPointingSample pointing; /* 插值到帧 ntp_timestamp 的指向与视场 */
+} UdpJsonEoFrameMeta;
+
 #define GST_TYPE_UDPJSON_META (gst_udpjson_meta_get_type())
 #define GST_UDPJSON_META(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_UDPJSON_META, GstUdpJsonMeta))
 #define GST_UDPJSON_META_CLASS(klass) (G_TYPE_CHECK_CLASS_CAST((klass), GST_TYPE_UDPJSON_META, GstUdpJsonMetaClass))
@@ -21,30 +44,45 @@ struct _GstUdpJsonMeta
 {
     GstBaseTransform parent;
 
-    gchar *multicast_ip; /* 组播地址 */
-    guint port; /* 组播端口 */
-    gchar *iface; /* 绑定网卡名 */
-    guint recv_buf_size; /* 接收缓冲区大小 */
+    UdpJsonIngest *ingest; /* 接收、解析与缓存 */
     guint cache_ttl_ms; /* 缓存有效期(毫秒) */
-    guint max_cache_size; /* 最大缓存条目数 */
 
     /* C-UAV 协议解析配置 */
-    gboolean enable_cuav_parser; /* 是否启用 C-UAV 协议解析 */
-    guint cuav_multicast_port; /* C-UAV 组播端口 */
-    guint cuav_ctrl_port; /* C-UAV 控制/引导端口 */
     gboolean cuav_debug; /* C-UAV 调试打印 */
+    gchar *debug_sample; /* 调试事件按类型采样配置 */
+    UdpJsonEventLog *event_log; /* 异步调试事件日志 */
+    gboolean cuav_drop_duplicates; /* 丢弃重复的 C-UAV 报文 */
+    gchar *cuav_accept_msg_ids; /* C-UAV 接收的 msg_id 列表，逗号分隔 */
+    gboolean cuav_filter_rx; /* 只接收发往本机 (cuav-sys-id/cuav-dev-id) 的报文 */
     CUAVParser *cuav_parser; /* C-UAV 报文解析器 */
+    gchar *eo_source_map; /* 光电设备到源的映射 "tx_dev_id:source_id,..." */
+    gint eo_source_slot[UDPJSON_MAX_EO_SOURCES]; /* 按 source_id 索引的设备状态槽位，-1 表示未映射 */
+    CUAVFusionConfig fusion_config; /* 引导航迹融合配置，gate_m 为 0 表示不融合 */
+    gboolean fusion_suppress_duplicates; /* 只转发融合批号主航迹的引导信息 */
+    CUAVFusion *fusion; /* 多雷达引导航迹融合 */
+
+    /* C-UAV 报文发送配置 */
+    gchar *cuav_send_ip; /* 发送组播地址，为空时使用 multicast-ip */
+    guint cuav_send_port; /* 发送端口，0 表示不发送 */
+    CUAVAddressing cuav_addressing; /* 发送报文的收发地址 */
+    GMutex cuav_sender_lock; /* 保护 cuav_sender 的创建与释放 */
+    CUAVSender *cuav_sender; /* C-UAV 报文发送器 */
 
-    gint sockfd; /* UDP 套接字 */
-    gint cuav_sockfd; /* C-UAV UDP 套接字 */
-    gint cuav_ctrl_sockfd; /* C-UAV 控制/引导 UDP 套接字 */
-    GThread *recv_thread; /* 接收线程 */
-    gint stop_flag; /* 停止标记 */
+    /* 脱靶量伺服输出配置 */
+    gboolean servo_enable; /* 是否按帧输出 0x7204 脱靶量 */
+    guint servo_source_id; /* 光电视频对应的 source_id */
+    guint64 servo_object_id; /* 指定跟踪的 object_id，G_MAXUINT64 表示按引导批号关联 */
+    gdouble servo_max_rate; /* 最大输出频率(Hz) */
+    gdouble servo_smoothing; /* 脱靶量平滑系数 */
+    guint servo_dev_id; /* 0x7204 控制的设备：0=可见光 1=红外 2=两者 */
+    guint servo_mode; /* 0x7204 水平/垂直控制模式：0=手动 1=跟踪 */
+    UdpJsonServoStage servo_stage; /* 伺服输出级状态 */
 
-    GRWLock cache_lock; /* 缓存读写锁 */
-    GHashTable *cache; /* 数据缓存 */
+    guint trace_attach_interval; /* 每 N 个附加的目标触发一次 attach 探针，0 表示不触发 */
+    guint trace_attach_count; /* attach 探针采样计数（流线程使用） */
 
     NvDsMetaType meta_type; /* 用户元数据类型 */
+    NvDsMetaType eo_meta_type; /* 光电设备状态帧元数据类型 */
 };
 
 struct _GstUdpJsonMetaClass
@@ -106,6 +144,121 @@ void gst_udpjson_meta_enable_cuav_parser(GstUdpJsonMeta *element,
  */
 void gst_udpjson_meta_set_cuav_debug(GstUdpJsonMeta *element, gboolean enable);
 
+/**
+ * @brief 获取 C-UAV 报文序号统计（丢失/乱序/重复）
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param stats 输出统计
+ */
+void gst_udpjson_meta_get_cuav_seq_stats(GstUdpJsonMeta *element, CUAVSeqStats *stats);
+
+/**
+ * @brief 获取 C-UAV 报文头预过滤统计
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param stats 输出统计
+ */
+void gst_udpjson_meta_get_cuav_filter_stats(GstUdpJsonMeta *element, CUAVFilterStats *stats);
+
+/**
+ * @brief 获取映射到指定源的光电设备最新状态
+ *
+ * 可在任意线程调用。
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param source_id 源ID
+ * @param state 输出设备状态
+ * @return 源已映射且收到过该设备的状态报文返回 TRUE
+ */
+gboolean gst_udpjson_meta_get_eo_state(GstUdpJsonMeta *element, guint source_id,
+                                       CUAVDeviceState *state);
+
+/**
+ * @brief 获取当前全部融合航迹
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param tracks 输出数组
+ * @param max_tracks 数组容量
+ * @return 融合航迹总数（可能大于 max_tracks），未启用融合返回 0
+ */
+guint gst_udpjson_meta_get_fused_tracks(GstUdpJsonMeta *element, CUAVFusedTrack *tracks,
+                                        guint max_tracks);
+
+/**
+ * @brief 查询雷达航迹的融合批号
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param tx_sys_id 发送方系统号
+ * @param tx_dev_id 发送方设备编号
+ * @param tar_id 引导批号
+ * @return 融合批号，未知航迹或未启用融合返回 0
+ */
+guint32 gst_udpjson_meta_get_fused_id(GstUdpJsonMeta *element, guint16 tx_sys_id,
+                                      guint16 tx_dev_id, guint32 tar_id);
+
+/**
+ * @brief 清零时延直方图（"reset-stats" 动作信号的处理函数）
+ *
+ * 计数器保持单调递增，不受影响。
+ *
+ * @param element GstUdpJsonMeta 元素
+ */
+void gst_udpjson_meta_reset_stats(GstUdpJsonMeta *element);
+
+/**
+ * @brief 把飞行记录器写入文件（"dump-flight-recorder" 动作信号的处理函数）
+ *
+ * 可在任意线程调用，不影响接收线程记录。
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param path 文件路径，NULL 表示在 flight-recorder-dir 下自动命名
+ * @return 写入成功返回 TRUE，记录器未启用或写入失败返回 FALSE
+ */
+gboolean gst_udpjson_meta_dump_flight_recorder(GstUdpJsonMeta *element, const gchar *path);
+
+/**
+ * @brief 非阻塞发送光电伺服控制 (0x7204)
+ *
+ * 可在流线程中直接调用；未配置 cuav-send-port 或元素未启动时返回 FALSE。
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param servo 伺服控制
+ * @return 报文已交给内核返回 TRUE
+ */
+gboolean gst_udpjson_meta_send_servo_control(GstUdpJsonMeta *element,
+                                             const CUAVServoControl *servo);
+
+/**
+ * @brief 非阻塞发送光电跟踪控制 (0x7203)
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param track 跟踪控制
+ * @return 报文已交给内核返回 TRUE
+ */
+gboolean gst_udpjson_meta_send_track_control(GstUdpJsonMeta *element,
+                                             const CUAVTrackControl *track);
+
+/**
+ * @brief 对一个批次执行与 transform_ip 相同的处理（不经过流水线）
+ *
+ * 供微基准与测试直接驱动元素；缓冲区须带 NvDsBatchMeta。
+ *
+ * @param element GstUdpJsonMeta 元素
+ * @param buf 批次缓冲区
+ * @return transform_ip 的返回值
+ */
+GstFlowReturn gst_udpjson_meta_process_batch(GstUdpJsonMeta *element, GstBuffer *buf);
+
+/**
+ * @brief 初始化调试分类并注册 udpjsonlatency 追踪器与 udpjsonmeta 元素
+ *
+ * 插件加载时调用；静态链接元素的程序在 gst_plugin_register_static() 的初始化函数中调用。
+ *
+ * @param plugin 插件
+ * @return 元素注册成功返回 TRUE
+ */
+gboolean gst_udpjson_meta_register(GstPlugin *plugin);
+
 G_END_DECLS
 
 #endif /* __GST_UDPJSON_META_H__ */
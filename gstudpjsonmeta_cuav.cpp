@@ -1,9 +1,112 @@
 #include "gstudpjsonmeta_cuav.h"
+#include "gstudpjsonmeta_eventlog.h"
+#include "gstudpjsonmeta_fusion.h"
+#include "gstudpjsonmeta_trace.h"
+#include <math.h>
 #include <string.h>
 #include <stdio.h>
 #include <cctype>
 #include <gst/gst.h>
 
+/* 序号乱序窗口大小（位图宽度） */
+#define CUAV_SEQ_WINDOW 64
+/* 序号跳变超过该值视为发送方重启，不计入丢失 */
+#define CUAV_SEQ_RESET_GAP 1024
+
+/**
+ * @brief 序号检查结果
+ */
+typedef enum
+{
+    CUAV_SEQ_IN_ORDER,
+    CUAV_SEQ_REORDERED,
+    CUAV_SEQ_DUPLICATE
+} CUAVSeqResult;
+
+/**
+ * @brief 字节扫描时已找到的公共报文头字段位
+ */
+typedef enum
+{
+    CUAV_HDR_MSG_ID = 1 << 0,
+    CUAV_HDR_MSG_TYPE = 1 << 1,
+    CUAV_HDR_MSG_SN = 1 << 2,
+    CUAV_HDR_TX_SYS_ID = 1 << 3,
+    CUAV_HDR_TX_DEV_TYPE = 1 << 4,
+    CUAV_HDR_TX_DEV_ID = 1 << 5,
+    CUAV_HDR_TX_SUBDEV_ID = 1 << 6,
+    CUAV_HDR_RX_SYS_ID = 1 << 7,
+    CUAV_HDR_RX_DEV_TYPE = 1 << 8,
+    CUAV_HDR_RX_DEV_ID = 1 << 9,
+    CUAV_HDR_RX_SUBDEV_ID = 1 << 10,
+    CUAV_HDR_YR = 1 << 11,
+    CUAV_HDR_MO = 1 << 12,
+    CUAV_HDR_DY = 1 << 13,
+    CUAV_HDR_H = 1 << 14,
+    CUAV_HDR_MIN = 1 << 15,
+    CUAV_HDR_SEC = 1 << 16,
+    CUAV_HDR_MSEC = 1 << 17,
+    CUAV_HDR_CONT_TYPE = 1 << 18,
+    CUAV_HDR_CONT_SUM = 1 << 19,
+    CUAV_HDR_ALL = (1 << 20) - 1,
+    CUAV_HDR_REQUIRED = CUAV_HDR_MSG_ID | CUAV_HDR_MSG_TYPE
+} CUAVHeaderFields;
+
+/**
+ * @brief 单个发送方的序号状态
+ */
+typedef struct
+{
+    guint64 sender_key;       /* 发送方标识（哈希表键） */
+    guint32 max_sn;           /* 已收到的最大序号 */
+    guint64 window;           /* 第 i 位表示 max_sn - i 已收到 */
+    guint64 missing;          /* 第 i 位表示 max_sn - i 已计为丢失 */
+} CUAVSeqState;
+
+/**
+ * @brief 指向历史环的一个槽位
+ *
+ * seq 为 2*i+1 表示正在写入第 i 个采样，2*i+2 表示第 i 个采样已写完；读取方
+ * 据此确认读到的是完整的、且正是要找的那个采样。
+ */
+typedef struct
+{
+    guint64 seq;              /* 写入序号（原子） */
+    CUAVPointingSample sample; /* 指向采样 */
+} CUAVPointingSlot;
+
+/**
+ * @brief 设备状态槽位
+ *
+ * 接收线程是唯一写入方，seq 为奇数表示正在写入，读取方据此重试。
+ * 指向历史按 history_head 递增写入，每个槽位各有写入序号。
+ */
+typedef struct
+{
+    gint seq;                 /* 写入序号（原子） */
+    CUAVDeviceState state;    /* 设备状态 */
+    guint64 history_head;     /* 已写入的指向采样数（原子） */
+    CUAVPointingSlot history[CUAV_POINTING_HISTORY]; /* 指向历史环 */
+} CUAVDeviceSlot;
+
+/**
+ * @brief 报文头预过滤配置
+ *
+ * 发布后只读；修改时复制一份改好后整体原子替换，接收线程每个报文只读取一次指针。
+ */
+typedef struct
+{
+    gboolean msg_id_enabled;           /* 是否按 msg_id 过滤 */
+    guint8 msg_id_accept[65536 / 8];   /* msg_id 位图，覆盖全部 16 位取值 */
+    gboolean rx_enabled;               /* 是否按接收方地址过滤 */
+    guint16 rx_sys_id;                 /* 本机系统号 */
+    guint16 rx_dev_id;                 /* 本机设备编号 */
+} CUAVFilterConfig;
+
+/* 类型化报文处理函数，msg 为解码后的结构体 */
+typedef void (*CUAVDispatchFunc)(CUAVParser *parser, const CUAVCommonHeader *header,
+                                 gconstpointer msg);
+
 /**
  * @brief C-UAV 报文解析器（私有结构体）
  */
@@ -18,14 +121,72 @@ struct _CUAVParser
     gpointer servo_user_data;
     CUAVRawMessageCallback raw_callback;
     gpointer raw_user_data;
+    CUAVMessageCallback message_callback;
+    gpointer message_user_data;
+    /* 按报文描述表下标分发的类型化处理函数 */
+    CUAVDispatchFunc dispatch[CUAV_MSG_INDEX_COUNT];
     /* 调试控制 */
     gboolean debug_enabled;
+    UdpJsonEventLog *event_log;
+    /* 最近一次有效引导批号（原子访问，0=无引导或已取消） */
+    gint guidance_tar_id;
+    /* 序号跟踪：状态表仅在接收线程访问，统计计数原子访问 */
+    GHashTable *seq_senders;
+    gboolean drop_duplicates;
+    CUAVSeqStats seq_stats;
+    /* 报文头预过滤：配置原子替换，NULL 表示不过滤 */
+    CUAVFilterConfig *filter;
+    GMutex filter_lock;       /* 串行化过滤设置，保护 filter_retired */
+    GList *filter_retired;    /* 已被替换的配置，接收线程下次解析时释放 */
+    CUAVFilterStats filter_stats;
+    /* 原始报文仅转发（不构建 DOM） */
+    gboolean raw_forward_only;
+    /* 引导航迹融合 */
+    CUAVFusion *fusion;
+    gboolean fusion_suppress_duplicates;
+    /* 按 tx_dev_id 的设备状态：device_index 为槽位下标+1，0 表示未分配 */
+    GMutex device_lock;       /* 仅保护槽位分配 */
+    gint n_devices;           /* 已分配槽位数（原子） */
+    guint8 device_index[65536];
+    CUAVDeviceSlot devices[CUAV_MAX_DEVICES];
 };
 
+/**
+ * @brief 原始报文（私有结构体），DOM 按需构建
+ */
+struct _CUAVRawMessage
+{
+    const gchar *data;
+    gsize len;
+    JsonParser *json_parser; /* 延迟创建，由原始报文释放 */
+    JsonObject *object;
+    gboolean parsed;
+};
+
+static void cuav_on_guidance(CUAVParser *parser, const CUAVCommonHeader *header,
+                             gconstpointer msg);
+static void cuav_on_eo_system(CUAVParser *parser, const CUAVCommonHeader *header,
+                              gconstpointer msg);
+static void cuav_on_servo_control(CUAVParser *parser, const CUAVCommonHeader *header,
+                                  gconstpointer msg);
+static void cuav_on_eo_bit(CUAVParser *parser, const CUAVCommonHeader *header,
+                           gconstpointer msg);
+static void cuav_on_target(CUAVParser *parser, const CUAVCommonHeader *header,
+                           gconstpointer msg);
+
 CUAVParser *cuav_parser_new(void)
 {
     CUAVParser *parser = (CUAVParser *)g_malloc0(sizeof(CUAVParser));
     parser->debug_enabled = FALSE;
+    parser->dispatch[CUAV_MSG_INDEX_GUIDANCE] = cuav_on_guidance;
+    parser->dispatch[CUAV_MSG_INDEX_EO_SYSTEM] = cuav_on_eo_system;
+    parser->dispatch[CUAV_MSG_INDEX_EO_SERVO] = cuav_on_servo_control;
+    parser->dispatch[CUAV_MSG_INDEX_EO_BIT] = cuav_on_eo_bit;
+    parser->dispatch[CUAV_MSG_INDEX_TARGET1] = cuav_on_target;
+    parser->dispatch[CUAV_MSG_INDEX_TARGET2] = cuav_on_target;
+    g_mutex_init(&parser->device_lock);
+    g_mutex_init(&parser->filter_lock);
+    parser->seq_senders = g_hash_table_new_full(g_int64_hash, g_int64_equal, NULL, g_free);
     return parser;
 }
 
@@ -33,6 +194,11 @@ void cuav_parser_free(CUAVParser *parser)
 {
     if (parser)
     {
+        g_hash_table_destroy(parser->seq_senders);
+        g_free(parser->filter);
+        g_list_free_full(parser->filter_retired, g_free);
+        g_mutex_clear(&parser->filter_lock);
+        g_mutex_clear(&parser->device_lock);
         g_free(parser);
     }
 }
@@ -186,315 +352,1004 @@ static gboolean cuav_parse_uint32(JsonObject *obj, const gchar *name, guint32 *o
 }
 
 /**
- * @brief 解析公共报文头
+ * @brief 解析 JSON 数组到 gint32 数组
  */
-static void cuav_parse_common_header(JsonObject *common, CUAVCommonHeader *header,
-                                     guint64 recv_ts_us)
+static void cuav_parse_int32_array(JsonObject *obj, const gchar *name, gint32 *out, guint count)
 {
-    memset(header, 0, sizeof(CUAVCommonHeader));
+    JsonNode *node = json_object_get_member(obj, name);
+    JsonArray *array = NULL;
+    guint n = 0;
+
+    if (!node || !JSON_NODE_HOLDS_ARRAY(node))
+        return;
+    array = json_node_get_array(node);
+    n = MIN(json_array_get_length(array), count);
+    for (guint i = 0; i < n; i++)
+    {
+        JsonNode *elem = json_array_get_element(array, i);
+        if (JSON_NODE_HOLDS_VALUE(elem))
+            out[i] = (gint32)json_node_get_int(elem);
+    }
+}
 
-    cuav_parse_uint16(common, "msg_id", &header->msg_id);
-    cuav_parse_uint16(common, "msg_sn", (guint16 *)&header->msg_sn);
-    cuav_parse_uint8(common, "msg_type", &header->msg_type);
-    cuav_parse_uint16(common, "tx_sys_id", &header->tx_sys_id);
-    cuav_parse_uint16(common, "tx_dev_type", &header->tx_dev_type);
-    cuav_parse_uint16(common, "tx_dev_id", &header->tx_dev_id);
-    cuav_parse_uint16(common, "tx_subdev_id", &header->tx_subdev_id);
-    cuav_parse_uint16(common, "rx_sys_id", &header->rx_sys_id);
-    cuav_parse_uint16(common, "rx_dev_type", &header->rx_dev_type);
-    cuav_parse_uint16(common, "rx_dev_id", &header->rx_dev_id);
-    cuav_parse_uint16(common, "rx_subdev_id", &header->rx_subdev_id);
-
-    cuav_parse_uint16(common, "yr", &header->yr);
-    cuav_parse_uint8(common, "mo", &header->mo);
-    cuav_parse_uint8(common, "dy", &header->dy);
-    cuav_parse_uint8(common, "h", &header->h);
-    cuav_parse_uint8(common, "min", &header->min);
-    cuav_parse_uint8(common, "sec", &header->sec);
-    cuav_parse_float(common, "msec", &header->msec);
-
-    cuav_parse_uint8(common, "cont_type", &header->cont_type);
-    cuav_parse_uint16(common, "cont_sum", &header->cont_sum);
+gboolean cuav_decode_message(const CUAVMessageDesc *desc, JsonObject *obj, gpointer msg)
+{
+    if (!desc || !msg || desc->n_fields == 0)
+        return FALSE;
 
-    header->recv_ts_us = recv_ts_us;
+    memset(msg, 0, desc->size);
+    if (!obj)
+        return TRUE;
+
+    for (guint i = 0; i < desc->n_fields; i++)
+    {
+        const CUAVFieldDesc *f = &desc->fields[i];
+        gpointer p = G_STRUCT_MEMBER_P(msg, f->offset);
+
+        switch (f->type)
+        {
+        case CUAV_FIELD_U8:
+            cuav_parse_uint8(obj, f->name, (guint8 *)p);
+            break;
+        case CUAV_FIELD_U16:
+            cuav_parse_uint16(obj, f->name, (guint16 *)p);
+            break;
+        case CUAV_FIELD_I16:
+            cuav_parse_int16(obj, f->name, (gint16 *)p);
+            break;
+        case CUAV_FIELD_U32:
+            cuav_parse_uint32(obj, f->name, (guint32 *)p);
+            break;
+        case CUAV_FIELD_I32:
+            cuav_parse_int32_array(obj, f->name, (gint32 *)p, f->count);
+            break;
+        case CUAV_FIELD_F32:
+            cuav_parse_float(obj, f->name, (gfloat *)p);
+            break;
+        case CUAV_FIELD_F64:
+            cuav_parse_double(obj, f->name, (gdouble *)p);
+            break;
+        case CUAV_FIELD_STR:
+        {
+            JsonNode *node = json_object_get_member(obj, f->name);
+            if (node && JSON_NODE_HOLDS_VALUE(node) &&
+                json_node_get_value_type(node) == G_TYPE_STRING)
+                g_strlcpy((gchar *)p, json_node_get_string(node), f->count);
+            break;
+        }
+        }
+    }
+    return TRUE;
 }
 
 /**
- * @brief 解析引导信息
+ * @brief 统计计数原子累加
  */
-static void cuav_parse_guidance(JsonObject *specific, CUAVGuidanceInfo *guidance)
+static inline void cuav_stat_add(guint64 *counter, guint64 n)
+{
+    __atomic_fetch_add(counter, n, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief 按发送方检查报文序号，统计丢失/乱序/重复
+ *
+ * 每个发送方维护最大序号和一个 64 位到达位图；缺口先计为丢失，
+ * 窗口内迟到的报文再从丢失中扣除并计为乱序。
+ */
+static CUAVSeqResult cuav_seq_check(CUAVParser *parser, const CUAVCommonHeader *header)
+{
+    guint64 key = ((guint64)header->tx_sys_id << 48) | ((guint64)header->tx_dev_type << 32) |
+                  ((guint64)header->tx_dev_id << 16) | (guint64)header->tx_subdev_id;
+    CUAVSeqState *st = (CUAVSeqState *)g_hash_table_lookup(parser->seq_senders, &key);
+    gint32 diff = 0;
+    guint32 back = 0;
+    guint64 bit = 0;
+
+    cuav_stat_add(&parser->seq_stats.received, 1);
+
+    if (!st)
+    {
+        st = (CUAVSeqState *)g_malloc0(sizeof(CUAVSeqState));
+        st->sender_key = key;
+        st->max_sn = header->msg_sn;
+        st->window = 1;
+        g_hash_table_insert(parser->seq_senders, &st->sender_key, st);
+        __atomic_store_n(&parser->seq_stats.senders, g_hash_table_size(parser->seq_senders),
+                         __ATOMIC_RELAXED);
+        return CUAV_SEQ_IN_ORDER;
+    }
+
+    diff = (gint32)(header->msg_sn - st->max_sn);
+    if (diff == 0)
+    {
+        cuav_stat_add(&parser->seq_stats.duplicates, 1);
+        return CUAV_SEQ_DUPLICATE;
+    }
+
+    if (diff >= CUAV_SEQ_RESET_GAP || diff <= -CUAV_SEQ_RESET_GAP)
+    {
+        cuav_stat_add(&parser->seq_stats.resets, 1);
+        st->max_sn = header->msg_sn;
+        st->window = 1;
+        st->missing = 0;
+        return CUAV_SEQ_IN_ORDER;
+    }
+
+    if (diff > 0)
+    {
+        if (diff > 1)
+            cuav_stat_add(&parser->seq_stats.lost, (guint64)(diff - 1));
+        /* 跳过的 max_sn+1 .. sn-1 计为丢失，即新窗口的第 1 .. diff-1 位 */
+        st->window = diff >= CUAV_SEQ_WINDOW ? 1 : (st->window << diff) | 1;
+        st->missing = diff >= CUAV_SEQ_WINDOW
+                          ? ~(guint64)1
+                          : (st->missing << diff) | (((guint64)1 << diff) - 2);
+        st->max_sn = header->msg_sn;
+        return CUAV_SEQ_IN_ORDER;
+    }
+
+    back = (guint32)(-diff);
+    if (back >= CUAV_SEQ_WINDOW)
+    {
+        /* 超出窗口，无法区分重复，按乱序计 */
+        cuav_stat_add(&parser->seq_stats.reordered, 1);
+        return CUAV_SEQ_REORDERED;
+    }
+
+    bit = (guint64)1 << back;
+    if (st->window & bit)
+    {
+        cuav_stat_add(&parser->seq_stats.duplicates, 1);
+        return CUAV_SEQ_DUPLICATE;
+    }
+
+    st->window |= bit;
+    cuav_stat_add(&parser->seq_stats.reordered, 1);
+    /* 只有此前计为丢失的序号迟到时才扣回，早于该发送方首个报文的序号不曾计入 */
+    if (st->missing & bit)
+    {
+        st->missing &= ~bit;
+        __atomic_fetch_sub(&parser->seq_stats.lost, 1, __ATOMIC_RELAXED);
+    }
+    return CUAV_SEQ_REORDERED;
+}
+
+void cuav_parser_set_drop_duplicates(CUAVParser *parser, gboolean enable)
 {
-    memset(guidance, 0, sizeof(CUAVGuidanceInfo));
+    if (parser)
+    {
+        parser->drop_duplicates = enable;
+    }
+}
 
-    cuav_parse_uint16(specific, "yr", &guidance->yr);
-    cuav_parse_uint8(specific, "mo", &guidance->mo);
-    cuav_parse_uint8(specific, "dy", &guidance->dy);
-    cuav_parse_uint8(specific, "h", &guidance->h);
-    cuav_parse_uint8(specific, "min", &guidance->min);
-    cuav_parse_uint8(specific, "sec", &guidance->sec);
-    cuav_parse_float(specific, "msec", &guidance->msec);
+void cuav_parser_get_seq_stats(CUAVParser *parser, CUAVSeqStats *stats)
+{
+    if (!stats)
+        return;
+    memset(stats, 0, sizeof(CUAVSeqStats));
+    if (!parser)
+        return;
+    stats->received = __atomic_load_n(&parser->seq_stats.received, __ATOMIC_RELAXED);
+    stats->lost = __atomic_load_n(&parser->seq_stats.lost, __ATOMIC_RELAXED);
+    stats->reordered = __atomic_load_n(&parser->seq_stats.reordered, __ATOMIC_RELAXED);
+    stats->duplicates = __atomic_load_n(&parser->seq_stats.duplicates, __ATOMIC_RELAXED);
+    stats->resets = __atomic_load_n(&parser->seq_stats.resets, __ATOMIC_RELAXED);
+    stats->senders = __atomic_load_n(&parser->seq_stats.senders, __ATOMIC_RELAXED);
+}
 
-    cuav_parse_uint32(specific, "tar_id", &guidance->tar_id);
-    cuav_parse_uint16(specific, "tar_category", &guidance->tar_category);
-    cuav_parse_uint8(specific, "guid_stat", &guidance->guid_stat);
+/**
+ * @brief 查找设备已预留的槽位（不分配）
+ *
+ * @return 槽位下标，未预留返回 -1
+ */
+static inline gint cuav_parser_find_device(CUAVParser *parser, guint16 tx_dev_id)
+{
+    return (gint)__atomic_load_n(&parser->device_index[tx_dev_id], __ATOMIC_ACQUIRE) - 1;
+}
 
-    cuav_parse_double(specific, "ecef_x", &guidance->ecef_x);
-    cuav_parse_double(specific, "ecef_y", &guidance->ecef_y);
-    cuav_parse_double(specific, "ecef_z", &guidance->ecef_z);
-    cuav_parse_double(specific, "ecef_vx", &guidance->ecef_vx);
-    cuav_parse_double(specific, "ecef_vy", &guidance->ecef_vy);
-    cuav_parse_double(specific, "ecef_vz", &guidance->ecef_vz);
+gint cuav_parser_register_device(CUAVParser *parser, guint16 tx_dev_id)
+{
+    gint slot = -1;
 
-    cuav_parse_float(specific, "h_dvi_pct", &guidance->h_dvi_pct);
-    cuav_parse_float(specific, "v_dvi_pct", &guidance->v_dvi_pct);
+    if (!parser)
+        return -1;
 
-    cuav_parse_double(specific, "enu_r", &guidance->enu_r);
-    cuav_parse_double(specific, "enu_a", &guidance->enu_a);
-    cuav_parse_double(specific, "enu_e", &guidance->enu_e);
-    cuav_parse_double(specific, "enu_v", &guidance->enu_v);
-    cuav_parse_double(specific, "enu_h", &guidance->enu_h);
+    slot = cuav_parser_find_device(parser, tx_dev_id);
+    if (slot >= 0)
+        return slot;
 
-    cuav_parse_double(specific, "lon", &guidance->lon);
-    cuav_parse_double(specific, "lat", &guidance->lat);
-    cuav_parse_double(specific, "alt", &guidance->alt);
+    g_mutex_lock(&parser->device_lock);
+    slot = (gint)parser->device_index[tx_dev_id] - 1;
+    if (slot < 0 && parser->n_devices < CUAV_MAX_DEVICES)
+    {
+        slot = parser->n_devices;
+        parser->devices[slot].state.tx_dev_id = tx_dev_id;
+        g_atomic_int_set(&parser->n_devices, slot + 1);
+        __atomic_store_n(&parser->device_index[tx_dev_id], (guint8)(slot + 1), __ATOMIC_RELEASE);
+    }
+    g_mutex_unlock(&parser->device_lock);
+    return slot;
 }
 
 /**
- * @brief 解析光电系统参数
+ * @brief 写入设备状态中的一类报文（仅接收线程调用，未预留的设备忽略）
+ *
+ * @param flag 报文类型位
+ * @param offset 报文在 CUAVDeviceState 中的偏移
+ * @param ts_offset 对应接收时间字段的偏移
  */
-static void cuav_parse_eo_system(JsonObject *specific, CUAVEOSystemParam *eo_param)
-{
-    memset(eo_param, 0, sizeof(CUAVEOSystemParam));
-
-    cuav_parse_uint8(specific, "sv_stat", &eo_param->sv_stat);
-    cuav_parse_uint16(specific, "sv_err", &eo_param->sv_err);
-    cuav_parse_uint8(specific, "st_mode_h", &eo_param->st_mode_h);
-    cuav_parse_uint8(specific, "st_mode_v", &eo_param->st_mode_v);
-    cuav_parse_float(specific, "st_loc_h", &eo_param->st_loc_h);
-    cuav_parse_float(specific, "st_loc_v", &eo_param->st_loc_v);
-
-    cuav_parse_uint8(specific, "pt_stat", &eo_param->pt_stat);
-    cuav_parse_uint16(specific, "pt_err", &eo_param->pt_err);
-    cuav_parse_float(specific, "pt_focal", &eo_param->pt_focal);
-    cuav_parse_uint16(specific, "pt_focus", &eo_param->pt_focus);
-    cuav_parse_float(specific, "pt_fov_h", &eo_param->pt_fov_h);
-    cuav_parse_float(specific, "pt_fov_v", &eo_param->pt_fov_v);
-
-    cuav_parse_uint8(specific, "ir_stat", &eo_param->ir_stat);
-    cuav_parse_uint16(specific, "ir_err", &eo_param->ir_err);
-    cuav_parse_float(specific, "ir_focal", &eo_param->ir_focal);
-    cuav_parse_uint16(specific, "ir_focus", &eo_param->ir_focus);
-    cuav_parse_float(specific, "ir_fov_h", &eo_param->ir_fov_h);
-    cuav_parse_float(specific, "ir_fov_v", &eo_param->ir_fov_v);
-
-    cuav_parse_uint8(specific, "dm_stat", &eo_param->dm_stat);
-    cuav_parse_uint16(specific, "dm_err", &eo_param->dm_err);
-    cuav_parse_uint8(specific, "dm_dev", &eo_param->dm_dev);
-
-    cuav_parse_uint8(specific, "trk_dev", &eo_param->trk_dev);
-    cuav_parse_uint8(specific, "pt_trk_link", &eo_param->pt_trk_link);
-    cuav_parse_uint8(specific, "ir_trk_link", &eo_param->ir_trk_link);
-    cuav_parse_uint8(specific, "trk_str", &eo_param->trk_str);
-    cuav_parse_uint8(specific, "trk_mod", &eo_param->trk_mod);
-    cuav_parse_uint8(specific, "det_trk", &eo_param->det_trk);
-    cuav_parse_uint8(specific, "trk_stat", &eo_param->trk_stat);
-    cuav_parse_uint8(specific, "pt_zoom", &eo_param->pt_zoom);
-    cuav_parse_uint8(specific, "ir_zoom", &eo_param->ir_zoom);
-    cuav_parse_uint8(specific, "pt_focus_mode", &eo_param->pt_focus_mode);
-    cuav_parse_uint8(specific, "ir_focus_mode", &eo_param->ir_focus_mode);
+static void cuav_device_store(CUAVParser *parser, const CUAVCommonHeader *header, guint32 flag,
+                              gsize offset, gsize ts_offset, gconstpointer msg, gsize size)
+{
+    gint slot = cuav_parser_find_device(parser, header->tx_dev_id);
+    CUAVDeviceSlot *dev = NULL;
+
+    if (slot < 0)
+        return;
+
+    dev = &parser->devices[slot];
+    g_atomic_int_inc(&dev->seq);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    dev->state.tx_sys_id = header->tx_sys_id;
+    dev->state.flags |= flag;
+    memcpy(G_STRUCT_MEMBER_P(&dev->state, offset), msg, size);
+    G_STRUCT_MEMBER(guint64, &dev->state, ts_offset) = header->recv_ts_us;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    g_atomic_int_inc(&dev->seq);
 }
 
 /**
- * @brief 解析光电伺服控制
+ * @brief 追加一个指向采样（仅接收线程调用，未预留的设备忽略）
  */
-static void cuav_parse_servo_control(JsonObject *specific, CUAVServoControl *servo)
-{
-    memset(servo, 0, sizeof(CUAVServoControl));
-
-    cuav_parse_uint8(specific, "dev_id", &servo->dev_id);
-    cuav_parse_uint8(specific, "dev_en", &servo->dev_en);
-    cuav_parse_uint8(specific, "ctrl_en", &servo->ctrl_en);
-    cuav_parse_uint8(specific, "mode_h", &servo->mode_h);
-    cuav_parse_uint8(specific, "mode_v", &servo->mode_v);
-    cuav_parse_uint8(specific, "speed_en_h", &servo->speed_en_h);
-    cuav_parse_uint8(specific, "speed_h", &servo->speed_h);
-    cuav_parse_uint8(specific, "speed_en_v", &servo->speed_en_v);
-    cuav_parse_uint8(specific, "speed_v", &servo->speed_v);
-    cuav_parse_uint8(specific, "loc_en_h", &servo->loc_en_h);
-    cuav_parse_float(specific, "loc_h", &servo->loc_h);
-    cuav_parse_uint8(specific, "loc_en_v", &servo->loc_en_v);
-    cuav_parse_float(specific, "loc_v", &servo->loc_v);
-    cuav_parse_uint8(specific, "offset_en", &servo->offset_en);
-    cuav_parse_int16(specific, "offset_h", &servo->offset_h);
-    cuav_parse_int16(specific, "offset_v", &servo->offset_v);
+static void cuav_pointing_store(CUAVParser *parser, const CUAVCommonHeader *header,
+                                const CUAVEOSystemParam *eo_param)
+{
+    gint slot = cuav_parser_find_device(parser, header->tx_dev_id);
+    CUAVDeviceSlot *dev = NULL;
+    CUAVPointingSlot *ps = NULL;
+    guint64 head = 0;
+    gint64 ts_ns = (gint64)header->recv_ts_us * 1000;
+
+    if (slot < 0)
+        return;
+
+    dev = &parser->devices[slot];
+    head = __atomic_load_n(&dev->history_head, __ATOMIC_RELAXED);
+    /* 二分查找要求时间随下标单调，接收时间是单调时钟，回退的采样直接丢弃 */
+    if (head > 0 &&
+        dev->history[(head - 1) & (CUAV_POINTING_HISTORY - 1)].sample.ts_ns > ts_ns)
+        return;
+
+    ps = &dev->history[head & (CUAV_POINTING_HISTORY - 1)];
+    __atomic_store_n(&ps->seq, 2 * head + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&ps->sample.ts_ns, ts_ns, __ATOMIC_RELAXED);
+    ps->sample.loc_h = eo_param->st_loc_h;
+    ps->sample.loc_v = eo_param->st_loc_v;
+    ps->sample.pt_fov_h = eo_param->pt_fov_h;
+    ps->sample.pt_fov_v = eo_param->pt_fov_v;
+    ps->sample.ir_fov_h = eo_param->ir_fov_h;
+    ps->sample.ir_fov_v = eo_param->ir_fov_v;
+    __atomic_store_n(&ps->seq, 2 * head + 2, __ATOMIC_RELEASE);
+    __atomic_store_n(&dev->history_head, head + 1, __ATOMIC_RELEASE);
 }
 
 /**
- * @brief 判断对象是否包含 C-UAV 公共报文头字段。
+ * @brief 读取第 index 个指向采样（可在任意线程调用）
+ *
+ * @return 槽位中是完整写入的第 index 个采样时返回 TRUE，已被覆盖或正在写入返回 FALSE
  */
-static gboolean cuav_has_common_header(JsonObject *obj)
+static gboolean cuav_pointing_load(const CUAVDeviceSlot *dev, guint64 index,
+                                   CUAVPointingSample *out)
 {
-    if (!obj)
-        return FALSE;
+    const CUAVPointingSlot *ps = &dev->history[index & (CUAV_POINTING_HISTORY - 1)];
+    guint64 seq = __atomic_load_n(&ps->seq, __ATOMIC_ACQUIRE);
 
-    return json_object_has_member(obj, "msg_id") &&
-           json_object_has_member(obj, "msg_type");
+    if (seq != 2 * index + 2)
+        return FALSE;
+    memcpy(out, &ps->sample, sizeof(CUAVPointingSample));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&ps->seq, __ATOMIC_RELAXED) == seq;
 }
 
-gboolean cuav_parser_parse(CUAVParser *parser, const gchar *data, gssize len)
+/**
+ * @brief 两个指向之间的球面线性插值
+ *
+ * @param t 插值系数 [0,1]
+ */
+static void cuav_pointing_slerp(const CUAVPointingSample *a, const CUAVPointingSample *b,
+                                gdouble t, CUAVPointingSample *out)
 {
-    JsonParser *json_parser = NULL;
-    JsonNode *root = NULL;
-    JsonObject *root_obj = NULL;
-    JsonObject *common = NULL;
-    JsonObject *specific = NULL;
-    guint16 msg_id = 0;
-    guint64 recv_ts_us = 0;
-    CUAVCommonHeader header;
-    gboolean result = FALSE;
+    const gdouble d2r = G_PI / 180.0;
+    gdouble va[3];
+    gdouble vb[3];
+    gdouble v[3];
+    gdouble dot = 0;
+    gdouble omega = 0;
+    gdouble wa = 1.0 - t;
+    gdouble wb = t;
+    gdouble az = 0;
+
+    /* 方位角从北向顺时针，俯仰角向上为正 */
+    va[0] = cos(a->loc_v * d2r) * sin(a->loc_h * d2r);
+    va[1] = cos(a->loc_v * d2r) * cos(a->loc_h * d2r);
+    va[2] = sin(a->loc_v * d2r);
+    vb[0] = cos(b->loc_v * d2r) * sin(b->loc_h * d2r);
+    vb[1] = cos(b->loc_v * d2r) * cos(b->loc_h * d2r);
+    vb[2] = sin(b->loc_v * d2r);
+
+    dot = CLAMP(va[0] * vb[0] + va[1] * vb[1] + va[2] * vb[2], -1.0, 1.0);
+    omega = acos(dot);
+    if (omega > 1e-6)
+    {
+        wa = sin((1.0 - t) * omega) / sin(omega);
+        wb = sin(t * omega) / sin(omega);
+    }
+    for (guint i = 0; i < 3; i++)
+        v[i] = wa * va[i] + wb * vb[i];
+
+    az = atan2(v[0], v[1]) / d2r;
+    if (az < 0)
+        az += 360.0;
+    out->loc_h = (gfloat)az;
+    out->loc_v = (gfloat)(atan2(v[2], sqrt(v[0] * v[0] + v[1] * v[1])) / d2r);
+    out->pt_fov_h = (gfloat)(a->pt_fov_h + (b->pt_fov_h - a->pt_fov_h) * t);
+    out->pt_fov_v = (gfloat)(a->pt_fov_v + (b->pt_fov_v - a->pt_fov_v) * t);
+    out->ir_fov_h = (gfloat)(a->ir_fov_h + (b->ir_fov_h - a->ir_fov_h) * t);
+    out->ir_fov_v = (gfloat)(a->ir_fov_v + (b->ir_fov_v - a->ir_fov_v) * t);
+}
 
-    if (!parser || !data || len <= 0)
-        return FALSE;
+CUAVPointingResult cuav_parser_interpolate_pointing(CUAVParser *parser, gint slot, gint64 ts_ns,
+                                                    CUAVPointingSample *out)
+{
+    CUAVDeviceSlot *dev = NULL;
+    CUAVPointingSample a;
+    CUAVPointingSample b;
+    gboolean has_next = FALSE;
 
-    recv_ts_us = (guint64)g_get_monotonic_time();
+    if (!parser || !out || slot < 0 || slot >= g_atomic_int_get(&parser->n_devices))
+        return CUAV_POINTING_NONE;
 
-    json_parser = json_parser_new();
-    if (!json_parser_load_from_data(json_parser, data, len, NULL))
+    dev = &parser->devices[slot];
+    for (;;)
     {
-        if (parser->debug_enabled)
+        guint64 head = __atomic_load_n(&dev->history_head, __ATOMIC_ACQUIRE);
+        guint64 oldest = head - MIN(head, (guint64)CUAV_POINTING_HISTORY);
+        guint64 lo = oldest;
+        guint64 hi = head;
+
+        if (head == 0)
+            return CUAV_POINTING_NONE;
+
+        /* 查找最后一个 ts <= ts_ns 的采样 */
+        while (hi - lo > 1)
         {
-            GST_WARNING("[CUAV] Failed to parse JSON");
+            guint64 mid = lo + (hi - lo) / 2;
+            if (__atomic_load_n(&dev->history[mid & (CUAV_POINTING_HISTORY - 1)].sample.ts_ns,
+                                __ATOMIC_RELAXED) <= ts_ns)
+                lo = mid;
+            else
+                hi = mid;
         }
-        goto cleanup;
+
+        has_next = lo + 1 < head;
+        if (!cuav_pointing_load(dev, lo, &a) || (has_next && !cuav_pointing_load(dev, lo + 1, &b)))
+            continue;
+        /* 查找途中读到的时间可能来自刚被覆盖的槽位，用完整读出的两端确认区间 */
+        if ((lo != oldest && a.ts_ns > ts_ns) || (has_next && b.ts_ns <= ts_ns))
+            continue;
+        break;
     }
 
-    root = json_parser_get_root(json_parser);
-    if (!root || !JSON_NODE_HOLDS_OBJECT(root))
+    /* 早于最旧采样或晚于最新采样时取端点 */
+    if (ts_ns <= a.ts_ns || !has_next || b.ts_ns <= a.ts_ns)
     {
-        GST_WARNING("Root is not a JSON object");
-        goto cleanup;
+        *out = a;
+        out->ts_ns = ts_ns;
+        return ts_ns == a.ts_ns ? CUAV_POINTING_INTERPOLATED : CUAV_POINTING_CLAMPED;
     }
 
-    root_obj = json_node_get_object(root);
+    cuav_pointing_slerp(&a, &b, (gdouble)(ts_ns - a.ts_ns) / (gdouble)(b.ts_ns - a.ts_ns), out);
+    out->ts_ns = ts_ns;
+    return CUAV_POINTING_INTERPOLATED;
+}
+
+gboolean cuav_parser_read_device(CUAVParser *parser, gint slot, CUAVDeviceState *state)
+{
+    CUAVDeviceSlot *dev = NULL;
+    gint seq = 0;
+
+    if (!parser || !state || slot < 0 || slot >= g_atomic_int_get(&parser->n_devices))
+        return FALSE;
 
-    if (cuav_has_common_header(root_obj))
+    dev = &parser->devices[slot];
+    for (;;)
     {
-        common = root_obj;
+        seq = g_atomic_int_get(&dev->seq);
+        if (seq & 1)
+            continue;
+        memcpy(state, &dev->state, sizeof(CUAVDeviceState));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (g_atomic_int_get(&dev->seq) == seq)
+            break;
     }
+    return state->flags != 0;
+}
 
-    if (!common)
+gboolean cuav_parser_get_device_state(CUAVParser *parser, guint16 tx_dev_id,
+                                      CUAVDeviceState *state)
+{
+    if (!parser)
+        return FALSE;
+    return cuav_parser_read_device(parser, cuav_parser_find_device(parser, tx_dev_id), state);
+}
+
+/**
+ * @brief 报文头预过滤：按字节扫描得到的报文头判断报文是否需要进一步处理
+ *
+ * @param filter 本报文使用的过滤配置，NULL 表示不过滤
+ * @param found 扫描到的报文头字段 CUAVHeaderFields
+ */
+static gboolean cuav_prefilter(CUAVParser *parser, const CUAVFilterConfig *filter,
+                               const CUAVCommonHeader *header, guint found)
+{
+    if (!filter)
+        return TRUE;
+
+    if (filter->msg_id_enabled &&
+        !(filter->msg_id_accept[header->msg_id >> 3] & (1u << (header->msg_id & 7))))
     {
-        GST_WARNING("No common header found");
-        goto cleanup;
+        cuav_stat_add(&parser->filter_stats.rejected_msg_id, 1);
+        return FALSE;
     }
 
-    /* 解析公共报文头 */
-    cuav_parse_common_header(common, &header, recv_ts_us);
-    msg_id = header.msg_id;
+    if (filter->rx_enabled)
+    {
+        if ((found & CUAV_HDR_RX_SYS_ID) && header->rx_sys_id != filter->rx_sys_id &&
+            header->rx_sys_id != CUAV_BROADCAST_ID)
+        {
+            cuav_stat_add(&parser->filter_stats.rejected_rx_sys, 1);
+            return FALSE;
+        }
+        if ((found & CUAV_HDR_RX_DEV_ID) && header->rx_dev_id != filter->rx_dev_id &&
+            header->rx_dev_id != CUAV_BROADCAST_ID)
+        {
+            cuav_stat_add(&parser->filter_stats.rejected_rx_dev, 1);
+            return FALSE;
+        }
+    }
+
+    cuav_stat_add(&parser->filter_stats.passed, 1);
+    return TRUE;
+}
+
+/**
+ * @brief 复制当前过滤配置供修改（持有 filter_lock 时调用）
+ */
+static CUAVFilterConfig *cuav_filter_config_copy(CUAVParser *parser)
+{
+    CUAVFilterConfig *next = g_new0(CUAVFilterConfig, 1);
+
+    if (parser->filter)
+        memcpy(next, parser->filter, sizeof(CUAVFilterConfig));
+    return next;
+}
 
-    /* 真实设备当前使用扁平 JSON：公共头和具体信息都在根对象。 */
-    specific = root_obj;
+/**
+ * @brief 原子替换过滤配置（持有 filter_lock 时调用）
+ *
+ * 接收线程可能仍在使用旧配置，旧配置留到接收线程下次解析时释放。
+ *
+ * @param next 新配置，不过滤任何报文时释放并发布 NULL
+ */
+static void cuav_filter_config_publish(CUAVParser *parser, CUAVFilterConfig *next)
+{
+    CUAVFilterConfig *old = parser->filter;
 
-    if (!specific)
+    if (!next->msg_id_enabled && !next->rx_enabled)
     {
-        GST_WARNING("No specific info found for msg_id=0x%04X", msg_id);
-        goto cleanup;
+        g_free(next);
+        next = NULL;
     }
+    g_atomic_pointer_set(&parser->filter, next);
+    if (old)
+        g_atomic_pointer_set(&parser->filter_retired, g_list_prepend(parser->filter_retired, old));
+}
 
-    /* 根据 msg_id 分发处理 */
-    switch (msg_id)
+/**
+ * @brief 释放已被替换的过滤配置（接收线程在解析报文前调用）
+ *
+ * 解析只在接收线程进行，进入本次解析时上一个报文已处理完，替换前读到旧配置的
+ * 解析都已结束。
+ */
+static void cuav_filter_config_reclaim(CUAVParser *parser)
+{
+    GList *retired = NULL;
+
+    if (!g_atomic_pointer_get(&parser->filter_retired))
+        return;
+    g_mutex_lock(&parser->filter_lock);
+    retired = parser->filter_retired;
+    g_atomic_pointer_set(&parser->filter_retired, NULL);
+    g_mutex_unlock(&parser->filter_lock);
+    g_list_free_full(retired, g_free);
+}
+
+void cuav_parser_set_msg_id_filter(CUAVParser *parser, const guint16 *msg_ids, guint n_ids)
+{
+    CUAVFilterConfig *next = NULL;
+
+    if (!parser)
+        return;
+
+    g_mutex_lock(&parser->filter_lock);
+    next = cuav_filter_config_copy(parser);
+    memset(next->msg_id_accept, 0, sizeof(next->msg_id_accept));
+    next->msg_id_enabled = msg_ids && n_ids > 0;
+    for (guint i = 0; next->msg_id_enabled && i < n_ids; i++)
     {
-    case CUAV_MSG_ID_GUIDANCE:
+        next->msg_id_accept[msg_ids[i] >> 3] |= (guint8)(1u << (msg_ids[i] & 7));
+    }
+    cuav_filter_config_publish(parser, next);
+    g_mutex_unlock(&parser->filter_lock);
+}
+
+void cuav_parser_set_rx_filter(CUAVParser *parser, gboolean enable, guint16 sys_id,
+                               guint16 dev_id)
+{
+    CUAVFilterConfig *next = NULL;
+
+    if (!parser)
+        return;
+
+    g_mutex_lock(&parser->filter_lock);
+    next = cuav_filter_config_copy(parser);
+    next->rx_sys_id = sys_id;
+    next->rx_dev_id = dev_id;
+    next->rx_enabled = enable;
+    cuav_filter_config_publish(parser, next);
+    g_mutex_unlock(&parser->filter_lock);
+}
+
+void cuav_parser_get_filter_stats(CUAVParser *parser, CUAVFilterStats *stats)
+{
+    if (!stats)
+        return;
+    memset(stats, 0, sizeof(CUAVFilterStats));
+    if (!parser)
+        return;
+    stats->passed = __atomic_load_n(&parser->filter_stats.passed, __ATOMIC_RELAXED);
+    stats->rejected_msg_id = __atomic_load_n(&parser->filter_stats.rejected_msg_id, __ATOMIC_RELAXED);
+    stats->rejected_rx_sys = __atomic_load_n(&parser->filter_stats.rejected_rx_sys, __ATOMIC_RELAXED);
+    stats->rejected_rx_dev = __atomic_load_n(&parser->filter_stats.rejected_rx_dev, __ATOMIC_RELAXED);
+    stats->rejected_no_header =
+        __atomic_load_n(&parser->filter_stats.rejected_no_header, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief 把扫描到的一个顶层字段写入报文头
+ *
+ * 数值可带引号；负数按 0 处理，与 DOM 解析一致。
+ *
+ * @param found 已找到的字段 CUAVHeaderFields，命中时置位
+ */
+static void cuav_scan_header_field(CUAVCommonHeader *header, const gchar *key, gsize key_len,
+                                   const gchar *val, const gchar *end, guint *found)
+{
+#define CUAV_KEY_IS(name) (key_len == sizeof(name) - 1 && memcmp(key, name, key_len) == 0)
+#define CUAV_HDR_FIELD(name, field, type, bit) \
+    if (CUAV_KEY_IS(name))                      \
+    {                                           \
+        header->field = (type)v;                \
+        *found |= (bit);                        \
+        return;                                 \
+    }
+    gchar num[32];
+    gsize n = 0;
+    guint64 v = 0;
+
+    while (val < end && n < sizeof(num) - 1 &&
+           (g_ascii_isdigit(*val) || *val == '.' || *val == '-' || *val == '+' ||
+            *val == 'e' || *val == 'E'))
+        num[n++] = *val++;
+    num[n] = '\0';
+    if (n == 0)
+        return;
+
+    if (CUAV_KEY_IS("msec"))
     {
-        CUAVGuidanceInfo guidance;
-        cuav_parse_guidance(specific, &guidance);
+        header->msec = (gfloat)g_ascii_strtod(num, NULL);
+        *found |= CUAV_HDR_MSEC;
+        return;
+    }
+
+    if (num[0] != '-')
+        v = g_ascii_strtoull(num, NULL, 10);
+    CUAV_HDR_FIELD("msg_id", msg_id, guint16, CUAV_HDR_MSG_ID)
+    CUAV_HDR_FIELD("msg_type", msg_type, guint8, CUAV_HDR_MSG_TYPE)
+    CUAV_HDR_FIELD("msg_sn", msg_sn, guint32, CUAV_HDR_MSG_SN)
+    CUAV_HDR_FIELD("tx_sys_id", tx_sys_id, guint16, CUAV_HDR_TX_SYS_ID)
+    CUAV_HDR_FIELD("tx_dev_type", tx_dev_type, guint16, CUAV_HDR_TX_DEV_TYPE)
+    CUAV_HDR_FIELD("tx_dev_id", tx_dev_id, guint16, CUAV_HDR_TX_DEV_ID)
+    CUAV_HDR_FIELD("tx_subdev_id", tx_subdev_id, guint16, CUAV_HDR_TX_SUBDEV_ID)
+    CUAV_HDR_FIELD("rx_sys_id", rx_sys_id, guint16, CUAV_HDR_RX_SYS_ID)
+    CUAV_HDR_FIELD("rx_dev_type", rx_dev_type, guint16, CUAV_HDR_RX_DEV_TYPE)
+    CUAV_HDR_FIELD("rx_dev_id", rx_dev_id, guint16, CUAV_HDR_RX_DEV_ID)
+    CUAV_HDR_FIELD("rx_subdev_id", rx_subdev_id, guint16, CUAV_HDR_RX_SUBDEV_ID)
+    CUAV_HDR_FIELD("yr", yr, guint16, CUAV_HDR_YR)
+    CUAV_HDR_FIELD("mo", mo, guint8, CUAV_HDR_MO)
+    CUAV_HDR_FIELD("dy", dy, guint8, CUAV_HDR_DY)
+    CUAV_HDR_FIELD("h", h, guint8, CUAV_HDR_H)
+    CUAV_HDR_FIELD("min", min, guint8, CUAV_HDR_MIN)
+    CUAV_HDR_FIELD("sec", sec, guint8, CUAV_HDR_SEC)
+    CUAV_HDR_FIELD("cont_type", cont_type, guint8, CUAV_HDR_CONT_TYPE)
+    CUAV_HDR_FIELD("cont_sum", cont_sum, guint16, CUAV_HDR_CONT_SUM)
+#undef CUAV_HDR_FIELD
+#undef CUAV_KEY_IS
+}
+
+/**
+ * @brief 单遍扫描根对象的直接成员，解析公共报文头（不构建 DOM）
+ *
+ * 按深度跟踪对象/数组并跳过字符串内容，嵌套对象、数组和字符串中的同名键
+ * 不会被当作报文头；报文头字段全部找到后即停止，不再扫描具体信息。
+ *
+ * @return 找到的字段 CUAVHeaderFields，含 CUAV_HDR_REQUIRED 时报文头有效
+ */
+static guint cuav_scan_common_header(const gchar *data, gsize len, CUAVCommonHeader *header,
+                                     guint64 recv_ts_us)
+{
+    const gchar *p = data;
+    const gchar *end = data + len;
+    gint depth = 0;
+    guint found = 0;
 
-        /* 调试打印 */
-        if (parser->debug_enabled)
+    memset(header, 0, sizeof(CUAVCommonHeader));
+    header->recv_ts_us = recv_ts_us;
+
+    while (p < end && found != CUAV_HDR_ALL)
+    {
+        gchar c = *p++;
+        if (c == '{' || c == '[')
         {
-            cuav_print_guidance(&guidance);
+            depth++;
         }
-
-        if (parser->guidance_callback)
+        else if (c == '}' || c == ']')
         {
-            parser->guidance_callback(&header, &guidance, parser->guidance_user_data);
+            if (--depth <= 0)
+                break;
         }
-        if (parser->raw_callback)
+        else if (c == '"')
         {
-            parser->raw_callback(&header, specific, parser->raw_user_data);
+            const gchar *key = p;
+            while (p < end && *p != '"')
+            {
+                if (*p == '\\' && p + 1 < end)
+                    p++;
+                p++;
+            }
+            if (p >= end)
+                break;
+            gsize key_len = (gsize)(p - key);
+            p++;
+
+            if (depth != 1)
+                continue;
+            const gchar *q = p;
+            while (q < end && g_ascii_isspace(*q))
+                q++;
+            if (q >= end || *q != ':')
+                continue;
+            q++;
+            while (q < end && g_ascii_isspace(*q))
+                q++;
+            if (q < end && *q == '"')
+                q++;
+            cuav_scan_header_field(header, key, key_len, q, end, &found);
         }
-        GST_DEBUG("Parsed GUIDANCE: tar_id=%u, guid_stat=%u, enu_a=%.2f, enu_e=%.2f",
-                  guidance.tar_id, guidance.guid_stat, guidance.enu_a, guidance.enu_e);
-        result = TRUE;
+    }
+
+    return found;
+}
+
+const gchar *cuav_raw_message_get_data(const CUAVRawMessage *msg, gsize *len)
+{
+    if (!msg)
+    {
+        if (len)
+            *len = 0;
+        return NULL;
+    }
+    if (len)
+        *len = msg->len;
+    return msg->data;
+}
+
+JsonObject *cuav_raw_message_get_object(CUAVRawMessage *msg)
+{
+    JsonNode *root = NULL;
+
+    if (!msg)
+        return NULL;
+    if (msg->parsed)
+        return msg->object;
+
+    msg->parsed = TRUE;
+    msg->json_parser = json_parser_new();
+    if (!json_parser_load_from_data(msg->json_parser, msg->data, (gssize)msg->len, NULL))
+        return NULL;
+
+    root = json_parser_get_root(msg->json_parser);
+    if (root && JSON_NODE_HOLDS_OBJECT(root))
+        msg->object = json_node_get_object(root);
+    return msg->object;
+}
+
+/**
+ * @brief 申请一条调试事件记录并填好报文头字段
+ *
+ * @return 未设置事件日志或被采样跳过时返回 NULL
+ */
+static UdpJsonEventRecord *cuav_debug_reserve(CUAVParser *parser, UdpJsonEventKind kind,
+                                              const CUAVCommonHeader *header)
+{
+    UdpJsonEventRecord *rec = udpjson_event_log_reserve(parser->event_log, kind);
+    if (rec)
+    {
+        rec->msg_id = header->msg_id;
+        rec->msg_sn = header->msg_sn;
+    }
+    return rec;
+}
+
+/**
+ * @brief 记录或打印一条解码后的报文（cuav-debug）
+ *
+ * @param desc 报文描述，未知报文为 NULL
+ * @param msg 解码后的结构体，仅报文头时为 NULL
+ */
+static void cuav_debug_message(CUAVParser *parser, const CUAVCommonHeader *header,
+                               const CUAVMessageDesc *desc, const CUAVMessageUnion *msg)
+{
+    UdpJsonEventKind kind = UDPJSON_EVENT_CUAV_OTHER;
+    UdpJsonEventRecord *rec = NULL;
+
+    if (!parser->debug_enabled)
+        return;
+
+    if (desc && msg)
+    {
+        if (desc->index == CUAV_MSG_INDEX_GUIDANCE)
+            kind = UDPJSON_EVENT_CUAV_GUIDANCE;
+        else if (desc->index == CUAV_MSG_INDEX_EO_SYSTEM)
+            kind = UDPJSON_EVENT_CUAV_EO_SYSTEM;
+        else if (desc->index == CUAV_MSG_INDEX_EO_SERVO)
+            kind = UDPJSON_EVENT_CUAV_SERVO;
+    }
+
+    rec = cuav_debug_reserve(parser, kind, header);
+    if (rec)
+    {
+        if (msg)
+            memcpy(&rec->u.msg, msg, desc->size);
+        udpjson_event_log_commit(parser->event_log, rec);
+        return;
+    }
+    if (parser->event_log)
+        return; /* 被采样跳过 */
+
+    switch (kind)
+    {
+    case UDPJSON_EVENT_CUAV_GUIDANCE:
+        cuav_print_guidance(&msg->guidance);
+        break;
+    case UDPJSON_EVENT_CUAV_EO_SYSTEM:
+        cuav_print_eo_system(&msg->eo_system);
+        break;
+    case UDPJSON_EVENT_CUAV_SERVO:
+        cuav_print_servo_control(&msg->eo_servo);
+        break;
+    default:
+        if (desc && msg)
+            cuav_print_message(desc, msg);
+        else
+            GST_INFO("[CUAV] 未处理报文: msg_id=0x%04X", header->msg_id);
         break;
     }
-    case CUAV_MSG_ID_EO_SYSTEM:
+}
+
+static void cuav_on_guidance(CUAVParser *parser, const CUAVCommonHeader *header,
+                             gconstpointer msg)
+{
+    const CUAVGuidanceInfo *guidance = (const CUAVGuidanceInfo *)msg;
+    CUAVFusion *fusion = (CUAVFusion *)g_atomic_pointer_get(&parser->fusion);
+    gboolean primary = TRUE;
+
+    g_atomic_int_set(&parser->guidance_tar_id,
+                     guidance->guid_stat == 0 ? 0 : (gint)guidance->tar_id);
+    if (fusion)
+    {
+        guint32 fused_id = cuav_fusion_update(fusion, header, guidance, &primary);
+        GST_LOG("Fused tx_dev_id=%u tar_id=%u -> fused_id=%u primary=%d", header->tx_dev_id,
+                guidance->tar_id, fused_id, primary);
+        /* 取消引导总是转发 */
+        if (guidance->guid_stat == 0)
+            primary = TRUE;
+    }
+    if (parser->guidance_callback && (primary || !parser->fusion_suppress_duplicates))
     {
-        CUAVEOSystemParam eo_param;
-        cuav_parse_eo_system(specific, &eo_param);
+        parser->guidance_callback(header, guidance, parser->guidance_user_data);
+    }
+    GST_DEBUG("Parsed GUIDANCE: tar_id=%u, guid_stat=%u, enu_a=%.2f, enu_e=%.2f",
+              guidance->tar_id, guidance->guid_stat, guidance->enu_a, guidance->enu_e);
+}
 
-        /* 调试打印 */
-        if (parser->debug_enabled)
-        {
-            cuav_print_eo_system(&eo_param);
-        }
+static void cuav_on_eo_system(CUAVParser *parser, const CUAVCommonHeader *header,
+                              gconstpointer msg)
+{
+    const CUAVEOSystemParam *eo_param = (const CUAVEOSystemParam *)msg;
+
+    cuav_pointing_store(parser, header, eo_param);
+    cuav_device_store(parser, header, CUAV_DEVICE_HAS_EO_SYSTEM,
+                      G_STRUCT_OFFSET(CUAVDeviceState, eo_system),
+                      G_STRUCT_OFFSET(CUAVDeviceState, eo_system_ts_us), msg,
+                      sizeof(CUAVEOSystemParam));
+    if (parser->eo_system_callback)
+    {
+        parser->eo_system_callback(header, eo_param, parser->eo_system_user_data);
+    }
+    GST_DEBUG("Parsed EO_SYSTEM: sv_stat=%u, st_loc_h=%.2f, st_loc_v=%.2f",
+              eo_param->sv_stat, eo_param->st_loc_h, eo_param->st_loc_v);
+}
 
-        if (parser->eo_system_callback)
-        {
-            parser->eo_system_callback(&header, &eo_param, parser->eo_system_user_data);
-        }
-        if (parser->raw_callback)
+static void cuav_on_eo_bit(CUAVParser *parser, const CUAVCommonHeader *header,
+                           gconstpointer msg)
+{
+    cuav_device_store(parser, header, CUAV_DEVICE_HAS_EO_BIT,
+                      G_STRUCT_OFFSET(CUAVDeviceState, eo_bit),
+                      G_STRUCT_OFFSET(CUAVDeviceState, eo_bit_ts_us), msg,
+                      sizeof(CUAVEOBitStatus));
+}
+
+static void cuav_on_target(CUAVParser *parser, const CUAVCommonHeader *header,
+                           gconstpointer msg)
+{
+    cuav_device_store(parser, header, CUAV_DEVICE_HAS_TARGET,
+                      G_STRUCT_OFFSET(CUAVDeviceState, target),
+                      G_STRUCT_OFFSET(CUAVDeviceState, target_ts_us), msg,
+                      sizeof(CUAVTargetInfo));
+}
+
+static void cuav_on_servo_control(CUAVParser *parser, const CUAVCommonHeader *header,
+                                  gconstpointer msg)
+{
+    const CUAVServoControl *servo = (const CUAVServoControl *)msg;
+
+    if (parser->servo_callback)
+    {
+        parser->servo_callback(header, servo, parser->servo_user_data);
+    }
+    GST_DEBUG("Parsed EO_SERVO: mode_h=%u, mode_v=%u, loc_h=%.2f, loc_v=%.2f",
+              servo->mode_h, servo->mode_v, servo->loc_h, servo->loc_v);
+}
+
+gboolean cuav_parser_parse(CUAVParser *parser, const gchar *data, gssize len)
+{
+    guint16 msg_id = 0;
+    guint64 recv_ts_us = 0;
+    guint found = 0;
+    const CUAVFilterConfig *filter = NULL;
+    CUAVCommonHeader header;
+    CUAVRawMessage raw;
+    CUAVSeqResult seq = CUAV_SEQ_IN_ORDER;
+    const CUAVMessageDesc *desc = NULL;
+    CUAVMessageUnion msg;
+    gboolean result = FALSE;
+
+    if (!parser || !data || len <= 0)
+        return FALSE;
+
+    recv_ts_us = (guint64)g_get_monotonic_time();
+    cuav_filter_config_reclaim(parser);
+    filter = (const CUAVFilterConfig *)g_atomic_pointer_get(&parser->filter);
+
+    /* 报文头从字节扫描，过滤与序号检查都不需要 DOM */
+    found = cuav_scan_common_header(data, (gsize)len, &header, recv_ts_us);
+    if ((found & CUAV_HDR_REQUIRED) != CUAV_HDR_REQUIRED)
+    {
+        if (filter && filter->msg_id_enabled)
         {
-            parser->raw_callback(&header, specific, parser->raw_user_data);
+            cuav_stat_add(&parser->filter_stats.rejected_no_header, 1);
+            return TRUE;
         }
-        GST_DEBUG("Parsed EO_SYSTEM: sv_stat=%u, st_loc_h=%.2f, st_loc_v=%.2f",
-                  eo_param.sv_stat, eo_param.st_loc_h, eo_param.st_loc_v);
-        result = TRUE;
-        break;
+        GST_WARNING("No common header found");
+        return FALSE;
     }
-    case CUAV_MSG_ID_EO_SERVO:
+    msg_id = header.msg_id;
+
+    /* 发送方的 msg_sn 对全部报文连续编号，过滤之前检查序号，被过滤的报文不计为丢失 */
+    seq = cuav_seq_check(parser, &header);
+
+    /* 发往其他设备或不关心的报文在构建 DOM 前丢弃 */
+    if (!cuav_prefilter(parser, filter, &header, found))
+        return TRUE;
+
+    /* 按需丢弃冗余发送的重复报文 */
+    if (seq == CUAV_SEQ_DUPLICATE && parser->drop_duplicates)
     {
-        CUAVServoControl servo;
-        cuav_parse_servo_control(specific, &servo);
+        GST_LOG("[CUAV] Drop duplicate msg_id=0x%04X msg_sn=%u", msg_id, header.msg_sn);
+        return TRUE;
+    }
+
+    raw.data = data;
+    raw.len = (gsize)len;
+    raw.json_parser = NULL;
+    raw.object = NULL;
+    raw.parsed = FALSE;
+
+    /* 仅转发模式不做类型化分发 */
+    if (parser->raw_forward_only)
+        goto forward;
 
-        /* 调试打印 */
-        if (parser->debug_enabled)
+    /* 按报文描述表分发：查表为常数时间；只有带字段定义的报文才构建 DOM，
+     * 未知报文和仅报文头的报文不解析 JSON */
+    desc = cuav_message_desc_lookup(msg_id);
+    if (desc && desc->n_fields > 0)
+    {
+        /* 真实设备当前使用扁平 JSON：公共头和具体信息都在根对象。 */
+        JsonObject *specific = cuav_raw_message_get_object(&raw);
+        if (!specific)
         {
-            cuav_print_servo_control(&servo);
+            if (parser->debug_enabled)
+            {
+                GST_WARNING("[CUAV] Failed to parse JSON object for msg_id=0x%04X", msg_id);
+            }
+            goto cleanup;
         }
 
-        if (parser->servo_callback)
+        cuav_decode_message(desc, specific, &msg);
+        cuav_debug_message(parser, &header, desc, &msg);
+        UDPJSON_PROBE3(cuav_dispatch, msg_id, header.tx_dev_id,
+                       parser->dispatch[desc->index] != NULL);
+        if (parser->dispatch[desc->index])
         {
-            parser->servo_callback(&header, &servo, parser->servo_user_data);
+            parser->dispatch[desc->index](parser, &header, &msg);
         }
-        if (parser->raw_callback)
+        if (parser->message_callback)
         {
-            parser->raw_callback(&header, specific, parser->raw_user_data);
+            parser->message_callback(&header, desc, &msg, parser->message_user_data);
         }
-        GST_DEBUG("Parsed EO_SERVO: mode_h=%u, mode_v=%u, loc_h=%.2f, loc_v=%.2f",
-                  servo.mode_h, servo.mode_v, servo.loc_h, servo.loc_v);
-        result = TRUE;
-        break;
     }
-    default:
-        if (parser->debug_enabled)
-        {
-            GST_INFO("[CUAV] 未处理报文: msg_id=0x%04X", msg_id);
-        }
-        if (parser->raw_callback)
+    else
+    {
+        cuav_debug_message(parser, &header, desc, NULL);
+        if (desc && parser->message_callback)
         {
-            parser->raw_callback(&header, specific, parser->raw_user_data);
+            parser->message_callback(&header, desc, NULL, parser->message_user_data);
         }
-        result = TRUE;
-        break;
     }
 
+forward:
+    /* 已为分发构建的 DOM 由原始报文复用，否则只在回调取对象时构建 */
+    if (parser->raw_callback)
+    {
+        parser->raw_callback(&header, &raw, parser->raw_user_data);
+    }
+    result = TRUE;
+
 cleanup:
-    if (json_parser)
-        g_object_unref(json_parser);
+    if (raw.json_parser)
+        g_object_unref(raw.json_parser);
     return result;
 }
 
+guint32 cuav_parser_get_guidance_tar_id(CUAVParser *parser)
+{
+    if (!parser)
+        return 0;
+    return (guint32)g_atomic_int_get(&parser->guidance_tar_id);
+}
+
 void cuav_parser_set_guidance_callback(CUAVParser *parser, CUAVGuidanceCallback callback,
                                        gpointer user_data)
 {
@@ -535,6 +1390,42 @@ void cuav_parser_set_raw_callback(CUAVParser *parser, CUAVRawMessageCallback cal
     }
 }
 
+void cuav_parser_set_message_callback(CUAVParser *parser, CUAVMessageCallback callback,
+                                      gpointer user_data)
+{
+    if (parser)
+    {
+        parser->message_callback = callback;
+        parser->message_user_data = user_data;
+    }
+}
+
+void cuav_parser_set_fusion(CUAVParser *parser, CUAVFusion *fusion,
+                            gboolean suppress_duplicates)
+{
+    if (parser)
+    {
+        parser->fusion_suppress_duplicates = suppress_duplicates;
+        g_atomic_pointer_set(&parser->fusion, fusion);
+    }
+}
+
+void cuav_parser_set_event_log(CUAVParser *parser, UdpJsonEventLog *log)
+{
+    if (parser)
+    {
+        parser->event_log = log;
+    }
+}
+
+void cuav_parser_set_raw_forward_only(CUAVParser *parser, gboolean enable)
+{
+    if (parser)
+    {
+        parser->raw_forward_only = enable;
+    }
+}
+
 /**
  * @brief 报文类型名称表
  */
@@ -556,40 +1447,11 @@ const gchar *cuav_get_msg_type_name(guint8 msg_type)
     return cuav_msg_type_names[4];
 }
 
-/**
- * @brief 报文ID名称表
- */
-static const struct
-{
-    guint16 msg_id;
-    const gchar *name;
-} cuav_msg_id_names[] = {
-    {CUAV_MSG_ID_CMD, "指令"},
-    {CUAV_MSG_ID_DEV_CONFIG, "设备配置参数"},
-    {CUAV_MSG_ID_GUIDANCE, "引导信息"},
-    {CUAV_MSG_ID_TARGET1, "目标信息1"},
-    {CUAV_MSG_ID_TARGET2, "目标信息2"},
-    {CUAV_MSG_ID_EO_SYSTEM, "光电系统参数"},
-    {CUAV_MSG_ID_EO_BIT, "光电BIT状态"},
-    {CUAV_MSG_ID_EO_TRACK, "光电跟踪控制"},
-    {CUAV_MSG_ID_EO_SERVO, "光电伺服控制"},
-    {CUAV_MSG_ID_EO_PT, "可见光控制"},
-    {CUAV_MSG_ID_EO_IR, "红外控制"},
-    {CUAV_MSG_ID_EO_DM, "光电测距控制"},
-    {CUAV_MSG_ID_EO_BOX, "手框目标区"},
-    {CUAV_MSG_ID_EO_REC, "光电录像"},
-    {CUAV_MSG_ID_EO_AUX, "配套控制"},
-    {CUAV_MSG_ID_EO_IMG, "图像控制"},
-};
-
 const gchar *cuav_get_msg_id_name(guint16 msg_id)
 {
-    guint n = sizeof(cuav_msg_id_names) / sizeof(cuav_msg_id_names[0]);
-    for (guint i = 0; i < n; i++)
-    {
-        if (cuav_msg_id_names[i].msg_id == msg_id)
-            return cuav_msg_id_names[i].name;
-    }
+    const CUAVMessageDesc *desc = cuav_message_desc_lookup(msg_id);
+    if (desc)
+        return desc->name;
     static gchar buf[32];
     snprintf(buf, sizeof(buf), "未知(0x%04X)", msg_id);
     return buf;
@@ -684,3 +1546,47 @@ void cuav_print_servo_control(const CUAVServoControl *servo)
            servo->loc_h, servo->loc_v);
     fflush(stdout);
 }
+
+void cuav_print_message(const CUAVMessageDesc *desc, gconstpointer msg)
+{
+    if (!desc || !msg)
+        return;
+
+    printf("[CUAV] === %s (0x%04X) ===\n", desc->name, desc->msg_id);
+    for (guint i = 0; i < desc->n_fields; i++)
+    {
+        const CUAVFieldDesc *f = &desc->fields[i];
+        gconstpointer p = G_STRUCT_MEMBER_P(msg, f->offset);
+
+        printf("[CUAV]   %s(%s): ", f->desc, f->name);
+        switch (f->type)
+        {
+        case CUAV_FIELD_U8:
+            printf("%u\n", *(const guint8 *)p);
+            break;
+        case CUAV_FIELD_U16:
+            printf("%u\n", *(const guint16 *)p);
+            break;
+        case CUAV_FIELD_I16:
+            printf("%d\n", *(const gint16 *)p);
+            break;
+        case CUAV_FIELD_U32:
+            printf("%u\n", *(const guint32 *)p);
+            break;
+        case CUAV_FIELD_I32:
+            for (guint k = 0; k < f->count; k++)
+                printf(k + 1 < f->count ? "%d, " : "%d\n", ((const gint32 *)p)[k]);
+            break;
+        case CUAV_FIELD_F32:
+            printf("%.*f\n", (gint)f->decimals, *(const gfloat *)p);
+            break;
+        case CUAV_FIELD_F64:
+            printf("%.*f\n", (gint)f->decimals, *(const gdouble *)p);
+            break;
+        case CUAV_FIELD_STR:
+            printf("%s\n", (const gchar *)p);
+            break;
+        }
+    }
+    fflush(stdout);
+}
@@ -3,31 +3,12 @@
 
 #include <glib.h>
 #include <json-glib/json-glib.h>
+#include "gstudpjsonmeta_cuav_msgs.h"
 
 G_BEGIN_DECLS
 
-/**
- * @brief C-UAV 报文ID常量定义
- */
-typedef enum
-{
-    CUAV_MSG_ID_CMD = 0x7101,         /* 指令 */
-    CUAV_MSG_ID_DEV_CONFIG = 0x7102,  /* 设备配置参数 */
-    CUAV_MSG_ID_GUIDANCE = 0x7111,    /* 引导信息 */
-    CUAV_MSG_ID_TARGET1 = 0x7112,     /* 目标信息1 */
-    CUAV_MSG_ID_TARGET2 = 0x7113,     /* 目标信息2 */
-    CUAV_MSG_ID_EO_SYSTEM = 0x7201,   /* 光电系统参数 */
-    CUAV_MSG_ID_EO_BIT = 0x7202,      /* 光电BIT状态 */
-    CUAV_MSG_ID_EO_TRACK = 0x7203,    /* 光电跟踪控制 */
-    CUAV_MSG_ID_EO_SERVO = 0x7204,    /* 光电伺服控制 */
-    CUAV_MSG_ID_EO_PT = 0x7205,       /* 可见光控制 */
-    CUAV_MSG_ID_EO_IR = 0x7206,       /* 红外控制 */
-    CUAV_MSG_ID_EO_DM = 0x7207,       /* 光电测距控制 */
-    CUAV_MSG_ID_EO_BOX = 0x7208,      /* 手框目标区 */
-    CUAV_MSG_ID_EO_REC = 0x7209,      /* 光电录像 */
-    CUAV_MSG_ID_EO_AUX = 0x720A,      /* 配套控制 */
-    CUAV_MSG_ID_EO_IMG = 0x720B       /* 图像控制 */
-} CUAVMessageId;
+/* 广播/未配置的系统号、设备编号 */
+#define CUAV_BROADCAST_ID 999
 
 /**
  * @brief C-UAV 报文类型定义
@@ -59,101 +40,6 @@ typedef enum
     CUAV_TARGET_UNKNOWN2 = 15
 } CUAVTargetType;
 
-/**
- * @brief 引导信息结构体 (msg_id = 0x7111)
- */
-typedef struct
-{
-    guint16 yr;           /* 年 */
-    guint8 mo;            /* 月 */
-    guint8 dy;            /* 日 */
-    guint8 h;             /* 时 */
-    guint8 min;           /* 分 */
-    guint8 sec;           /* 秒 */
-    gfloat msec;          /* 毫秒 */
-    guint32 tar_id;       /* 引导批号 */
-    guint16 tar_category; /* 目标类别 */
-    guint8 guid_stat;     /* 目标状态: 0=取消 1=正常 2=外推 */
-    gdouble ecef_x;       /* 地心坐标 X */
-    gdouble ecef_y;       /* 地心坐标 Y */
-    gdouble ecef_z;       /* 地心坐标 Z */
-    gdouble ecef_vx;      /* 速度 X */
-    gdouble ecef_vy;      /* 速度 Y */
-    gdouble ecef_vz;      /* 速度 Z */
-    gfloat h_dvi_pct;     /* 水平偏差百分比 */
-    gfloat v_dvi_pct;     /* 垂直偏差百分比 */
-    gdouble enu_r;        /* 目标距离 */
-    gdouble enu_a;        /* 目标方位 */
-    gdouble enu_e;        /* 目标俯仰 */
-    gdouble enu_v;        /* 目标速度 */
-    gdouble enu_h;        /* 目标相对高度 */
-    gdouble lon;          /* 经度 */
-    gdouble lat;          /* 纬度 */
-    gdouble alt;          /* 高度 */
-} CUAVGuidanceInfo;
-
-/**
- * @brief 光电系统参数结构体 (msg_id = 0x7201)
- */
-typedef struct
-{
-    guint8 sv_stat;       /* 伺服状态: 0=无效 1=正常 2=自检 3=预热 4=错误 */
-    guint16 sv_err;       /* 伺服错误代码 */
-    guint8 st_mode_h;     /* 伺服水平模式: 0=手动 1=跟踪 */
-    guint8 st_mode_v;     /* 伺服垂直模式: 0=手动 1=跟踪 */
-    gfloat st_loc_h;      /* 伺服水平指向(度) [0,360] */
-    gfloat st_loc_v;      /* 伺服垂直指向(度) [-90,90] */
-    guint8 pt_stat;       /* 可见光状态 */
-    guint16 pt_err;       /* 可见光错误代码 */
-    gfloat pt_focal;      /* 可见光焦距 [134-16298] */
-    guint16 pt_focus;     /* 可见光聚焦 */
-    gfloat pt_fov_h;      /* 可见光水平视场 */
-    gfloat pt_fov_v;      /* 可见光垂直视场 */
-    guint8 ir_stat;       /* 红外状态 */
-    guint16 ir_err;       /* 红外错误代码 */
-    gfloat ir_focal;      /* 红外焦距 [851-1223] */
-    guint16 ir_focus;     /* 红外聚焦 */
-    gfloat ir_fov_h;      /* 红外水平视场 */
-    gfloat ir_fov_v;      /* 红外垂直视场 */
-    guint8 dm_stat;       /* 测距状态 */
-    guint16 dm_err;       /* 测距错误代码 */
-    guint8 dm_dev;        /* 测距设备 */
-    guint8 trk_dev;       /* 跟踪设备: 0=可见光 1=红外 3=多传感器联动 */
-    guint8 pt_trk_link;   /* 光电联动: 0=停止 1=开始 */
-    guint8 ir_trk_link;   /* 红外联动: 0=停止 1=开始 */
-    guint8 trk_str;       /* 跟踪开关: 0=停止 1=开始 */
-    guint8 trk_mod;       /* 跟踪模式: 0=自动 1=半自动 2=手动 */
-    guint8 det_trk;       /* 检测跟踪: 0=检测 1=识别 */
-    guint8 trk_stat;      /* 目标状态: 0=非跟踪 1=跟踪正常 3=失锁 4=丢失 */
-    guint8 pt_zoom;       /* 可见光自动变倍: 0=不自动 1=自动 */
-    guint8 ir_zoom;       /* 红外自动变倍: 0=不自动 1=自动 */
-    guint8 pt_focus_mode; /* 可见光聚焦模式: 0=自动 1=手动 */
-    guint8 ir_focus_mode; /* 红外聚焦模式: 0=自动 1=手动 */
-} CUAVEOSystemParam;
-
-/**
- * @brief 光电伺服控制结构体 (msg_id = 0x7204)
- */
-typedef struct
-{
-    guint8 dev_id;        /* 设备类型: 0=可见光 1=红外 2=两者 */
-    guint8 dev_en;        /* 使能: 0=关闭 1=上电 */
-    guint8 ctrl_en;       /* 控制使能: 0=无效 1=有效 */
-    guint8 mode_h;        /* 水平控制模式: 0=手动 1=跟踪 */
-    guint8 mode_v;        /* 垂直控制模式: 0=手动 1=跟踪 */
-    guint8 speed_en_h;    /* 水平速度使能: 0=无效 1=设置 2=获取 3=增加 4=减小 */
-    guint8 speed_h;       /* 水平速度 [1,200] */
-    guint8 speed_en_v;    /* 垂直速度使能 */
-    guint8 speed_v;       /* 垂直速度 [1,200] */
-    guint8 loc_en_h;      /* 水平位置使能: 0=无效 1=设置 2=获取 3=增加 4=减小 */
-    gfloat loc_h;         /* 水平位置(度) */
-    guint8 loc_en_v;      /* 垂直位置使能 */
-    gfloat loc_v;         /* 垂直位置(度) */
-    guint8 offset_en;     /* 脱靶量使能 */
-    gint16 offset_h;      /* 水平脱靶量(像素) */
-    gint16 offset_v;      /* 垂直脱靶量(像素) */
-} CUAVServoControl;
-
 /**
  * @brief 公共报文头结构体
  */
@@ -182,6 +68,115 @@ typedef struct
     guint64 recv_ts_us;       /* 接收时间戳(微秒) */
 } CUAVCommonHeader;
 
+/**
+ * @brief 报文序号统计（按发送方 tx_sys_id/tx_dev_type/tx_dev_id/tx_subdev_id 分别跟踪后汇总）
+ *
+ * 发送方的 msg_sn 对全部报文连续编号，因此序号检查在预过滤之前进行，被过滤的报文
+ * 同样计入，不会被当作丢失。
+ */
+typedef struct
+{
+    guint64 received;         /* 已跟踪报文数 */
+    guint64 lost;             /* 丢失报文数（迟到补齐后扣除） */
+    guint64 reordered;        /* 乱序到达报文数 */
+    guint64 duplicates;       /* 重复报文数 */
+    guint64 resets;           /* 序号大幅跳变（发送方重启）次数 */
+    guint senders;            /* 已知发送方数量 */
+} CUAVSeqStats;
+
+/**
+ * @brief 报文头预过滤统计（在构建 JSON DOM 之前按原因计数）
+ */
+typedef struct
+{
+    guint64 passed;           /* 通过预过滤的报文数 */
+    guint64 rejected_msg_id;  /* msg_id 不在接收列表 */
+    guint64 rejected_rx_sys;  /* rx_sys_id 不是本系统 */
+    guint64 rejected_rx_dev;  /* rx_dev_id 不是本设备 */
+    guint64 rejected_no_header; /* 根对象中找不到 msg_id/msg_type */
+} CUAVFilterStats;
+
+/* 按发送设备保存最新状态的槽位数 */
+#define CUAV_MAX_DEVICES 16
+
+/* 每个设备保存的指向历史采样数，必须是 2 的幂 */
+#define CUAV_POINTING_HISTORY 64
+
+/**
+ * @brief 设备状态中已收到的报文类型位
+ */
+typedef enum
+{
+    CUAV_DEVICE_HAS_EO_SYSTEM = 1 << 0, /* 光电系统参数 (0x7201) */
+    CUAV_DEVICE_HAS_EO_BIT = 1 << 1,    /* 光电BIT状态 (0x7202) */
+    CUAV_DEVICE_HAS_TARGET = 1 << 2     /* 目标信息 (0x7112/0x7113) */
+} CUAVDeviceStateFlags;
+
+/**
+ * @brief 单个发送设备（按 tx_dev_id 区分）的最新状态
+ */
+typedef struct
+{
+    guint16 tx_sys_id;            /* 发送方系统号 */
+    guint16 tx_dev_id;            /* 发送方设备编号 */
+    guint32 flags;                /* 已收到的报文类型 CUAVDeviceStateFlags */
+    guint64 eo_system_ts_us;      /* eo_system 接收时间(微秒) */
+    guint64 eo_bit_ts_us;         /* eo_bit 接收时间(微秒) */
+    guint64 target_ts_us;         /* target 接收时间(微秒) */
+    CUAVEOSystemParam eo_system;  /* 最新光电系统参数 */
+    CUAVEOBitStatus eo_bit;       /* 最新光电BIT状态 */
+    CUAVTargetInfo target;        /* 最新目标信息 */
+} CUAVDeviceState;
+
+/**
+ * @brief 光电指向与视场采样（取自 0x7201）
+ */
+typedef struct
+{
+    gint64 ts_ns;             /* 采样时间(单调时钟纳秒，即报文头 recv_ts_us) */
+    gfloat loc_h;             /* 伺服水平指向(度) [0,360) */
+    gfloat loc_v;             /* 伺服垂直指向(度) [-90,90] */
+    gfloat pt_fov_h;          /* 可见光水平视场 */
+    gfloat pt_fov_v;          /* 可见光垂直视场 */
+    gfloat ir_fov_h;          /* 红外水平视场 */
+    gfloat ir_fov_v;          /* 红外垂直视场 */
+} CUAVPointingSample;
+
+/**
+ * @brief 指向插值结果
+ */
+typedef enum
+{
+    CUAV_POINTING_NONE = 0,       /* 无采样 */
+    CUAV_POINTING_INTERPOLATED,   /* 在两个采样之间插值 */
+    CUAV_POINTING_CLAMPED         /* 超出历史范围，取最近的端点 */
+} CUAVPointingResult;
+
+/**
+ * @brief 原始报文（不透明类型）
+ *
+ * 持有原始报文字节，JSON DOM 仅在调用 cuav_raw_message_get_object() 时构建。
+ * 只在回调期间有效，不能保存到回调之外。
+ */
+typedef struct _CUAVRawMessage CUAVRawMessage;
+
+/**
+ * @brief 获取原始报文字节
+ *
+ * @param msg 原始报文
+ * @param len 输出字节数，可为 NULL
+ * @return 报文字节（不保证以 NUL 结尾）
+ */
+const gchar *cuav_raw_message_get_data(const CUAVRawMessage *msg, gsize *len);
+
+/**
+ * @brief 获取报文 JSON 对象，首次调用时才解析
+ *
+ * @param msg 原始报文
+ * @return 根对象，解析失败返回 NULL；归原始报文所有
+ */
+JsonObject *cuav_raw_message_get_object(CUAVRawMessage *msg);
+
 /**
  * @brief 回调函数类型定义
  */
@@ -198,9 +193,15 @@ typedef void (*CUAVServoControlCallback)(const CUAVCommonHeader *header,
                                          gpointer user_data);
 
 typedef void (*CUAVRawMessageCallback)(const CUAVCommonHeader *header,
-                                       JsonObject *specific,
+                                       CUAVRawMessage *msg,
                                        gpointer user_data);
 
+/* 通用报文回调：msg 指向 desc->struct_name 对应的结构体，仅报文头的报文为 NULL */
+typedef void (*CUAVMessageCallback)(const CUAVCommonHeader *header,
+                                    const CUAVMessageDesc *desc,
+                                    gconstpointer msg,
+                                    gpointer user_data);
+
 /**
  * @brief C-UAV 报文解析器（不透明类型）
  */
@@ -228,9 +229,119 @@ void cuav_parser_free(CUAVParser *parser);
  */
 void cuav_parser_set_debug(CUAVParser *parser, gboolean enable);
 
+/**
+ * @brief 设置是否丢弃重复报文
+ *
+ * 启用后，同一发送方重复的 msg_sn（如冗余发送）在回调之前被丢弃。
+ *
+ * @param parser 解析器实例
+ * @param enable TRUE 丢弃重复报文
+ */
+void cuav_parser_set_drop_duplicates(CUAVParser *parser, gboolean enable);
+
+/**
+ * @brief 设置 msg_id 接收列表
+ *
+ * 过滤在构建 JSON DOM 之前完成：只扫描根对象的公共报文头字段，嵌套对象和
+ * 字符串中的同名键不参与过滤。可在任意线程调用，新配置整体原子生效。
+ *
+ * @param parser 解析器实例
+ * @param msg_ids 接收的报文ID数组
+ * @param n_ids 数组长度，0 表示接收全部报文
+ */
+void cuav_parser_set_msg_id_filter(CUAVParser *parser, const guint16 *msg_ids, guint n_ids);
+
+/**
+ * @brief 设置接收方地址过滤
+ *
+ * 启用后只接收 rx_sys_id/rx_dev_id 为本机或广播 (999) 的报文，
+ * 缺少对应字段的报文视为广播。可在任意线程调用，新配置整体原子生效。
+ *
+ * @param parser 解析器实例
+ * @param enable 是否启用
+ * @param sys_id 本机系统号
+ * @param dev_id 本机设备编号
+ */
+void cuav_parser_set_rx_filter(CUAVParser *parser, gboolean enable, guint16 sys_id,
+                               guint16 dev_id);
+
+/**
+ * @brief 获取报文头预过滤统计
+ *
+ * 可在任意线程调用。
+ *
+ * @param parser 解析器实例
+ * @param stats 输出统计
+ */
+void cuav_parser_get_filter_stats(CUAVParser *parser, CUAVFilterStats *stats);
+
+/**
+ * @brief 获取报文序号统计
+ *
+ * 可在任意线程调用。
+ *
+ * @param parser 解析器实例
+ * @param stats 输出统计
+ */
+void cuav_parser_get_seq_stats(CUAVParser *parser, CUAVSeqStats *stats);
+
+/**
+ * @brief 为发送设备预留状态槽位
+ *
+ * 只跟踪预留了槽位的设备：未预留设备（如非光电的目标信息发送方）的报文不写入
+ * 设备状态，不会占用槽位。可在任意线程调用，重复调用返回同一槽位。
+ *
+ * @param parser 解析器实例
+ * @param tx_dev_id 发送方设备编号
+ * @return 槽位下标，槽位已满返回 -1
+ */
+gint cuav_parser_register_device(CUAVParser *parser, guint16 tx_dev_id);
+
+/**
+ * @brief 按槽位读取设备最新状态
+ *
+ * 无锁读取，可在任意线程调用，与接收线程的写入互不阻塞。
+ *
+ * @param parser 解析器实例
+ * @param slot cuav_parser_register_device() 返回的槽位
+ * @param state 输出设备状态
+ * @return 槽位有效且已收到过状态报文返回 TRUE
+ */
+gboolean cuav_parser_read_device(CUAVParser *parser, gint slot, CUAVDeviceState *state);
+
+/**
+ * @brief 按设备编号读取设备最新状态
+ *
+ * @param parser 解析器实例
+ * @param tx_dev_id 发送方设备编号
+ * @param state 输出设备状态
+ * @return 设备已预留槽位且收到过其状态报文返回 TRUE
+ */
+gboolean cuav_parser_get_device_state(CUAVParser *parser, guint16 tx_dev_id,
+                                      CUAVDeviceState *state);
+
+/**
+ * @brief 按时间插值设备的指向与视场
+ *
+ * 在该设备最近 CUAV_POINTING_HISTORY 个 0x7201 采样中二分查找 ts_ns 两侧的采样，
+ * 指向按单位球面球面线性插值（正确处理 0/360 度跨越），视场线性插值。
+ * 无锁读取，可在任意线程调用。采样时间取报文接收时的单调时钟，UTC 时间（如帧的
+ * ntp_timestamp）须先换算到单调时钟。
+ *
+ * @param parser 解析器实例
+ * @param slot cuav_parser_register_device() 返回的槽位
+ * @param ts_ns 目标时间(单调时钟纳秒，与 g_get_monotonic_time() 同一时钟)
+ * @param out 输出采样，ts_ns 为请求时间
+ * @return 插值结果
+ */
+CUAVPointingResult cuav_parser_interpolate_pointing(CUAVParser *parser, gint slot, gint64 ts_ns,
+                                                    CUAVPointingSample *out);
+
 /**
  * @brief 解析 C-UAV 报文
  *
+ * 同一解析器只能在一个线程（接收线程）中调用。
+ *
  * @param parser 解析器实例
  * @param data JSON 数据
  * @param len 数据长度
@@ -238,6 +349,16 @@ void cuav_parser_set_debug(CUAVParser *parser, gboolean enable);
  */
 gboolean cuav_parser_parse(CUAVParser *parser, const gchar *data, gssize len);
 
+/**
+ * @brief 获取最近一次有效引导的目标批号
+ *
+ * 可在任意线程调用。
+ *
+ * @param parser 解析器实例
+ * @return 引导批号，无引导或引导已取消返回 0
+ */
+guint32 cuav_parser_get_guidance_tar_id(CUAVParser *parser);
+
 /**
  * @brief 注册引导信息回调
  *
@@ -282,6 +403,69 @@ void cuav_parser_set_raw_callback(CUAVParser *parser,
                                   CUAVRawMessageCallback callback,
                                   gpointer user_data);
 
+/**
+ * @brief 注册通用报文回调（协议描述表中的全部报文）
+ *
+ * @param parser 解析器实例
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ */
+void cuav_parser_set_message_callback(CUAVParser *parser,
+                                      CUAVMessageCallback callback,
+                                      gpointer user_data);
+
+/**
+ * @brief 按报文描述把 JSON 对象解码到结构体
+ *
+ * 缺少的字段保持为 0。
+ *
+ * @param desc 报文描述
+ * @param obj JSON 对象
+ * @param msg 输出结构体，大小为 desc->size
+ * @return desc 定义了字段时返回 TRUE
+ */
+gboolean cuav_decode_message(const CUAVMessageDesc *desc, JsonObject *obj, gpointer msg);
+
+/**
+ * @brief 设置原始报文仅转发模式
+ *
+ * 启用后只调用原始报文回调，不做类型化解码，类型化回调和引导批号跟踪不再生效。
+ * 报文头总是从字节中扫描；未启用时也只有带字段定义的报文才构建 JSON DOM。
+ *
+ * @param parser 解析器实例
+ * @param enable 是否启用
+ */
+void cuav_parser_set_raw_forward_only(CUAVParser *parser, gboolean enable);
+
+/* 异步调试事件日志，见 gstudpjsonmeta_eventlog.h */
+typedef struct _UdpJsonEventLog UdpJsonEventLog;
+
+/**
+ * @brief 设置调试事件日志
+ *
+ * 设置后调试输出写入事件日志，由其后台线程格式化；
+ * 未设置时调试输出直接打印到 stdout。
+ *
+ * @param parser 解析器实例
+ * @param log 事件日志，NULL 表示直接打印；不转移所有权
+ */
+void cuav_parser_set_event_log(CUAVParser *parser, UdpJsonEventLog *log);
+
+/* 多传感器引导航迹融合，见 gstudpjsonmeta_fusion.h */
+typedef struct _CUAVFusion CUAVFusion;
+
+/**
+ * @brief 设置引导航迹融合
+ *
+ * 设置后每条引导信息先送入融合，再调用引导信息回调。
+ *
+ * @param parser 解析器实例
+ * @param fusion 融合实例，NULL 表示不融合；不转移所有权
+ * @param suppress_duplicates 只对融合批号的主航迹调用引导信息回调
+ */
+void cuav_parser_set_fusion(CUAVParser *parser, CUAVFusion *fusion,
+                            gboolean suppress_duplicates);
+
 /**
  * @brief 获取报文类型名称
  *
@@ -320,6 +504,14 @@ void cuav_print_guidance(const CUAVGuidanceInfo *guidance);
  */
 void cuav_print_eo_system(const CUAVEOSystemParam *eo_param);
 
+/**
+ * @brief 按报文描述逐字段打印（调试用）
+ *
+ * @param desc 报文描述
+ * @param msg 报文结构体
+ */
+void cuav_print_message(const CUAVMessageDesc *desc, gconstpointer msg);
+
 /**
  * @brief 打印伺服控制（调试用）
  *
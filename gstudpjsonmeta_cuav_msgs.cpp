@@ -0,0 +1,287 @@
+/* 由 python_tools/cuav_codegen.py 根据 python_tools/cuav_schema.json 生成，请勿手工修改 */
+#include "gstudpjsonmeta_cuav_msgs.h"
+
+#define CUAV_FIELD(st, field, type, count, decimals, desc) \
+    {#field, type, (guint16)G_STRUCT_OFFSET(st, field), count, decimals, desc}
+
+static const CUAVFieldDesc cuav_fields_CUAVCommand[] = {
+    CUAV_FIELD(CUAVCommand, cmd_id, CUAV_FIELD_U16, 1, 0, "指令ID"),
+    CUAV_FIELD(CUAVCommand, cmd_coef1, CUAV_FIELD_U16, 1, 0, "指令参数1"),
+};
+
+static const CUAVFieldDesc cuav_fields_CUAVDevConfig[] = {
+    CUAV_FIELD(CUAVDevConfig, sys_set, CUAV_FIELD_U8, 1, 0, "系统设置: 1=设置 2=查询反馈"),
+    CUAV_FIELD(CUAVDevConfig, lon, CUAV_FIELD_F64, 1, 7, "经度"),
+    CUAV_FIELD(CUAVDevConfig, lat, CUAV_FIELD_F64, 1, 7, "纬度"),
+    CUAV_FIELD(CUAVDevConfig, alt, CUAV_FIELD_F64, 1, 3, "高度"),
+    CUAV_FIELD(CUAVDevConfig, sys_id, CUAV_FIELD_U16, 1, 0, "系统号"),
+    CUAV_FIELD(CUAVDevConfig, dev_type, CUAV_FIELD_U16, 1, 0, "设备类型"),
+    CUAV_FIELD(CUAVDevConfig, dev_id, CUAV_FIELD_U16, 1, 0, "设备编号"),
+    CUAV_FIELD(CUAVDevConfig, subdev_id, CUAV_FIELD_U16, 1, 0, "分系统编号"),
+    CUAV_FIELD(CUAVDevConfig, net_set, CUAV_FIELD_U8, 1, 0, "网络设置"),
+    CUAV_FIELD(CUAVDevConfig, loc_ip, CUAV_FIELD_STR, 16, 0, "本机IP"),
+    CUAV_FIELD(CUAVDevConfig, loc_port, CUAV_FIELD_U16, 1, 0, "本机端口"),
+    CUAV_FIELD(CUAVDevConfig, bit_mas_ip, CUAV_FIELD_STR, 16, 0, "BIT主机IP"),
+    CUAV_FIELD(CUAVDevConfig, bit_mas_port, CUAV_FIELD_U16, 1, 0, "BIT主机端口"),
+    CUAV_FIELD(CUAVDevConfig, mas_ip, CUAV_FIELD_STR, 16, 0, "主机IP"),
+    CUAV_FIELD(CUAVDevConfig, mas_port, CUAV_FIELD_U16, 1, 0, "主机端口"),
+    CUAV_FIELD(CUAVDevConfig, proc_set, CUAV_FIELD_U8, 1, 0, "处理设置"),
+    CUAV_FIELD(CUAVDevConfig, nor_agle, CUAV_FIELD_F32, 1, 4, "北向角(度)"),
+    CUAV_FIELD(CUAVDevConfig, azi_agle, CUAV_FIELD_F32, 1, 4, "方位安装角(度)"),
+    CUAV_FIELD(CUAVDevConfig, elv_agle, CUAV_FIELD_F32, 1, 4, "俯仰安装角(度)"),
+    CUAV_FIELD(CUAVDevConfig, trk_set, CUAV_FIELD_U8, 1, 0, "跟踪设置"),
+    CUAV_FIELD(CUAVDevConfig, fb_set, CUAV_FIELD_U8, 1, 0, "回馈设置"),
+    CUAV_FIELD(CUAVDevConfig, version, CUAV_FIELD_STR, 32, 0, "软件版本"),
+};
+
+static const CUAVFieldDesc cuav_fields_CUAVGuidanceInfo[] = {
+    CUAV_FIELD(CUAVGuidanceInfo, yr, CUAV_FIELD_U16, 1, 0, "年"),
+    CUAV_FIELD(CUAVGuidanceInfo, mo, CUAV_FIELD_U8, 1, 0, "月"),
+    CUAV_FIELD(CUAVGuidanceInfo, dy, CUAV_FIELD_U8, 1, 0, "日"),
+    CUAV_FIELD(CUAVGuidanceInfo, h, CUAV_FIELD_U8, 1, 0, "时"),
+    CUAV_FIELD(CUAVGuidanceInfo, min, CUAV_FIELD_U8, 1, 0, "分"),
+    CUAV_FIELD(CUAVGuidanceInfo, sec, CUAV_FIELD_U8, 1, 0, "秒"),
+    CUAV_FIELD(CUAVGuidanceInfo, msec, CUAV_FIELD_F32, 1, 3, "毫秒"),
+    CUAV_FIELD(CUAVGuidanceInfo, tar_id, CUAV_FIELD_U32, 1, 0, "引导批号"),
+    CUAV_FIELD(CUAVGuidanceInfo, tar_category, CUAV_FIELD_U16, 1, 0, "目标类别"),
+    CUAV_FIELD(CUAVGuidanceInfo, guid_stat, CUAV_FIELD_U8, 1, 0, "目标状态: 0=取消 1=正常 2=外推"),
+    CUAV_FIELD(CUAVGuidanceInfo, ecef_x, CUAV_FIELD_F64, 1, 3, "地心坐标 X"),
+    CUAV_FIELD(CUAVGuidanceInfo, ecef_y, CUAV_FIELD_F64, 1, 3, "地心坐标 Y"),
+    CUAV_FIELD(CUAVGuidanceInfo, ecef_z, CUAV_FIELD_F64, 1, 3, "地心坐标 Z"),
+    CUAV_FIELD(CUAVGuidanceInfo, ecef_vx, CUAV_FIELD_F64, 1, 3, "速度 X"),
+    CUAV_FIELD(CUAVGuidanceInfo, ecef_vy, CUAV_FIELD_F64, 1, 3, "速度 Y"),
+    CUAV_FIELD(CUAVGuidanceInfo, ecef_vz, CUAV_FIELD_F64, 1, 3, "速度 Z"),
+    CUAV_FIELD(CUAVGuidanceInfo, h_dvi_pct, CUAV_FIELD_F32, 1, 3, "水平偏差百分比"),
+    CUAV_FIELD(CUAVGuidanceInfo, v_dvi_pct, CUAV_FIELD_F32, 1, 3, "垂直偏差百分比"),
+    CUAV_FIELD(CUAVGuidanceInfo, enu_r, CUAV_FIELD_F64, 1, 3, "目标距离"),
+    CUAV_FIELD(CUAVGuidanceInfo, enu_a, CUAV_FIELD_F64, 1, 4, "目标方位"),
+    CUAV_FIELD(CUAVGuidanceInfo, enu_e, CUAV_FIELD_F64, 1, 4, "目标俯仰"),
+    CUAV_FIELD(CUAVGuidanceInfo, enu_v, CUAV_FIELD_F64, 1, 3, "目标速度"),
+    CUAV_FIELD(CUAVGuidanceInfo, enu_h, CUAV_FIELD_F64, 1, 3, "目标相对高度"),
+    CUAV_FIELD(CUAVGuidanceInfo, lon, CUAV_FIELD_F64, 1, 7, "经度"),
+    CUAV_FIELD(CUAVGuidanceInfo, lat, CUAV_FIELD_F64, 1, 7, "纬度"),
+    CUAV_FIELD(CUAVGuidanceInfo, alt, CUAV_FIELD_F64, 1, 3, "高度"),
+};
+
+static const CUAVFieldDesc cuav_fields_CUAVTargetInfo[] = {
+    CUAV_FIELD(CUAVTargetInfo, yr, CUAV_FIELD_U16, 1, 0, "年"),
+    CUAV_FIELD(CUAVTargetInfo, mo, CUAV_FIELD_U8, 1, 0, "月"),
+    CUAV_FIELD(CUAVTargetInfo, dy, CUAV_FIELD_U8, 1, 0, "日"),
+    CUAV_FIELD(CUAVTargetInfo, h, CUAV_FIELD_U8, 1, 0, "时"),
+    CUAV_FIELD(CUAVTargetInfo, min, CUAV_FIELD_U8, 1, 0, "分"),
+    CUAV_FIELD(CUAVTargetInfo, sec, CUAV_FIELD_U8, 1, 0, "秒"),
+    CUAV_FIELD(CUAVTargetInfo, msec, CUAV_FIELD_F32, 1, 3, "毫秒"),
+    CUAV_FIELD(CUAVTargetInfo, dev_id, CUAV_FIELD_U8, 1, 0, "探测设备: 0=可见光 1=红外"),
+    CUAV_FIELD(CUAVTargetInfo, guid_id, CUAV_FIELD_U32, 1, 0, "关联的引导批号"),
+    CUAV_FIELD(CUAVTargetInfo, tar_id, CUAV_FIELD_U32, 1, 0, "目标批号"),
+    CUAV_FIELD(CUAVTargetInfo, trk_stat, CUAV_FIELD_U8, 1, 0, "目标状态: 0=丢失 1=正常 2=外推"),
+    CUAV_FIELD(CUAVTargetInfo, trk_mod, CUAV_FIELD_U8, 1, 0, "跟踪模式: 0=自动 1=半自动 2=手动"),
+    CUAV_FIELD(CUAVTargetInfo, tar_a, CUAV_FIELD_F64, 1, 4, "目标方位(度)"),
+    CUAV_FIELD(CUAVTargetInfo, tar_e, CUAV_FIELD_F64, 1, 4, "目标俯仰(度)"),
+    CUAV_FIELD(CUAVTargetInfo, tar_av, CUAV_FIELD_F32, 1, 3, "方位角速度(度/秒)"),
+    CUAV_FIELD(CUAVTargetInfo, tar_ev, CUAV_FIELD_F32, 1, 3, "俯仰角速度(度/秒)"),
+    CUAV_FIELD(CUAVTargetInfo, tar_rng, CUAV_FIELD_F64, 1, 1, "目标距离(米)"),
+    CUAV_FIELD(CUAVTargetInfo, tar_rv, CUAV_FIELD_F32, 1, 2, "径向速度(米/秒)"),
+    CUAV_FIELD(CUAVTargetInfo, tar_category, CUAV_FIELD_U16, 1, 0, "目标类别"),
+    CUAV_FIELD(CUAVTargetInfo, tar_iden, CUAV_FIELD_STR, 16, 0, "目标识别结果"),
+    CUAV_FIELD(CUAVTargetInfo, tar_cfid, CUAV_FIELD_F32, 1, 3, "置信度"),
+    CUAV_FIELD(CUAVTargetInfo, offset_h, CUAV_FIELD_I16, 1, 0, "水平脱靶量(像素)"),
+    CUAV_FIELD(CUAVTargetInfo, offset_v, CUAV_FIELD_I16, 1, 0, "垂直脱靶量(像素)"),
+    CUAV_FIELD(CUAVTargetInfo, tar_rect, CUAV_FIELD_I32, 4, 0, "目标框 x,y,w,h (像素)"),
+    CUAV_FIELD(CUAVTargetInfo, fov_h, CUAV_FIELD_F32, 1, 3, "水平视场/指向"),
+    CUAV_FIELD(CUAVTargetInfo, fov_v, CUAV_FIELD_F32, 1, 3, "垂直视场/指向"),
+    CUAV_FIELD(CUAVTargetInfo, tar_sum, CUAV_FIELD_U16, 1, 0, "目标总数"),
+    CUAV_FIELD(CUAVTargetInfo, lon, CUAV_FIELD_F64, 1, 7, "经度"),
+    CUAV_FIELD(CUAVTargetInfo, lat, CUAV_FIELD_F64, 1, 7, "纬度"),
+    CUAV_FIELD(CUAVTargetInfo, alt, CUAV_FIELD_F64, 1, 3, "高度"),
+};
+
+static const CUAVFieldDesc cuav_fields_CUAVEOSystemParam[] = {
+    CUAV_FIELD(CUAVEOSystemParam, sv_stat, CUAV_FIELD_U8, 1, 0, "伺服状态: 0=无效 1=正常 2=自检 3=预热 4=错误"),
+    CUAV_FIELD(CUAVEOSystemParam, sv_err, CUAV_FIELD_U16, 1, 0, "伺服错误代码"),
+    CUAV_FIELD(CUAVEOSystemParam, st_mode_h, CUAV_FIELD_U8, 1, 0, "伺服水平模式: 0=手动 1=跟踪"),
+    CUAV_FIELD(CUAVEOSystemParam, st_mode_v, CUAV_FIELD_U8, 1, 0, "伺服垂直模式: 0=手动 1=跟踪"),
+    CUAV_FIELD(CUAVEOSystemParam, st_loc_h, CUAV_FIELD_F32, 1, 4, "伺服水平指向(度) [0,360]"),
+    CUAV_FIELD(CUAVEOSystemParam, st_loc_v, CUAV_FIELD_F32, 1, 4, "伺服垂直指向(度) [-90,90]"),
+    CUAV_FIELD(CUAVEOSystemParam, pt_stat, CUAV_FIELD_U8, 1, 0, "可见光状态"),
+    CUAV_FIELD(CUAVEOSystemParam, pt_err, CUAV_FIELD_U16, 1, 0, "可见光错误代码"),
+    CUAV_FIELD(CUAVEOSystemParam, pt_focal, CUAV_FIELD_F32, 1, 1, "可见光焦距 [134-16298]"),
+    CUAV_FIELD(CUAVEOSystemParam, pt_focus, CUAV_FIELD_U16, 1, 0, "可见光聚焦"),
+    CUAV_FIELD(CUAVEOSystemParam, pt_fov_h, CUAV_FIELD_F32, 1, 4, "可见光水平视场"),
+    CUAV_FIELD(CUAVEOSystemParam, pt_fov_v, CUAV_FIELD_F32, 1, 4, "可见光垂直视场"),
+    CUAV_FIELD(CUAVEOSystemParam, ir_stat, CUAV_FIELD_U8, 1, 0, "红外状态"),
+    CUAV_FIELD(CUAVEOSystemParam, ir_err, CUAV_FIELD_U16, 1, 0, "红外错误代码"),
+    CUAV_FIELD(CUAVEOSystemParam, ir_focal, CUAV_FIELD_F32, 1, 1, "红外焦距 [851-1223]"),
+    CUAV_FIELD(CUAVEOSystemParam, ir_focus, CUAV_FIELD_U16, 1, 0, "红外聚焦"),
+    CUAV_FIELD(CUAVEOSystemParam, ir_fov_h, CUAV_FIELD_F32, 1, 4, "红外水平视场"),
+    CUAV_FIELD(CUAVEOSystemParam, ir_fov_v, CUAV_FIELD_F32, 1, 4, "红外垂直视场"),
+    CUAV_FIELD(CUAVEOSystemParam, dm_stat, CUAV_FIELD_U8, 1, 0, "测距状态"),
+    CUAV_FIELD(CUAVEOSystemParam, dm_err, CUAV_FIELD_U16, 1, 0, "测距错误代码"),
+    CUAV_FIELD(CUAVEOSystemParam, dm_dev, CUAV_FIELD_U8, 1, 0, "测距设备"),
+    CUAV_FIELD(CUAVEOSystemParam, trk_dev, CUAV_FIELD_U8, 1, 0, "跟踪设备: 0=可见光 1=红外 3=多传感器联动"),
+    CUAV_FIELD(CUAVEOSystemParam, pt_trk_link, CUAV_FIELD_U8, 1, 0, "光电联动: 0=停止 1=开始"),
+    CUAV_FIELD(CUAVEOSystemParam, ir_trk_link, CUAV_FIELD_U8, 1, 0, "红外联动: 0=停止 1=开始"),
+    CUAV_FIELD(CUAVEOSystemParam, trk_str, CUAV_FIELD_U8, 1, 0, "跟踪开关: 0=停止 1=开始"),
+    CUAV_FIELD(CUAVEOSystemParam, trk_mod, CUAV_FIELD_U8, 1, 0, "跟踪模式: 0=自动 1=半自动 2=手动"),
+    CUAV_FIELD(CUAVEOSystemParam, det_trk, CUAV_FIELD_U8, 1, 0, "检测跟踪: 0=检测 1=识别"),
+    CUAV_FIELD(CUAVEOSystemParam, trk_stat, CUAV_FIELD_U8, 1, 0, "目标状态: 0=非跟踪 1=跟踪正常 3=失锁 4=丢失"),
+    CUAV_FIELD(CUAVEOSystemParam, pt_zoom, CUAV_FIELD_U8, 1, 0, "可见光自动变倍: 0=不自动 1=自动"),
+    CUAV_FIELD(CUAVEOSystemParam, ir_zoom, CUAV_FIELD_U8, 1, 0, "红外自动变倍: 0=不自动 1=自动"),
+    CUAV_FIELD(CUAVEOSystemParam, pt_focus_mode, CUAV_FIELD_U8, 1, 0, "可见光聚焦模式: 0=自动 1=手动"),
+    CUAV_FIELD(CUAVEOSystemParam, ir_focus_mode, CUAV_FIELD_U8, 1, 0, "红外聚焦模式: 0=自动 1=手动"),
+};
+
+static const CUAVFieldDesc cuav_fields_CUAVEOBitStatus[] = {
+    CUAV_FIELD(CUAVEOBitStatus, sv_stat_h, CUAV_FIELD_U8, 1, 0, "水平伺服状态"),
+    CUAV_FIELD(CUAVEOBitStatus, sv_stat_v, CUAV_FIELD_U8, 1, 0, "垂直伺服状态"),
+    CUAV_FIELD(CUAVEOBitStatus, sv_pwr, CUAV_FIELD_U8, 1, 0, "伺服供电"),
+    CUAV_FIELD(CUAVEOBitStatus, sv_max_t, CUAV_FIELD_F32, 1, 1, "伺服最高温度"),
+    CUAV_FIELD(CUAVEOBitStatus, pt_stat, CUAV_FIELD_U8, 1, 0, "可见光状态"),
+    CUAV_FIELD(CUAVEOBitStatus, pt_err, CUAV_FIELD_U16, 1, 0, "可见光错误代码"),
+    CUAV_FIELD(CUAVEOBitStatus, pt_pwr, CUAV_FIELD_U8, 1, 0, "可见光供电"),
+    CUAV_FIELD(CUAVEOBitStatus, pt_max_t, CUAV_FIELD_F32, 1, 1, "可见光最高温度"),
+    CUAV_FIELD(CUAVEOBitStatus, pt_avg_t, CUAV_FIELD_F32, 1, 1, "可见光平均温度"),
+    CUAV_FIELD(CUAVEOBitStatus, ir_stat, CUAV_FIELD_U8, 1, 0, "红外状态"),
+    CUAV_FIELD(CUAVEOBitStatus, ir_err, CUAV_FIELD_U16, 1, 0, "红外错误代码"),
+    CUAV_FIELD(CUAVEOBitStatus, ir_pwr, CUAV_FIELD_U8, 1, 0, "红外供电"),
+    CUAV_FIELD(CUAVEOBitStatus, ir_max_t, CUAV_FIELD_F32, 1, 1, "红外最高温度"),
+    CUAV_FIELD(CUAVEOBitStatus, ir_avg_t, CUAV_FIELD_F32, 1, 1, "红外平均温度"),
+    CUAV_FIELD(CUAVEOBitStatus, laster_stat, CUAV_FIELD_U8, 1, 0, "激光状态（协议字段名如此）"),
+    CUAV_FIELD(CUAVEOBitStatus, laster_err, CUAV_FIELD_U16, 1, 0, "激光错误代码（协议字段名如此）"),
+    CUAV_FIELD(CUAVEOBitStatus, laser_pwr, CUAV_FIELD_U8, 1, 0, "激光供电"),
+    CUAV_FIELD(CUAVEOBitStatus, laser_max_t, CUAV_FIELD_F32, 1, 1, "激光最高温度"),
+    CUAV_FIELD(CUAVEOBitStatus, laser_avg_t, CUAV_FIELD_F32, 1, 1, "激光平均温度"),
+    CUAV_FIELD(CUAVEOBitStatus, wiper_stat, CUAV_FIELD_U8, 1, 0, "雨刷状态"),
+    CUAV_FIELD(CUAVEOBitStatus, defrost_stat, CUAV_FIELD_U8, 1, 0, "除霜状态"),
+    CUAV_FIELD(CUAVEOBitStatus, ofr_stat, CUAV_FIELD_U8, 1, 0, "其他状态"),
+};
+
+static const CUAVFieldDesc cuav_fields_CUAVTrackControl[] = {
+    CUAV_FIELD(CUAVTrackControl, trk_end, CUAV_FIELD_U8, 1, 0, "跟踪模块开关: 0=关闭 1=开启"),
+    CUAV_FIELD(CUAVTrackControl, pt_trk_link, CUAV_FIELD_U8, 1, 0, "可见光联动: 0=停止 1=开始"),
+    CUAV_FIELD(CUAVTrackControl, ir_trk_link, CUAV_FIELD_U8, 1, 0, "红外联动: 0=停止 1=开始"),
+    CUAV_FIELD(CUAVTrackControl, trk_str, CUAV_FIELD_U8, 1, 0, "跟踪开关: 0=停止 1=开始"),
+    CUAV_FIELD(CUAVTrackControl, trk_dev, CUAV_FIELD_U8, 1, 0, "跟踪设备: 0=可见光 1=红外 3=多传感器联动"),
+    CUAV_FIELD(CUAVTrackControl, trk_mod, CUAV_FIELD_U8, 1, 0, "跟踪模式: 0=自动 1=半自动 2=手动"),
+    CUAV_FIELD(CUAVTrackControl, det_trk, CUAV_FIELD_U8, 1, 0, "检测跟踪: 0=检测 1=识别"),
+};
+
+static const CUAVFieldDesc cuav_fields_CUAVServoControl[] = {
+    CUAV_FIELD(CUAVServoControl, dev_id, CUAV_FIELD_U8, 1, 0, "设备类型: 0=可见光 1=红外 2=两者"),
+    CUAV_FIELD(CUAVServoControl, dev_en, CUAV_FIELD_U8, 1, 0, "使能: 0=关闭 1=上电"),
+    CUAV_FIELD(CUAVServoControl, ctrl_en, CUAV_FIELD_U8, 1, 0, "控制使能: 0=无效 1=有效"),
+    CUAV_FIELD(CUAVServoControl, mode_h, CUAV_FIELD_U8, 1, 0, "水平控制模式: 0=手动 1=跟踪"),
+    CUAV_FIELD(CUAVServoControl, mode_v, CUAV_FIELD_U8, 1, 0, "垂直控制模式: 0=手动 1=跟踪"),
+    CUAV_FIELD(CUAVServoControl, speed_en_h, CUAV_FIELD_U8, 1, 0, "水平速度使能: 0=无效 1=设置 2=获取 3=增加 4=减小"),
+    CUAV_FIELD(CUAVServoControl, speed_h, CUAV_FIELD_U8, 1, 0, "水平速度 [1,200]"),
+    CUAV_FIELD(CUAVServoControl, speed_en_v, CUAV_FIELD_U8, 1, 0, "垂直速度使能"),
+    CUAV_FIELD(CUAVServoControl, speed_v, CUAV_FIELD_U8, 1, 0, "垂直速度 [1,200]"),
+    CUAV_FIELD(CUAVServoControl, loc_en_h, CUAV_FIELD_U8, 1, 0, "水平位置使能: 0=无效 1=设置 2=获取 3=增加 4=减小"),
+    CUAV_FIELD(CUAVServoControl, loc_h, CUAV_FIELD_F32, 1, 4, "水平位置(度)"),
+    CUAV_FIELD(CUAVServoControl, loc_en_v, CUAV_FIELD_U8, 1, 0, "垂直位置使能"),
+    CUAV_FIELD(CUAVServoControl, loc_v, CUAV_FIELD_F32, 1, 4, "垂直位置(度)"),
+    CUAV_FIELD(CUAVServoControl, offset_en, CUAV_FIELD_U8, 1, 0, "脱靶量使能"),
+    CUAV_FIELD(CUAVServoControl, offset_h, CUAV_FIELD_I16, 1, 0, "水平脱靶量(像素)"),
+    CUAV_FIELD(CUAVServoControl, offset_v, CUAV_FIELD_I16, 1, 0, "垂直脱靶量(像素)"),
+};
+
+static const CUAVFieldDesc cuav_fields_CUAVPTControl[] = {
+    CUAV_FIELD(CUAVPTControl, pt_focal_en, CUAV_FIELD_U8, 1, 0, "焦距使能: 0=无效 1=设置 2=获取 3=增加 4=减小"),
+    CUAV_FIELD(CUAVPTControl, pt_focal, CUAV_FIELD_F32, 1, 1, "可见光焦距"),
+};
+
+static const CUAVFieldDesc cuav_fields_CUAVIRControl[] = {
+    CUAV_FIELD(CUAVIRControl, ir_focal_en, CUAV_FIELD_U8, 1, 0, "焦距使能: 0=无效 1=设置 2=获取 3=增加 4=减小"),
+    CUAV_FIELD(CUAVIRControl, ir_focal, CUAV_FIELD_F32, 1, 1, "红外焦距"),
+};
+
+const CUAVMessageDesc cuav_message_descs[CUAV_MSG_INDEX_COUNT] = {
+    {CUAV_MSG_ID_CMD, CUAV_MSG_INDEX_CMD, "指令", "CUAVCommand", sizeof(CUAVCommand),
+     cuav_fields_CUAVCommand, G_N_ELEMENTS(cuav_fields_CUAVCommand)},
+    {CUAV_MSG_ID_DEV_CONFIG, CUAV_MSG_INDEX_DEV_CONFIG, "设备配置参数", "CUAVDevConfig", sizeof(CUAVDevConfig),
+     cuav_fields_CUAVDevConfig, G_N_ELEMENTS(cuav_fields_CUAVDevConfig)},
+    {CUAV_MSG_ID_GUIDANCE, CUAV_MSG_INDEX_GUIDANCE, "引导信息", "CUAVGuidanceInfo", sizeof(CUAVGuidanceInfo),
+     cuav_fields_CUAVGuidanceInfo, G_N_ELEMENTS(cuav_fields_CUAVGuidanceInfo)},
+    {CUAV_MSG_ID_TARGET1, CUAV_MSG_INDEX_TARGET1, "目标信息1", "CUAVTargetInfo", sizeof(CUAVTargetInfo),
+     cuav_fields_CUAVTargetInfo, G_N_ELEMENTS(cuav_fields_CUAVTargetInfo)},
+    {CUAV_MSG_ID_TARGET2, CUAV_MSG_INDEX_TARGET2, "目标信息2", "CUAVTargetInfo", sizeof(CUAVTargetInfo),
+     cuav_fields_CUAVTargetInfo, G_N_ELEMENTS(cuav_fields_CUAVTargetInfo)},
+    {CUAV_MSG_ID_EO_SYSTEM, CUAV_MSG_INDEX_EO_SYSTEM, "光电系统参数", "CUAVEOSystemParam", sizeof(CUAVEOSystemParam),
+     cuav_fields_CUAVEOSystemParam, G_N_ELEMENTS(cuav_fields_CUAVEOSystemParam)},
+    {CUAV_MSG_ID_EO_BIT, CUAV_MSG_INDEX_EO_BIT, "光电BIT状态", "CUAVEOBitStatus", sizeof(CUAVEOBitStatus),
+     cuav_fields_CUAVEOBitStatus, G_N_ELEMENTS(cuav_fields_CUAVEOBitStatus)},
+    {CUAV_MSG_ID_EO_TRACK, CUAV_MSG_INDEX_EO_TRACK, "光电跟踪控制", "CUAVTrackControl", sizeof(CUAVTrackControl),
+     cuav_fields_CUAVTrackControl, G_N_ELEMENTS(cuav_fields_CUAVTrackControl)},
+    {CUAV_MSG_ID_EO_SERVO, CUAV_MSG_INDEX_EO_SERVO, "光电伺服控制", "CUAVServoControl", sizeof(CUAVServoControl),
+     cuav_fields_CUAVServoControl, G_N_ELEMENTS(cuav_fields_CUAVServoControl)},
+    {CUAV_MSG_ID_EO_PT, CUAV_MSG_INDEX_EO_PT, "可见光控制", "CUAVPTControl", sizeof(CUAVPTControl),
+     cuav_fields_CUAVPTControl, G_N_ELEMENTS(cuav_fields_CUAVPTControl)},
+    {CUAV_MSG_ID_EO_IR, CUAV_MSG_INDEX_EO_IR, "红外控制", "CUAVIRControl", sizeof(CUAVIRControl),
+     cuav_fields_CUAVIRControl, G_N_ELEMENTS(cuav_fields_CUAVIRControl)},
+    {CUAV_MSG_ID_EO_DM, CUAV_MSG_INDEX_EO_DM, "光电测距控制", NULL, 0, NULL, 0},
+    {CUAV_MSG_ID_EO_BOX, CUAV_MSG_INDEX_EO_BOX, "手框目标区", NULL, 0, NULL, 0},
+    {CUAV_MSG_ID_EO_REC, CUAV_MSG_INDEX_EO_REC, "光电录像", NULL, 0, NULL, 0},
+    {CUAV_MSG_ID_EO_AUX, CUAV_MSG_INDEX_EO_AUX, "配套控制", NULL, 0, NULL, 0},
+    {CUAV_MSG_ID_EO_IMG, CUAV_MSG_INDEX_EO_IMG, "图像控制", NULL, 0, NULL, 0},
+};
+
+/* msg_id 0x71xx: 低字节 -> 描述表下标 + 1（0 表示未知） */
+static const guint8 cuav_desc_page_71[256] = {
+    0, 1, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 3, 4, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+/* msg_id 0x72xx: 低字节 -> 描述表下标 + 1（0 表示未知） */
+static const guint8 cuav_desc_page_72[256] = {
+    0, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+const CUAVMessageDesc *cuav_message_desc_lookup(guint16 msg_id)
+{
+    const guint8 *page = NULL;
+    guint8 idx = 0;
+
+    switch (msg_id >> 8)
+    {
+    case 0x71:
+        page = cuav_desc_page_71;
+        break;
+    case 0x72:
+        page = cuav_desc_page_72;
+        break;
+    default:
+        return NULL;
+    }
+
+    idx = page[msg_id & 0xFF];
+    return idx ? &cuav_message_descs[idx - 1] : NULL;
+}
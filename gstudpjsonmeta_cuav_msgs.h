@@ -0,0 +1,359 @@
+/* 由 python_tools/cuav_codegen.py 根据 python_tools/cuav_schema.json 生成，请勿手工修改 */
+#ifndef __GST_UDPJSON_META_CUAV_MSGS_H__
+#define __GST_UDPJSON_META_CUAV_MSGS_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief C-UAV 报文ID常量定义
+ */
+typedef enum
+{
+    CUAV_MSG_ID_CMD = 0x7101,         /* 指令 */
+    CUAV_MSG_ID_DEV_CONFIG = 0x7102,  /* 设备配置参数 */
+    CUAV_MSG_ID_GUIDANCE = 0x7111,    /* 引导信息 */
+    CUAV_MSG_ID_TARGET1 = 0x7112,     /* 目标信息1 */
+    CUAV_MSG_ID_TARGET2 = 0x7113,     /* 目标信息2 */
+    CUAV_MSG_ID_EO_SYSTEM = 0x7201,   /* 光电系统参数 */
+    CUAV_MSG_ID_EO_BIT = 0x7202,      /* 光电BIT状态 */
+    CUAV_MSG_ID_EO_TRACK = 0x7203,    /* 光电跟踪控制 */
+    CUAV_MSG_ID_EO_SERVO = 0x7204,    /* 光电伺服控制 */
+    CUAV_MSG_ID_EO_PT = 0x7205,       /* 可见光控制 */
+    CUAV_MSG_ID_EO_IR = 0x7206,       /* 红外控制 */
+    CUAV_MSG_ID_EO_DM = 0x7207,       /* 光电测距控制 */
+    CUAV_MSG_ID_EO_BOX = 0x7208,      /* 手框目标区 */
+    CUAV_MSG_ID_EO_REC = 0x7209,      /* 光电录像 */
+    CUAV_MSG_ID_EO_AUX = 0x720A,      /* 配套控制 */
+    CUAV_MSG_ID_EO_IMG = 0x720B       /* 图像控制 */
+} CUAVMessageId;
+
+/**
+ * @brief 报文描述表下标
+ */
+typedef enum
+{
+    CUAV_MSG_INDEX_CMD,
+    CUAV_MSG_INDEX_DEV_CONFIG,
+    CUAV_MSG_INDEX_GUIDANCE,
+    CUAV_MSG_INDEX_TARGET1,
+    CUAV_MSG_INDEX_TARGET2,
+    CUAV_MSG_INDEX_EO_SYSTEM,
+    CUAV_MSG_INDEX_EO_BIT,
+    CUAV_MSG_INDEX_EO_TRACK,
+    CUAV_MSG_INDEX_EO_SERVO,
+    CUAV_MSG_INDEX_EO_PT,
+    CUAV_MSG_INDEX_EO_IR,
+    CUAV_MSG_INDEX_EO_DM,
+    CUAV_MSG_INDEX_EO_BOX,
+    CUAV_MSG_INDEX_EO_REC,
+    CUAV_MSG_INDEX_EO_AUX,
+    CUAV_MSG_INDEX_EO_IMG,
+    CUAV_MSG_INDEX_COUNT
+} CUAVMessageIndex;
+
+/**
+ * @brief 指令结构体 (msg_id = 0x7101)
+ */
+typedef struct
+{
+    guint16 cmd_id;       /* 指令ID */
+    guint16 cmd_coef1;    /* 指令参数1 */
+} CUAVCommand;
+
+/**
+ * @brief 设备配置参数结构体 (msg_id = 0x7102)
+ */
+typedef struct
+{
+    guint8 sys_set;       /* 系统设置: 1=设置 2=查询反馈 */
+    gdouble lon;          /* 经度 */
+    gdouble lat;          /* 纬度 */
+    gdouble alt;          /* 高度 */
+    guint16 sys_id;       /* 系统号 */
+    guint16 dev_type;     /* 设备类型 */
+    guint16 dev_id;       /* 设备编号 */
+    guint16 subdev_id;    /* 分系统编号 */
+    guint8 net_set;       /* 网络设置 */
+    gchar loc_ip[16];     /* 本机IP */
+    guint16 loc_port;     /* 本机端口 */
+    gchar bit_mas_ip[16]; /* BIT主机IP */
+    guint16 bit_mas_port; /* BIT主机端口 */
+    gchar mas_ip[16];     /* 主机IP */
+    guint16 mas_port;     /* 主机端口 */
+    guint8 proc_set;      /* 处理设置 */
+    gfloat nor_agle;      /* 北向角(度) */
+    gfloat azi_agle;      /* 方位安装角(度) */
+    gfloat elv_agle;      /* 俯仰安装角(度) */
+    guint8 trk_set;       /* 跟踪设置 */
+    guint8 fb_set;        /* 回馈设置 */
+    gchar version[32];    /* 软件版本 */
+} CUAVDevConfig;
+
+/**
+ * @brief 引导信息结构体 (msg_id = 0x7111)
+ */
+typedef struct
+{
+    guint16 yr;           /* 年 */
+    guint8 mo;            /* 月 */
+    guint8 dy;            /* 日 */
+    guint8 h;             /* 时 */
+    guint8 min;           /* 分 */
+    guint8 sec;           /* 秒 */
+    gfloat msec;          /* 毫秒 */
+    guint32 tar_id;       /* 引导批号 */
+    guint16 tar_category; /* 目标类别 */
+    guint8 guid_stat;     /* 目标状态: 0=取消 1=正常 2=外推 */
+    gdouble ecef_x;       /* 地心坐标 X */
+    gdouble ecef_y;       /* 地心坐标 Y */
+    gdouble ecef_z;       /* 地心坐标 Z */
+    gdouble ecef_vx;      /* 速度 X */
+    gdouble ecef_vy;      /* 速度 Y */
+    gdouble ecef_vz;      /* 速度 Z */
+    gfloat h_dvi_pct;     /* 水平偏差百分比 */
+    gfloat v_dvi_pct;     /* 垂直偏差百分比 */
+    gdouble enu_r;        /* 目标距离 */
+    gdouble enu_a;        /* 目标方位 */
+    gdouble enu_e;        /* 目标俯仰 */
+    gdouble enu_v;        /* 目标速度 */
+    gdouble enu_h;        /* 目标相对高度 */
+    gdouble lon;          /* 经度 */
+    gdouble lat;          /* 纬度 */
+    gdouble alt;          /* 高度 */
+} CUAVGuidanceInfo;
+
+/**
+ * @brief 目标信息1结构体 (msg_id = 0x7112/0x7113)
+ */
+typedef struct
+{
+    guint16 yr;           /* 年 */
+    guint8 mo;            /* 月 */
+    guint8 dy;            /* 日 */
+    guint8 h;             /* 时 */
+    guint8 min;           /* 分 */
+    guint8 sec;           /* 秒 */
+    gfloat msec;          /* 毫秒 */
+    guint8 dev_id;        /* 探测设备: 0=可见光 1=红外 */
+    guint32 guid_id;      /* 关联的引导批号 */
+    guint32 tar_id;       /* 目标批号 */
+    guint8 trk_stat;      /* 目标状态: 0=丢失 1=正常 2=外推 */
+    guint8 trk_mod;       /* 跟踪模式: 0=自动 1=半自动 2=手动 */
+    gdouble tar_a;        /* 目标方位(度) */
+    gdouble tar_e;        /* 目标俯仰(度) */
+    gfloat tar_av;        /* 方位角速度(度/秒) */
+    gfloat tar_ev;        /* 俯仰角速度(度/秒) */
+    gdouble tar_rng;      /* 目标距离(米) */
+    gfloat tar_rv;        /* 径向速度(米/秒) */
+    guint16 tar_category; /* 目标类别 */
+    gchar tar_iden[16];   /* 目标识别结果 */
+    gfloat tar_cfid;      /* 置信度 */
+    gint16 offset_h;      /* 水平脱靶量(像素) */
+    gint16 offset_v;      /* 垂直脱靶量(像素) */
+    gint32 tar_rect[4];   /* 目标框 x,y,w,h (像素) */
+    gfloat fov_h;         /* 水平视场/指向 */
+    gfloat fov_v;         /* 垂直视场/指向 */
+    guint16 tar_sum;      /* 目标总数 */
+    gdouble lon;          /* 经度 */
+    gdouble lat;          /* 纬度 */
+    gdouble alt;          /* 高度 */
+} CUAVTargetInfo;
+
+/**
+ * @brief 光电系统参数结构体 (msg_id = 0x7201)
+ */
+typedef struct
+{
+    guint8 sv_stat;       /* 伺服状态: 0=无效 1=正常 2=自检 3=预热 4=错误 */
+    guint16 sv_err;       /* 伺服错误代码 */
+    guint8 st_mode_h;     /* 伺服水平模式: 0=手动 1=跟踪 */
+    guint8 st_mode_v;     /* 伺服垂直模式: 0=手动 1=跟踪 */
+    gfloat st_loc_h;      /* 伺服水平指向(度) [0,360] */
+    gfloat st_loc_v;      /* 伺服垂直指向(度) [-90,90] */
+    guint8 pt_stat;       /* 可见光状态 */
+    guint16 pt_err;       /* 可见光错误代码 */
+    gfloat pt_focal;      /* 可见光焦距 [134-16298] */
+    guint16 pt_focus;     /* 可见光聚焦 */
+    gfloat pt_fov_h;      /* 可见光水平视场 */
+    gfloat pt_fov_v;      /* 可见光垂直视场 */
+    guint8 ir_stat;       /* 红外状态 */
+    guint16 ir_err;       /* 红外错误代码 */
+    gfloat ir_focal;      /* 红外焦距 [851-1223] */
+    guint16 ir_focus;     /* 红外聚焦 */
+    gfloat ir_fov_h;      /* 红外水平视场 */
+    gfloat ir_fov_v;      /* 红外垂直视场 */
+    guint8 dm_stat;       /* 测距状态 */
+    guint16 dm_err;       /* 测距错误代码 */
+    guint8 dm_dev;        /* 测距设备 */
+    guint8 trk_dev;       /* 跟踪设备: 0=可见光 1=红外 3=多传感器联动 */
+    guint8 pt_trk_link;   /* 光电联动: 0=停止 1=开始 */
+    guint8 ir_trk_link;   /* 红外联动: 0=停止 1=开始 */
+    guint8 trk_str;       /* 跟踪开关: 0=停止 1=开始 */
+    guint8 trk_mod;       /* 跟踪模式: 0=自动 1=半自动 2=手动 */
+    guint8 det_trk;       /* 检测跟踪: 0=检测 1=识别 */
+    guint8 trk_stat;      /* 目标状态: 0=非跟踪 1=跟踪正常 3=失锁 4=丢失 */
+    guint8 pt_zoom;       /* 可见光自动变倍: 0=不自动 1=自动 */
+    guint8 ir_zoom;       /* 红外自动变倍: 0=不自动 1=自动 */
+    guint8 pt_focus_mode; /* 可见光聚焦模式: 0=自动 1=手动 */
+    guint8 ir_focus_mode; /* 红外聚焦模式: 0=自动 1=手动 */
+} CUAVEOSystemParam;
+
+/**
+ * @brief 光电BIT状态结构体 (msg_id = 0x7202)
+ */
+typedef struct
+{
+    guint8 sv_stat_h;     /* 水平伺服状态 */
+    guint8 sv_stat_v;     /* 垂直伺服状态 */
+    guint8 sv_pwr;        /* 伺服供电 */
+    gfloat sv_max_t;      /* 伺服最高温度 */
+    guint8 pt_stat;       /* 可见光状态 */
+    guint16 pt_err;       /* 可见光错误代码 */
+    guint8 pt_pwr;        /* 可见光供电 */
+    gfloat pt_max_t;      /* 可见光最高温度 */
+    gfloat pt_avg_t;      /* 可见光平均温度 */
+    guint8 ir_stat;       /* 红外状态 */
+    guint16 ir_err;       /* 红外错误代码 */
+    guint8 ir_pwr;        /* 红外供电 */
+    gfloat ir_max_t;      /* 红外最高温度 */
+    gfloat ir_avg_t;      /* 红外平均温度 */
+    guint8 laster_stat;   /* 激光状态（协议字段名如此） */
+    guint16 laster_err;   /* 激光错误代码（协议字段名如此） */
+    guint8 laser_pwr;     /* 激光供电 */
+    gfloat laser_max_t;   /* 激光最高温度 */
+    gfloat laser_avg_t;   /* 激光平均温度 */
+    guint8 wiper_stat;    /* 雨刷状态 */
+    guint8 defrost_stat;  /* 除霜状态 */
+    guint8 ofr_stat;      /* 其他状态 */
+} CUAVEOBitStatus;
+
+/**
+ * @brief 光电跟踪控制结构体 (msg_id = 0x7203)
+ */
+typedef struct
+{
+    guint8 trk_end;       /* 跟踪模块开关: 0=关闭 1=开启 */
+    guint8 pt_trk_link;   /* 可见光联动: 0=停止 1=开始 */
+    guint8 ir_trk_link;   /* 红外联动: 0=停止 1=开始 */
+    guint8 trk_str;       /* 跟踪开关: 0=停止 1=开始 */
+    guint8 trk_dev;       /* 跟踪设备: 0=可见光 1=红外 3=多传感器联动 */
+    guint8 trk_mod;       /* 跟踪模式: 0=自动 1=半自动 2=手动 */
+    guint8 det_trk;       /* 检测跟踪: 0=检测 1=识别 */
+} CUAVTrackControl;
+
+/**
+ * @brief 光电伺服控制结构体 (msg_id = 0x7204)
+ */
+typedef struct
+{
+    guint8 dev_id;        /* 设备类型: 0=可见光 1=红外 2=两者 */
+    guint8 dev_en;        /* 使能: 0=关闭 1=上电 */
+    guint8 ctrl_en;       /* 控制使能: 0=无效 1=有效 */
+    guint8 mode_h;        /* 水平控制模式: 0=手动 1=跟踪 */
+    guint8 mode_v;        /* 垂直控制模式: 0=手动 1=跟踪 */
+    guint8 speed_en_h;    /* 水平速度使能: 0=无效 1=设置 2=获取 3=增加 4=减小 */
+    guint8 speed_h;       /* 水平速度 [1,200] */
+    guint8 speed_en_v;    /* 垂直速度使能 */
+    guint8 speed_v;       /* 垂直速度 [1,200] */
+    guint8 loc_en_h;      /* 水平位置使能: 0=无效 1=设置 2=获取 3=增加 4=减小 */
+    gfloat loc_h;         /* 水平位置(度) */
+    guint8 loc_en_v;      /* 垂直位置使能 */
+    gfloat loc_v;         /* 垂直位置(度) */
+    guint8 offset_en;     /* 脱靶量使能 */
+    gint16 offset_h;      /* 水平脱靶量(像素) */
+    gint16 offset_v;      /* 垂直脱靶量(像素) */
+} CUAVServoControl;
+
+/**
+ * @brief 可见光控制结构体 (msg_id = 0x7205)
+ */
+typedef struct
+{
+    guint8 pt_focal_en;   /* 焦距使能: 0=无效 1=设置 2=获取 3=增加 4=减小 */
+    gfloat pt_focal;      /* 可见光焦距 */
+} CUAVPTControl;
+
+/**
+ * @brief 红外控制结构体 (msg_id = 0x7206)
+ */
+typedef struct
+{
+    guint8 ir_focal_en;   /* 焦距使能: 0=无效 1=设置 2=获取 3=增加 4=减小 */
+    gfloat ir_focal;      /* 红外焦距 */
+} CUAVIRControl;
+
+/**
+ * @brief 可容纳任一报文结构体的联合体
+ */
+typedef union
+{
+    CUAVCommand cmd;
+    CUAVDevConfig dev_config;
+    CUAVGuidanceInfo guidance;
+    CUAVTargetInfo target1;
+    CUAVEOSystemParam eo_system;
+    CUAVEOBitStatus eo_bit;
+    CUAVTrackControl eo_track;
+    CUAVServoControl eo_servo;
+    CUAVPTControl eo_pt;
+    CUAVIRControl eo_ir;
+} CUAVMessageUnion;
+
+/**
+ * @brief 字段类型
+ */
+typedef enum
+{
+    CUAV_FIELD_U8,        /* guint8 */
+    CUAV_FIELD_U16,       /* guint16 */
+    CUAV_FIELD_I16,       /* gint16 */
+    CUAV_FIELD_U32,       /* guint32 */
+    CUAV_FIELD_I32,       /* gint32 */
+    CUAV_FIELD_F32,       /* gfloat */
+    CUAV_FIELD_F64,       /* gdouble */
+    CUAV_FIELD_STR,       /* gchar */
+} CUAVFieldType;
+
+/**
+ * @brief 字段描述
+ */
+typedef struct
+{
+    const gchar *name;        /* JSON 字段名 */
+    CUAVFieldType type;       /* 字段类型 */
+    guint16 offset;           /* 结构体内偏移 */
+    guint16 count;            /* 数组元素数/字符串缓冲区长度，标量为 1 */
+    guint8 decimals;          /* 编码浮点数的小数位 */
+    const gchar *desc;        /* 字段说明 */
+} CUAVFieldDesc;
+
+/**
+ * @brief 报文描述
+ */
+typedef struct
+{
+    guint16 msg_id;           /* 报文ID */
+    CUAVMessageIndex index;   /* 描述表下标 */
+    const gchar *name;        /* 报文名称 */
+    const gchar *struct_name; /* 结构体名，NULL 表示协议未定义字段（仅报文头） */
+    gsize size;               /* 结构体大小 */
+    const CUAVFieldDesc *fields; /* 字段描述 */
+    guint n_fields;           /* 字段数 */
+} CUAVMessageDesc;
+
+/* 全部报文描述，按 CUAVMessageIndex 排列 */
+extern const CUAVMessageDesc cuav_message_descs[CUAV_MSG_INDEX_COUNT];
+
+/**
+ * @brief 按 msg_id 查找报文描述（常数时间）
+ *
+ * @param msg_id 报文ID
+ * @return 报文描述，未知报文返回 NULL
+ */
+const CUAVMessageDesc *cuav_message_desc_lookup(guint16 msg_id);
+
+G_END_DECLS
+
+#endif /* __GST_UDPJSON_META_CUAV_MSGS_H__ */
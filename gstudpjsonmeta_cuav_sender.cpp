@@ -0,0 +1,618 @@
+#include "gstudpjsonmeta_cuav_sender.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <math.h>
+#include <net/if.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <gst/gst.h>
+
+/**
+ * @brief C-UAV 报文编码器（私有结构体）
+ */
+struct _CUAVEncoder
+{
+    gint msg_sn;              /* 报文计数（原子递增） */
+    gchar addr_json[256];     /* 预格式化的收发地址片段 */
+    gsize addr_len;           /* 收发地址片段长度 */
+    glong utc_offset_s;       /* 本地时区偏移(秒)，创建时确定 */
+};
+
+/**
+ * @brief C-UAV 组播发送器（私有结构体）
+ */
+struct _CUAVSender
+{
+    gint sockfd;              /* UDP 套接字 */
+    struct sockaddr_in dest;  /* 目的地址 */
+    CUAVEncoder *encoder;     /* 报文编码器 */
+    guint64 sent;             /* 已发送报文数 */
+    guint64 dropped;          /* 丢弃报文数 */
+};
+
+/**
+ * @brief 就地写 JSON 的游标，溢出后后续写入全部忽略
+ */
+typedef struct
+{
+    gchar *p;
+    gchar *end;
+    gboolean overflow;
+} CUAVWriter;
+
+static void cuav_w_raw(CUAVWriter *w, const gchar *s, gsize n)
+{
+    if (w->overflow || (gsize)(w->end - w->p) < n)
+    {
+        w->overflow = TRUE;
+        return;
+    }
+    memcpy(w->p, s, n);
+    w->p += n;
+}
+
+/* 写入字面量片段（编译期确定长度） */
+#define CUAV_W_LIT(w, s) cuav_w_raw((w), (s), sizeof(s) - 1)
+
+static void cuav_w_uint(CUAVWriter *w, guint64 v)
+{
+    gchar tmp[20];
+    gint n = 0;
+    do
+    {
+        tmp[sizeof(tmp) - 1 - n] = (gchar)('0' + v % 10);
+        v /= 10;
+        n++;
+    } while (v);
+    cuav_w_raw(w, tmp + sizeof(tmp) - n, (gsize)n);
+}
+
+static void cuav_w_int(CUAVWriter *w, gint64 v)
+{
+    if (v < 0)
+    {
+        CUAV_W_LIT(w, "-");
+        cuav_w_uint(w, (guint64)0 - (guint64)v);
+        return;
+    }
+    cuav_w_uint(w, (guint64)v);
+}
+
+/**
+ * @brief 以定点格式写入浮点数（固定小数位，不经 printf）
+ */
+static void cuav_w_fixed(CUAVWriter *w, gdouble v, guint decimals)
+{
+    static const guint64 scales[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000};
+    guint64 scale = 0;
+    guint64 scaled = 0;
+    guint64 frac = 0;
+    gchar tmp[8];
+
+    if (!isfinite(v))
+    {
+        CUAV_W_LIT(w, "0");
+        return;
+    }
+    if (decimals >= G_N_ELEMENTS(scales))
+        decimals = G_N_ELEMENTS(scales) - 1;
+    scale = scales[decimals];
+
+    /* 超出定点范围时退回通用格式 */
+    if (fabs(v) * (gdouble)scale >= 9.0e18)
+    {
+        gchar dbuf[G_ASCII_DTOSTR_BUF_SIZE];
+        g_ascii_dtostr(dbuf, sizeof(dbuf), v);
+        cuav_w_raw(w, dbuf, strlen(dbuf));
+        return;
+    }
+
+    if (v < 0)
+    {
+        scaled = (guint64)(-v * (gdouble)scale + 0.5);
+        if (scaled)
+            CUAV_W_LIT(w, "-");
+    }
+    else
+    {
+        scaled = (guint64)(v * (gdouble)scale + 0.5);
+    }
+
+    cuav_w_uint(w, scaled / scale);
+    if (decimals == 0)
+        return;
+
+    frac = scaled % scale;
+    for (guint i = decimals; i > 0; i--)
+    {
+        tmp[i - 1] = (gchar)('0' + frac % 10);
+        frac /= 10;
+    }
+    CUAV_W_LIT(w, ".");
+    cuav_w_raw(w, tmp, decimals);
+}
+
+/**
+ * @brief 由 1970-01-01 起的天数换算公历日期（无锁，不依赖 localtime）
+ */
+static void cuav_civil_from_days(gint64 days, gint *yr, guint *mo, guint *dy)
+{
+    gint64 z = days + 719468;
+    gint64 era = (z >= 0 ? z : z - 146096) / 146097;
+    guint doe = (guint)(z - era * 146097);
+    guint yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    guint doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    guint mp = (5 * doy + 2) / 153;
+
+    *dy = doy - (153 * mp + 2) / 5 + 1;
+    *mo = mp < 10 ? mp + 3 : mp - 9;
+    *yr = (gint)(yoe + era * 400) + (*mo <= 2 ? 1 : 0);
+}
+
+/**
+ * @brief 写入公共报文头（msg_id 至 cont_sum）
+ *
+ * 时间字段为本地时间，时区偏移在编码器创建时确定，夏令时切换需重建编码器。
+ */
+static void cuav_w_common_header(CUAVEncoder *encoder, CUAVWriter *w, guint16 msg_id,
+                                 guint8 msg_type, guint8 cont_type)
+{
+    struct timespec ts;
+    gint64 local_s = 0;
+    gint64 days = 0;
+    gint64 sod = 0;
+    gint yr = 0;
+    guint mo = 0;
+    guint dy = 0;
+    guint32 msg_sn = (guint32)g_atomic_int_add(&encoder->msg_sn, 1) + 1;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    local_s = (gint64)ts.tv_sec + encoder->utc_offset_s;
+    days = local_s >= 0 ? local_s / 86400 : (local_s - 86399) / 86400;
+    sod = local_s - days * 86400;
+    cuav_civil_from_days(days, &yr, &mo, &dy);
+
+    CUAV_W_LIT(w, "{\"msg_id\":");
+    cuav_w_uint(w, msg_id);
+    CUAV_W_LIT(w, ",\"msg_sn\":");
+    cuav_w_uint(w, msg_sn);
+    CUAV_W_LIT(w, ",\"msg_type\":");
+    cuav_w_uint(w, msg_type);
+    cuav_w_raw(w, encoder->addr_json, encoder->addr_len);
+    CUAV_W_LIT(w, ",\"yr\":");
+    cuav_w_int(w, yr);
+    CUAV_W_LIT(w, ",\"mo\":");
+    cuav_w_uint(w, mo);
+    CUAV_W_LIT(w, ",\"dy\":");
+    cuav_w_uint(w, dy);
+    CUAV_W_LIT(w, ",\"h\":");
+    cuav_w_uint(w, (guint64)(sod / 3600));
+    CUAV_W_LIT(w, ",\"min\":");
+    cuav_w_uint(w, (guint64)(sod / 60 % 60));
+    CUAV_W_LIT(w, ",\"sec\":");
+    cuav_w_uint(w, (guint64)(sod % 60));
+    CUAV_W_LIT(w, ",\"msec\":");
+    cuav_w_fixed(w, ts.tv_nsec / 1e6, 3);
+    CUAV_W_LIT(w, ",\"cont_type\":");
+    cuav_w_uint(w, cont_type);
+    CUAV_W_LIT(w, ",\"cont_sum\":1");
+}
+
+/**
+ * @brief 结束编码，返回长度（溢出返回 0）
+ */
+static gsize cuav_w_finish(CUAVWriter *w, gchar *buf)
+{
+    CUAV_W_LIT(w, "}");
+    if (w->overflow)
+        return 0;
+    /* 预留结尾 '\0'，便于调试打印 */
+    if (w->p >= w->end)
+        return 0;
+    *w->p = '\0';
+    return (gsize)(w->p - buf);
+}
+
+CUAVEncoder *cuav_encoder_new(const CUAVAddressing *addressing)
+{
+    CUAVEncoder *encoder = (CUAVEncoder *)g_malloc0(sizeof(CUAVEncoder));
+    CUAVAddressing def = {999, 1, 999, 999, 999, 1, 999, 999};
+    const CUAVAddressing *a = addressing ? addressing : &def;
+    time_t now = time(NULL);
+    struct tm tm_local;
+
+    encoder->addr_len = (gsize)g_snprintf(
+        encoder->addr_json, sizeof(encoder->addr_json),
+        ",\"tx_sys_id\":%u,\"tx_dev_type\":%u,\"tx_dev_id\":%u,\"tx_subdev_id\":%u"
+        ",\"rx_sys_id\":%u,\"rx_dev_type\":%u,\"rx_dev_id\":%u,\"rx_subdev_id\":%u",
+        a->tx_sys_id, a->tx_dev_type, a->tx_dev_id, a->tx_subdev_id,
+        a->rx_sys_id, a->rx_dev_type, a->rx_dev_id, a->rx_subdev_id);
+
+    memset(&tm_local, 0, sizeof(tm_local));
+    if (localtime_r(&now, &tm_local))
+        encoder->utc_offset_s = tm_local.tm_gmtoff;
+
+    return encoder;
+}
+
+void cuav_encoder_free(CUAVEncoder *encoder)
+{
+    if (encoder)
+    {
+        g_free(encoder);
+    }
+}
+
+gsize cuav_encode_servo_control(CUAVEncoder *encoder, const CUAVServoControl *servo,
+                                gchar *buf, gsize size)
+{
+    CUAVWriter w = {buf, buf + size, FALSE};
+
+    if (!encoder || !servo || !buf || size == 0)
+        return 0;
+
+    cuav_w_common_header(encoder, &w, CUAV_MSG_ID_EO_SERVO, CUAV_MSG_TYPE_CTRL, 0);
+    /* cmd_id 与 Python 工具/模拟器的控制指令分发保持兼容 */
+    CUAV_W_LIT(&w, ",\"cmd_id\":29188,\"cmd_coef1\":0");
+    CUAV_W_LIT(&w, ",\"dev_id\":");
+    cuav_w_uint(&w, servo->dev_id);
+    CUAV_W_LIT(&w, ",\"dev_en\":");
+    cuav_w_uint(&w, servo->dev_en);
+    CUAV_W_LIT(&w, ",\"ctrl_en\":");
+    cuav_w_uint(&w, servo->ctrl_en);
+    CUAV_W_LIT(&w, ",\"mode_h\":");
+    cuav_w_uint(&w, servo->mode_h);
+    CUAV_W_LIT(&w, ",\"mode_v\":");
+    cuav_w_uint(&w, servo->mode_v);
+    CUAV_W_LIT(&w, ",\"speed_en_h\":");
+    cuav_w_uint(&w, servo->speed_en_h);
+    CUAV_W_LIT(&w, ",\"speed_h\":");
+    cuav_w_uint(&w, servo->speed_h);
+    CUAV_W_LIT(&w, ",\"speed_en_v\":");
+    cuav_w_uint(&w, servo->speed_en_v);
+    CUAV_W_LIT(&w, ",\"speed_v\":");
+    cuav_w_uint(&w, servo->speed_v);
+    CUAV_W_LIT(&w, ",\"loc_en_h\":");
+    cuav_w_uint(&w, servo->loc_en_h);
+    CUAV_W_LIT(&w, ",\"loc_h\":");
+    cuav_w_fixed(&w, servo->loc_h, 4);
+    CUAV_W_LIT(&w, ",\"loc_en_v\":");
+    cuav_w_uint(&w, servo->loc_en_v);
+    CUAV_W_LIT(&w, ",\"loc_v\":");
+    cuav_w_fixed(&w, servo->loc_v, 4);
+    CUAV_W_LIT(&w, ",\"offset_en\":");
+    cuav_w_uint(&w, servo->offset_en);
+    CUAV_W_LIT(&w, ",\"offset_h\":");
+    cuav_w_int(&w, servo->offset_h);
+    CUAV_W_LIT(&w, ",\"offset_v\":");
+    cuav_w_int(&w, servo->offset_v);
+
+    return cuav_w_finish(&w, buf);
+}
+
+gsize cuav_encode_track_control(CUAVEncoder *encoder, const CUAVTrackControl *track,
+                                gchar *buf, gsize size)
+{
+    CUAVWriter w = {buf, buf + size, FALSE};
+
+    if (!encoder || !track || !buf || size == 0)
+        return 0;
+
+    cuav_w_common_header(encoder, &w, CUAV_MSG_ID_EO_TRACK, CUAV_MSG_TYPE_CTRL, 0);
+    CUAV_W_LIT(&w, ",\"cmd_id\":29187,\"cmd_coef1\":0");
+    CUAV_W_LIT(&w, ",\"trk_end\":");
+    cuav_w_uint(&w, track->trk_end);
+    CUAV_W_LIT(&w, ",\"pt_trk_link\":");
+    cuav_w_uint(&w, track->pt_trk_link);
+    CUAV_W_LIT(&w, ",\"ir_trk_link\":");
+    cuav_w_uint(&w, track->ir_trk_link);
+    CUAV_W_LIT(&w, ",\"trk_str\":");
+    cuav_w_uint(&w, track->trk_str);
+    CUAV_W_LIT(&w, ",\"trk_dev\":");
+    cuav_w_uint(&w, track->trk_dev);
+    CUAV_W_LIT(&w, ",\"trk_mod\":");
+    cuav_w_uint(&w, track->trk_mod);
+    CUAV_W_LIT(&w, ",\"det_trk\":");
+    cuav_w_uint(&w, track->det_trk);
+
+    return cuav_w_finish(&w, buf);
+}
+
+gsize cuav_encode_guidance(CUAVEncoder *encoder, const CUAVGuidanceInfo *guidance,
+                           gchar *buf, gsize size)
+{
+    CUAVWriter w = {buf, buf + size, FALSE};
+
+    if (!encoder || !guidance || !buf || size == 0)
+        return 0;
+
+    cuav_w_common_header(encoder, &w, CUAV_MSG_ID_GUIDANCE, CUAV_MSG_TYPE_CTRL, 1);
+    CUAV_W_LIT(&w, ",\"tar_id\":");
+    cuav_w_uint(&w, guidance->tar_id);
+    CUAV_W_LIT(&w, ",\"tar_category\":");
+    cuav_w_uint(&w, guidance->tar_category);
+    CUAV_W_LIT(&w, ",\"guid_stat\":");
+    cuav_w_uint(&w, guidance->guid_stat);
+    CUAV_W_LIT(&w, ",\"ecef_x\":");
+    cuav_w_fixed(&w, guidance->ecef_x, 3);
+    CUAV_W_LIT(&w, ",\"ecef_y\":");
+    cuav_w_fixed(&w, guidance->ecef_y, 3);
+    CUAV_W_LIT(&w, ",\"ecef_z\":");
+    cuav_w_fixed(&w, guidance->ecef_z, 3);
+    CUAV_W_LIT(&w, ",\"ecef_vx\":");
+    cuav_w_fixed(&w, guidance->ecef_vx, 3);
+    CUAV_W_LIT(&w, ",\"ecef_vy\":");
+    cuav_w_fixed(&w, guidance->ecef_vy, 3);
+    CUAV_W_LIT(&w, ",\"ecef_vz\":");
+    cuav_w_fixed(&w, guidance->ecef_vz, 3);
+    CUAV_W_LIT(&w, ",\"h_dvi_pct\":");
+    cuav_w_fixed(&w, guidance->h_dvi_pct, 3);
+    CUAV_W_LIT(&w, ",\"v_dvi_pct\":");
+    cuav_w_fixed(&w, guidance->v_dvi_pct, 3);
+    CUAV_W_LIT(&w, ",\"enu_r\":");
+    cuav_w_fixed(&w, guidance->enu_r, 3);
+    CUAV_W_LIT(&w, ",\"enu_a\":");
+    cuav_w_fixed(&w, guidance->enu_a, 4);
+    CUAV_W_LIT(&w, ",\"enu_e\":");
+    cuav_w_fixed(&w, guidance->enu_e, 4);
+    CUAV_W_LIT(&w, ",\"enu_v\":");
+    cuav_w_fixed(&w, guidance->enu_v, 3);
+    CUAV_W_LIT(&w, ",\"enu_h\":");
+    cuav_w_fixed(&w, guidance->enu_h, 3);
+    CUAV_W_LIT(&w, ",\"lon\":");
+    cuav_w_fixed(&w, guidance->lon, 7);
+    CUAV_W_LIT(&w, ",\"lat\":");
+    cuav_w_fixed(&w, guidance->lat, 7);
+    CUAV_W_LIT(&w, ",\"alt\":");
+    cuav_w_fixed(&w, guidance->alt, 3);
+
+    return cuav_w_finish(&w, buf);
+}
+
+/**
+ * @brief 写入 JSON 字符串（转义引号、反斜杠与控制字符）
+ */
+static void cuav_w_string(CUAVWriter *w, const gchar *s, gsize max_len)
+{
+    static const gchar hex[] = "0123456789abcdef";
+
+    CUAV_W_LIT(w, "\"");
+    for (gsize i = 0; i < max_len && s[i]; i++)
+    {
+        guchar c = (guchar)s[i];
+        if (c == '"' || c == '\\')
+        {
+            gchar esc[2] = {'\\', (gchar)c};
+            cuav_w_raw(w, esc, 2);
+        }
+        else if (c < 0x20)
+        {
+            gchar esc[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+            cuav_w_raw(w, esc, 6);
+        }
+        else
+        {
+            cuav_w_raw(w, (const gchar *)&c, 1);
+        }
+    }
+    CUAV_W_LIT(w, "\"");
+}
+
+/**
+ * @brief 字段是否已由公共报文头写出
+ */
+static gboolean cuav_is_header_field(const gchar *name)
+{
+    static const gchar *const header_fields[] = {"yr", "mo", "dy", "h", "min", "sec", "msec"};
+
+    for (guint i = 0; i < G_N_ELEMENTS(header_fields); i++)
+    {
+        if (strcmp(name, header_fields[i]) == 0)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+gsize cuav_encode_message(CUAVEncoder *encoder, guint16 msg_id, guint8 msg_type,
+                          gconstpointer msg, gchar *buf, gsize size)
+{
+    const CUAVMessageDesc *desc = cuav_message_desc_lookup(msg_id);
+    CUAVWriter w = {buf, buf + size, FALSE};
+
+    if (!encoder || !desc || (!msg && desc->n_fields > 0) || !buf || size == 0)
+        return 0;
+
+    cuav_w_common_header(encoder, &w, msg_id, msg_type, 0);
+    for (guint i = 0; i < desc->n_fields; i++)
+    {
+        const CUAVFieldDesc *f = &desc->fields[i];
+        gconstpointer p = G_STRUCT_MEMBER_P(msg, f->offset);
+
+        if (cuav_is_header_field(f->name))
+            continue;
+
+        CUAV_W_LIT(&w, ",\"");
+        cuav_w_raw(&w, f->name, strlen(f->name));
+        CUAV_W_LIT(&w, "\":");
+        switch (f->type)
+        {
+        case CUAV_FIELD_U8:
+            cuav_w_uint(&w, *(const guint8 *)p);
+            break;
+        case CUAV_FIELD_U16:
+            cuav_w_uint(&w, *(const guint16 *)p);
+            break;
+        case CUAV_FIELD_I16:
+            cuav_w_int(&w, *(const gint16 *)p);
+            break;
+        case CUAV_FIELD_U32:
+            cuav_w_uint(&w, *(const guint32 *)p);
+            break;
+        case CUAV_FIELD_I32:
+            CUAV_W_LIT(&w, "[");
+            for (guint k = 0; k < f->count; k++)
+            {
+                if (k > 0)
+                    CUAV_W_LIT(&w, ",");
+                cuav_w_int(&w, ((const gint32 *)p)[k]);
+            }
+            CUAV_W_LIT(&w, "]");
+            break;
+        case CUAV_FIELD_F32:
+            cuav_w_fixed(&w, *(const gfloat *)p, f->decimals);
+            break;
+        case CUAV_FIELD_F64:
+            cuav_w_fixed(&w, *(const gdouble *)p, f->decimals);
+            break;
+        case CUAV_FIELD_STR:
+            cuav_w_string(&w, (const gchar *)p, f->count);
+            break;
+        }
+    }
+
+    return cuav_w_finish(&w, buf);
+}
+
+CUAVSender *cuav_sender_new(const gchar *dest_ip, guint port, const gchar *iface,
+                            const CUAVAddressing *addressing)
+{
+    CUAVSender *sender = NULL;
+    guchar ttl = 1;
+
+    if (!dest_ip || port == 0 || port > 65535)
+        return NULL;
+
+    sender = (CUAVSender *)g_malloc0(sizeof(CUAVSender));
+    sender->sockfd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sender->sockfd < 0)
+    {
+        GST_ERROR("Failed to create C-UAV send socket: %s", strerror(errno));
+        g_free(sender);
+        return NULL;
+    }
+
+    memset(&sender->dest, 0, sizeof(sender->dest));
+    sender->dest.sin_family = AF_INET;
+    sender->dest.sin_port = htons((guint16)port);
+    if (inet_pton(AF_INET, dest_ip, &sender->dest.sin_addr) != 1)
+    {
+        GST_ERROR("Invalid C-UAV send address %s", dest_ip);
+        close(sender->sockfd);
+        g_free(sender);
+        return NULL;
+    }
+
+    if (setsockopt(sender->sockfd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0)
+    {
+        GST_WARNING("Failed to set IP_MULTICAST_TTL: %s", strerror(errno));
+    }
+
+    if (iface && strlen(iface) > 0)
+    {
+        struct ifreq ifr; /* 网卡信息 */
+        memset(&ifr, 0, sizeof(ifr));
+        strncpy(ifr.ifr_name, iface, IFNAMSIZ - 1);
+        if (ioctl(sender->sockfd, SIOCGIFADDR, &ifr) == 0)
+        {
+            struct sockaddr_in *sin = (struct sockaddr_in *)&ifr.ifr_addr; /* 网卡地址 */
+            if (setsockopt(sender->sockfd, IPPROTO_IP, IP_MULTICAST_IF, &sin->sin_addr,
+                           sizeof(sin->sin_addr)) < 0)
+            {
+                GST_WARNING("Failed to set IP_MULTICAST_IF %s: %s", iface, strerror(errno));
+            }
+        }
+    }
+
+    sender->encoder = cuav_encoder_new(addressing);
+    GST_INFO("C-UAV sender ready: %s:%u", dest_ip, port);
+    return sender;
+}
+
+void cuav_sender_free(CUAVSender *sender)
+{
+    if (!sender)
+        return;
+    if (sender->sockfd >= 0)
+        close(sender->sockfd);
+    cuav_encoder_free(sender->encoder);
+    g_free(sender);
+}
+
+/**
+ * @brief 非阻塞发送已编码报文，内核缓冲区满时直接丢弃
+ */
+static gboolean cuav_sender_send_raw(CUAVSender *sender, const gchar *buf, gsize len)
+{
+    ssize_t ret = 0;
+
+    if (len == 0)
+    {
+        __atomic_fetch_add(&sender->dropped, 1, __ATOMIC_RELAXED);
+        return FALSE;
+    }
+
+    ret = sendto(sender->sockfd, buf, len, MSG_DONTWAIT,
+                 (const struct sockaddr *)&sender->dest, sizeof(sender->dest));
+    if (ret < 0)
+    {
+        __atomic_fetch_add(&sender->dropped, 1, __ATOMIC_RELAXED);
+        GST_DEBUG("C-UAV send failed: %s", strerror(errno));
+        return FALSE;
+    }
+
+    __atomic_fetch_add(&sender->sent, 1, __ATOMIC_RELAXED);
+    return TRUE;
+}
+
+gboolean cuav_sender_send_servo_control(CUAVSender *sender, const CUAVServoControl *servo)
+{
+    gchar buf[CUAV_ENCODE_MAX_LEN];
+
+    if (!sender || !servo)
+        return FALSE;
+    return cuav_sender_send_raw(sender, buf,
+                                cuav_encode_servo_control(sender->encoder, servo, buf, sizeof(buf)));
+}
+
+gboolean cuav_sender_send_track_control(CUAVSender *sender, const CUAVTrackControl *track)
+{
+    gchar buf[CUAV_ENCODE_MAX_LEN];
+
+    if (!sender || !track)
+        return FALSE;
+    return cuav_sender_send_raw(sender, buf,
+                                cuav_encode_track_control(sender->encoder, track, buf, sizeof(buf)));
+}
+
+gboolean cuav_sender_send_guidance(CUAVSender *sender, const CUAVGuidanceInfo *guidance)
+{
+    gchar buf[CUAV_ENCODE_MAX_LEN];
+
+    if (!sender || !guidance)
+        return FALSE;
+    return cuav_sender_send_raw(sender, buf,
+                                cuav_encode_guidance(sender->encoder, guidance, buf, sizeof(buf)));
+}
+
+gboolean cuav_sender_send_message(CUAVSender *sender, guint16 msg_id, guint8 msg_type,
+                                  gconstpointer msg)
+{
+    gchar buf[CUAV_ENCODE_MAX_LEN];
+
+    if (!sender)
+        return FALSE;
+    return cuav_sender_send_raw(sender, buf,
+                                cuav_encode_message(sender->encoder, msg_id, msg_type, msg,
+                                                    buf, sizeof(buf)));
+}
+
+void cuav_sender_get_stats(CUAVSender *sender, guint64 *sent, guint64 *dropped)
+{
+    if (sent)
+        *sent = sender ? __atomic_load_n(&sender->sent, __ATOMIC_RELAXED) : 0;
+    if (dropped)
+        *dropped = sender ? __atomic_load_n(&sender->dropped, __ATOMIC_RELAXED) : 0;
+}
@@ -0,0 +1,176 @@
+#ifndef __GST_UDPJSON_META_CUAV_SENDER_H__
+#define __GST_UDPJSON_META_CUAV_SENDER_H__
+
+#include <glib.h>
+#include "gstudpjsonmeta_cuav.h"
+
+G_BEGIN_DECLS
+
+/* 单条 C-UAV 报文编码的最大长度 */
+#define CUAV_ENCODE_MAX_LEN 1024
+
+/**
+ * @brief 报文收发地址（公共报文头中的 tx/rx 字段）
+ */
+typedef struct
+{
+    guint16 tx_sys_id;        /* 发送方系统号 */
+    guint16 tx_dev_type;      /* 发送方设备类型 */
+    guint16 tx_dev_id;        /* 发送方设备编号 */
+    guint16 tx_subdev_id;     /* 发送方分系统编号 */
+    guint16 rx_sys_id;        /* 接收方系统号 */
+    guint16 rx_dev_type;      /* 接收方设备类型 */
+    guint16 rx_dev_id;        /* 接收方设备编号 */
+    guint16 rx_subdev_id;     /* 接收方分系统编号 */
+} CUAVAddressing;
+
+/**
+ * @brief C-UAV 报文编码器（不透明类型）
+ *
+ * 收发地址在创建时预格式化为 JSON 片段，编码时只就地格式化数值字段；
+ * msg_sn 由编码器原子递增维护，可在多个线程间共享。
+ */
+typedef struct _CUAVEncoder CUAVEncoder;
+
+/**
+ * @brief C-UAV 组播发送器（不透明类型）
+ */
+typedef struct _CUAVSender CUAVSender;
+
+/**
+ * @brief 创建编码器实例
+ *
+ * @param addressing 收发地址
+ * @return 编码器实例
+ */
+CUAVEncoder *cuav_encoder_new(const CUAVAddressing *addressing);
+
+/**
+ * @brief 释放编码器实例
+ *
+ * @param encoder 编码器实例
+ */
+void cuav_encoder_free(CUAVEncoder *encoder);
+
+/**
+ * @brief 编码光电伺服控制报文 (0x7204)
+ *
+ * @param encoder 编码器实例
+ * @param servo 伺服控制
+ * @param buf 输出缓冲区
+ * @param size 缓冲区大小
+ * @return 编码长度，缓冲区不足返回 0
+ */
+gsize cuav_encode_servo_control(CUAVEncoder *encoder, const CUAVServoControl *servo,
+                                gchar *buf, gsize size);
+
+/**
+ * @brief 编码光电跟踪控制报文 (0x7203)
+ *
+ * @param encoder 编码器实例
+ * @param track 跟踪控制
+ * @param buf 输出缓冲区
+ * @param size 缓冲区大小
+ * @return 编码长度，缓冲区不足返回 0
+ */
+gsize cuav_encode_track_control(CUAVEncoder *encoder, const CUAVTrackControl *track,
+                                gchar *buf, gsize size);
+
+/**
+ * @brief 编码引导信息报文 (0x7111)
+ *
+ * @param encoder 编码器实例
+ * @param guidance 引导信息
+ * @param buf 输出缓冲区
+ * @param size 缓冲区大小
+ * @return 编码长度，缓冲区不足返回 0
+ */
+gsize cuav_encode_guidance(CUAVEncoder *encoder, const CUAVGuidanceInfo *guidance,
+                           gchar *buf, gsize size);
+
+/**
+ * @brief 按报文描述表编码任意已定义报文
+ *
+ * 与公共报文头同名的字段（时间字段）由报文头给出，不重复写入。
+ *
+ * @param encoder 编码器实例
+ * @param msg_id 报文ID
+ * @param msg_type 报文类型 CUAVMessageType
+ * @param msg 对应的报文结构体
+ * @param buf 输出缓冲区
+ * @param size 缓冲区大小
+ * @return 编码长度，未知报文或缓冲区不足返回 0
+ */
+gsize cuav_encode_message(CUAVEncoder *encoder, guint16 msg_id, guint8 msg_type,
+                          gconstpointer msg, gchar *buf, gsize size);
+
+/**
+ * @brief 创建组播发送器
+ *
+ * @param dest_ip 目的组播地址
+ * @param port 目的端口
+ * @param iface 出口网卡名（可为 NULL）
+ * @param addressing 收发地址
+ * @return 发送器实例，失败返回 NULL
+ */
+CUAVSender *cuav_sender_new(const gchar *dest_ip, guint port, const gchar *iface,
+                            const CUAVAddressing *addressing);
+
+/**
+ * @brief 释放发送器实例
+ *
+ * @param sender 发送器实例
+ */
+void cuav_sender_free(CUAVSender *sender);
+
+/**
+ * @brief 非阻塞发送光电伺服控制
+ *
+ * @param sender 发送器实例
+ * @param servo 伺服控制
+ * @return 报文已交给内核返回 TRUE
+ */
+gboolean cuav_sender_send_servo_control(CUAVSender *sender, const CUAVServoControl *servo);
+
+/**
+ * @brief 非阻塞发送光电跟踪控制
+ *
+ * @param sender 发送器实例
+ * @param track 跟踪控制
+ * @return 报文已交给内核返回 TRUE
+ */
+gboolean cuav_sender_send_track_control(CUAVSender *sender, const CUAVTrackControl *track);
+
+/**
+ * @brief 非阻塞发送引导信息
+ *
+ * @param sender 发送器实例
+ * @param guidance 引导信息
+ * @return 报文已交给内核返回 TRUE
+ */
+gboolean cuav_sender_send_guidance(CUAVSender *sender, const CUAVGuidanceInfo *guidance);
+
+/**
+ * @brief 非阻塞发送任意已定义报文（按报文描述表编码）
+ *
+ * @param sender 发送器实例
+ * @param msg_id 报文ID
+ * @param msg_type 报文类型 CUAVMessageType
+ * @param msg 对应的报文结构体
+ * @return 报文已交给内核返回 TRUE
+ */
+gboolean cuav_sender_send_message(CUAVSender *sender, guint16 msg_id, guint8 msg_type,
+                                  gconstpointer msg);
+
+/**
+ * @brief 获取发送统计
+ *
+ * @param sender 发送器实例
+ * @param sent 输出已发送报文数（可为 NULL）
+ * @param dropped 输出因缓冲区满或错误丢弃的报文数（可为 NULL）
+ */
+void cuav_sender_get_stats(CUAVSender *sender, guint64 *sent, guint64 *dropped);
+
+G_END_DECLS
+
+#endif /* __GST_UDPJSON_META_CUAV_SENDER_H__ */
@@ -0,0 +1,143 @@
+#include "gstudpjsonmeta_dedup.h"
+
+#include <string.h>
+
+/* 插入或查找时最多探测的槽位数 */
+#define UDPJSON_DEDUP_PROBES 8
+
+/* 去重表槽位 */
+typedef struct
+{
+    guint64 hash; /* 报文内容哈希，0 表示空闲 */
+    guint64 first_ns; /* 首个副本到达时间 */
+    guint path; /* 首个副本的路径 */
+    guint32 seen_paths; /* 本次发送已送达的路径位图（超出位数的路径共用最高位） */
+} UdpJsonDedupSlot;
+
+struct _UdpJsonDedup
+{
+    guint64 window_ns; /* 去重时间窗口(纳秒) */
+    UdpJsonDedupSlot slots[UDPJSON_DEDUP_SLOTS]; /* 去重表（接收线程使用） */
+    UdpJsonDedupPathStats paths[UDPJSON_DEDUP_MAX_PATHS]; /* 各路径统计，按字原子读写 */
+};
+
+/**
+ * @brief 计算报文内容的 64 位 FNV-1a 哈希（不为 0）。
+ *
+ * @param data 报文。
+ * @param len 报文长度。
+ * @return 哈希值。
+ */
+static guint64 udpjson_dedup_hash(const gchar *data, gsize len)
+{
+    guint64 h = G_GUINT64_CONSTANT(0xcbf29ce484222325); /* 哈希值 */
+
+    for (gsize i = 0; i < len; i++)
+    {
+        h ^= (guint8)data[i];
+        h *= G_GUINT64_CONSTANT(0x100000001b3);
+    }
+    return h ? h : 1;
+}
+
+/**
+ * @brief 原子地累加路径计数（只有接收线程写入）。
+ *
+ * @param field 计数字段。
+ * @param delta 增量。
+ */
+static inline void udpjson_dedup_count(guint64 *field, guint64 delta)
+{
+    __atomic_store_n(field, __atomic_load_n(field, __ATOMIC_RELAXED) + delta, __ATOMIC_RELAXED);
+}
+
+UdpJsonDedup *udpjson_dedup_new(guint window_ms)
+{
+    UdpJsonDedup *dedup = (UdpJsonDedup *)g_malloc0(sizeof(UdpJsonDedup));
+
+    dedup->window_ns = (guint64)MAX(window_ms, 1u) * 1000000;
+    return dedup;
+}
+
+void udpjson_dedup_free(UdpJsonDedup *dedup)
+{
+    g_free(dedup);
+}
+
+gboolean udpjson_dedup_check(UdpJsonDedup *dedup, guint path, const gchar *data, gsize len,
+                             guint64 now_ns)
+{
+    guint64 hash = udpjson_dedup_hash(data, len); /* 内容哈希 */
+    UdpJsonDedupSlot *victim = NULL; /* 插入位置：首个空闲槽位，否则最旧的槽位 */
+    gboolean victim_free = FALSE; /* 插入位置是否空闲 */
+    guint p = path < UDPJSON_DEDUP_MAX_PATHS ? path : UDPJSON_DEDUP_MAX_PATHS - 1; /* 统计下标 */
+    guint32 bit = 1u << p; /* 路径位 */
+
+    for (guint i = 0; i < UDPJSON_DEDUP_PROBES; i++)
+    {
+        UdpJsonDedupSlot *slot = &dedup->slots[(hash + i) & (UDPJSON_DEDUP_SLOTS - 1)]; /* 槽位 */
+        gboolean live = slot->hash != 0 && now_ns - slot->first_ns <= dedup->window_ns; /* 未过期 */
+
+        if (live && slot->hash == hash && (slot->seen_paths & bit))
+        {
+            /* 本路径已送达过该报文，这是发送端的重发而不是冗余副本：照常处理，
+             * 并以本路径为首个副本重新开始去重（重发可能先从其他路径到达） */
+            slot->first_ns = now_ns;
+            slot->path = path;
+            slot->seen_paths = bit;
+            udpjson_dedup_count(&dedup->paths[p].first, 1);
+            return TRUE;
+        }
+        if (live && slot->hash == hash)
+        {
+            slot->seen_paths |= bit;
+            udpjson_dedup_count(&dedup->paths[p].late, 1);
+            if (slot->path < UDPJSON_DEDUP_MAX_PATHS)
+            {
+                UdpJsonDedupPathStats *winner = &dedup->paths[slot->path]; /* 先到路径 */
+                guint64 lead_ns = now_ns - slot->first_ns; /* 领先时间 */
+
+                udpjson_dedup_count(&winner->lead_count, 1);
+                udpjson_dedup_count(&winner->lead_sum_ns, lead_ns);
+                if (lead_ns > __atomic_load_n(&winner->lead_max_ns, __ATOMIC_RELAXED))
+                    __atomic_store_n(&winner->lead_max_ns, lead_ns, __ATOMIC_RELAXED);
+            }
+            return FALSE;
+        }
+        if (!live)
+        {
+            if (!victim_free)
+            {
+                victim = slot;
+                victim_free = TRUE;
+            }
+        }
+        else if (!victim_free && (!victim || slot->first_ns < victim->first_ns))
+        {
+            victim = slot;
+        }
+    }
+
+    victim->hash = hash;
+    victim->first_ns = now_ns;
+    victim->path = path;
+    victim->seen_paths = bit;
+    udpjson_dedup_count(&dedup->paths[p].first, 1);
+    return TRUE;
+}
+
+void udpjson_dedup_get_path_stats(const UdpJsonDedup *dedup, guint path,
+                                  UdpJsonDedupPathStats *stats)
+{
+    const UdpJsonDedupPathStats *src = NULL; /* 路径统计 */
+
+    memset(stats, 0, sizeof(*stats));
+    if (!dedup || path >= UDPJSON_DEDUP_MAX_PATHS)
+        return;
+    src = &dedup->paths[path];
+    stats->first = __atomic_load_n(&src->first, __ATOMIC_RELAXED);
+    stats->late = __atomic_load_n(&src->late, __ATOMIC_RELAXED);
+    stats->lead_count = __atomic_load_n(&src->lead_count, __ATOMIC_RELAXED);
+    stats->lead_sum_ns = __atomic_load_n(&src->lead_sum_ns, __ATOMIC_RELAXED);
+    stats->lead_max_ns = __atomic_load_n(&src->lead_max_ns, __ATOMIC_RELAXED);
+}
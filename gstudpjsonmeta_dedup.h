@@ -0,0 +1,81 @@
+#ifndef __GST_UDPJSON_META_DEDUP_H__
+#define __GST_UDPJSON_META_DEDUP_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* 去重表的槽位数（2 的幂） */
+#define UDPJSON_DEDUP_SLOTS 4096
+/* 统计到达领先量的最大路径数 */
+#define UDPJSON_DEDUP_MAX_PATHS 32
+
+/**
+ * @brief 单条路径的到达统计
+ */
+typedef struct
+{
+    guint64 first;            /* 先于其他路径到达并被采用的报文数 */
+    guint64 late;             /* 其他路径已送达、作为重复丢弃的报文数 */
+    guint64 lead_count;       /* 本路径先到、随后在其他路径收到副本的次数 */
+    guint64 lead_sum_ns;      /* 上述情况下领先时间之和(纳秒) */
+    guint64 lead_max_ns;      /* 最大领先时间(纳秒) */
+} UdpJsonDedupPathStats;
+
+/**
+ * @brief 多路冗余接收的先到先用去重
+ *
+ * 同一报文经多块网卡（路径）到达时，按内容哈希在时间窗口内去重：首个副本
+ * 采用，窗口内其他路径的相同报文丢弃，并记录首个副本所在路径的领先时间。
+ * 每个槽位记录已送达过该报文的路径；某条路径再次送达相同报文说明发送端重发了
+ * 一次，无论重发先从哪条路径到达都照常采用，并以该次到达重新开始去重（其他
+ * 路径上这次重发的副本仍会丢弃）。
+ * 去重表为开放寻址的定长数组，过期槽位视为空闲，表满时覆盖最旧的槽位（只会
+ * 放过重复报文，不会丢弃首个副本）。
+ *
+ * udpjson_dedup_check() 只能由接收线程调用；路径统计按字原子读写，
+ * udpjson_dedup_get_path_stats() 可在任意线程调用。
+ */
+typedef struct _UdpJsonDedup UdpJsonDedup;
+
+/**
+ * @brief 创建去重器
+ *
+ * @param window_ms 去重时间窗口(毫秒)，大于 0
+ * @return 去重器
+ */
+UdpJsonDedup *udpjson_dedup_new(guint window_ms);
+
+/**
+ * @brief 释放去重器
+ *
+ * @param dedup 去重器（可为 NULL）
+ */
+void udpjson_dedup_free(UdpJsonDedup *dedup);
+
+/**
+ * @brief 判断报文是否为窗口内已从其他路径收到的副本（接收线程调用）
+ *
+ * @param dedup 去重器
+ * @param path 到达路径编号
+ * @param data 报文
+ * @param len 报文长度
+ * @param now_ns 到达时间(udpjson_now_ns)
+ * @return 首个副本或发送端重发的首个副本返回 TRUE（应处理），其他路径的副本返回 FALSE
+ */
+gboolean udpjson_dedup_check(UdpJsonDedup *dedup, guint path, const gchar *data, gsize len,
+                             guint64 now_ns);
+
+/**
+ * @brief 获取一条路径的到达统计
+ *
+ * @param dedup 去重器
+ * @param path 路径编号，不小于 UDPJSON_DEDUP_MAX_PATHS 时输出全 0
+ * @param stats 输出统计
+ */
+void udpjson_dedup_get_path_stats(const UdpJsonDedup *dedup, guint path,
+                                  UdpJsonDedupPathStats *stats);
+
+G_END_DECLS
+
+#endif /* __GST_UDPJSON_META_DEDUP_H__ */
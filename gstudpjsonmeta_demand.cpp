@@ -0,0 +1,229 @@
+#include "gstudpjsonmeta_demand.h"
+
+#include <string.h>
+
+/* 位图的 64 位字数 */
+#define UDPJSON_DEMAND_WORDS (UDPJSON_DEMAND_BITS / 64)
+/* 快速扫描接受的最大十进制位数，保证与 json-glib 的整数解析结果一致 */
+#define UDPJSON_DEMAND_MAX_DIGITS 18
+
+struct _UdpJsonDemand
+{
+    guint interval; /* 发布间隔(批次) */
+    guint batches; /* 本周期已结束的批次数（流线程使用） */
+    guint64 building[UDPJSON_DEMAND_WORDS]; /* 本周期登记的目标（流线程使用） */
+    guint64 previous[UDPJSON_DEMAND_WORDS]; /* 上一周期登记的目标（流线程使用） */
+    guint64 building_hwm[UDPJSON_DEMAND_MAX_SOURCES]; /* 本周期各源的最大目标ID+1（流线程使用） */
+
+    guint64 published[UDPJSON_DEMAND_WORDS]; /* 发布的位图，按字原子读写 */
+    guint64 published_hwm[UDPJSON_DEMAND_MAX_SOURCES]; /* 发布的各源最大目标ID+1，0 表示未见过 */
+    gint64 published_us; /* 上次发布时间，0 表示尚未发布 */
+};
+
+/**
+ * @brief 计算目标在位图中的位号。
+ *
+ * @param source_id 源ID。
+ * @param object_id 目标ID。
+ * @return 位号。
+ */
+static inline guint udpjson_demand_bit(guint source_id, guint64 object_id)
+{
+    guint64 h = object_id ^ ((guint64)source_id << 48) ^ ((guint64)source_id >> 16); /* 混合值 */
+
+    /* splitmix64 末级混合，连续的目标ID分散到不同的字 */
+    h ^= h >> 30;
+    h *= G_GUINT64_CONSTANT(0xbf58476d1ce4e5b9);
+    h ^= h >> 27;
+    h *= G_GUINT64_CONSTANT(0x94d049bb133111eb);
+    h ^= h >> 31;
+    return (guint)(h & (UDPJSON_DEMAND_BITS - 1));
+}
+
+UdpJsonDemand *udpjson_demand_new(guint interval)
+{
+    UdpJsonDemand *demand = (UdpJsonDemand *)g_malloc0(sizeof(UdpJsonDemand));
+
+    demand->interval = MAX(interval, 1u);
+    return demand;
+}
+
+void udpjson_demand_free(UdpJsonDemand *demand)
+{
+    g_free(demand);
+}
+
+void udpjson_demand_add(UdpJsonDemand *demand, guint source_id, guint64 object_id)
+{
+    guint bit = udpjson_demand_bit(source_id, object_id); /* 位号 */
+
+    demand->building[bit / 64] |= G_GUINT64_CONSTANT(1) << (bit % 64);
+    if (source_id < UDPJSON_DEMAND_MAX_SOURCES && object_id + 1 > demand->building_hwm[source_id])
+        demand->building_hwm[source_id] = object_id + 1;
+}
+
+void udpjson_demand_batch_done(UdpJsonDemand *demand, gint64 now_us)
+{
+    if (++demand->batches < demand->interval)
+        return;
+    demand->batches = 0;
+
+    for (guint i = 0; i < UDPJSON_DEMAND_WORDS; i++)
+    {
+        __atomic_store_n(&demand->published[i], demand->building[i] | demand->previous[i],
+                         __ATOMIC_RELAXED);
+        demand->previous[i] = demand->building[i];
+        demand->building[i] = 0;
+    }
+    /* 高水位只增不减：跟踪器ID按源递增，低于高水位且不在位图中的是已离开的目标 */
+    for (guint s = 0; s < UDPJSON_DEMAND_MAX_SOURCES; s++)
+    {
+        if (demand->building_hwm[s] > __atomic_load_n(&demand->published_hwm[s], __ATOMIC_RELAXED))
+            __atomic_store_n(&demand->published_hwm[s], demand->building_hwm[s], __ATOMIC_RELAXED);
+        demand->building_hwm[s] = 0;
+    }
+    __atomic_store_n(&demand->published_us, MAX(now_us, (gint64)1), __ATOMIC_RELEASE);
+}
+
+gboolean udpjson_demand_wanted(const UdpJsonDemand *demand, guint source_id, guint64 object_id,
+                               gint64 now_us)
+{
+    gint64 published_us = __atomic_load_n(&demand->published_us, __ATOMIC_ACQUIRE); /* 发布时间 */
+    guint bit = 0; /* 位号 */
+
+    if (published_us == 0 || now_us - published_us > UDPJSON_DEMAND_STALE_US)
+        return TRUE;
+    if (source_id >= UDPJSON_DEMAND_MAX_SOURCES ||
+        object_id >= __atomic_load_n(&demand->published_hwm[source_id], __ATOMIC_RELAXED))
+        return TRUE;
+
+    bit = udpjson_demand_bit(source_id, object_id);
+    return (__atomic_load_n(&demand->published[bit / 64], __ATOMIC_RELAXED) >> (bit % 64)) & 1;
+}
+
+/**
+ * @brief 解析冒号之后的非负整数取值，允许带引号。
+ *
+ * @param p 冒号之后的位置。
+ * @param end 报文结尾。
+ * @param out 输出值。
+ * @return 取值可快速解析返回 TRUE。
+ */
+static gboolean udpjson_demand_scan_value(const gchar *p, const gchar *end, guint64 *out)
+{
+    gboolean quoted = FALSE; /* 取值是否带引号 */
+    guint digits = 0; /* 十进制位数 */
+    guint64 v = 0; /* 取值 */
+
+    while (p < end && g_ascii_isspace(*p))
+        p++;
+    if (p < end && *p == '"')
+    {
+        quoted = TRUE;
+        p++;
+    }
+    for (; p < end && g_ascii_isdigit(*p); p++)
+    {
+        if (++digits > UDPJSON_DEMAND_MAX_DIGITS)
+            return FALSE;
+        v = v * 10 + (guint64)(*p - '0');
+    }
+    if (digits == 0)
+        return FALSE;
+    if (quoted)
+    {
+        if (p >= end || *p != '"')
+            return FALSE;
+        p++;
+    }
+    /* 取值须完整结束，排除 1.5、1e3 等形式 */
+    if (p < end && *p != ',' && *p != '}' && !g_ascii_isspace(*p))
+        return FALSE;
+    *out = v;
+    return TRUE;
+}
+
+/**
+ * @brief 在报文顶层对象中查找键 "key" 的唯一一次出现并解析其非负整数值。
+ *
+ * 与 cuav_scan_common_header 一样跟踪括号深度和字符串边界，嵌套对象中的同名键
+ * 以及字符串取值中的同名文本都不计入。
+ *
+ * @param data 报文。
+ * @param len 报文长度。
+ * @param key 带引号的键名。
+ * @param out 输出值。
+ * @return 取到值返回 1，顶层不存在该键返回 0，顶层键重复、取值无法快速解析或报文
+ *         截断返回 -1。
+ */
+static gint udpjson_demand_scan_key(const gchar *data, gsize len, const gchar *key, guint64 *out)
+{
+    gsize key_len = strlen(key); /* 键长度（含引号） */
+    const gchar *p = data; /* 扫描位置 */
+    const gchar *end = data + len; /* 报文结尾 */
+    gint depth = 0; /* 括号深度 */
+    gint found = 0; /* 是否已取到值 */
+
+    while (p < end)
+    {
+        gchar c = *p; /* 当前字符 */
+
+        if (c == '{' || c == '[')
+        {
+            depth++;
+            p++;
+        }
+        else if (c == '}' || c == ']')
+        {
+            if (--depth <= 0)
+                break;
+            p++;
+        }
+        else if (c == '"')
+        {
+            const gchar *token = p++; /* 字符串起点 */
+
+            while (p < end && *p != '"')
+            {
+                if (*p == '\\' && p + 1 < end)
+                    p++;
+                p++;
+            }
+            if (p >= end)
+                return -1;
+            p++;
+
+            if (depth != 1 || (gsize)(p - token) != key_len || memcmp(token, key, key_len) != 0)
+                continue;
+            const gchar *q = p; /* 冒号位置 */
+            while (q < end && g_ascii_isspace(*q))
+                q++;
+            if (q >= end || *q != ':')
+                continue;
+            if (found || !udpjson_demand_scan_value(q + 1, end, out))
+                return -1;
+            found = 1;
+        }
+        else
+        {
+            p++;
+        }
+    }
+    return found;
+}
+
+gboolean udpjson_demand_scan_ids(const gchar *data, gsize len, guint *source_id,
+                                 guint64 *object_id)
+{
+    guint64 src = 0; /* 源ID */
+    gint found = 0; /* source_id 的查找结果 */
+
+    if (udpjson_demand_scan_key(data, len, "\"object_id\"", object_id) != 1)
+        return FALSE;
+    found = udpjson_demand_scan_key(data, len, "\"source_id\"", &src);
+    if (found < 0)
+        return FALSE;
+    if (found > 0)
+        *source_id = (guint)src;
+    return TRUE;
+}
@@ -0,0 +1,91 @@
+#ifndef __GST_UDPJSON_META_DEMAND_H__
+#define __GST_UDPJSON_META_DEMAND_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* 需求位图的位数（2 的幂），每个 (source_id, object_id) 占一位 */
+#define UDPJSON_DEMAND_BITS (1u << 16)
+/* 记录目标ID高水位的源数，source_id 不小于该值的报文不过滤 */
+#define UDPJSON_DEMAND_MAX_SOURCES 256
+/* 超过该时间(微秒)未发布时视为流线程停滞，放行全部报文 */
+#define UDPJSON_DEMAND_STALE_US (500 * 1000)
+
+/**
+ * @brief 需求过滤器：最近帧中可见目标的集合
+ *
+ * 流线程 (transform_ip) 在每批次中调用 udpjson_demand_add() 登记可见目标，
+ * 每 interval 个批次调用一次 udpjson_demand_batch_done() 时发布：发布的位图
+ * 是最近两个周期登记的并集，同时记录每个源出现过的最大目标ID（高水位）。
+ *
+ * 接收线程调用 udpjson_demand_wanted() 判断报文是否需要解析。位图与高水位
+ * 按字原子读写，读写双方都不加锁；查询只读一个字，发布过程中读到新旧混合
+ * 的位图也只会多放行或少放行一个周期。高于高水位的目标ID视为即将出现的
+ * 新目标而放行（跟踪器按源递增分配ID），作为新目标的宽限窗口。
+ */
+typedef struct _UdpJsonDemand UdpJsonDemand;
+
+/**
+ * @brief 创建需求过滤器
+ *
+ * @param interval 发布间隔(批次)，0 视为 1
+ * @return 过滤器，未发布前放行全部报文
+ */
+UdpJsonDemand *udpjson_demand_new(guint interval);
+
+/**
+ * @brief 释放需求过滤器
+ *
+ * @param demand 过滤器（可为 NULL）
+ */
+void udpjson_demand_free(UdpJsonDemand *demand);
+
+/**
+ * @brief 登记一个可见目标（流线程调用）
+ *
+ * @param demand 过滤器
+ * @param source_id 源ID
+ * @param object_id 目标ID
+ */
+void udpjson_demand_add(UdpJsonDemand *demand, guint source_id, guint64 object_id);
+
+/**
+ * @brief 结束一个批次，满 interval 个批次时发布（流线程调用）
+ *
+ * @param demand 过滤器
+ * @param now_us 当前单调时间(微秒)
+ */
+void udpjson_demand_batch_done(UdpJsonDemand *demand, gint64 now_us);
+
+/**
+ * @brief 判断目标是否在需求中（接收线程调用）
+ *
+ * @param demand 过滤器
+ * @param source_id 源ID
+ * @param object_id 目标ID
+ * @param now_us 当前单调时间(微秒)
+ * @return 在最近发布的集合中、高于高水位、尚未发布或发布已停滞时返回 TRUE
+ */
+gboolean udpjson_demand_wanted(const UdpJsonDemand *demand, guint source_id, guint64 object_id,
+                               gint64 now_us);
+
+/**
+ * @brief 不解析 JSON，从报文中取出顶层 source_id 与 object_id
+ *
+ * 只看顶层对象的键，嵌套对象中的同名键不计入。只接受顶层 "object_id" 与
+ * "source_id" 各至多出现一次、取值为非负整数（可加引号）的报文，其他情况返回
+ * FALSE，由调用者完整解析。
+ *
+ * @param data 报文（以 '\0' 结尾）
+ * @param len 报文长度
+ * @param source_id 输出源ID，报文未给出时不修改
+ * @param object_id 输出目标ID
+ * @return 取到目标ID返回 TRUE
+ */
+gboolean udpjson_demand_scan_ids(const gchar *data, gsize len, guint *source_id,
+                                 guint64 *object_id);
+
+G_END_DECLS
+
+#endif /* __GST_UDPJSON_META_DEMAND_H__ */
@@ -0,0 +1,324 @@
+#include "gstudpjsonmeta_eventlog.h"
+#include <stdio.h>
+#include <string.h>
+
+/* 后台线程空闲时的轮询间隔(微秒) */
+#define UDPJSON_EVENT_LOG_IDLE_US 10000
+
+/**
+ * @brief 环中的一个槽位
+ *
+ * seq 为 pos+1 表示记录已提交，0 表示正在写入。
+ */
+typedef struct
+{
+    guint64 seq;              /* 提交标记 */
+    guint64 pos;              /* 写入方申请到的位置 */
+    UdpJsonEventRecord rec;   /* 事件记录 */
+} UdpJsonEventSlot;
+
+/**
+ * @brief 异步调试事件日志（私有结构体）
+ */
+struct _UdpJsonEventLog
+{
+    UdpJsonEventSlot *slots;  /* 记录环 */
+    guint64 mask;             /* 容量 - 1 */
+    guint64 head;             /* 下一个写入位置（原子） */
+    guint64 tail;             /* 下一个读取位置（仅后台线程） */
+    guint interval[UDPJSON_EVENT_KIND_COUNT]; /* 各类型采样间隔 */
+    gint counter[UDPJSON_EVENT_KIND_COUNT];   /* 各类型事件计数（原子） */
+    UdpJsonEventLogStats stats;               /* 统计（原子） */
+    GThread *thread;          /* 后台格式化线程 */
+    gint stop_flag;           /* 线程停止标志 */
+};
+
+static const gchar *udpjson_event_kind_names[UDPJSON_EVENT_KIND_COUNT] = {
+    "guidance", "eo-system", "servo", "other", "cache-update", "cache-flush"};
+
+static inline void udpjson_event_stat_add(guint64 *counter, guint64 v)
+{
+    __atomic_fetch_add(counter, v, __ATOMIC_RELAXED);
+}
+
+UdpJsonEventLog *udpjson_event_log_new(guint capacity)
+{
+    UdpJsonEventLog *log = (UdpJsonEventLog *)g_malloc0(sizeof(UdpJsonEventLog));
+    guint64 size = 1;
+
+    if (capacity == 0)
+        capacity = UDPJSON_EVENT_LOG_DEFAULT_CAPACITY;
+    while (size < capacity)
+        size <<= 1;
+
+    log->slots = (UdpJsonEventSlot *)g_malloc0(sizeof(UdpJsonEventSlot) * size);
+    log->mask = size - 1;
+    for (guint i = 0; i < UDPJSON_EVENT_KIND_COUNT; i++)
+        log->interval[i] = 1;
+    return log;
+}
+
+void udpjson_event_log_free(UdpJsonEventLog *log)
+{
+    if (!log)
+        return;
+    udpjson_event_log_stop(log);
+    g_free(log->slots);
+    g_free(log);
+}
+
+void udpjson_event_log_set_sample(UdpJsonEventLog *log, UdpJsonEventKind kind, guint interval)
+{
+    if (!log || (guint)kind >= UDPJSON_EVENT_KIND_COUNT)
+        return;
+    g_atomic_int_set((gint *)&log->interval[kind], (gint)interval);
+}
+
+gboolean udpjson_event_log_parse_sample(UdpJsonEventLog *log, const gchar *spec)
+{
+    gchar **tokens = NULL; /* 分割后的条目 */
+    gboolean ok = TRUE;
+
+    if (!log)
+        return FALSE;
+
+    for (guint i = 0; i < UDPJSON_EVENT_KIND_COUNT; i++)
+        udpjson_event_log_set_sample(log, (UdpJsonEventKind)i, 1);
+    if (!spec)
+        return TRUE;
+
+    tokens = g_strsplit(spec, ",", -1);
+    for (guint t = 0; tokens[t]; t++)
+    {
+        gchar *entry = g_strstrip(tokens[t]);
+        gchar *colon = strchr(entry, ':');
+        const gchar *name = "*";
+        const gchar *num = entry;
+        gchar *end = NULL;
+        guint64 interval = 0;
+        gboolean matched = FALSE;
+
+        if (entry[0] == '\0')
+            continue;
+        if (colon)
+        {
+            *colon = '\0';
+            name = g_strstrip(entry);
+            num = colon + 1;
+        }
+
+        interval = g_ascii_strtoull(num, &end, 10);
+        if (end == num || interval > G_MAXUINT)
+        {
+            ok = FALSE;
+            continue;
+        }
+
+        for (guint i = 0; i < UDPJSON_EVENT_KIND_COUNT; i++)
+        {
+            if (g_strcmp0(name, "*") == 0 || g_strcmp0(name, udpjson_event_kind_names[i]) == 0)
+            {
+                udpjson_event_log_set_sample(log, (UdpJsonEventKind)i, (guint)interval);
+                matched = TRUE;
+            }
+        }
+        if (!matched)
+            ok = FALSE;
+    }
+    g_strfreev(tokens);
+    return ok;
+}
+
+UdpJsonEventRecord *udpjson_event_log_reserve(UdpJsonEventLog *log, UdpJsonEventKind kind)
+{
+    UdpJsonEventSlot *slot = NULL;
+    guint interval = 0;
+    guint64 pos = 0;
+
+    if (!log || (guint)kind >= UDPJSON_EVENT_KIND_COUNT)
+        return NULL;
+
+    interval = (guint)g_atomic_int_get((gint *)&log->interval[kind]);
+    if (interval == 0 ||
+        (interval > 1 && (guint)g_atomic_int_add(&log->counter[kind], 1) % interval != 0))
+    {
+        udpjson_event_stat_add(&log->stats.sampled_out, 1);
+        return NULL;
+    }
+
+    pos = __atomic_fetch_add(&log->head, 1, __ATOMIC_RELAXED);
+    slot = &log->slots[pos & log->mask];
+
+    /* 先清除提交标记，读取方据此识别正在被覆盖的槽位 */
+    __atomic_store_n(&slot->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    slot->pos = pos;
+    slot->rec.ts_us = (guint64)g_get_monotonic_time();
+    slot->rec.kind = (guint16)kind;
+    slot->rec.msg_id = 0;
+    slot->rec.msg_sn = 0;
+    return &slot->rec;
+}
+
+void udpjson_event_log_commit(UdpJsonEventLog *log, UdpJsonEventRecord *rec)
+{
+    UdpJsonEventSlot *slot = NULL;
+
+    if (!log || !rec)
+        return;
+
+    slot = (UdpJsonEventSlot *)((guint8 *)rec - G_STRUCT_OFFSET(UdpJsonEventSlot, rec));
+    __atomic_store_n(&slot->seq, slot->pos + 1, __ATOMIC_RELEASE);
+    udpjson_event_stat_add(&log->stats.written, 1);
+}
+
+/**
+ * @brief 格式化输出一条记录（后台线程）
+ */
+static void udpjson_event_log_format(const UdpJsonEventRecord *rec)
+{
+    switch (rec->kind)
+    {
+    case UDPJSON_EVENT_CUAV_GUIDANCE:
+        printf("[CUAV] t=%" G_GUINT64_FORMAT "us msg_sn=%u\n", rec->ts_us, rec->msg_sn);
+        cuav_print_guidance(&rec->u.guidance);
+        break;
+    case UDPJSON_EVENT_CUAV_EO_SYSTEM:
+        printf("[CUAV] t=%" G_GUINT64_FORMAT "us msg_sn=%u\n", rec->ts_us, rec->msg_sn);
+        cuav_print_eo_system(&rec->u.eo_system);
+        break;
+    case UDPJSON_EVENT_CUAV_SERVO:
+        printf("[CUAV] t=%" G_GUINT64_FORMAT "us msg_sn=%u\n", rec->ts_us, rec->msg_sn);
+        cuav_print_servo_control(&rec->u.servo);
+        break;
+    case UDPJSON_EVENT_CUAV_OTHER:
+    {
+        const CUAVMessageDesc *desc = cuav_message_desc_lookup(rec->msg_id);
+        if (desc && desc->n_fields > 0)
+        {
+            printf("[CUAV] t=%" G_GUINT64_FORMAT "us msg_sn=%u\n", rec->ts_us, rec->msg_sn);
+            cuav_print_message(desc, &rec->u.msg);
+            break;
+        }
+        printf("[CUAV] t=%" G_GUINT64_FORMAT "us 未处理报文: msg_id=0x%04X(%s) msg_sn=%u\n",
+               rec->ts_us, rec->msg_id, cuav_get_msg_id_name(rec->msg_id), rec->msg_sn);
+        break;
+    }
+    case UDPJSON_EVENT_CACHE_UPDATE:
+        printf("[UDPJSON] t=%" G_GUINT64_FORMAT "us 缓存写入: source_id=%u object_id=%"
+               G_GUINT64_FORMAT " tar_id=%u len=%u\n",
+               rec->ts_us, rec->u.cache.source_id, rec->u.cache.object_id,
+               rec->u.cache.tar_id, rec->u.cache.value_len);
+        break;
+    case UDPJSON_EVENT_CACHE_FLUSH:
+        printf("[UDPJSON] t=%" G_GUINT64_FORMAT "us 缓存已满，清空 %u 条\n",
+               rec->ts_us, rec->u.cache.entries);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 读取并输出所有已提交的记录
+ *
+ * @return 输出的记录数
+ */
+static guint udpjson_event_log_drain(UdpJsonEventLog *log)
+{
+    guint64 head = __atomic_load_n(&log->head, __ATOMIC_ACQUIRE);
+    guint64 capacity = log->mask + 1;
+    guint n = 0;
+    UdpJsonEventRecord rec;
+
+    if (head - log->tail > capacity)
+    {
+        udpjson_event_stat_add(&log->stats.overwritten, head - log->tail - capacity);
+        log->tail = head - capacity;
+    }
+
+    while (log->tail < head)
+    {
+        UdpJsonEventSlot *slot = &log->slots[log->tail & log->mask];
+        guint64 seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+
+        if (seq == 0 || seq < log->tail + 1)
+            break; /* 写入方尚未提交，下次再读 */
+
+        if (seq == log->tail + 1)
+        {
+            memcpy(&rec, &slot->rec, sizeof(rec));
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq)
+            {
+                udpjson_event_log_format(&rec);
+                n++;
+                log->tail++;
+                continue;
+            }
+        }
+
+        /* 读取过程中被写入方套圈覆盖 */
+        udpjson_event_stat_add(&log->stats.overwritten, 1);
+        log->tail++;
+    }
+
+    if (n > 0)
+    {
+        fflush(stdout);
+        udpjson_event_stat_add(&log->stats.formatted, n);
+    }
+    return n;
+}
+
+/**
+ * @brief 后台格式化线程入口
+ */
+static gpointer udpjson_event_log_thread(gpointer data)
+{
+    UdpJsonEventLog *log = (UdpJsonEventLog *)data;
+
+    while (!g_atomic_int_get(&log->stop_flag))
+    {
+        if (udpjson_event_log_drain(log) == 0)
+            g_usleep(UDPJSON_EVENT_LOG_IDLE_US);
+    }
+    udpjson_event_log_drain(log);
+    return NULL;
+}
+
+gboolean udpjson_event_log_start(UdpJsonEventLog *log)
+{
+    if (!log)
+        return FALSE;
+    if (log->thread)
+        return TRUE;
+
+    g_atomic_int_set(&log->stop_flag, 0);
+    log->thread = g_thread_new("udpjson-evlog", udpjson_event_log_thread, log);
+    return log->thread != NULL;
+}
+
+void udpjson_event_log_stop(UdpJsonEventLog *log)
+{
+    if (!log || !log->thread)
+        return;
+
+    g_atomic_int_set(&log->stop_flag, 1);
+    g_thread_join(log->thread);
+    log->thread = NULL;
+}
+
+void udpjson_event_log_get_stats(UdpJsonEventLog *log, UdpJsonEventLogStats *stats)
+{
+    if (!stats)
+        return;
+    memset(stats, 0, sizeof(UdpJsonEventLogStats));
+    if (!log)
+        return;
+    stats->written = __atomic_load_n(&log->stats.written, __ATOMIC_RELAXED);
+    stats->formatted = __atomic_load_n(&log->stats.formatted, __ATOMIC_RELAXED);
+    stats->overwritten = __atomic_load_n(&log->stats.overwritten, __ATOMIC_RELAXED);
+    stats->sampled_out = __atomic_load_n(&log->stats.sampled_out, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,155 @@
+#ifndef __GST_UDPJSON_META_EVENTLOG_H__
+#define __GST_UDPJSON_META_EVENTLOG_H__
+
+#include <glib.h>
+#include "gstudpjsonmeta_cuav.h"
+
+G_BEGIN_DECLS
+
+/* 事件环默认容量（条），必须是 2 的幂 */
+#define UDPJSON_EVENT_LOG_DEFAULT_CAPACITY 4096
+
+/**
+ * @brief 调试事件类型，采样率按类型分别设置
+ */
+typedef enum
+{
+    UDPJSON_EVENT_CUAV_GUIDANCE = 0,  /* 引导信息 (0x7111) */
+    UDPJSON_EVENT_CUAV_EO_SYSTEM,     /* 光电系统参数 (0x7201) */
+    UDPJSON_EVENT_CUAV_SERVO,         /* 光电伺服控制 (0x7204) */
+    UDPJSON_EVENT_CUAV_OTHER,         /* 其他 C-UAV 报文（按描述表输出） */
+    UDPJSON_EVENT_CACHE_UPDATE,       /* 缓存写入 */
+    UDPJSON_EVENT_CACHE_FLUSH,        /* 缓存满清空 */
+    UDPJSON_EVENT_KIND_COUNT
+} UdpJsonEventKind;
+
+/**
+ * @brief 定长二进制事件记录
+ *
+ * 热路径只做结构体拷贝，不做任何格式化；格式化在后台线程完成。
+ */
+typedef struct
+{
+    guint64 ts_us;            /* 事件时间(单调时钟，微秒) */
+    guint16 kind;             /* 事件类型 UdpJsonEventKind */
+    guint16 msg_id;           /* C-UAV 报文ID，缓存事件为 0 */
+    guint32 msg_sn;           /* C-UAV 报文计数 */
+    union
+    {
+        CUAVGuidanceInfo guidance;
+        CUAVEOSystemParam eo_system;
+        CUAVServoControl servo;
+        CUAVMessageUnion msg;     /* 其他已定义报文，按 msg_id 查描述表解释 */
+        struct
+        {
+            guint32 source_id;    /* 源ID */
+            guint32 tar_id;       /* 关联的引导批号 */
+            guint64 object_id;    /* 目标ID */
+            guint32 value_len;    /* 值字符串长度 */
+            guint32 entries;      /* 清空前的缓存条目数 */
+        } cache;
+        guint8 pad[232];
+    } u;
+} UdpJsonEventRecord;
+
+/**
+ * @brief 事件日志统计
+ */
+typedef struct
+{
+    guint64 written;          /* 已写入环的事件数 */
+    guint64 formatted;        /* 后台线程已输出的事件数 */
+    guint64 overwritten;      /* 未及输出即被覆盖的事件数 */
+    guint64 sampled_out;      /* 因采样被跳过的事件数 */
+} UdpJsonEventLogStats;
+
+/**
+ * @brief 异步调试事件日志（不透明类型）
+ *
+ * 多生产者无锁写入定长记录环，环满时覆盖最旧记录；
+ * 单个后台线程读取、格式化并输出到 stdout。
+ */
+typedef struct _UdpJsonEventLog UdpJsonEventLog;
+
+/**
+ * @brief 创建事件日志
+ *
+ * @param capacity 环容量（条），向上取整为 2 的幂，0 使用默认值
+ * @return 事件日志实例
+ */
+UdpJsonEventLog *udpjson_event_log_new(guint capacity);
+
+/**
+ * @brief 停止后台线程并释放事件日志
+ *
+ * @param log 事件日志
+ */
+void udpjson_event_log_free(UdpJsonEventLog *log);
+
+/**
+ * @brief 启动后台格式化线程（重复调用无副作用）
+ *
+ * @param log 事件日志
+ * @return 成功返回 TRUE
+ */
+gboolean udpjson_event_log_start(UdpJsonEventLog *log);
+
+/**
+ * @brief 输出剩余事件后停止后台线程
+ *
+ * @param log 事件日志
+ */
+void udpjson_event_log_stop(UdpJsonEventLog *log);
+
+/**
+ * @brief 设置某类事件的采样间隔
+ *
+ * @param log 事件日志
+ * @param kind 事件类型
+ * @param interval 每 interval 个事件记录 1 个，0 表示不记录
+ */
+void udpjson_event_log_set_sample(UdpJsonEventLog *log, UdpJsonEventKind kind, guint interval);
+
+/**
+ * @brief 按配置字符串设置采样间隔
+ *
+ * 格式为逗号分隔的 "类型:间隔"，类型可为 guidance、eo-system、servo、other、
+ * cache-update、cache-flush 或 *；单独的数字等同于 "*:数字"。
+ *
+ * @param log 事件日志
+ * @param spec 配置字符串，NULL 表示全部记录
+ * @return 全部条目有效时返回 TRUE
+ */
+gboolean udpjson_event_log_parse_sample(UdpJsonEventLog *log, const gchar *spec);
+
+/**
+ * @brief 申请一条记录，按采样间隔可能返回 NULL
+ *
+ * 返回的记录已填好 ts_us/kind，调用方填写其余字段后必须调用
+ * udpjson_event_log_commit()。
+ *
+ * @param log 事件日志
+ * @param kind 事件类型
+ * @return 记录指针，跳过时返回 NULL
+ */
+UdpJsonEventRecord *udpjson_event_log_reserve(UdpJsonEventLog *log, UdpJsonEventKind kind);
+
+/**
+ * @brief 提交 udpjson_event_log_reserve() 申请的记录
+ *
+ * @param log 事件日志
+ * @param rec 记录指针
+ */
+void udpjson_event_log_commit(UdpJsonEventLog *log, UdpJsonEventRecord *rec);
+
+/**
+ * @brief 获取事件日志统计
+ *
+ * @param log 事件日志
+ * @param stats 输出统计
+ */
+void udpjson_event_log_get_stats(UdpJsonEventLog *log, UdpJsonEventLogStats *stats);
+
+G_END_DECLS
+
+#endif /* __GST_UDPJSON_META_EVENTLOG_H__ */
@@ -0,0 +1,90 @@
+#include "gstudpjsonmeta_flightrec.h"
+#include <errno.h>
+#include <gst/gst.h>
+#include <stdio.h>
+#include <time.h>
+
+UdpJsonFlightRecorder *udpjson_flight_recorder_new(guint capacity)
+{
+    UdpJsonFlightRecorder *fr = NULL;
+    guint cap = 16; /* 实际容量 */
+
+    while (cap < capacity && cap < (1u << 24))
+        cap <<= 1;
+
+    fr = (UdpJsonFlightRecorder *)g_malloc0(sizeof(UdpJsonFlightRecorder));
+    fr->capacity = cap;
+    fr->mask = cap - 1;
+    fr->events = (UdpJsonFlightEvent *)g_malloc0(sizeof(UdpJsonFlightEvent) * cap);
+    return fr;
+}
+
+void udpjson_flight_recorder_free(UdpJsonFlightRecorder *fr)
+{
+    if (!fr)
+        return;
+    g_free(fr->events);
+    g_free(fr);
+}
+
+gint udpjson_flight_recorder_dump(UdpJsonFlightRecorder *fr, const gchar *path,
+                                  const gchar *reason)
+{
+    UdpJsonFlightHeader header; /* 文件头 */
+    UdpJsonFlightEvent *copy = NULL; /* 事件快照 */
+    guint64 head = 0; /* 复制前的事件数 */
+    guint64 head_after = 0; /* 复制后的事件数 */
+    guint64 first = 0; /* 快照中第一条事件的序号 */
+    guint64 valid_first = 0; /* 未被覆盖的第一条事件的序号 */
+    guint n = 0;
+    struct timespec ts;
+    FILE *fp = NULL;
+
+    if (!fr || !path)
+        return -1;
+
+    /* 先复制再校验：复制期间写入方可能覆盖最旧的槽位，以及正在写的 head 槽位 */
+    copy = (UdpJsonFlightEvent *)g_malloc(sizeof(UdpJsonFlightEvent) * fr->capacity);
+    head = __atomic_load_n(&fr->head, __ATOMIC_ACQUIRE);
+    first = head > fr->capacity ? head - fr->capacity : 0;
+    for (guint64 i = first; i < head; i++)
+        copy[i - first] = fr->events[i & fr->mask];
+    head_after = __atomic_load_n(&fr->head, __ATOMIC_ACQUIRE);
+    valid_first = head_after + 1 > fr->capacity ? head_after + 1 - fr->capacity : 0;
+    if (valid_first < first)
+        valid_first = first;
+    if (valid_first > head)
+        valid_first = head;
+    n = (guint)(head - valid_first);
+
+    memset(&header, 0, sizeof(header));
+    header.magic = UDPJSON_FLIGHTREC_MAGIC;
+    header.version = UDPJSON_FLIGHTREC_VERSION;
+    header.event_size = sizeof(UdpJsonFlightEvent);
+    header.count = n;
+    header.total = head;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    header.dump_mono_ns = (guint64)ts.tv_sec * 1000000000ull + (guint64)ts.tv_nsec;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    header.dump_real_ns = (guint64)ts.tv_sec * 1000000000ull + (guint64)ts.tv_nsec;
+    g_strlcpy(header.reason, reason ? reason : "", sizeof(header.reason));
+
+    fp = fopen(path, "wb");
+    if (!fp)
+    {
+        GST_ERROR("Failed to open flight recorder dump %s: %s", path, strerror(errno));
+        g_free(copy);
+        return -1;
+    }
+    if (fwrite(&header, sizeof(header), 1, fp) != 1 ||
+        (n > 0 && fwrite(copy + (valid_first - first), sizeof(UdpJsonFlightEvent), n, fp) != n))
+    {
+        GST_ERROR("Failed to write flight recorder dump %s: %s", path, strerror(errno));
+        fclose(fp);
+        g_free(copy);
+        return -1;
+    }
+    fclose(fp);
+    g_free(copy);
+    return (gint)n;
+}
@@ -0,0 +1,149 @@
+#ifndef __GST_UDPJSON_META_FLIGHTREC_H__
+#define __GST_UDPJSON_META_FLIGHTREC_H__
+
+#include <glib.h>
+#include <string.h>
+
+G_BEGIN_DECLS
+
+/* 转储文件魔数 "UJFR" 与版本 */
+#define UDPJSON_FLIGHTREC_MAGIC 0x52464A55u
+#define UDPJSON_FLIGHTREC_VERSION 1
+
+/**
+ * @brief 事件来源套接字
+ */
+typedef enum
+{
+    UDPJSON_FR_SOCKET_JSON = 0,       /* 目标 JSON 端口 */
+    UDPJSON_FR_SOCKET_CUAV,           /* C-UAV 端口 */
+    UDPJSON_FR_SOCKET_CUAV_CTRL       /* C-UAV 控制端口 */
+} UdpJsonFlightSocket;
+
+/**
+ * @brief 解析结果
+ */
+typedef enum
+{
+    UDPJSON_FR_RESULT_PENDING = 0,    /* 已收到，尚未解析 */
+    UDPJSON_FR_RESULT_OK,             /* 目标 JSON 解析并写入缓存 */
+    UDPJSON_FR_RESULT_INVALID_JSON,   /* JSON 语法错误或根不是对象 */
+    UDPJSON_FR_RESULT_MISSING_FIELDS, /* 缺少 object_id/value 或取值非法 */
+    UDPJSON_FR_RESULT_CUAV_OK,        /* C-UAV 解析成功 */
+    UDPJSON_FR_RESULT_CUAV_FAILED,    /* C-UAV 解析失败 */
+    UDPJSON_FR_RESULT_RECV_ERROR,     /* recvfrom 出错，size 为 errno */
+    UDPJSON_FR_RESULT_NOT_IN_DEMAND,  /* 目标不在需求中，未解析 */
+    UDPJSON_FR_RESULT_DUPLICATE       /* 其他路径已收到的重复报文，未解析 */
+} UdpJsonFlightResult;
+
+/**
+ * @brief 缓存动作
+ */
+typedef enum
+{
+    UDPJSON_FR_CACHE_NONE = 0,        /* 未写缓存 */
+    UDPJSON_FR_CACHE_INSERT,          /* 新增条目 */
+    UDPJSON_FR_CACHE_REPLACE,         /* 覆盖已有条目 */
+    UDPJSON_FR_CACHE_FLUSH_INSERT     /* 缓存满整体清空后新增 */
+} UdpJsonFlightCacheAction;
+
+/**
+ * @brief 一条接收事件（40 字节，按此布局直接写入转储文件）
+ */
+typedef struct
+{
+    guint64 ts_ns;            /* 接收时间(单调时钟，纳秒) */
+    guint64 object_id;        /* 目标ID */
+    guint32 source_id;        /* 源ID */
+    guint32 size;             /* 报文长度 */
+    guint32 sender_ip;        /* 发送方 IPv4 地址(网络字节序) */
+    guint16 sender_port;      /* 发送方端口(主机字节序) */
+    guint8 socket;            /* UdpJsonFlightSocket */
+    guint8 result;            /* UdpJsonFlightResult */
+    guint8 cache_action;      /* UdpJsonFlightCacheAction */
+    guint8 reserved[3];
+    guint32 cache_entries;    /* 写入后的缓存条目数 */
+} UdpJsonFlightEvent;
+
+/**
+ * @brief 转储文件头，后跟 count 条 UdpJsonFlightEvent（按时间先后）
+ */
+typedef struct
+{
+    guint32 magic;            /* UDPJSON_FLIGHTREC_MAGIC */
+    guint32 version;          /* UDPJSON_FLIGHTREC_VERSION */
+    guint32 event_size;       /* sizeof(UdpJsonFlightEvent) */
+    guint32 count;            /* 事件数 */
+    guint64 total;            /* 累计记录的事件数（含已覆盖） */
+    guint64 dump_mono_ns;     /* 转储时的单调时钟，用于换算 ts_ns */
+    guint64 dump_real_ns;     /* 转储时的系统时间(纳秒) */
+    gchar reason[32];         /* 转储原因 */
+} UdpJsonFlightHeader;
+
+/**
+ * @brief 飞行记录器：最近 N 条接收事件的环形缓冲
+ *
+ * 只由接收线程写入：begin 取得下一个槽位并原地填写，commit 发布；
+ * 不加锁、无原子读改写。转储可在任意线程进行，被写入方覆盖的槽位在
+ * 复制后按序号剔除。
+ */
+typedef struct
+{
+    guint capacity;               /* 容量（2 的幂） */
+    guint mask;                   /* capacity - 1 */
+    guint64 head;                 /* 已发布的事件数 */
+    UdpJsonFlightEvent *events;   /* 事件槽 */
+} UdpJsonFlightRecorder;
+
+/**
+ * @brief 创建飞行记录器
+ *
+ * @param capacity 容量，向上取整为 2 的幂
+ * @return 飞行记录器
+ */
+UdpJsonFlightRecorder *udpjson_flight_recorder_new(guint capacity);
+
+/**
+ * @brief 释放飞行记录器
+ *
+ * @param fr 飞行记录器（可为 NULL）
+ */
+void udpjson_flight_recorder_free(UdpJsonFlightRecorder *fr);
+
+/**
+ * @brief 取得下一个事件槽并清零（只能由写入线程调用）
+ *
+ * @param fr 飞行记录器
+ * @return 事件槽，调用 udpjson_flight_recorder_commit() 前对读取方不可见
+ */
+static inline UdpJsonFlightEvent *udpjson_flight_recorder_begin(UdpJsonFlightRecorder *fr)
+{
+    UdpJsonFlightEvent *ev = &fr->events[fr->head & fr->mask];
+    memset(ev, 0, sizeof(*ev));
+    return ev;
+}
+
+/**
+ * @brief 发布 begin 取得的事件（只能由写入线程调用）
+ *
+ * @param fr 飞行记录器
+ */
+static inline void udpjson_flight_recorder_commit(UdpJsonFlightRecorder *fr)
+{
+    __atomic_store_n(&fr->head, fr->head + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 把最近的事件写入文件
+ *
+ * @param fr 飞行记录器
+ * @param path 文件路径
+ * @param reason 转储原因（写入文件头）
+ * @return 成功返回写入的事件数，失败返回 -1
+ */
+gint udpjson_flight_recorder_dump(UdpJsonFlightRecorder *fr, const gchar *path,
+                                  const gchar *reason);
+
+G_END_DECLS
+
+#endif /* __GST_UDPJSON_META_FLIGHTREC_H__ */
@@ -0,0 +1,486 @@
+#include "gstudpjsonmeta_fusion.h"
+#include <math.h>
+#include <string.h>
+
+/* 离开融合批号的门限为关联门限的倍数，避免在门限附近反复合并/拆分 */
+#define CUAV_FUSION_RELEASE_FACTOR 1.5
+/* 释放门限覆盖的格子半径：格子边长等于关联门限，1.5 倍门限最远跨 2 个格子 */
+#define CUAV_FUSION_RELEASE_CELLS 2
+
+/**
+ * @brief 单个传感器航迹
+ */
+typedef struct _CUAVFusionTrack CUAVFusionTrack;
+struct _CUAVFusionTrack
+{
+    guint64 key;              /* tx_sys_id << 48 | tx_dev_id << 32 | tar_id */
+    gint64 cell;              /* 所在格子 */
+    CUAVFusionTrack *cell_next; /* 同一格子中的下一条航迹 */
+    gdouble pos[3];           /* ECEF 位置(米) */
+    gdouble vel[3];           /* ECEF 速度(米/秒) */
+    guint64 ts_us;            /* 最近更新时间 */
+    guint16 tar_category;     /* 目标类型 */
+    guint32 fused_id;         /* 融合批号 */
+};
+
+/**
+ * @brief 融合批号
+ */
+typedef struct
+{
+    guint32 fused_id;         /* 融合批号 */
+    guint n_members;          /* 成员航迹数 */
+    guint64 primary_key;      /* 主航迹，0 表示由下一个更新的成员接任 */
+} CUAVFusionGroup;
+
+/**
+ * @brief 多传感器引导航迹融合（私有结构体）
+ */
+struct _CUAVFusion
+{
+    GMutex lock;
+    CUAVFusionConfig config;
+    GHashTable *tracks;       /* key -> CUAVFusionTrack */
+    GHashTable *cells;        /* cell -> 格子中第一条航迹 */
+    GHashTable *groups;       /* fused_id -> CUAVFusionGroup */
+    guint32 next_fused_id;
+    guint64 last_sweep_us;
+    CUAVFusionStats stats;
+};
+
+/**
+ * @brief 一次更新的候选扫描状态
+ */
+typedef struct
+{
+    gdouble vgate2;           /* 速度门限平方，0 表示不检查 */
+    gdouble release_d2;       /* 释放门限平方 */
+    gdouble best_d2;          /* 当前最近候选的距离平方，初值为关联门限平方 */
+    CUAVFusionTrack *best;    /* 关联门限内最近的候选 */
+    gboolean keep_group;      /* 释放门限内是否仍有本组成员 */
+} CUAVFusionScan;
+
+static guint64 cuav_fusion_key(guint16 tx_sys_id, guint16 tx_dev_id, guint32 tar_id)
+{
+    return ((guint64)tx_sys_id << 48) | ((guint64)tx_dev_id << 32) | (guint64)tar_id;
+}
+
+/**
+ * @brief 格子坐标打包为 64 位键（每轴 21 位，超出范围回绕，回绕只会多检查候选）
+ */
+static gint64 cuav_fusion_cell_pack(gint64 ix, gint64 iy, gint64 iz)
+{
+    return ((ix & 0x1FFFFF) << 42) | ((iy & 0x1FFFFF) << 21) | (iz & 0x1FFFFF);
+}
+
+static void cuav_fusion_cell_index(CUAVFusion *fusion, const gdouble *pos, gint64 *idx)
+{
+    for (guint i = 0; i < 3; i++)
+        idx[i] = (gint64)floor(pos[i] / fusion->config.gate_m);
+}
+
+static void cuav_fusion_cell_insert(CUAVFusion *fusion, CUAVFusionTrack *track)
+{
+    CUAVFusionTrack *head = (CUAVFusionTrack *)g_hash_table_lookup(fusion->cells, &track->cell);
+    track->cell_next = head;
+    /* 键指向链表头航迹的 cell 字段，必须随链表头一起替换 */
+    g_hash_table_replace(fusion->cells, &track->cell, track);
+}
+
+static void cuav_fusion_cell_remove(CUAVFusion *fusion, CUAVFusionTrack *track)
+{
+    CUAVFusionTrack *head = (CUAVFusionTrack *)g_hash_table_lookup(fusion->cells, &track->cell);
+
+    if (head == track)
+    {
+        if (track->cell_next)
+            g_hash_table_replace(fusion->cells, &track->cell_next->cell, track->cell_next);
+        else
+            g_hash_table_remove(fusion->cells, &track->cell);
+    }
+    else
+    {
+        for (CUAVFusionTrack *t = head; t; t = t->cell_next)
+        {
+            if (t->cell_next == track)
+            {
+                t->cell_next = track->cell_next;
+                break;
+            }
+        }
+    }
+    track->cell_next = NULL;
+}
+
+static CUAVFusionGroup *cuav_fusion_group_new(CUAVFusion *fusion, guint64 primary_key)
+{
+    CUAVFusionGroup *group = (CUAVFusionGroup *)g_malloc0(sizeof(CUAVFusionGroup));
+
+    if (fusion->next_fused_id == 0)
+        fusion->next_fused_id = 1;
+    group->fused_id = fusion->next_fused_id++;
+    group->primary_key = primary_key;
+    g_hash_table_insert(fusion->groups, &group->fused_id, group);
+    return group;
+}
+
+static void cuav_fusion_group_join(CUAVFusionGroup *group, CUAVFusionTrack *track)
+{
+    group->n_members++;
+    track->fused_id = group->fused_id;
+}
+
+static void cuav_fusion_group_leave(CUAVFusion *fusion, CUAVFusionTrack *track)
+{
+    CUAVFusionGroup *group = NULL;
+
+    if (track->fused_id == 0)
+        return;
+    group = (CUAVFusionGroup *)g_hash_table_lookup(fusion->groups, &track->fused_id);
+    track->fused_id = 0;
+    if (!group)
+        return;
+
+    if (group->primary_key == track->key)
+        group->primary_key = 0;
+    if (--group->n_members == 0)
+        g_hash_table_remove(fusion->groups, &group->fused_id);
+}
+
+/**
+ * @brief 从全部索引中删除航迹
+ */
+static void cuav_fusion_track_remove(CUAVFusion *fusion, CUAVFusionTrack *track)
+{
+    cuav_fusion_cell_remove(fusion, track);
+    cuav_fusion_group_leave(fusion, track);
+    g_hash_table_remove(fusion->tracks, &track->key);
+}
+
+/**
+ * @brief 删除超时航迹，按超时时间的 1/4 间隔执行
+ */
+static void cuav_fusion_sweep(CUAVFusion *fusion, guint64 now_us)
+{
+    guint64 timeout_us = (guint64)fusion->config.timeout_ms * 1000;
+    GHashTableIter iter;
+    gpointer value = NULL;
+
+    if (timeout_us == 0 || now_us - fusion->last_sweep_us < timeout_us / 4)
+        return;
+    fusion->last_sweep_us = now_us;
+
+    g_hash_table_iter_init(&iter, fusion->tracks);
+    while (g_hash_table_iter_next(&iter, NULL, &value))
+    {
+        CUAVFusionTrack *track = (CUAVFusionTrack *)value;
+        if (now_us - track->ts_us <= timeout_us)
+            continue;
+        cuav_fusion_cell_remove(fusion, track);
+        cuav_fusion_group_leave(fusion, track);
+        g_hash_table_iter_remove(&iter);
+        fusion->stats.expired++;
+    }
+}
+
+/**
+ * @brief 检查一个格子中的候选航迹，更新最近候选与本组成员状态
+ */
+static void cuav_fusion_scan_cell(CUAVFusion *fusion, CUAVFusionTrack *track, gint64 cell,
+                                  CUAVFusionScan *scan)
+{
+    for (CUAVFusionTrack *c = (CUAVFusionTrack *)g_hash_table_lookup(fusion->cells, &cell); c;
+         c = c->cell_next)
+    {
+        gdouble d2 = 0;
+        gdouble v2 = 0;
+
+        /* 同一传感器的航迹不融合 */
+        if (c == track || (c->key >> 32) == (track->key >> 32))
+            continue;
+        fusion->stats.candidates++;
+        for (guint i = 0; i < 3; i++)
+        {
+            d2 += (c->pos[i] - track->pos[i]) * (c->pos[i] - track->pos[i]);
+            v2 += (c->vel[i] - track->vel[i]) * (c->vel[i] - track->vel[i]);
+        }
+        if (scan->vgate2 > 0 && v2 > scan->vgate2)
+            continue;
+        if (track->fused_id != 0 && c->fused_id == track->fused_id && d2 < scan->release_d2)
+            scan->keep_group = TRUE;
+        if (d2 < scan->best_d2)
+        {
+            scan->best_d2 = d2;
+            scan->best = c;
+        }
+    }
+}
+
+static void cuav_fusion_clear(CUAVFusion *fusion)
+{
+    g_hash_table_remove_all(fusion->cells);
+    g_hash_table_remove_all(fusion->groups);
+    g_hash_table_remove_all(fusion->tracks);
+}
+
+CUAVFusion *cuav_fusion_new(const CUAVFusionConfig *config)
+{
+    CUAVFusion *fusion = (CUAVFusion *)g_malloc0(sizeof(CUAVFusion));
+
+    g_mutex_init(&fusion->lock);
+    fusion->tracks = g_hash_table_new_full(g_int64_hash, g_int64_equal, NULL, g_free);
+    fusion->cells = g_hash_table_new(g_int64_hash, g_int64_equal);
+    fusion->groups = g_hash_table_new_full(g_int_hash, g_int_equal, NULL, g_free);
+    fusion->next_fused_id = 1;
+    fusion->config.timeout_ms = CUAV_FUSION_DEFAULT_TIMEOUT_MS;
+    if (config)
+        cuav_fusion_set_config(fusion, config);
+    return fusion;
+}
+
+void cuav_fusion_free(CUAVFusion *fusion)
+{
+    if (!fusion)
+        return;
+    /* cells 不持有航迹，需在 tracks 之前销毁 */
+    g_hash_table_destroy(fusion->cells);
+    g_hash_table_destroy(fusion->groups);
+    g_hash_table_destroy(fusion->tracks);
+    g_mutex_clear(&fusion->lock);
+    g_free(fusion);
+}
+
+void cuav_fusion_set_config(CUAVFusion *fusion, const CUAVFusionConfig *config)
+{
+    if (!fusion || !config)
+        return;
+
+    g_mutex_lock(&fusion->lock);
+    if (config->gate_m != fusion->config.gate_m)
+        cuav_fusion_clear(fusion);
+    fusion->config = *config;
+    if (fusion->config.gate_m < 0)
+        fusion->config.gate_m = 0;
+    g_mutex_unlock(&fusion->lock);
+}
+
+guint32 cuav_fusion_update(CUAVFusion *fusion, const CUAVCommonHeader *header,
+                           const CUAVGuidanceInfo *guidance, gboolean *primary)
+{
+    guint64 key = 0;
+    CUAVFusionTrack *track = NULL;
+    CUAVFusionGroup *group = NULL;
+    CUAVFusionScan scan;
+    gint64 idx[3];
+    guint32 fused_id = 0;
+
+    if (primary)
+        *primary = FALSE;
+    if (!fusion || !header || !guidance)
+        return 0;
+
+    key = cuav_fusion_key(header->tx_sys_id, header->tx_dev_id, guidance->tar_id);
+
+    g_mutex_lock(&fusion->lock);
+    if (fusion->config.gate_m <= 0)
+    {
+        g_mutex_unlock(&fusion->lock);
+        return 0;
+    }
+    fusion->stats.updates++;
+    cuav_fusion_sweep(fusion, header->recv_ts_us);
+
+    track = (CUAVFusionTrack *)g_hash_table_lookup(fusion->tracks, &key);
+    if (guidance->guid_stat == 0)
+    {
+        if (track)
+            cuav_fusion_track_remove(fusion, track);
+        g_mutex_unlock(&fusion->lock);
+        return 0;
+    }
+
+    if (!track)
+    {
+        track = (CUAVFusionTrack *)g_malloc0(sizeof(CUAVFusionTrack));
+        track->key = key;
+        g_hash_table_insert(fusion->tracks, &track->key, track);
+    }
+    else
+    {
+        cuav_fusion_cell_remove(fusion, track);
+    }
+
+    track->pos[0] = guidance->ecef_x;
+    track->pos[1] = guidance->ecef_y;
+    track->pos[2] = guidance->ecef_z;
+    track->vel[0] = guidance->ecef_vx;
+    track->vel[1] = guidance->ecef_vy;
+    track->vel[2] = guidance->ecef_vz;
+    track->ts_us = header->recv_ts_us;
+    track->tar_category = guidance->tar_category;
+
+    cuav_fusion_cell_index(fusion, track->pos, idx);
+    track->cell = cuav_fusion_cell_pack(idx[0], idx[1], idx[2]);
+    cuav_fusion_cell_insert(fusion, track);
+
+    /* 关联只需检查相邻 27 个格子：格子边长等于门限，门限内的航迹必在其中 */
+    memset(&scan, 0, sizeof(scan));
+    scan.best_d2 = fusion->config.gate_m * fusion->config.gate_m;
+    scan.release_d2 = scan.best_d2 * CUAV_FUSION_RELEASE_FACTOR * CUAV_FUSION_RELEASE_FACTOR;
+    scan.vgate2 = fusion->config.velocity_gate_mps * fusion->config.velocity_gate_mps;
+    for (gint dx = -1; dx <= 1; dx++)
+        for (gint dy = -1; dy <= 1; dy++)
+            for (gint dz = -1; dz <= 1; dz++)
+                cuav_fusion_scan_cell(fusion, track,
+                                      cuav_fusion_cell_pack(idx[0] + dx, idx[1] + dy, idx[2] + dz),
+                                      &scan);
+
+    if (track->fused_id != 0)
+        group = (CUAVFusionGroup *)g_hash_table_lookup(fusion->groups, &track->fused_id);
+
+    /* 释放门限超出相邻格子，内层未找到本组成员时再检查外层格子，避免误拆分 */
+    if (group && group->n_members > 1 && !scan.keep_group)
+    {
+        for (gint dx = -CUAV_FUSION_RELEASE_CELLS; dx <= CUAV_FUSION_RELEASE_CELLS; dx++)
+        {
+            for (gint dy = -CUAV_FUSION_RELEASE_CELLS; dy <= CUAV_FUSION_RELEASE_CELLS; dy++)
+            {
+                for (gint dz = -CUAV_FUSION_RELEASE_CELLS; dz <= CUAV_FUSION_RELEASE_CELLS; dz++)
+                {
+                    if (ABS(dx) <= 1 && ABS(dy) <= 1 && ABS(dz) <= 1)
+                        continue;
+                    cuav_fusion_scan_cell(fusion, track,
+                                          cuav_fusion_cell_pack(idx[0] + dx, idx[1] + dy,
+                                                                idx[2] + dz),
+                                          &scan);
+                }
+            }
+        }
+    }
+
+    if (group && group->n_members > 1 && scan.keep_group)
+    {
+        /* 仍与本组成员关联，保持 */
+    }
+    else if (scan.best && scan.best->fused_id != 0 && scan.best->fused_id != track->fused_id)
+    {
+        cuav_fusion_group_leave(fusion, track);
+        group = (CUAVFusionGroup *)g_hash_table_lookup(fusion->groups, &scan.best->fused_id);
+        cuav_fusion_group_join(group, track);
+        fusion->stats.merges++;
+    }
+    else if (!group || group->n_members > 1)
+    {
+        if (group)
+        {
+            cuav_fusion_group_leave(fusion, track);
+            fusion->stats.splits++;
+        }
+        group = cuav_fusion_group_new(fusion, key);
+        cuav_fusion_group_join(group, track);
+    }
+
+    if (group->primary_key == 0)
+        group->primary_key = key;
+    if (primary)
+        *primary = group->primary_key == key;
+    fused_id = group->fused_id;
+
+    g_mutex_unlock(&fusion->lock);
+    return fused_id;
+}
+
+guint32 cuav_fusion_lookup(CUAVFusion *fusion, guint16 tx_sys_id, guint16 tx_dev_id,
+                           guint32 tar_id)
+{
+    guint64 key = cuav_fusion_key(tx_sys_id, tx_dev_id, tar_id);
+    CUAVFusionTrack *track = NULL;
+    guint32 fused_id = 0;
+
+    if (!fusion)
+        return 0;
+
+    g_mutex_lock(&fusion->lock);
+    track = (CUAVFusionTrack *)g_hash_table_lookup(fusion->tracks, &key);
+    if (track)
+        fused_id = track->fused_id;
+    g_mutex_unlock(&fusion->lock);
+    return fused_id;
+}
+
+guint cuav_fusion_snapshot(CUAVFusion *fusion, CUAVFusedTrack *tracks, guint max_tracks)
+{
+    GHashTable *slots = NULL; /* fused_id -> 输出下标+1 */
+    GHashTableIter iter;
+    gpointer value = NULL;
+    guint n = 0;
+    guint total = 0;
+
+    if (!fusion)
+        return 0;
+
+    slots = g_hash_table_new(g_direct_hash, g_direct_equal);
+    g_mutex_lock(&fusion->lock);
+    total = g_hash_table_size(fusion->groups);
+
+    g_hash_table_iter_init(&iter, fusion->tracks);
+    while (tracks && g_hash_table_iter_next(&iter, NULL, &value))
+    {
+        CUAVFusionTrack *t = (CUAVFusionTrack *)value;
+        CUAVFusionGroup *group = NULL;
+        CUAVFusedTrack *f = NULL;
+        guint slot = GPOINTER_TO_UINT(g_hash_table_lookup(slots, GUINT_TO_POINTER(t->fused_id)));
+
+        if (t->fused_id == 0)
+            continue;
+        if (slot == 0)
+        {
+            if (n >= max_tracks)
+                continue;
+            group = (CUAVFusionGroup *)g_hash_table_lookup(fusion->groups, &t->fused_id);
+            f = &tracks[n++];
+            memset(f, 0, sizeof(CUAVFusedTrack));
+            f->fused_id = t->fused_id;
+            f->n_members = group ? group->n_members : 1;
+            g_hash_table_insert(slots, GUINT_TO_POINTER(t->fused_id), GUINT_TO_POINTER(n));
+        }
+        else
+        {
+            f = &tracks[slot - 1];
+            group = (CUAVFusionGroup *)g_hash_table_lookup(fusion->groups, &t->fused_id);
+        }
+
+        if (f->primary_tar_id == 0 || (group && group->primary_key == t->key))
+        {
+            f->primary_tx_dev_id = (guint16)(t->key >> 32);
+            f->primary_tar_id = (guint32)t->key;
+            f->tar_category = t->tar_category;
+        }
+        f->ecef_x += t->pos[0] / f->n_members;
+        f->ecef_y += t->pos[1] / f->n_members;
+        f->ecef_z += t->pos[2] / f->n_members;
+        f->ecef_vx += t->vel[0] / f->n_members;
+        f->ecef_vy += t->vel[1] / f->n_members;
+        f->ecef_vz += t->vel[2] / f->n_members;
+        f->update_ts_us = MAX(f->update_ts_us, t->ts_us);
+    }
+
+    g_mutex_unlock(&fusion->lock);
+    g_hash_table_destroy(slots);
+    return total;
+}
+
+void cuav_fusion_get_stats(CUAVFusion *fusion, CUAVFusionStats *stats)
+{
+    if (!stats)
+        return;
+    memset(stats, 0, sizeof(CUAVFusionStats));
+    if (!fusion)
+        return;
+
+    g_mutex_lock(&fusion->lock);
+    *stats = fusion->stats;
+    stats->tracks = g_hash_table_size(fusion->tracks);
+    stats->fused_tracks = g_hash_table_size(fusion->groups);
+    g_mutex_unlock(&fusion->lock);
+}
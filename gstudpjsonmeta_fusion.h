@@ -0,0 +1,138 @@
+#ifndef __GST_UDPJSON_META_FUSION_H__
+#define __GST_UDPJSON_META_FUSION_H__
+
+#include <glib.h>
+#include "gstudpjsonmeta_cuav.h"
+
+G_BEGIN_DECLS
+
+/* 航迹超过该时间未更新即删除(毫秒) */
+#define CUAV_FUSION_DEFAULT_TIMEOUT_MS 3000
+
+/**
+ * @brief 融合配置
+ */
+typedef struct
+{
+    gdouble gate_m;               /* 位置关联门限(米)，也是空间哈希格子边长，0 表示不融合 */
+    gdouble velocity_gate_mps;    /* 速度差门限(米/秒)，0 表示不检查 */
+    guint timeout_ms;             /* 航迹超时(毫秒) */
+} CUAVFusionConfig;
+
+/**
+ * @brief 融合后的航迹（成员航迹的平均）
+ */
+typedef struct
+{
+    guint32 fused_id;             /* 融合批号 */
+    guint n_members;              /* 成员航迹数 */
+    guint16 primary_tx_dev_id;    /* 主航迹的发送设备编号 */
+    guint32 primary_tar_id;       /* 主航迹的引导批号 */
+    guint16 tar_category;         /* 主航迹的目标类型 */
+    gdouble ecef_x;               /* ECEF X(米) */
+    gdouble ecef_y;               /* ECEF Y(米) */
+    gdouble ecef_z;               /* ECEF Z(米) */
+    gdouble ecef_vx;              /* ECEF X 速度(米/秒) */
+    gdouble ecef_vy;              /* ECEF Y 速度(米/秒) */
+    gdouble ecef_vz;              /* ECEF Z 速度(米/秒) */
+    guint64 update_ts_us;         /* 最近一次成员更新时间(单调时钟，微秒) */
+} CUAVFusedTrack;
+
+/**
+ * @brief 融合统计
+ */
+typedef struct
+{
+    guint64 updates;              /* 处理的引导报文数 */
+    guint64 merges;               /* 航迹并入其他融合批号的次数 */
+    guint64 splits;               /* 航迹离开融合批号的次数 */
+    guint64 expired;              /* 超时删除的航迹数 */
+    guint64 candidates;           /* 门限检查的候选航迹数（衡量空间哈希效果） */
+    guint tracks;                 /* 当前传感器航迹数 */
+    guint fused_tracks;           /* 当前融合批号数 */
+} CUAVFusionStats;
+
+/**
+ * @brief 多传感器引导航迹融合（不透明类型）
+ *
+ * 以 (tx_sys_id, tx_dev_id, tar_id) 区分各雷达的航迹，按 ECEF 坐标放入
+ * 边长为 gate_m 的空间哈希格子；每次更新只检查相邻 27 个格子中的航迹，
+ * 位置与速度都在门限内的不同传感器航迹共享同一个融合批号。已融合的航迹在
+ * 1.5 倍门限内仍有本组成员时保持批号，相邻格子中没有本组成员时再检查外层
+ * 格子，避免在门限附近反复合并/拆分。
+ * 内部加锁，可在接收线程更新、在任意线程读取。
+ */
+typedef struct _CUAVFusion CUAVFusion;
+
+/**
+ * @brief 创建融合实例
+ *
+ * @param config 融合配置，NULL 表示不融合（gate_m 为 0），之后可用 cuav_fusion_set_config 开启
+ * @return 融合实例
+ */
+CUAVFusion *cuav_fusion_new(const CUAVFusionConfig *config);
+
+/**
+ * @brief 释放融合实例
+ *
+ * @param fusion 融合实例
+ */
+void cuav_fusion_free(CUAVFusion *fusion);
+
+/**
+ * @brief 修改融合配置，门限变化时清空全部航迹
+ *
+ * gate_m 为 0 时关闭融合：清空航迹，之后的 cuav_fusion_update 直接返回 0。
+ *
+ * @param fusion 融合实例
+ * @param config 融合配置
+ */
+void cuav_fusion_set_config(CUAVFusion *fusion, const CUAVFusionConfig *config);
+
+/**
+ * @brief 输入一条引导信息
+ *
+ * guid_stat 为 0（取消）时删除对应航迹。融合关闭时不记录航迹。
+ *
+ * @param fusion 融合实例
+ * @param header 公共报文头
+ * @param guidance 引导信息
+ * @param primary 输出是否为融合批号的主航迹（可为 NULL）
+ * @return 融合批号，航迹被删除或融合关闭时返回 0
+ */
+guint32 cuav_fusion_update(CUAVFusion *fusion, const CUAVCommonHeader *header,
+                           const CUAVGuidanceInfo *guidance, gboolean *primary);
+
+/**
+ * @brief 查询传感器航迹的融合批号
+ *
+ * @param fusion 融合实例
+ * @param tx_sys_id 发送方系统号
+ * @param tx_dev_id 发送方设备编号
+ * @param tar_id 引导批号
+ * @return 融合批号，未知航迹返回 0
+ */
+guint32 cuav_fusion_lookup(CUAVFusion *fusion, guint16 tx_sys_id, guint16 tx_dev_id,
+                           guint32 tar_id);
+
+/**
+ * @brief 获取当前全部融合航迹
+ *
+ * @param fusion 融合实例
+ * @param tracks 输出数组
+ * @param max_tracks 数组容量
+ * @return 融合航迹总数（可能大于 max_tracks）
+ */
+guint cuav_fusion_snapshot(CUAVFusion *fusion, CUAVFusedTrack *tracks, guint max_tracks);
+
+/**
+ * @brief 获取融合统计
+ *
+ * @param fusion 融合实例
+ * @param stats 输出统计
+ */
+void cuav_fusion_get_stats(CUAVFusion *fusion, CUAVFusionStats *stats);
+
+G_END_DECLS
+
+#endif /* __GST_UDPJSON_META_FUSION_H__ */
@@ -0,0 +1,2041 @@
+#include "gstudpjsonmeta_ingest.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <json-glib/json-glib.h>
+#include <net/if.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "gstudpjsonmeta_trace.h"
+
+/* 每秒报文数低于该值时不判断失败比例 */
+#define UDPJSON_FLIGHT_MIN_PACKETS 10
+/* 两次自动转储的最小间隔(微秒) */
+#define UDPJSON_FLIGHT_AUTO_DUMP_INTERVAL_US (10 * G_USEC_PER_SEC)
+/* 接收日志环形缓冲大小（约 4 MiB，刷写线程每 10ms 清空一次） */
+#define UDPJSON_JOURNAL_RING_SIZE (4u << 20)
+
+/* flight-recorder-signal 的最大信号编号 */
+#define UDPJSON_FLIGHT_MAX_SIGNAL 64
+
+/* 各信号收到的次数，安装了该信号的实例的接收线程据此转储 */
+static volatile gint udpjson_flight_signal_count[UDPJSON_FLIGHT_MAX_SIGNAL + 1];
+/* 各信号安装处理函数的实例数与安装前的信号动作（udpjson_flight_signal_lock 保护） */
+static GMutex udpjson_flight_signal_lock;
+static guint udpjson_flight_signal_refs[UDPJSON_FLIGHT_MAX_SIGNAL + 1];
+static struct sigaction udpjson_flight_signal_prev[UDPJSON_FLIGHT_MAX_SIGNAL + 1];
+
+/* 进程内共享接收器注册表："group:port@iface" -> UdpJsonIngest */
+static GMutex udpjson_shared_lock;
+static GHashTable *udpjson_shared_table = NULL;
+
+/**
+ * @brief 取实例名（文件名与日志中使用）。
+ *
+ * @param ingest 接收实例。
+ * @return name，未设置时为 owner 的名字，均无时为 "ingest"。
+ */
+static const gchar *udpjson_ingest_name(const UdpJsonIngest *ingest)
+{
+    if (ingest->name)
+        return ingest->name;
+    return ingest->owner ? GST_OBJECT_NAME(ingest->owner) : "ingest";
+}
+
+/**
+ * @brief 计算缓存键的哈希值。
+ *
+ * @param key 缓存键指针。
+ * @return 哈希值。
+ */
+static guint udpjson_cache_key_hash(gconstpointer key)
+{
+    const UdpJsonCacheKey *ckey = (const UdpJsonCacheKey *)key; /* 缓存键指针 */
+    guint hash = 0; /* 哈希值 */
+    hash = g_direct_hash(GINT_TO_POINTER(ckey->source_id));
+    hash ^= g_int64_hash(&ckey->object_id);
+    return hash;
+}
+
+/**
+ * @brief 判断两个缓存键是否相等。
+ *
+ * @param a 缓存键A。
+ * @param b 缓存键B。
+ * @return 相等返回 TRUE。
+ */
+static gboolean udpjson_cache_key_equal(gconstpointer a, gconstpointer b)
+{
+    const UdpJsonCacheKey *ka = (const UdpJsonCacheKey *)a; /* 缓存键A */
+    const UdpJsonCacheKey *kb = (const UdpJsonCacheKey *)b; /* 缓存键B */
+    return (ka->source_id == kb->source_id) && (ka->object_id == kb->object_id);
+}
+
+/**
+ * @brief 释放缓存键。
+ *
+ * @param data 缓存键指针。
+ */
+static void udpjson_cache_key_free(gpointer data)
+{
+    UdpJsonCacheKey *key = (UdpJsonCacheKey *)data; /* 缓存键 */
+    g_free(key);
+}
+
+/**
+ * @brief 释放缓存值。
+ *
+ * @param data 缓存值指针。
+ */
+static void udpjson_cache_value_free(gpointer data)
+{
+    UdpJsonCacheValue *val = (UdpJsonCacheValue *)data; /* 缓存值 */
+    if (!val)
+        return;
+    g_free(val->value);
+    g_free(val);
+}
+
+/**
+ * @brief 从 JSON 节点解析无符号整数。
+ *
+ * @param node JSON 节点。
+ * @param out 输出的整数。
+ * @return 解析成功返回 TRUE。
+ */
+static gboolean udpjson_parse_uint64(JsonNode *node, guint64 *out)
+{
+    GType vtype = 0; /* 值类型 */
+    if (!node || !out)
+        return FALSE;
+
+    vtype = json_node_get_value_type(node);
+    if (vtype == G_TYPE_STRING)
+    {
+        const gchar *str = json_node_get_string(node); /* 字符串 */
+        if (!str)
+            return FALSE;
+        *out = g_ascii_strtoull(str, NULL, 10);
+        return TRUE;
+    }
+    if (vtype == G_TYPE_INT64)
+    {
+        *out = (guint64)json_node_get_int(node);
+        return TRUE;
+    }
+    if (vtype == G_TYPE_DOUBLE)
+    {
+        *out = (guint64)json_node_get_double(node);
+        return TRUE;
+    }
+    if (vtype == G_TYPE_UINT64)
+    {
+        GValue val = G_VALUE_INIT; /* 临时值 */
+        json_node_get_value(node, &val);
+        *out = g_value_get_uint64(&val);
+        g_value_unset(&val);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/**
+ * @brief 将 JSON 节点转换为字符串。
+ *
+ * @param node JSON 节点。
+ * @return 新分配的字符串，需调用 g_free 释放。
+ */
+static gchar *udpjson_node_to_string(JsonNode *node)
+{
+    GType vtype = 0; /* 值类型 */
+    if (!node)
+        return NULL;
+
+    if (!JSON_NODE_HOLDS_VALUE(node))
+    {
+        return json_to_string(node, FALSE);
+    }
+
+    vtype = json_node_get_value_type(node);
+    if (vtype == G_TYPE_STRING)
+        return g_strdup(json_node_get_string(node));
+    if (vtype == G_TYPE_INT64)
+        return g_strdup_printf("%" G_GINT64_FORMAT, json_node_get_int(node));
+    if (vtype == G_TYPE_DOUBLE)
+        return g_strdup_printf("%f", json_node_get_double(node));
+    if (vtype == G_TYPE_BOOLEAN)
+        return g_strdup(json_node_get_boolean(node) ? "true" : "false");
+    if (vtype == G_TYPE_UINT64)
+    {
+        GValue val = G_VALUE_INIT; /* 临时值 */
+        guint64 out = 0; /* 解析值 */
+        json_node_get_value(node, &val);
+        out = g_value_get_uint64(&val);
+        g_value_unset(&val);
+        return g_strdup_printf("%" G_GUINT64_FORMAT, out);
+    }
+
+    return json_to_string(node, FALSE);
+}
+
+void udpjson_ingest_cache_update(UdpJsonIngest *ingest, guint source_id,
+                                 guint64 object_id, const gchar *value, guint32 tar_id)
+{
+    UdpJsonCacheKey *key = NULL; /* 缓存键 */
+    UdpJsonCacheValue *val = NULL; /* 缓存值 */
+    guint64 now_us = 0; /* 当前时间(微秒) */
+    gboolean flushed = FALSE; /* 本次写入前是否整体清空 */
+    gboolean inserted = FALSE; /* 是否为新增条目 */
+
+    if (!ingest || !value)
+        return;
+
+    now_us = (guint64)g_get_monotonic_time();
+
+    g_rw_lock_writer_lock(&ingest->cache_lock);
+
+    if (ingest->max_cache_size > 0 && g_hash_table_size(ingest->cache) >= ingest->max_cache_size)
+    {
+        if (ingest->cache_debug)
+        {
+            UdpJsonEventRecord *rec = udpjson_event_log_reserve(ingest->event_log,
+                                                                UDPJSON_EVENT_CACHE_FLUSH);
+            if (rec)
+            {
+                rec->u.cache.entries = g_hash_table_size(ingest->cache);
+                udpjson_event_log_commit(ingest->event_log, rec);
+            }
+        }
+        UDPJSON_PROBE1(cache_evict, g_hash_table_size(ingest->cache));
+        udpjson_stats_add(ingest->stats, UDPJSON_STATS_SHARD_RECV, UDPJSON_STAT_CACHE_EVICTIONS, 1);
+        udpjson_stats_add(ingest->stats, UDPJSON_STATS_SHARD_RECV, UDPJSON_STAT_CACHE_EVICTED,
+                          g_hash_table_size(ingest->cache));
+        g_hash_table_remove_all(ingest->cache);
+        flushed = TRUE;
+    }
+
+    key = (UdpJsonCacheKey *)g_malloc0(sizeof(UdpJsonCacheKey));
+    key->source_id = source_id;
+    key->object_id = object_id;
+
+    val = (UdpJsonCacheValue *)g_malloc0(sizeof(UdpJsonCacheValue));
+    val->value = g_strdup(value);
+    val->recv_ts_us = now_us;
+    val->tar_id = tar_id;
+
+    inserted = g_hash_table_replace(ingest->cache, key, val);
+    UDPJSON_PROBE3(cache_publish, source_id, object_id, g_hash_table_size(ingest->cache));
+    if (ingest->flight_event)
+    {
+        ingest->flight_event->cache_action = flushed ? UDPJSON_FR_CACHE_FLUSH_INSERT
+                                         : inserted ? UDPJSON_FR_CACHE_INSERT
+                                                    : UDPJSON_FR_CACHE_REPLACE;
+        ingest->flight_event->cache_entries = g_hash_table_size(ingest->cache);
+    }
+    g_rw_lock_writer_unlock(&ingest->cache_lock);
+    if (flushed && ingest->flight_recorder_dump_on_flush)
+        ingest->flight_flush_pending = TRUE;
+    udpjson_stats_add(ingest->stats, UDPJSON_STATS_SHARD_RECV, UDPJSON_STAT_CACHE_UPDATES, 1);
+
+    if (ingest->cache_debug)
+    {
+        UdpJsonEventRecord *rec = udpjson_event_log_reserve(ingest->event_log,
+                                                            UDPJSON_EVENT_CACHE_UPDATE);
+        if (rec)
+        {
+            rec->u.cache.source_id = source_id;
+            rec->u.cache.object_id = object_id;
+            rec->u.cache.tar_id = tar_id;
+            rec->u.cache.value_len = (guint32)strlen(value);
+            udpjson_event_log_commit(ingest->event_log, rec);
+        }
+    }
+}
+
+/**
+ * @brief 记录一次目标 JSON 解析失败。
+ *
+ * @param ingest 接收实例。
+ * @param stat 失败计数器。
+ */
+static void udpjson_parse_failed(UdpJsonIngest *ingest, UdpJsonStat stat)
+{
+    udpjson_stats_add(ingest->stats, UDPJSON_STATS_SHARD_RECV, stat, 1);
+    UDPJSON_PROBE3(parse_end, 0, 0, 0);
+    if (ingest->flight_event)
+        ingest->flight_event->result = stat == UDPJSON_STAT_PARSE_FAILURES
+                                         ? UDPJSON_FR_RESULT_INVALID_JSON
+                                         : UDPJSON_FR_RESULT_MISSING_FIELDS;
+}
+
+void udpjson_ingest_parse_and_cache(UdpJsonIngest *ingest, const gchar *data, gssize len,
+                                    guint64 recv_ns, guint default_source_id)
+{
+    JsonParser *parser = NULL; /* JSON 解析器 */
+    JsonNode *root = NULL; /* 根节点 */
+    JsonObject *obj = NULL; /* JSON 对象 */
+    JsonNode *obj_id_node = NULL; /* 目标ID节点 */
+    JsonNode *src_id_node = NULL; /* 源ID节点 */
+    JsonNode *val_node = NULL; /* 值节点 */
+    guint64 object_id = 0; /* 目标ID */
+    guint64 source_id64 = 0; /* 源ID */
+    guint64 tar_id64 = 0; /* 关联的引导批号 */
+    gchar *value_str = NULL; /* 值字符串 */
+    guint64 parsed_ns = 0; /* 解析完成时间 */
+    guint64 published_ns = 0; /* 写入缓存完成时间 */
+
+    if (!ingest || !data || len <= 0)
+        return;
+
+    /* 不在可见目标集合中的报文只扫描ID，不解析、不写缓存 */
+    if (ingest->demand)
+    {
+        guint scan_source_id = default_source_id; /* 扫描到的源ID */
+
+        if (udpjson_demand_scan_ids(data, (gsize)len, &scan_source_id, &object_id) &&
+            !udpjson_demand_wanted(ingest->demand, scan_source_id, object_id,
+                                   (gint64)(recv_ns / 1000)))
+        {
+            udpjson_stats_add(ingest->stats, UDPJSON_STATS_SHARD_RECV,
+                              UDPJSON_STAT_PARSE_NOT_IN_DEMAND, 1);
+            if (ingest->flight_event)
+            {
+                ingest->flight_event->result = UDPJSON_FR_RESULT_NOT_IN_DEMAND;
+                ingest->flight_event->source_id = scan_source_id;
+                ingest->flight_event->object_id = object_id;
+            }
+            return;
+        }
+        object_id = 0;
+    }
+
+    UDPJSON_PROBE1(parse_start, len);
+
+    parser = json_parser_new();
+    if (!json_parser_load_from_data(parser, data, len, NULL))
+    {
+        udpjson_parse_failed(ingest, UDPJSON_STAT_PARSE_FAILURES);
+        g_object_unref(parser);
+        return;
+    }
+
+    root = json_parser_get_root(parser);
+    if (!root || !JSON_NODE_HOLDS_OBJECT(root))
+    {
+        udpjson_parse_failed(ingest, UDPJSON_STAT_PARSE_FAILURES);
+        g_object_unref(parser);
+        return;
+    }
+
+    obj = json_node_get_object(root);
+    if (!obj)
+    {
+        udpjson_parse_failed(ingest, UDPJSON_STAT_PARSE_FAILURES);
+        g_object_unref(parser);
+        return;
+    }
+
+    if (json_object_has_member(obj, "object_id"))
+        obj_id_node = json_object_get_member(obj, "object_id");
+    if (json_object_has_member(obj, "source_id"))
+        src_id_node = json_object_get_member(obj, "source_id");
+    if (json_object_has_member(obj, "value"))
+        val_node = json_object_get_member(obj, "value");
+
+    if (!obj_id_node || !val_node)
+    {
+        udpjson_parse_failed(ingest, UDPJSON_STAT_PARSE_MISSING);
+        g_object_unref(parser);
+        return;
+    }
+
+    if (!udpjson_parse_uint64(obj_id_node, &object_id))
+    {
+        udpjson_parse_failed(ingest, UDPJSON_STAT_PARSE_MISSING);
+        g_object_unref(parser);
+        return;
+    }
+
+    if (src_id_node && udpjson_parse_uint64(src_id_node, &source_id64))
+    {
+        /* 使用解析到的 source_id */
+    }
+    else
+    {
+        source_id64 = default_source_id;
+    }
+
+    /* 引导批号可在顶层或 value 对象中给出，用于伺服目标关联 */
+    if (json_object_has_member(obj, "tar_id"))
+    {
+        udpjson_parse_uint64(json_object_get_member(obj, "tar_id"), &tar_id64);
+    }
+    else if (JSON_NODE_HOLDS_OBJECT(val_node) &&
+             json_object_has_member(json_node_get_object(val_node), "tar_id"))
+    {
+        udpjson_parse_uint64(json_object_get_member(json_node_get_object(val_node), "tar_id"),
+                             &tar_id64);
+    }
+
+    value_str = udpjson_node_to_string(val_node);
+    if (value_str)
+    {
+        parsed_ns = udpjson_now_ns();
+        UDPJSON_PROBE3(parse_end, 1, source_id64, object_id);
+        udpjson_stats_record(ingest->stats, UDPJSON_HIST_RECV_PARSE, parsed_ns - recv_ns);
+        if (ingest->flight_event)
+        {
+            ingest->flight_event->result = UDPJSON_FR_RESULT_OK;
+            ingest->flight_event->source_id = (guint32)source_id64;
+            ingest->flight_event->object_id = object_id;
+        }
+        udpjson_ingest_cache_update(ingest, (guint)source_id64, object_id, value_str,
+                                    (guint32)tar_id64);
+        published_ns = udpjson_now_ns();
+        udpjson_stats_record(ingest->stats, UDPJSON_HIST_PARSE_PUBLISH, published_ns - parsed_ns);
+        if (udpjson_trace_enabled() && ingest->owner)
+        {
+            udpjson_trace_stage(ingest->owner, UDPJSON_TRACE_STAGE_PARSE, parsed_ns - recv_ns);
+            udpjson_trace_stage(ingest->owner, UDPJSON_TRACE_STAGE_PUBLISH,
+                                published_ns - parsed_ns);
+        }
+        udpjson_stats_add(ingest->stats, UDPJSON_STATS_SHARD_RECV, UDPJSON_STAT_PARSE_OK, 1);
+        g_free(value_str);
+    }
+    else
+    {
+        udpjson_parse_failed(ingest, UDPJSON_STAT_PARSE_MISSING);
+    }
+
+    g_object_unref(parser);
+}
+
+void udpjson_ingest_parse_cuav(UdpJsonIngest *ingest, const gchar *data, gssize len)
+{
+    gboolean ok = cuav_parser_parse(ingest->cuav_parser, data, len); /* 解析结果 */
+
+    udpjson_stats_add(ingest->stats, UDPJSON_STATS_SHARD_RECV,
+                      ok ? UDPJSON_STAT_CUAV_PARSED : UDPJSON_STAT_CUAV_FAILURES, 1);
+    if (ingest->flight_event)
+        ingest->flight_event->result =
+            ok ? UDPJSON_FR_RESULT_CUAV_OK : UDPJSON_FR_RESULT_CUAV_FAILED;
+}
+
+/**
+ * @brief 启用去重时在统计结构中加入 "dedup-paths"：每条路径一个 "path-N" 子结构，
+ *        含端点、采用数、重复数与领先时间。
+ *
+ * @param json 接收目标 JSON 的实例（自身或共享接收器）。
+ * @param structure 统计结构。
+ */
+static void udpjson_add_dedup_paths(UdpJsonIngest *json, GstStructure *structure)
+{
+    GstStructure *paths = NULL; /* 各路径统计 */
+    guint num_paths = 1; /* 路径数 */
+
+    if (!json->dedup)
+        return;
+    if (json->endpoint_socks)
+        num_paths = MIN(json->endpoint_socks->len, (guint)UDPJSON_DEDUP_MAX_PATHS);
+
+    paths = gst_structure_new_empty("dedup-paths");
+    for (guint i = 0; i < num_paths; i++)
+    {
+        UdpJsonDedupPathStats st; /* 路径统计 */
+        gchar *endpoint = NULL; /* 路径的端点 */
+        gchar field[16]; /* 字段名 */
+        GstStructure *sub = NULL; /* 单条路径 */
+
+        udpjson_dedup_get_path_stats(json->dedup, i, &st);
+        if (json->endpoint_socks)
+        {
+            const UdpJsonEndpoint *ep = &g_array_index(json->endpoint_socks, UdpJsonEndpoint, i);
+            endpoint = g_strdup_printf("%s:%u@%s", ep->multicast_ip, ep->port,
+                                       ep->iface ? ep->iface : "");
+        }
+        else
+        {
+            endpoint = g_strdup_printf("%s:%u@%s", json->multicast_ip, json->port,
+                                       json->iface ? json->iface : "");
+        }
+        g_snprintf(field, sizeof(field), "path-%u", i);
+        sub = gst_structure_new(field,
+                                "endpoint", G_TYPE_STRING, endpoint,
+                                "first", G_TYPE_UINT64, st.first,
+                                "late", G_TYPE_UINT64, st.late,
+                                "lead-count", G_TYPE_UINT64, st.lead_count,
+                                "lead-mean-ns", G_TYPE_UINT64,
+                                st.lead_count ? st.lead_sum_ns / st.lead_count : 0,
+                                "lead-max-ns", G_TYPE_UINT64, st.lead_max_ns, NULL);
+        gst_structure_set(paths, field, GST_TYPE_STRUCTURE, sub, NULL);
+        gst_structure_free(sub);
+        g_free(endpoint);
+    }
+    gst_structure_set(structure, "dedup-paths", GST_TYPE_STRUCTURE, paths, NULL);
+    gst_structure_free(paths);
+}
+
+/**
+ * @brief 按 stats-interval-ms 在总线上发布统计消息（接收线程调用）。
+ *
+ * @param ingest 接收实例。
+ */
+static void udpjson_post_stats(UdpJsonIngest *ingest)
+{
+    guint interval_ms = (guint)g_atomic_int_get(&ingest->stats_interval_ms); /* 发布间隔 */
+    gint64 now_us = 0; /* 当前时间 */
+    GstStructure *structure = NULL; /* 统计消息 */
+
+    if (interval_ms == 0 || !ingest->owner)
+        return;
+    now_us = g_get_monotonic_time();
+    if (now_us - ingest->stats_post_us < (gint64)interval_ms * 1000)
+        return;
+    ingest->stats_post_us = now_us;
+
+    structure = udpjson_stats_to_structure(ingest->stats);
+    udpjson_add_dedup_paths(ingest->json_ingest, structure);
+    gst_element_post_message(ingest->owner,
+                             gst_message_new_element(GST_OBJECT(ingest->owner), structure));
+}
+
+/**
+ * @brief 信号处理函数：只计数并转交安装前的处理函数，转储由接收线程发起。
+ *
+ * 安装前为默认动作或忽略时不转交，默认动作多为终止进程。
+ *
+ * @param signum 信号编号。
+ * @param info 信号信息。
+ * @param context 信号上下文。
+ */
+static void udpjson_flight_signal_handler(int signum, siginfo_t *info, void *context)
+{
+    const struct sigaction *prev = &udpjson_flight_signal_prev[signum]; /* 安装前的动作 */
+
+    __atomic_add_fetch(&udpjson_flight_signal_count[signum], 1, __ATOMIC_RELAXED);
+    if (prev->sa_flags & SA_SIGINFO)
+    {
+        if (prev->sa_sigaction)
+            prev->sa_sigaction(signum, info, context);
+    }
+    else if (prev->sa_handler != SIG_DFL && prev->sa_handler != SIG_IGN)
+    {
+        prev->sa_handler(signum);
+    }
+}
+
+/**
+ * @brief 释放本实例对信号处理函数的引用，最后一个实例恢复安装前的信号动作。
+ *
+ * 其他代码在之后改装了该信号时保留其处理函数。
+ *
+ * @param ingest 接收实例。
+ */
+static void udpjson_flight_uninstall_signal(UdpJsonIngest *ingest)
+{
+    gint signum = ingest->flight_signal_installed; /* 已安装的信号 */
+    struct sigaction cur; /* 当前信号动作 */
+
+    if (signum <= 0)
+        return;
+    ingest->flight_signal_installed = 0;
+
+    g_mutex_lock(&udpjson_flight_signal_lock);
+    if (--udpjson_flight_signal_refs[signum] == 0 && sigaction(signum, NULL, &cur) == 0 &&
+        (cur.sa_flags & SA_SIGINFO) && cur.sa_sigaction == udpjson_flight_signal_handler)
+        sigaction(signum, &udpjson_flight_signal_prev[signum], NULL);
+    g_mutex_unlock(&udpjson_flight_signal_lock);
+}
+
+/**
+ * @brief 安装 flight-recorder-signal 的处理函数（同一信号由进程内各实例共用、按引用计数）。
+ *
+ * @param ingest 接收实例。
+ */
+static void udpjson_flight_install_signal(UdpJsonIngest *ingest)
+{
+    gint signum = ingest->flight_recorder_signal; /* 请求的信号 */
+    struct sigaction sa; /* 信号动作 */
+
+    if (ingest->flight_signal_installed == signum)
+        return;
+    udpjson_flight_uninstall_signal(ingest);
+    if (signum <= 0 || signum > UDPJSON_FLIGHT_MAX_SIGNAL)
+        return;
+
+    g_mutex_lock(&udpjson_flight_signal_lock);
+    if (udpjson_flight_signal_refs[signum] == 0)
+    {
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_sigaction = udpjson_flight_signal_handler;
+        sa.sa_flags = SA_RESTART | SA_SIGINFO;
+        sigemptyset(&sa.sa_mask);
+        if (sigaction(signum, &sa, &udpjson_flight_signal_prev[signum]) < 0)
+        {
+            g_mutex_unlock(&udpjson_flight_signal_lock);
+            GST_WARNING_OBJECT(ingest->owner, "Failed to install flight recorder signal %d: %s",
+                               signum, strerror(errno));
+            return;
+        }
+    }
+    udpjson_flight_signal_refs[signum]++;
+    g_mutex_unlock(&udpjson_flight_signal_lock);
+    ingest->flight_signal_installed = signum;
+}
+
+gboolean udpjson_ingest_dump_flight_recorder(UdpJsonIngest *ingest, const gchar *path,
+                                             const gchar *reason)
+{
+    gchar *auto_path = NULL; /* 自动命名的路径 */
+    gint n = -1; /* 写入的事件数 */
+
+    g_mutex_lock(&ingest->flight_lock);
+    if (ingest->flight_recorder)
+    {
+        if (!path)
+        {
+            gint64 now_us = g_get_real_time(); /* 系统时间 */
+            time_t secs = (time_t)(now_us / G_USEC_PER_SEC);
+            struct tm tm_now;
+            gchar stamp[32]; /* 时间戳 */
+            gchar *name = NULL;
+
+            localtime_r(&secs, &tm_now);
+            strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm_now);
+            name = g_strdup_printf("udpjsonmeta-%s-%s.%03d-%s.ujfr", udpjson_ingest_name(ingest),
+                                   stamp, (gint)(now_us % G_USEC_PER_SEC / 1000), reason);
+            auto_path = g_build_filename(ingest->flight_recorder_dir ? ingest->flight_recorder_dir
+                                                                     : g_get_tmp_dir(),
+                                         name, NULL);
+            g_free(name);
+            path = auto_path;
+        }
+        n = udpjson_flight_recorder_dump(ingest->flight_recorder, path, reason);
+    }
+    g_mutex_unlock(&ingest->flight_lock);
+
+    if (n >= 0)
+        GST_WARNING_OBJECT(ingest->owner, "flight recorder (%s): %d events dumped to %s", reason,
+                           n, path);
+    if (n >= 0 && ingest->owner)
+    {
+        gst_element_post_message(
+            ingest->owner,
+            gst_message_new_element(GST_OBJECT(ingest->owner),
+                                    gst_structure_new("udpjsonmeta-flight-dump",
+                                                      "path", G_TYPE_STRING, path,
+                                                      "reason", G_TYPE_STRING, reason,
+                                                      "events", G_TYPE_INT, n, NULL)));
+    }
+    g_free(auto_path);
+    return n >= 0;
+}
+
+/**
+ * @brief 转储线程入口：等待接收线程的转储请求并在本线程写文件，退出前处理未完成的请求。
+ *
+ * @param data 接收实例。
+ * @return NULL。
+ */
+static gpointer udpjson_flight_dump_thread(gpointer data)
+{
+    UdpJsonIngest *ingest = (UdpJsonIngest *)data; /* 接收实例 */
+    const gchar *reason = NULL; /* 转储原因 */
+
+    g_mutex_lock(&ingest->flight_dump_lock);
+    for (;;)
+    {
+        while (!ingest->flight_dump_reason && !ingest->flight_dump_stop)
+            g_cond_wait(&ingest->flight_dump_cond, &ingest->flight_dump_lock);
+        reason = ingest->flight_dump_reason;
+        ingest->flight_dump_reason = NULL;
+        if (!reason)
+            break;
+        g_mutex_unlock(&ingest->flight_dump_lock);
+        udpjson_ingest_dump_flight_recorder(ingest, NULL, reason);
+        g_mutex_lock(&ingest->flight_dump_lock);
+    }
+    g_mutex_unlock(&ingest->flight_dump_lock);
+    return NULL;
+}
+
+/**
+ * @brief 请求转储线程转储（接收线程调用，不等待文件写入）。
+ *
+ * 上一次请求尚未开始时合并为一次，保留先到的原因。
+ *
+ * @param ingest 接收实例。
+ * @param reason 转储原因（静态字符串）。
+ */
+static void udpjson_flight_request_dump(UdpJsonIngest *ingest, const gchar *reason)
+{
+    if (!ingest->flight_dump_thread)
+        return;
+    g_mutex_lock(&ingest->flight_dump_lock);
+    if (!ingest->flight_dump_reason)
+        ingest->flight_dump_reason = reason;
+    g_cond_signal(&ingest->flight_dump_cond);
+    g_mutex_unlock(&ingest->flight_dump_lock);
+}
+
+/**
+ * @brief 结束转储线程（接收线程结束后调用）。
+ *
+ * @param ingest 接收实例。
+ */
+static void udpjson_flight_stop_dump_thread(UdpJsonIngest *ingest)
+{
+    if (!ingest->flight_dump_thread)
+        return;
+    g_mutex_lock(&ingest->flight_dump_lock);
+    ingest->flight_dump_stop = TRUE;
+    g_cond_signal(&ingest->flight_dump_cond);
+    g_mutex_unlock(&ingest->flight_dump_lock);
+    g_thread_join(ingest->flight_dump_thread);
+    ingest->flight_dump_thread = NULL;
+}
+
+/**
+ * @brief 自动转储，两次之间至少间隔 UDPJSON_FLIGHT_AUTO_DUMP_INTERVAL_US（接收线程调用）。
+ *
+ * @param ingest 接收实例。
+ * @param reason 转储原因。
+ * @param now_us 当前时间(单调时钟，微秒)。
+ */
+static void udpjson_flight_auto_dump(UdpJsonIngest *ingest, const gchar *reason, gint64 now_us)
+{
+    if (ingest->flight_auto_dump_us != 0 &&
+        now_us - ingest->flight_auto_dump_us < UDPJSON_FLIGHT_AUTO_DUMP_INTERVAL_US)
+        return;
+    ingest->flight_auto_dump_us = now_us;
+    udpjson_flight_request_dump(ingest, reason);
+}
+
+/**
+ * @brief 检查信号、缓存清空与失败比例，需要时转储（接收线程每轮调用）。
+ *
+ * @param ingest 接收实例。
+ */
+static void udpjson_flight_check(UdpJsonIngest *ingest)
+{
+    gint signals = 0; /* 累计收到的信号次数 */
+    gint64 now_us = 0; /* 当前时间 */
+    guint64 sums[UDPJSON_STAT_COUNT]; /* 计数器合计 */
+    guint64 packets = 0; /* 累计报文数 */
+    guint64 failures = 0; /* 累计失败数 */
+    guint64 d_packets = 0; /* 窗口内报文数 */
+    guint64 d_failures = 0; /* 窗口内失败数 */
+
+    if (!ingest->flight_recorder)
+        return;
+
+    signals = g_atomic_int_get(&udpjson_flight_signal_count[ingest->flight_signal_installed]);
+    if (ingest->flight_signal_installed > 0 && signals != ingest->flight_signal_seen)
+    {
+        ingest->flight_signal_seen = signals;
+        udpjson_flight_request_dump(ingest, "signal");
+    }
+
+    now_us = g_get_monotonic_time();
+    if (ingest->flight_flush_pending)
+    {
+        ingest->flight_flush_pending = FALSE;
+        udpjson_flight_auto_dump(ingest, "cache-flush", now_us);
+    }
+
+    if (ingest->flight_recorder_fail_ratio <= 0 || now_us - ingest->flight_window_us < G_USEC_PER_SEC)
+        return;
+
+    udpjson_stats_sum(ingest->stats, sums);
+    packets = sums[UDPJSON_STAT_JSON_PACKETS] + sums[UDPJSON_STAT_CUAV_PACKETS] +
+              sums[UDPJSON_STAT_CUAV_CTRL_PACKETS] + sums[UDPJSON_STAT_RECV_ERRORS];
+    failures = sums[UDPJSON_STAT_PARSE_FAILURES] + sums[UDPJSON_STAT_PARSE_MISSING] +
+               sums[UDPJSON_STAT_CUAV_FAILURES] + sums[UDPJSON_STAT_RECV_ERRORS];
+    d_packets = packets - ingest->flight_window_packets;
+    d_failures = failures - ingest->flight_window_failures;
+    ingest->flight_window_us = now_us;
+    ingest->flight_window_packets = packets;
+    ingest->flight_window_failures = failures;
+
+    if (d_packets >= UDPJSON_FLIGHT_MIN_PACKETS &&
+        (gdouble)d_failures > ingest->flight_recorder_fail_ratio * (gdouble)d_packets)
+        udpjson_flight_auto_dump(ingest, "fail-ratio", now_us);
+}
+
+/**
+ * @brief 开始记录一次收包（接收线程调用），之后的解析与缓存步骤填写同一事件。
+ *
+ * @param ingest 接收实例。
+ * @param socket 来源套接字。
+ * @param len recvfrom 返回值。
+ * @param err recvfrom 失败时的 errno。
+ * @param src 发送方地址。
+ * @param recv_ns 接收时间(udpjson_now_ns)。
+ */
+static inline void udpjson_flight_begin(UdpJsonIngest *ingest, UdpJsonFlightSocket socket,
+                                        ssize_t len, gint err, const struct sockaddr_in *src,
+                                        guint64 recv_ns)
+{
+    UdpJsonFlightEvent *ev = NULL; /* 事件槽 */
+
+    if (!ingest->flight_recorder)
+        return;
+
+    ev = udpjson_flight_recorder_begin(ingest->flight_recorder);
+    ev->ts_ns = recv_ns;
+    ev->socket = (guint8)socket;
+    if (len < 0)
+    {
+        ev->result = UDPJSON_FR_RESULT_RECV_ERROR;
+        ev->size = (guint32)err;
+    }
+    else
+    {
+        ev->size = (guint32)len;
+        ev->sender_ip = src->sin_addr.s_addr;
+        ev->sender_port = ntohs(src->sin_port);
+    }
+    ingest->flight_event = ev;
+}
+
+/**
+ * @brief 发布 udpjson_flight_begin 开始的事件（接收线程调用）。
+ *
+ * @param ingest 接收实例。
+ */
+static inline void udpjson_flight_end(UdpJsonIngest *ingest)
+{
+    if (!ingest->flight_event)
+        return;
+    udpjson_flight_recorder_commit(ingest->flight_recorder);
+    ingest->flight_event = NULL;
+}
+
+/**
+ * @brief 把收到的报文写入接收日志（接收线程调用）。
+ *
+ * @param ingest 接收实例。
+ * @param socket 来源套接字。
+ * @param data 报文数据。
+ * @param len 报文长度。
+ * @param src 发送方地址。
+ * @param recv_ns 接收时间(udpjson_now_ns)。
+ */
+static inline void udpjson_journal_record(UdpJsonIngest *ingest, UdpJsonFlightSocket socket,
+                                          const gchar *data, ssize_t len,
+                                          const struct sockaddr_in *src, guint64 recv_ns)
+{
+    gboolean ok = FALSE; /* 是否写入环形缓冲 */
+
+    if (!ingest->journal)
+        return;
+    ok = udpjson_journal_append(ingest->journal, socket, recv_ns, src->sin_addr.s_addr,
+                                ntohs(src->sin_port), data, (gsize)len);
+    udpjson_stats_add(ingest->stats, UDPJSON_STATS_SHARD_RECV,
+                      ok ? UDPJSON_STAT_JOURNAL_RECORDS : UDPJSON_STAT_JOURNAL_DROPPED, 1);
+}
+
+/* 各套接字的收包数与字节数计数器，按 UdpJsonFlightSocket 索引 */
+static const UdpJsonStat udpjson_socket_packets_stat[] = {
+    UDPJSON_STAT_JSON_PACKETS, UDPJSON_STAT_CUAV_PACKETS, UDPJSON_STAT_CUAV_CTRL_PACKETS};
+static const UdpJsonStat udpjson_socket_bytes_stat[] = {
+    UDPJSON_STAT_JSON_BYTES, UDPJSON_STAT_CUAV_BYTES, UDPJSON_STAT_CUAV_CTRL_BYTES};
+
+/**
+ * @brief 从一个套接字接收并处理一个报文（接收线程调用）。
+ *
+ * @param ingest 接收实例。
+ * @param socket 来源套接字。
+ * @param fd 套接字描述符（非阻塞）。
+ * @param default_source_id 目标 JSON 未给出 source_id 时使用的源ID。
+ * @param path 目标 JSON 套接字的路径编号（去重统计用），其他套接字为 0。
+ * @param buf 接收缓冲区。
+ * @param size 缓冲区大小，末尾留一字节补 '\0'。
+ * @return recvfrom 的返回值，没有待收报文时为 -1 且不计为错误。
+ */
+static ssize_t udpjson_recv_datagram(UdpJsonIngest *ingest, UdpJsonFlightSocket socket, gint fd,
+                                     guint default_source_id, guint path, gchar *buf,
+                                     gsize size)
+{
+    struct sockaddr_in src; /* 发送方地址 */
+    socklen_t src_len = sizeof(src);
+    ssize_t len = recvfrom(fd, buf, size - 1, 0, (struct sockaddr *)&src, &src_len);
+    gint err = errno; /* recvfrom 失败原因 */
+    guint64 recv_ns = 0; /* 接收时间 */
+
+    if (len < 0 && (err == EAGAIN || err == EWOULDBLOCK))
+        return len;
+
+    recv_ns = udpjson_now_ns();
+    udpjson_flight_begin(ingest, socket, len, err, &src, recv_ns);
+    if (len > 0)
+    {
+        buf[len] = '\0';
+        UDPJSON_PROBE2(recv, socket, len);
+        udpjson_stats_add(ingest->stats, UDPJSON_STATS_SHARD_RECV,
+                          udpjson_socket_packets_stat[socket], 1);
+        udpjson_stats_add(ingest->stats, UDPJSON_STATS_SHARD_RECV,
+                          udpjson_socket_bytes_stat[socket], len);
+        if (socket == UDPJSON_FR_SOCKET_JSON && ingest->dedup &&
+            !udpjson_dedup_check(ingest->dedup, path, buf, (gsize)len, recv_ns))
+        {
+            /* 其他路径已送达的副本：不记日志、不解析 */
+            udpjson_stats_add(ingest->stats, UDPJSON_STATS_SHARD_RECV,
+                              UDPJSON_STAT_DEDUP_DUPLICATES, 1);
+            if (ingest->flight_event)
+                ingest->flight_event->result = UDPJSON_FR_RESULT_DUPLICATE;
+            udpjson_flight_end(ingest);
+            return len;
+        }
+        udpjson_journal_record(ingest, socket, buf, len, &src, recv_ns);
+        if (socket == UDPJSON_FR_SOCKET_JSON)
+        {
+            /* 只解析 JSON 元数据，不进行 C-UAV 解析（因为 C-UAV 有独立端口） */
+            udpjson_ingest_parse_and_cache(ingest, buf, len, recv_ns, default_source_id);
+        }
+        else if (ingest->enable_cuav_parser && ingest->cuav_parser)
+        {
+            udpjson_ingest_parse_cuav(ingest, buf, len);
+        }
+    }
+    else if (len < 0)
+    {
+        udpjson_stats_add(ingest->stats, UDPJSON_STATS_SHARD_RECV, UDPJSON_STAT_RECV_ERRORS, 1);
+    }
+    udpjson_flight_end(ingest);
+    return len;
+}
+
+/**
+ * @brief 填写数据套接字的 poll 结构：先是目标 JSON 套接字（单个时固定在 0 号，
+ *        -1 时 poll 忽略），然后是 C-UAV 与 C-UAV 控制套接字。
+ *
+ * @param ingest 接收实例。
+ * @param pfds poll 结构数组，至少 UDPJSON_MAX_ENDPOINTS + 2 项。
+ * @param json_sources 输出各目标 JSON 套接字的默认源ID，至少 UDPJSON_MAX_ENDPOINTS 项。
+ * @param num_json 输出目标 JSON 套接字数。
+ * @param idx_cuav 输出 C-UAV socket 的下标，-1 表示无。
+ * @param idx_ctrl 输出 C-UAV 控制 socket 的下标，-1 表示无。
+ * @return 填写的项数。
+ */
+static guint udpjson_fill_data_pollfds(UdpJsonIngest *ingest, struct pollfd *pfds,
+                                       guint *json_sources, guint *num_json, int *idx_cuav,
+                                       int *idx_ctrl)
+{
+    guint num_fds = 0; /* 监听的 socket 数量 */
+
+    memset(pfds, 0, sizeof(struct pollfd) * (UDPJSON_MAX_ENDPOINTS + 2));
+    /* 使用共享接收器时没有目标 JSON 套接字 */
+    for (guint i = 0; ingest->endpoint_socks && i < ingest->endpoint_socks->len; i++)
+    {
+        const UdpJsonEndpoint *ep = &g_array_index(ingest->endpoint_socks, UdpJsonEndpoint, i);
+        pfds[num_fds].fd = ep->fd;
+        pfds[num_fds].events = POLLIN;
+        json_sources[num_fds++] = ep->source_id;
+    }
+    *num_json = num_fds;
+    *idx_cuav = -1;
+    *idx_ctrl = -1;
+
+    /* 如果启用了 C-UAV 解析，监听 C-UAV socket */
+    if (ingest->enable_cuav_parser && ingest->cuav_sockfd >= 0)
+    {
+        *idx_cuav = (int)num_fds;
+        pfds[num_fds].fd = ingest->cuav_sockfd;
+        pfds[num_fds].events = POLLIN;
+        num_fds++;
+    }
+    if (ingest->enable_cuav_parser && ingest->cuav_ctrl_sockfd >= 0)
+    {
+        *idx_ctrl = (int)num_fds;
+        pfds[num_fds].fd = ingest->cuav_ctrl_sockfd;
+        pfds[num_fds].events = POLLIN;
+        num_fds++;
+    }
+    return num_fds;
+}
+
+static void udpjson_reconfigure_sockets(UdpJsonIngest *ingest, gchar *buf, gsize size);
+
+/**
+ * @brief UDP 接收线程入口。
+ *
+ * @param data 接收实例。
+ * @return 线程返回值。
+ */
+static gpointer udpjson_recv_thread(gpointer data)
+{
+    UdpJsonIngest *ingest = (UdpJsonIngest *)data; /* 接收实例 */
+    /* poll 结构数组：目标 JSON、C-UAV、C-UAV 控制，末尾为指标服务 */
+    struct pollfd pfds[UDPJSON_MAX_ENDPOINTS + 2 + 1 + UDPJSON_METRICS_MAX_CLIENTS];
+    guint json_sources[UDPJSON_MAX_ENDPOINTS]; /* 各目标 JSON 套接字的默认源ID */
+    guint num_json = 0; /* 目标 JSON 套接字数 */
+    guint num_fds = 0; /* 监听的 socket 数量 */
+    int idx_cuav = -1;
+    int idx_ctrl = -1;
+    gchar buf[8192]; /* 接收缓冲区 */
+
+    if (!ingest)
+        return NULL;
+
+    num_fds = udpjson_fill_data_pollfds(ingest, pfds, json_sources, &num_json, &idx_cuav,
+                                            &idx_ctrl);
+
+    while (!g_atomic_int_get(&ingest->stop_flag))
+    {
+        /* 运行中修改了组播地址、端口或网卡：换用新套接字后重新填写 */
+        if (g_atomic_int_compare_and_exchange(&ingest->reconfigure, 1, 0))
+        {
+            udpjson_reconfigure_sockets(ingest, buf, sizeof(buf));
+            num_fds = udpjson_fill_data_pollfds(ingest, pfds, json_sources, &num_json,
+                                                &idx_cuav, &idx_ctrl);
+        }
+
+        /* 指标服务的 socket 接在数据 socket 之后，连接增减时每轮重新填写 */
+        guint num_metrics_fds = udpjson_metrics_server_fill_pollfds(
+            ingest->metrics_server, pfds + num_fds, G_N_ELEMENTS(pfds) - num_fds);
+        int ret = poll(pfds, num_fds + num_metrics_fds, 100); /* 100ms 轮询 */
+
+        udpjson_metrics_server_dispatch(ingest->metrics_server, pfds + num_fds,
+                                        ret > 0 ? num_metrics_fds : 0, ingest->stats);
+        udpjson_post_stats(ingest);
+        udpjson_flight_check(ingest);
+        if (ret <= 0)
+            continue;
+
+        /* 检查目标 JSON socket 是否有数据 */
+        for (guint i = 0; i < num_json; i++)
+        {
+            if (pfds[i].revents & POLLIN)
+                udpjson_recv_datagram(ingest, UDPJSON_FR_SOCKET_JSON, pfds[i].fd, json_sources[i],
+                                      i, buf, sizeof(buf));
+        }
+
+        /* 检查 C-UAV socket 是否有数据 */
+        if (idx_cuav >= 0 && (pfds[idx_cuav].revents & POLLIN))
+            udpjson_recv_datagram(ingest, UDPJSON_FR_SOCKET_CUAV, ingest->cuav_sockfd, 0, 0,
+                                  buf, sizeof(buf));
+        if (idx_ctrl >= 0 && (pfds[idx_ctrl].revents & POLLIN))
+            udpjson_recv_datagram(ingest, UDPJSON_FR_SOCKET_CUAV_CTRL, ingest->cuav_ctrl_sockfd,
+                                  0, 0, buf, sizeof(buf));
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 打开目标 JSON 的 UDP 套接字并加入组播。
+ *
+ * @param ingest 接收实例（取 recv_buf_size）。
+ * @param multicast_ip 组播地址。
+ * @param port 端口。
+ * @param iface 网卡名，NULL 或空表示不限。
+ * @return 非阻塞套接字，失败返回 -1。
+ */
+static gint udpjson_open_json_socket(UdpJsonIngest *ingest, const gchar *multicast_ip,
+                                     guint port, const gchar *iface)
+{
+    gint fd = -1; /* UDP 套接字 */
+    struct sockaddr_in addr; /* 绑定地址 */
+    struct ip_mreq mreq; /* 组播请求 */
+    int reuse = 1; /* 复用标记 */
+    int flags = 0; /* socket 标志 */
+
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0)
+    {
+        GST_ERROR("Failed to create UDP socket: %s", strerror(errno));
+        return -1;
+    }
+
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0)
+    {
+        GST_WARNING("Failed to set SO_REUSEADDR: %s", strerror(errno));
+    }
+
+    if (ingest->recv_buf_size > 0)
+    {
+        int rcvbuf = (int)ingest->recv_buf_size; /* 接收缓冲区 */
+        if (setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf)) < 0)
+        {
+            GST_WARNING("Failed to set SO_RCVBUF: %s", strerror(errno));
+        }
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((guint16)port);
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        GST_ERROR("Failed to bind UDP socket: %s", strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+#ifdef IP_MULTICAST_ALL
+    /* 只接收本套接字加入的组，同一端口上的其他组交给各自的套接字 */
+    {
+        int mc_all = 0; /* 关闭 IP_MULTICAST_ALL */
+        if (setsockopt(fd, IPPROTO_IP, IP_MULTICAST_ALL, &mc_all, sizeof(mc_all)) < 0)
+        {
+            GST_WARNING("Failed to clear IP_MULTICAST_ALL: %s", strerror(errno));
+        }
+    }
+#endif
+
+    memset(&mreq, 0, sizeof(mreq));
+    mreq.imr_multiaddr.s_addr = inet_addr(multicast_ip);
+    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+
+    if (iface && strlen(iface) > 0)
+    {
+        struct ifreq ifr; /* 网卡信息 */
+        memset(&ifr, 0, sizeof(ifr));
+        strncpy(ifr.ifr_name, iface, IFNAMSIZ - 1);
+        if (ioctl(fd, SIOCGIFADDR, &ifr) == 0)
+        {
+            struct sockaddr_in *sin = (struct sockaddr_in *)&ifr.ifr_addr; /* 网卡地址 */
+            mreq.imr_interface = sin->sin_addr;
+        }
+        if (setsockopt(fd, SOL_SOCKET, SO_BINDTODEVICE, iface, strlen(iface)) < 0)
+        {
+            GST_WARNING("Failed to bind device %s: %s", iface, strerror(errno));
+        }
+    }
+
+    if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0)
+    {
+        GST_ERROR("Failed to join multicast group %s:%u: %s", multicast_ip, port,
+                  strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    flags = fcntl(fd, F_GETFL, 0);
+    if (flags >= 0)
+    {
+        if (fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+        {
+            GST_WARNING("Failed to set UDP socket non-blocking: %s", strerror(errno));
+        }
+    }
+
+    return fd;
+}
+
+gboolean udpjson_parse_endpoint(gchar *entry, UdpJsonEndpoint *ep)
+{
+    gchar *eq = strchr(entry, '='); /* 源ID分隔符 */
+    gchar *at = NULL; /* 网卡分隔符 */
+    gchar *colon = NULL; /* 端口分隔符 */
+    gchar *end = NULL; /* 解析结束位置 */
+    guint64 port = 0; /* 端口 */
+    guint64 source_id = 0; /* 源ID */
+
+    if (eq)
+    {
+        *eq = '\0';
+        source_id = g_ascii_strtoull(eq + 1, &end, 0);
+        if (end == eq + 1 || *end != '\0' || source_id > G_MAXUINT)
+            return FALSE;
+    }
+    at = strchr(entry, '@');
+    if (at)
+        *at = '\0';
+    colon = strrchr(entry, ':');
+    if (!colon || colon == entry)
+        return FALSE;
+    *colon = '\0';
+    port = g_ascii_strtoull(colon + 1, &end, 10);
+    if (end == colon + 1 || *end != '\0' || port == 0 || port > 65535)
+        return FALSE;
+
+    ep->multicast_ip = g_strdup(entry);
+    ep->port = (guint)port;
+    ep->iface = at && at[1] ? g_strdup(at + 1) : NULL;
+    ep->source_id = (guint)source_id;
+    ep->fd = -1;
+    return TRUE;
+}
+
+void udpjson_endpoint_clear(gpointer data)
+{
+    UdpJsonEndpoint *ep = (UdpJsonEndpoint *)data; /* 端点 */
+
+    if (ep->fd >= 0)
+        close(ep->fd);
+    g_free(ep->multicast_ip);
+    g_free(ep->iface);
+}
+
+/**
+ * @brief 解析端点列表，不打开套接字。
+ *
+ * 无效条目告警后忽略，最多 UDPJSON_MAX_ENDPOINTS 个。
+ *
+ * @param ingest 接收实例（用于日志）。
+ * @param spec 端点列表（endpoints 属性的格式）。
+ * @return 端点表（fd 均为 -1），没有有效端点时返回 NULL。
+ */
+static GArray *udpjson_parse_endpoints(UdpJsonIngest *ingest, const gchar *spec)
+{
+    gchar **tokens = g_strsplit_set(spec, ",; ", -1); /* 分割后的条目 */
+    GArray *eps = g_array_new(FALSE, TRUE, sizeof(UdpJsonEndpoint)); /* 端点表 */
+
+    g_array_set_clear_func(eps, udpjson_endpoint_clear);
+    for (guint i = 0; tokens[i]; i++)
+    {
+        UdpJsonEndpoint ep; /* 端点 */
+        gchar *entry = NULL; /* 条目副本 */
+
+        if (tokens[i][0] == '\0')
+            continue;
+        entry = g_strdup(tokens[i]);
+        if (!udpjson_parse_endpoint(entry, &ep))
+        {
+            GST_WARNING_OBJECT(ingest->owner, "Ignoring invalid endpoint '%s'", tokens[i]);
+        }
+        else if (eps->len >= UDPJSON_MAX_ENDPOINTS)
+        {
+            GST_WARNING_OBJECT(ingest->owner, "Ignoring endpoint '%s' (max %u)", tokens[i],
+                               UDPJSON_MAX_ENDPOINTS);
+            udpjson_endpoint_clear(&ep);
+        }
+        else
+        {
+            g_array_append_val(eps, ep);
+        }
+        g_free(entry);
+    }
+    g_strfreev(tokens);
+
+    if (eps->len == 0)
+    {
+        GST_ERROR("No valid endpoint in '%s'", spec);
+        g_array_unref(eps);
+        return NULL;
+    }
+    return eps;
+}
+
+/**
+ * @brief 为端点表中尚未打开的端点打开目标 JSON 套接字。
+ *
+ * @param ingest 接收实例。
+ * @param eps 端点表，fd 为 -1 的端点需要打开。
+ * @return 全部打开返回 TRUE；失败时已打开的套接字由端点表释放时关闭。
+ */
+static gboolean udpjson_open_endpoints(UdpJsonIngest *ingest, GArray *eps)
+{
+    for (guint i = 0; i < eps->len; i++)
+    {
+        UdpJsonEndpoint *ep = &g_array_index(eps, UdpJsonEndpoint, i); /* 端点 */
+
+        if (ep->fd >= 0)
+            continue;
+        ep->fd = udpjson_open_json_socket(ingest, ep->multicast_ip, ep->port, ep->iface);
+        if (ep->fd < 0)
+            return FALSE;
+        GST_INFO_OBJECT(ingest->owner, "Endpoint %s:%u (iface %s) default source_id %u",
+                        ep->multicast_ip, ep->port, ep->iface ? ep->iface : "any",
+                        ep->source_id);
+    }
+    return TRUE;
+}
+
+/**
+ * @brief 按当前配置生成目标 JSON 套接字的端点列表：endpoints 非空时直接使用；
+ *        iface 为逗号分隔的多个网卡时，每个网卡一个端点（冗余路径）；否则为
+ *        multicast_ip:port@iface 一个端点。
+ *
+ * @param ingest 接收实例，运行中调用时须持 config_lock。
+ * @return 新分配的端点列表。
+ */
+static gchar *udpjson_json_endpoint_spec(UdpJsonIngest *ingest)
+{
+    GString *spec = NULL; /* 端点列表 */
+    gchar **ifaces = NULL; /* 网卡列表 */
+
+    if (ingest->endpoints && *ingest->endpoints)
+        return g_strdup(ingest->endpoints);
+    if (!ingest->iface || !strchr(ingest->iface, ','))
+        return g_strdup_printf("%s:%u@%s", ingest->multicast_ip ? ingest->multicast_ip : "",
+                               ingest->port, ingest->iface ? ingest->iface : "");
+
+    spec = g_string_new(NULL);
+    ifaces = g_strsplit(ingest->iface, ",", -1);
+    for (guint i = 0; ifaces[i]; i++)
+    {
+        g_strstrip(ifaces[i]);
+        if (ifaces[i][0] != '\0')
+            g_string_append_printf(spec, "%s%s:%u@%s", spec->len ? "," : "",
+                                   ingest->multicast_ip, ingest->port, ifaces[i]);
+    }
+    g_strfreev(ifaces);
+    return g_string_free(spec, FALSE);
+}
+
+/**
+ * @brief 按 udpjson_json_endpoint_spec() 的端点列表打开全部目标 JSON 套接字。
+ *
+ * @param ingest 接收实例。
+ * @return 成功返回 TRUE，端点表存入 ingest->endpoint_socks；任一失败时全部关闭。
+ */
+static gboolean udpjson_setup_socket(UdpJsonIngest *ingest)
+{
+    gchar *spec = NULL; /* 端点列表 */
+    GArray *eps = NULL; /* 端点表 */
+
+    if (!ingest)
+        return FALSE;
+
+    spec = udpjson_json_endpoint_spec(ingest);
+    eps = udpjson_parse_endpoints(ingest, spec);
+    g_free(spec);
+    if (!eps)
+        return FALSE;
+    if (!udpjson_open_endpoints(ingest, eps))
+    {
+        g_array_unref(eps);
+        return FALSE;
+    }
+    ingest->endpoint_socks = eps;
+    return TRUE;
+}
+
+/**
+ * @brief 打开 C-UAV 的 UDP 套接字：绑定端口并加入组播组（加入失败仅告警）。
+ *
+ * @param multicast_ip 组播地址。
+ * @param port 端口。
+ * @param what 日志中的套接字名称。
+ * @return 非阻塞套接字，失败返回 -1。
+ */
+static gint udpjson_open_cuav_socket(const gchar *multicast_ip, guint port, const gchar *what)
+{
+    struct sockaddr_in addr; /* 绑定地址 */
+    struct ip_mreq mreq; /* 组播请求 */
+    int reuse = 1; /* 复用标记 */
+    int flags = 0; /* socket 标志 */
+    gint fd = socket(AF_INET, SOCK_DGRAM, 0); /* UDP 套接字 */
+
+    if (fd < 0)
+    {
+        GST_ERROR("Failed to create %s UDP socket: %s", what, strerror(errno));
+        return -1;
+    }
+
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0)
+    {
+        GST_WARNING("Failed to set SO_REUSEADDR for %s: %s", what, strerror(errno));
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((guint16)port);
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        GST_ERROR("Failed to bind %s UDP socket to port %u: %s", what, port, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    flags = fcntl(fd, F_GETFL, 0);
+    if (flags >= 0)
+    {
+        if (fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+        {
+            GST_WARNING("Failed to set %s UDP socket non-blocking: %s", what, strerror(errno));
+        }
+    }
+
+    memset(&mreq, 0, sizeof(mreq));
+    mreq.imr_multiaddr.s_addr = inet_addr(multicast_ip);
+    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+    if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0)
+    {
+        GST_WARNING("Failed to join %s multicast group %s: %s", what, multicast_ip,
+                    strerror(errno));
+    }
+    else
+    {
+        GST_INFO("Joined %s multicast group %s", what, multicast_ip);
+    }
+
+    GST_INFO("%s socket bound to port %u", what, port);
+    return fd;
+}
+
+/**
+ * @brief 设置 C-UAV 协议的 UDP 套接字。
+ *
+ * 两个套接字都加入 multicast_ip（使用配置的组播地址）；cuav_ctrl_port 为 0
+ * 时不打开控制/引导套接字。
+ *
+ * @param ingest 接收实例。
+ * @return 成功返回 TRUE。
+ */
+static gboolean udpjson_setup_cuav_socket(UdpJsonIngest *ingest)
+{
+    if (!ingest)
+        return FALSE;
+
+    ingest->cuav_sockfd = -1;
+    ingest->cuav_ctrl_sockfd = -1;
+    ingest->cuav_bound_port = 0;
+    ingest->cuav_ctrl_bound_port = 0;
+
+    /* 如果未启用 C-UAV 解析，不创建 socket */
+    if (!ingest->enable_cuav_parser)
+        return TRUE;
+
+    g_free(ingest->cuav_group);
+    ingest->cuav_group = g_strdup(ingest->multicast_ip);
+    ingest->cuav_sockfd = udpjson_open_cuav_socket(ingest->cuav_group,
+                                                   ingest->cuav_multicast_port, "C-UAV");
+    if (ingest->cuav_sockfd < 0)
+        return FALSE;
+    ingest->cuav_bound_port = ingest->cuav_multicast_port;
+
+    /* 初始化控制/引导端口 socket */
+    if (ingest->cuav_ctrl_port == 0)
+        return TRUE;
+    ingest->cuav_ctrl_sockfd = udpjson_open_cuav_socket(ingest->cuav_group,
+                                                        ingest->cuav_ctrl_port, "C-UAV CTRL");
+    if (ingest->cuav_ctrl_sockfd < 0)
+        return FALSE;
+    ingest->cuav_ctrl_bound_port = ingest->cuav_ctrl_port;
+    return TRUE;
+}
+
+/**
+ * @brief 释放 UDP 套接字。
+ *
+ * @param ingest 接收实例。
+ */
+static void udpjson_teardown_socket(UdpJsonIngest *ingest)
+{
+    if (!ingest)
+        return;
+    if (ingest->endpoint_socks)
+    {
+        g_array_unref(ingest->endpoint_socks);
+        ingest->endpoint_socks = NULL;
+    }
+    if (ingest->cuav_sockfd >= 0)
+    {
+        close(ingest->cuav_sockfd);
+        ingest->cuav_sockfd = -1;
+    }
+    if (ingest->cuav_ctrl_sockfd >= 0)
+    {
+        close(ingest->cuav_ctrl_sockfd);
+        ingest->cuav_ctrl_sockfd = -1;
+    }
+    g_free(ingest->cuav_group);
+    ingest->cuav_group = NULL;
+    ingest->cuav_bound_port = 0;
+    ingest->cuav_ctrl_bound_port = 0;
+}
+
+/**
+ * @brief 收完套接字中已排队的报文（接收线程调用）。
+ *
+ * @param ingest 接收实例。
+ * @param socket 套接字类别。
+ * @param fd 套接字。
+ * @param source_id 默认源ID。
+ * @param path 去重路径号。
+ * @param buf 接收缓冲区。
+ * @param size 缓冲区大小。
+ */
+static void udpjson_drain_socket(UdpJsonIngest *ingest, UdpJsonFlightSocket socket, gint fd,
+                                 guint source_id, guint path, gchar *buf, gsize size)
+{
+    while (udpjson_recv_datagram(ingest, socket, fd, source_id, path, buf, size) >= 0)
+    {
+    }
+}
+
+/**
+ * @brief 按新端点列表重建目标 JSON 套接字：组播地址、端口与网卡都相同的端点
+ *        沿用旧套接字，其余端点打开新套接字。
+ *
+ * @param ingest 接收实例。
+ * @param spec 新端点列表。
+ * @return 新端点表（fd 已全部有效），失败返回 NULL 且旧端点表不变。
+ */
+static GArray *udpjson_reopen_endpoints(UdpJsonIngest *ingest, const gchar *spec)
+{
+    GArray *old_eps = ingest->endpoint_socks; /* 旧端点表 */
+    GArray *eps = udpjson_parse_endpoints(ingest, spec); /* 新端点表 */
+    gint reuse[UDPJSON_MAX_ENDPOINTS]; /* 新端点沿用的旧端点下标，-1 表示新开 */
+    gboolean taken[UDPJSON_MAX_ENDPOINTS] = {FALSE}; /* 旧端点是否已被沿用 */
+
+    if (!eps)
+        return NULL;
+    for (guint i = 0; i < eps->len; i++)
+    {
+        const UdpJsonEndpoint *ep = &g_array_index(eps, UdpJsonEndpoint, i); /* 新端点 */
+
+        reuse[i] = -1;
+        for (guint j = 0; old_eps && j < old_eps->len && reuse[i] < 0; j++)
+        {
+            const UdpJsonEndpoint *old = &g_array_index(old_eps, UdpJsonEndpoint, j); /* 旧端点 */
+            if (!taken[j] && old->port == ep->port &&
+                g_strcmp0(old->multicast_ip, ep->multicast_ip) == 0 &&
+                g_strcmp0(old->iface, ep->iface) == 0)
+            {
+                taken[j] = TRUE;
+                reuse[i] = (gint)j;
+            }
+        }
+    }
+
+    /* 从旧端点表取走沿用的套接字，新套接字打开失败时还回 */
+    for (guint i = 0; i < eps->len; i++)
+    {
+        UdpJsonEndpoint *ep = &g_array_index(eps, UdpJsonEndpoint, i); /* 新端点 */
+        UdpJsonEndpoint *old = NULL; /* 沿用的旧端点 */
+
+        if (reuse[i] < 0)
+            continue;
+        old = &g_array_index(old_eps, UdpJsonEndpoint, reuse[i]);
+        ep->fd = old->fd;
+        old->fd = -1;
+    }
+    if (!udpjson_open_endpoints(ingest, eps))
+    {
+        for (guint i = 0; i < eps->len; i++)
+        {
+            UdpJsonEndpoint *ep = &g_array_index(eps, UdpJsonEndpoint, i); /* 新端点 */
+
+            if (reuse[i] < 0)
+                continue;
+            g_array_index(old_eps, UdpJsonEndpoint, reuse[i]).fd = ep->fd;
+            ep->fd = -1;
+        }
+        g_array_unref(eps);
+        return NULL;
+    }
+    for (guint i = 0; i < eps->len && ingest->recv_buf_size > 0; i++)
+    {
+        int rcvbuf = (int)ingest->recv_buf_size; /* 接收缓冲区 */
+
+        if (reuse[i] >= 0 && setsockopt(g_array_index(eps, UdpJsonEndpoint, i).fd, SOL_SOCKET,
+                                        SO_RCVBUF, &rcvbuf, sizeof(rcvbuf)) < 0)
+            GST_WARNING("Failed to set SO_RCVBUF: %s", strerror(errno));
+    }
+    return eps;
+}
+
+/**
+ * @brief 按当前配置重建组播地址、端口或网卡变化了的套接字，收完旧套接字中已
+ *        排队的报文后关闭旧套接字（接收线程调用）。
+ *
+ * 未变化的套接字继续使用，recv_buf_size 直接应用到沿用的目标 JSON 套接字上。
+ * 需要的新套接字全部打开成功才切换，失败时保留旧套接字继续接收。切换前后缓存
+ * 不变；新旧套接字同时加入同一组播组的短暂窗口内可能重复收到报文，缓存写入是
+ * 幂等的。
+ *
+ * @param ingest 接收实例。
+ * @param buf 接收缓冲区。
+ * @param size 缓冲区大小。
+ */
+static void udpjson_reconfigure_sockets(UdpJsonIngest *ingest, gchar *buf, gsize size)
+{
+    gint *cuav_fds[2] = {&ingest->cuav_sockfd, &ingest->cuav_ctrl_sockfd}; /* C-UAV 套接字 */
+    guint *bound_ports[2] = {&ingest->cuav_bound_port, &ingest->cuav_ctrl_bound_port}; /* 已绑定端口 */
+    static const gchar *const names[2] = {"C-UAV", "C-UAV CTRL"}; /* 日志名称 */
+    guint ports[2] = {0, 0}; /* 新配置的 C-UAV 端口，0 表示不打开 */
+    gint new_fds[2] = {-1, -1}; /* 新打开的 C-UAV 套接字 */
+    gboolean changed[2] = {FALSE, FALSE}; /* C-UAV 套接字是否需要重建 */
+    GArray *old_eps = ingest->endpoint_socks; /* 旧端点表 */
+    GArray *eps = old_eps; /* 新端点表 */
+    gchar *spec = NULL; /* 新端点列表，NULL 表示不变 */
+    gchar *group = NULL; /* 新组播地址 */
+    gboolean ok = TRUE; /* 需要的新套接字是否全部打开 */
+
+    g_mutex_lock(&ingest->config_lock);
+    /* 共享接收器的目标 JSON 套接字在下次启动时才按新配置切换 */
+    if (!ingest->shared_json)
+        spec = udpjson_json_endpoint_spec(ingest);
+    group = g_strdup(ingest->multicast_ip);
+    if (ingest->enable_cuav_parser)
+    {
+        ports[0] = ingest->cuav_multicast_port;
+        ports[1] = ports[0] ? ingest->cuav_ctrl_port : 0;
+    }
+
+    if (spec)
+    {
+        eps = udpjson_reopen_endpoints(ingest, spec);
+        ok = eps != NULL;
+    }
+    for (guint k = 0; k < G_N_ELEMENTS(ports) && ok; k++)
+    {
+        changed[k] = ports[k] != *bound_ports[k] ||
+                     (ports[k] && g_strcmp0(group, ingest->cuav_group) != 0);
+        if (changed[k] && ports[k])
+        {
+            new_fds[k] = udpjson_open_cuav_socket(group, ports[k], names[k]);
+            ok = new_fds[k] >= 0;
+        }
+    }
+    g_mutex_unlock(&ingest->config_lock);
+
+    if (!ok)
+    {
+        GST_WARNING_OBJECT(ingest->owner, "reconfiguration failed, keeping previous sockets");
+        if (eps && eps != old_eps)
+            g_array_unref(eps);
+        for (guint k = 0; k < G_N_ELEMENTS(new_fds); k++)
+        {
+            if (new_fds[k] >= 0)
+                close(new_fds[k]);
+        }
+        g_free(spec);
+        g_free(group);
+        return;
+    }
+
+    GST_INFO_OBJECT(ingest->owner, "switching to %s, C-UAV ports %u/%u",
+                    spec ? spec : "shared receiver", ports[0], ports[1]);
+    ingest->endpoint_socks = eps;
+    for (guint i = 0; eps != old_eps && old_eps && i < old_eps->len; i++)
+    {
+        const UdpJsonEndpoint *ep = &g_array_index(old_eps, UdpJsonEndpoint, i); /* 旧端点 */
+        if (ep->fd >= 0)
+            udpjson_drain_socket(ingest, UDPJSON_FR_SOCKET_JSON, ep->fd, ep->source_id, i,
+                                 buf, size);
+    }
+    if (old_eps && eps != old_eps)
+        g_array_unref(old_eps);
+
+    for (guint k = 0; k < G_N_ELEMENTS(cuav_fds); k++)
+    {
+        gint old_fd = *cuav_fds[k]; /* 旧套接字 */
+
+        if (!changed[k])
+            continue;
+        *cuav_fds[k] = new_fds[k];
+        *bound_ports[k] = ports[k];
+        if (old_fd >= 0)
+        {
+            udpjson_drain_socket(ingest, (UdpJsonFlightSocket)(UDPJSON_FR_SOCKET_CUAV + k),
+                                 old_fd, 0, 0, buf, size);
+            close(old_fd);
+        }
+    }
+    g_free(ingest->cuav_group);
+    ingest->cuav_group = group;
+    g_free(spec);
+}
+
+/**
+ * @brief 按 flight-recorder-size 创建或重建飞行记录器，重置自动转储状态，安装信号处理
+ * 函数并启动转储线程。
+ *
+ * 停止后保留记录器与信号处理函数，便于事后转储；信号处理函数在释放实例时恢复。
+ *
+ * @param ingest 接收实例。
+ */
+static void udpjson_flight_setup(UdpJsonIngest *ingest)
+{
+    guint64 sums[UDPJSON_STAT_COUNT]; /* 计数器合计 */
+    guint size = ingest->flight_recorder_size; /* 请求的容量 */
+    UdpJsonFlightRecorder *fr = ingest->flight_recorder; /* 现有记录器 */
+
+    g_mutex_lock(&ingest->flight_lock);
+    if (size == 0 || (fr && (fr->capacity < size || fr->capacity / 2 >= MAX(size, 16u))))
+    {
+        udpjson_flight_recorder_free(fr);
+        ingest->flight_recorder = NULL;
+    }
+    if (size > 0 && !ingest->flight_recorder)
+        ingest->flight_recorder = udpjson_flight_recorder_new(size);
+    g_mutex_unlock(&ingest->flight_lock);
+
+    ingest->flight_event = NULL;
+    ingest->flight_flush_pending = FALSE;
+    if (ingest->flight_recorder)
+        udpjson_flight_install_signal(ingest);
+    else
+        udpjson_flight_uninstall_signal(ingest);
+    ingest->flight_signal_seen =
+        g_atomic_int_get(&udpjson_flight_signal_count[ingest->flight_signal_installed]);
+    ingest->flight_auto_dump_us = 0;
+    ingest->flight_window_us = g_get_monotonic_time();
+    udpjson_stats_sum(ingest->stats, sums);
+    ingest->flight_window_packets = sums[UDPJSON_STAT_JSON_PACKETS] +
+                                  sums[UDPJSON_STAT_CUAV_PACKETS] +
+                                  sums[UDPJSON_STAT_CUAV_CTRL_PACKETS] +
+                                  sums[UDPJSON_STAT_RECV_ERRORS];
+    ingest->flight_window_failures = sums[UDPJSON_STAT_PARSE_FAILURES] +
+                                   sums[UDPJSON_STAT_PARSE_MISSING] +
+                                   sums[UDPJSON_STAT_CUAV_FAILURES] +
+                                   sums[UDPJSON_STAT_RECV_ERRORS];
+
+    /* 转储在单独的线程中写文件，避免阻塞收包 */
+    if (ingest->flight_recorder)
+    {
+        ingest->flight_dump_reason = NULL;
+        ingest->flight_dump_stop = FALSE;
+        ingest->flight_dump_thread = g_thread_new("udpjson-flightrec", udpjson_flight_dump_thread,
+                                                  ingest);
+    }
+}
+
+UdpJsonIngest *udpjson_ingest_new(GstElement *owner)
+{
+    UdpJsonIngest *ingest = (UdpJsonIngest *)g_malloc0(sizeof(UdpJsonIngest));
+
+    ingest->owner = owner;
+    ingest->json_ingest = ingest;
+    ingest->cuav_sockfd = -1;
+    ingest->cuav_ctrl_sockfd = -1;
+    g_rw_lock_init(&ingest->cache_lock);
+    ingest->cache = g_hash_table_new_full(udpjson_cache_key_hash, udpjson_cache_key_equal,
+                                          udpjson_cache_key_free, udpjson_cache_value_free);
+    ingest->stats = udpjson_stats_new();
+    g_mutex_init(&ingest->flight_lock);
+    g_mutex_init(&ingest->flight_dump_lock);
+    g_cond_init(&ingest->flight_dump_cond);
+    g_mutex_init(&ingest->config_lock);
+    return ingest;
+}
+
+void udpjson_ingest_free(UdpJsonIngest *ingest)
+{
+    if (!ingest)
+        return;
+
+    g_free(ingest->multicast_ip);
+    g_free(ingest->iface);
+    g_free(ingest->endpoints);
+    g_free(ingest->metrics_endpoint);
+    g_free(ingest->flight_recorder_dir);
+    g_free(ingest->journal_dir);
+    g_free(ingest->name);
+    g_free(ingest->shared_key);
+
+    udpjson_flight_uninstall_signal(ingest);
+    udpjson_flight_recorder_free(ingest->flight_recorder);
+    g_mutex_clear(&ingest->flight_lock);
+    g_mutex_clear(&ingest->flight_dump_lock);
+    g_cond_clear(&ingest->flight_dump_cond);
+    g_mutex_clear(&ingest->config_lock);
+    udpjson_stats_free(ingest->stats);
+    g_hash_table_destroy(ingest->cache);
+    g_rw_lock_clear(&ingest->cache_lock);
+    g_free(ingest);
+}
+
+/**
+ * @brief 共享接收器的某项配置与使用者不同时，把保留的取值追加到 diff。
+ *
+ * @param diff 差异说明。
+ * @param differs 是否不同。
+ * @param name 属性名。
+ * @param kept 共享接收器保留的取值（接管）。
+ */
+static void udpjson_shared_diff_append(GString *diff, gboolean differs, const gchar *name,
+                                       gchar *kept)
+{
+    if (differs)
+        g_string_append_printf(diff, " %s=%s", name, kept ? kept : "(null)");
+    g_free(kept);
+}
+
+/**
+ * @brief 后来的使用者配置与共享接收器不同时告警，列出全部不同的属性。
+ *
+ * cache-ttl-ms 由各元素查询缓存时按自己的配置判断，不在此列。
+ *
+ * @param ingest 使用共享接收器的实例。
+ * @param shared 共享接收器。
+ */
+static void udpjson_shared_check_config(UdpJsonIngest *ingest, const UdpJsonIngest *shared)
+{
+    GString *diff = g_string_new(NULL); /* 不同的属性及共享接收器保留的取值 */
+
+    udpjson_shared_diff_append(diff, shared->max_cache_size != ingest->max_cache_size,
+                               "max-cache-size", g_strdup_printf("%u", shared->max_cache_size));
+    udpjson_shared_diff_append(diff, shared->recv_buf_size != ingest->recv_buf_size,
+                               "recv-buf-size", g_strdup_printf("%u", shared->recv_buf_size));
+    udpjson_shared_diff_append(diff, shared->dedup_window_ms != ingest->dedup_window_ms,
+                               "dedup-window-ms", g_strdup_printf("%u", shared->dedup_window_ms));
+    udpjson_shared_diff_append(diff,
+                               shared->flight_recorder_size != ingest->flight_recorder_size,
+                               "flight-recorder-size",
+                               g_strdup_printf("%u", shared->flight_recorder_size));
+    udpjson_shared_diff_append(
+        diff, g_strcmp0(shared->flight_recorder_dir, ingest->flight_recorder_dir) != 0,
+        "flight-recorder-dir", g_strdup(shared->flight_recorder_dir));
+    udpjson_shared_diff_append(
+        diff, shared->flight_recorder_fail_ratio != ingest->flight_recorder_fail_ratio,
+        "flight-recorder-fail-ratio", g_strdup_printf("%g", shared->flight_recorder_fail_ratio));
+    udpjson_shared_diff_append(
+        diff, shared->flight_recorder_dump_on_flush != ingest->flight_recorder_dump_on_flush,
+        "flight-recorder-dump-on-flush",
+        g_strdup(shared->flight_recorder_dump_on_flush ? "true" : "false"));
+    udpjson_shared_diff_append(diff,
+                               shared->flight_recorder_signal != ingest->flight_recorder_signal,
+                               "flight-recorder-signal",
+                               g_strdup_printf("%d", shared->flight_recorder_signal));
+    udpjson_shared_diff_append(diff, g_strcmp0(shared->journal_dir, ingest->journal_dir) != 0,
+                               "journal-dir", g_strdup(shared->journal_dir));
+    udpjson_shared_diff_append(diff, shared->journal_file_size != ingest->journal_file_size,
+                               "journal-file-size",
+                               g_strdup_printf("%u", shared->journal_file_size));
+    udpjson_shared_diff_append(diff, shared->journal_max_files != ingest->journal_max_files,
+                               "journal-max-files",
+                               g_strdup_printf("%u", shared->journal_max_files));
+
+    if (diff->len > 0)
+        GST_WARNING_OBJECT(ingest->owner, "shared receiver %s keeps%s", shared->shared_key,
+                           diff->str);
+    g_string_free(diff, TRUE);
+}
+
+/**
+ * @brief 按 ingest 的配置创建并启动一个共享接收器（不加入注册表）。
+ *
+ * @param ingest 首个使用者。
+ * @param key 注册表键（接管）。
+ * @return 共享接收器，启动失败返回 NULL。
+ */
+static UdpJsonIngest *udpjson_shared_new(UdpJsonIngest *ingest, gchar *key)
+{
+    UdpJsonIngest *shared = udpjson_ingest_new(NULL); /* 共享接收器 */
+
+    shared->name = ingest->endpoints && *ingest->endpoints
+                       ? g_strdup_printf("shared-endpoints-%08x", g_str_hash(key))
+                       : g_strdup_printf("shared-%s-%u", ingest->multicast_ip, ingest->port);
+    shared->shared_key = key;
+    shared->multicast_ip = g_strdup(ingest->multicast_ip);
+    shared->port = ingest->port;
+    shared->iface = g_strdup(ingest->iface);
+    shared->endpoints = g_strdup(ingest->endpoints);
+    shared->recv_buf_size = ingest->recv_buf_size;
+    shared->dedup_window_ms = ingest->dedup_window_ms;
+    shared->max_cache_size = ingest->max_cache_size;
+    shared->flight_recorder_size = ingest->flight_recorder_size;
+    shared->flight_recorder_dir = g_strdup(ingest->flight_recorder_dir);
+    shared->flight_recorder_fail_ratio = ingest->flight_recorder_fail_ratio;
+    shared->flight_recorder_dump_on_flush = ingest->flight_recorder_dump_on_flush;
+    shared->flight_recorder_signal = ingest->flight_recorder_signal;
+    shared->journal_dir = g_strdup(ingest->journal_dir);
+    shared->journal_file_size = ingest->journal_file_size;
+    shared->journal_max_files = ingest->journal_max_files;
+    if (!udpjson_ingest_start(shared))
+    {
+        udpjson_ingest_free(shared);
+        return NULL;
+    }
+    return shared;
+}
+
+/**
+ * @brief 取得与 ingest 的 (multicast_ip, port, iface) 相同的共享接收器，没有则创建并启动。
+ *
+ * 共享接收器没有 owner，只接收目标 JSON；缓存、接收缓冲、去重、飞行记录器与
+ * 接收日志取首个使用者的配置，后来者配置不同时仅告警。打开套接字与启动线程在
+ * 注册表锁之外进行，两个使用者同时创建时先加入注册表的生效，另一个停止丢弃。
+ *
+ * @param ingest 使用共享接收器的实例。
+ * @return 共享接收器（引用数已加一），启动失败返回 NULL。
+ */
+static UdpJsonIngest *udpjson_shared_acquire(UdpJsonIngest *ingest)
+{
+    gchar *key = NULL; /* 注册表键 */
+    UdpJsonIngest *shared = NULL; /* 共享接收器 */
+    UdpJsonIngest *created = NULL; /* 本次创建的共享接收器 */
+
+    if (ingest->endpoints && *ingest->endpoints)
+        key = g_strdup(ingest->endpoints);
+    else
+        key = g_strdup_printf("%s:%u@%s", ingest->multicast_ip ? ingest->multicast_ip : "",
+                              ingest->port, ingest->iface ? ingest->iface : "");
+
+    g_mutex_lock(&udpjson_shared_lock);
+    if (!udpjson_shared_table)
+        udpjson_shared_table = g_hash_table_new(g_str_hash, g_str_equal);
+    shared = (UdpJsonIngest *)g_hash_table_lookup(udpjson_shared_table, key);
+    if (shared)
+        shared->shared_refs++;
+    g_mutex_unlock(&udpjson_shared_lock);
+
+    if (!shared)
+    {
+        created = udpjson_shared_new(ingest, g_strdup(key));
+        if (!created)
+        {
+            g_free(key);
+            return NULL;
+        }
+
+        g_mutex_lock(&udpjson_shared_lock);
+        shared = (UdpJsonIngest *)g_hash_table_lookup(udpjson_shared_table, key);
+        if (!shared)
+        {
+            shared = created;
+            created = NULL;
+            g_hash_table_insert(udpjson_shared_table, shared->shared_key, shared);
+        }
+        shared->shared_refs++;
+        g_mutex_unlock(&udpjson_shared_lock);
+
+        if (created)
+        {
+            /* 另一个使用者先完成了创建 */
+            udpjson_ingest_stop(created);
+            udpjson_ingest_free(created);
+        }
+        else
+        {
+            GST_INFO_OBJECT(ingest->owner, "shared receiver %s started", shared->shared_key);
+            g_free(key);
+            return shared;
+        }
+    }
+
+    udpjson_shared_check_config(ingest, shared);
+    g_free(key);
+    return shared;
+}
+
+/**
+ * @brief 释放对共享接收器的引用，最后一个使用者释放时停止并销毁。
+ *
+ * @param shared 共享接收器。
+ */
+static void udpjson_shared_release(UdpJsonIngest *shared)
+{
+    g_mutex_lock(&udpjson_shared_lock);
+    if (--shared->shared_refs > 0)
+    {
+        g_mutex_unlock(&udpjson_shared_lock);
+        return;
+    }
+    g_hash_table_remove(udpjson_shared_table, shared->shared_key);
+    g_mutex_unlock(&udpjson_shared_lock);
+
+    GST_INFO("shared receiver %s stopped", shared->shared_key);
+    udpjson_ingest_stop(shared);
+    udpjson_ingest_free(shared);
+}
+
+/**
+ * @brief 断开与共享接收器的关联（未使用共享接收器时无操作）。
+ *
+ * @param ingest 接收实例。
+ */
+static void udpjson_ingest_release_json(UdpJsonIngest *ingest)
+{
+    UdpJsonIngest *shared = ingest->json_ingest; /* 共享接收器 */
+
+    if (shared == ingest)
+        return;
+    udpjson_stats_set_upstream(ingest->stats, NULL);
+    ingest->json_ingest = ingest;
+    udpjson_shared_release(shared);
+}
+
+gboolean udpjson_ingest_start(UdpJsonIngest *ingest)
+{
+    g_atomic_int_set(&ingest->stop_flag, 0);
+    if (ingest->shared_json)
+    {
+        /* 目标 JSON 由共享接收器接收，本实例不打开 JSON 套接字 */
+        UdpJsonIngest *shared = udpjson_shared_acquire(ingest); /* 共享接收器 */
+        if (!shared)
+            return FALSE;
+        ingest->json_ingest = shared;
+        udpjson_stats_set_upstream(ingest->stats, shared->stats);
+    }
+    else if (!udpjson_setup_socket(ingest))
+    {
+        return FALSE;
+    }
+
+    /* 设置 C-UAV socket（如果启用） */
+    if (!udpjson_setup_cuav_socket(ingest))
+    {
+        udpjson_teardown_socket(ingest);
+        udpjson_ingest_release_json(ingest);
+        return FALSE;
+    }
+
+    /* 指标服务失败不影响数据接收 */
+    ingest->metrics_server = udpjson_metrics_server_new(ingest->metrics_endpoint);
+    if (ingest->metrics_endpoint && *ingest->metrics_endpoint && !ingest->metrics_server)
+        GST_WARNING_OBJECT(ingest->owner, "metrics endpoint %s unavailable",
+                           ingest->metrics_endpoint);
+    ingest->stats_post_us = g_get_monotonic_time();
+
+    udpjson_flight_setup(ingest);
+
+    /* 共享接收器服务多个元素，不按单个元素的可见目标过滤 */
+    if (ingest->demand_interval > 0 && ingest->shared_json)
+        GST_WARNING_OBJECT(ingest->owner, "demand filter is not applied to a shared receiver");
+    else if (ingest->demand_interval > 0)
+        ingest->demand = udpjson_demand_new(ingest->demand_interval);
+
+    /* 去重在接收目标 JSON 的实例上进行，共享接收器按自己的配置去重 */
+    if (ingest->dedup_window_ms > 0 && !ingest->shared_json)
+        ingest->dedup = udpjson_dedup_new(ingest->dedup_window_ms);
+
+    /* 接收日志失败不影响数据接收 */
+    if (ingest->journal_dir && *ingest->journal_dir)
+    {
+        ingest->journal = udpjson_journal_new(
+            ingest->journal_dir, udpjson_ingest_name(ingest), ingest->journal_file_size,
+            ingest->journal_max_files, UDPJSON_JOURNAL_RING_SIZE);
+        if (!ingest->journal)
+            GST_WARNING_OBJECT(ingest->owner, "journal directory %s unavailable",
+                               ingest->journal_dir);
+    }
+
+    ingest->recv_thread = g_thread_new("udpjson-recv", udpjson_recv_thread, ingest);
+    return TRUE;
+}
+
+void udpjson_ingest_request_reconfigure(UdpJsonIngest *ingest)
+{
+    if (udpjson_ingest_running(ingest))
+        g_atomic_int_set(&ingest->reconfigure, 1);
+}
+
+void udpjson_ingest_stop(UdpJsonIngest *ingest)
+{
+    g_atomic_int_set(&ingest->stop_flag, 1);
+    if (ingest->recv_thread)
+    {
+        g_thread_join(ingest->recv_thread);
+        ingest->recv_thread = NULL;
+    }
+    udpjson_flight_stop_dump_thread(ingest);
+
+    udpjson_teardown_socket(ingest);
+    udpjson_ingest_release_json(ingest);
+    udpjson_metrics_server_free(ingest->metrics_server);
+    ingest->metrics_server = NULL;
+    udpjson_journal_free(ingest->journal);
+    ingest->journal = NULL;
+    udpjson_demand_free(ingest->demand);
+    ingest->demand = NULL;
+    udpjson_dedup_free(ingest->dedup);
+    ingest->dedup = NULL;
+}
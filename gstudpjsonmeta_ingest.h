@@ -0,0 +1,257 @@
+#ifndef __GST_UDPJSON_META_INGEST_H__
+#define __GST_UDPJSON_META_INGEST_H__
+
+#include <glib.h>
+#include <gst/gst.h>
+#include "gstudpjsonmeta_cuav.h"
+#include "gstudpjsonmeta_dedup.h"
+#include "gstudpjsonmeta_demand.h"
+#include "gstudpjsonmeta_eventlog.h"
+#include "gstudpjsonmeta_flightrec.h"
+#include "gstudpjsonmeta_journal.h"
+#include "gstudpjsonmeta_metrics.h"
+#include "gstudpjsonmeta_stats.h"
+
+G_BEGIN_DECLS
+
+/* 缓存键 */
+typedef struct
+{
+    guint source_id; /* 源ID */
+    guint64 object_id; /* 目标ID */
+} UdpJsonCacheKey;
+
+typedef struct _UdpJsonIngest UdpJsonIngest;
+
+/* endpoints 最多的端点数 */
+#define UDPJSON_MAX_ENDPOINTS 32
+
+/**
+ * @brief 目标 JSON 端点（endpoints 中的一项）
+ */
+typedef struct
+{
+    gchar *multicast_ip; /* 组播地址 */
+    guint port; /* 端口 */
+    gchar *iface; /* 网卡名，NULL 表示不限 */
+    guint source_id; /* 报文未给出 source_id 时使用的源ID */
+    gint fd; /* UDP 套接字 */
+} UdpJsonEndpoint;
+
+/* 缓存值 */
+typedef struct
+{
+    gchar *value; /* JSON 值字符串 */
+    guint64 recv_ts_us; /* 接收时间(微秒) */
+    guint32 tar_id; /* 关联的引导批号，0 表示未关联 */
+} UdpJsonCacheValue;
+
+/**
+ * @brief 接收、解析与缓存（不依赖 DeepStream）
+ *
+ * 负责组播套接字、接收线程、目标 JSON 解析与 (source_id, object_id) 缓存、
+ * C-UAV 报文分发、计数与直方图、指标服务和飞行记录器。元素在 transform_ip
+ * 中持 cache_lock 读锁查询 cache，并把结果附加为 NvDs 元数据。
+ *
+ * 配置字段在 udpjson_ingest_start() 前设置；标注“接收线程使用”的字段
+ * 只能由接收线程访问。运行中修改 multicast_ip、port、iface、endpoints、
+ * recv_buf_size 与 C-UAV 端口须持 config_lock，然后调用
+ * udpjson_ingest_request_reconfigure()；接收线程只重建组播地址、端口或网卡
+ * 变化了的套接字，其余套接字继续接收。
+ *
+ * endpoints 非空时按列表为每个端点打开一个目标 JSON 套接字，由同一接收线程
+ * 轮询；端点的默认源ID用于未给出 source_id 的报文。iface 为逗号分隔的多个
+ * 网卡时，在每个网卡上加入同一组播组（冗余路径）。dedup_window_ms 非 0 时，
+ * 各目标 JSON 套接字（路径）收到的相同报文在窗口内只处理首个副本。
+ *
+ * shared_json 为 TRUE 时，本实例不打开目标 JSON 套接字，start 时从进程内
+ * 注册表按 (multicast_ip, port, iface) 或 endpoints 取得共享接收器，
+ * json_ingest 指向它，元素从其缓存查询；C-UAV 套接字与解析仍由本实例负责。
+ */
+struct _UdpJsonIngest
+{
+    GstElement *owner; /* 发布总线消息与追踪记录的元素，可为 NULL */
+
+    gchar *multicast_ip; /* 组播地址 */
+    guint port; /* 组播端口 */
+    gchar *iface; /* 绑定网卡名 */
+    gchar *endpoints; /* 目标 JSON 端点列表，非空时代替 multicast_ip/port/iface */
+    guint recv_buf_size; /* 接收缓冲区大小 */
+    guint max_cache_size; /* 最大缓存条目数，0 表示不限 */
+    gboolean enable_cuav_parser; /* 是否接收并解析 C-UAV 报文 */
+    guint cuav_multicast_port; /* C-UAV 组播端口 */
+    guint cuav_ctrl_port; /* C-UAV 控制/引导端口，0 表示不接收 */
+    gboolean cache_debug; /* 缓存写入/清空调试事件 */
+    gboolean shared_json; /* 目标 JSON 由进程内共享接收器接收与缓存 */
+    guint demand_interval; /* 需求过滤发布间隔(批次)，0 表示不过滤 */
+    guint dedup_window_ms; /* 多路冗余接收的去重窗口(毫秒)，0 表示不去重 */
+    UdpJsonEventLog *event_log; /* 调试事件日志（不持有） */
+    CUAVParser *cuav_parser; /* C-UAV 报文解析器（不持有） */
+
+    GArray *endpoint_socks; /* UdpJsonEndpoint，已打开的目标 JSON 套接字 */
+    gint cuav_sockfd; /* C-UAV UDP 套接字 */
+    gint cuav_ctrl_sockfd; /* C-UAV 控制/引导 UDP 套接字 */
+    gchar *cuav_group; /* C-UAV 套接字已加入的组播地址 */
+    guint cuav_bound_port; /* cuav_sockfd 绑定的端口，0 表示未打开 */
+    guint cuav_ctrl_bound_port; /* cuav_ctrl_sockfd 绑定的端口，0 表示未打开 */
+    GThread *recv_thread; /* 接收线程 */
+    gint stop_flag; /* 停止标记 */
+    GMutex config_lock; /* 运行中修改套接字配置时保护配置字段 */
+    gint reconfigure; /* 套接字配置已修改，接收线程据此切换套接字 */
+
+    UdpJsonIngest *json_ingest; /* 提供目标 JSON 缓存的实例：本实例或共享接收器 */
+    gchar *name; /* 文件名与日志中的实例名，NULL 表示取 owner 的名字 */
+    gchar *shared_key; /* 共享接收器在注册表中的键，非共享接收器为 NULL */
+    guint shared_refs; /* 共享接收器的引用数（注册表锁保护） */
+
+    GRWLock cache_lock; /* 缓存读写锁 */
+    GHashTable *cache; /* UdpJsonCacheKey -> UdpJsonCacheValue */
+    UdpJsonStats *stats; /* 按线程分片的收包/解析/缓存/附加计数 */
+    UdpJsonDemand *demand; /* 可见目标的需求过滤器，start 时创建、stop 时释放 */
+    UdpJsonDedup *dedup; /* 目标 JSON 去重器，start 时创建、stop 时释放 */
+    gint stats_interval_ms; /* 总线统计消息发布间隔(毫秒)，0 表示不发布 */
+    gint64 stats_post_us; /* 上次发布统计消息的时间（接收线程使用） */
+    gchar *metrics_endpoint; /* Prometheus 指标服务地址 */
+    UdpJsonMetricsServer *metrics_server; /* 指标服务，由接收线程驱动 */
+
+    GMutex flight_lock; /* 保护 flight_recorder 的创建、释放与转储 */
+    UdpJsonFlightRecorder *flight_recorder; /* 最近接收事件的飞行记录器，NULL 表示关闭 */
+    UdpJsonFlightEvent *flight_event; /* 正在记录的事件（接收线程使用） */
+    guint flight_recorder_size; /* 飞行记录器容量，0 表示关闭 */
+    gchar *flight_recorder_dir; /* 自动转储文件目录，NULL 为系统临时目录 */
+    gdouble flight_recorder_fail_ratio; /* 触发自动转储的每秒失败比例，0 表示不触发 */
+    gboolean flight_recorder_dump_on_flush; /* 缓存整体清空时自动转储 */
+    gint flight_recorder_signal; /* 触发转储的信号编号，0 表示不安装 */
+    gint flight_signal_installed; /* 本实例安装了处理函数的信号编号，0 表示未安装 */
+    gint flight_signal_seen; /* 已处理的信号次数（接收线程使用） */
+    GThread *flight_dump_thread; /* 转储线程，记录器开启时随接收线程启动 */
+    GMutex flight_dump_lock; /* 保护 flight_dump_reason 与 flight_dump_stop */
+    GCond flight_dump_cond; /* 唤醒转储线程 */
+    const gchar *flight_dump_reason; /* 待转储的原因（静态字符串），NULL 表示无 */
+    gboolean flight_dump_stop; /* 转储线程退出标志 */
+    gboolean flight_flush_pending; /* 缓存已清空、待转储（接收线程使用） */
+    gint64 flight_window_us; /* 失败比例统计窗口起点（接收线程使用） */
+    guint64 flight_window_packets; /* 窗口起点的累计报文数（接收线程使用） */
+    guint64 flight_window_failures; /* 窗口起点的累计失败数（接收线程使用） */
+    gint64 flight_auto_dump_us; /* 上次自动转储时间（接收线程使用） */
+
+    gchar *journal_dir; /* 接收日志目录，NULL 或空表示不记录 */
+    guint journal_file_size; /* 单个日志文件长度(字节) */
+    guint journal_max_files; /* 最多保留的日志文件数 */
+    UdpJsonJournal *journal; /* 接收日志，start 时创建、stop 时关闭 */
+};
+
+/**
+ * @brief 创建接收实例（不打开套接字）
+ *
+ * @param owner 发布总线消息与追踪记录的元素，可为 NULL
+ * @return 接收实例
+ */
+UdpJsonIngest *udpjson_ingest_new(GstElement *owner);
+
+/**
+ * @brief 释放接收实例（须先 udpjson_ingest_stop()）
+ *
+ * @param ingest 接收实例（可为 NULL）
+ */
+void udpjson_ingest_free(UdpJsonIngest *ingest);
+
+/**
+ * @brief 打开套接字、指标服务、飞行记录器与接收日志并启动接收线程
+ *
+ * @param ingest 接收实例
+ * @return 成功返回 TRUE
+ */
+gboolean udpjson_ingest_start(UdpJsonIngest *ingest);
+
+/**
+ * @brief 停止接收线程并关闭套接字、指标服务与接收日志（缓存与飞行记录器保留）
+ *
+ * @param ingest 接收实例
+ */
+void udpjson_ingest_stop(UdpJsonIngest *ingest);
+
+/**
+ * @brief 请求接收线程按当前配置切换套接字（未运行时无操作，下次启动生效）
+ *
+ * 接收线程在下一轮（至多 100ms）打开并加入新套接字，成功后收完旧套接字中
+ * 已排队的报文再关闭，缓存保留；失败时保留旧套接字。使用共享接收器时目标
+ * JSON 套接字不切换，下次启动生效。
+ *
+ * @param ingest 接收实例
+ */
+void udpjson_ingest_request_reconfigure(UdpJsonIngest *ingest);
+
+/**
+ * @brief 接收线程是否在运行
+ */
+static inline gboolean udpjson_ingest_running(const UdpJsonIngest *ingest)
+{
+    return ingest->recv_thread != NULL;
+}
+
+/**
+ * @brief 解析一条目标 JSON 并更新缓存
+ *
+ * 接收线程对每个目标报文调用；回放和基准可在单一线程中直接调用。
+ *
+ * @param ingest 接收实例
+ * @param data JSON 数据
+ * @param len 数据长度
+ * @param recv_ns 报文接收时间(udpjson_now_ns)
+ * @param default_source_id 报文未给出 source_id 时使用的源ID（来自端点，缺省为 0）
+ */
+void udpjson_ingest_parse_and_cache(UdpJsonIngest *ingest, const gchar *data, gssize len,
+                                    guint64 recv_ns, guint default_source_id);
+
+/**
+ * @brief 更新缓存中的目标值（缓存满时整体清空）
+ *
+ * @param ingest 接收实例
+ * @param source_id 源ID
+ * @param object_id 目标ID
+ * @param value JSON 值字符串
+ * @param tar_id 关联的引导批号，0 表示未关联
+ */
+void udpjson_ingest_cache_update(UdpJsonIngest *ingest, guint source_id, guint64 object_id,
+                                 const gchar *value, guint32 tar_id);
+
+/**
+ * @brief 解析一条 C-UAV 报文并计数
+ *
+ * @param ingest 接收实例
+ * @param data 报文数据
+ * @param len 数据长度
+ */
+void udpjson_ingest_parse_cuav(UdpJsonIngest *ingest, const gchar *data, gssize len);
+
+/**
+ * @brief 转储飞行记录器，owner 不为空时在总线上发布 udpjsonmeta-flight-dump 消息
+ *
+ * @param ingest 接收实例
+ * @param path 文件路径，NULL 表示在 flight_recorder_dir 下自动命名
+ * @param reason 转储原因
+ * @return 写入成功返回 TRUE
+ */
+gboolean udpjson_ingest_dump_flight_recorder(UdpJsonIngest *ingest, const gchar *path,
+                                             const gchar *reason);
+
+/**
+ * @brief 解析一个端点条目 "group:port[@iface][=source_id]"
+ *
+ * @param entry 条目（会被修改）
+ * @param ep 输出端点，成功时 multicast_ip/iface 为新分配的字符串，fd 为 -1
+ * @return 格式正确返回 TRUE
+ */
+gboolean udpjson_parse_endpoint(gchar *entry, UdpJsonEndpoint *ep);
+
+/**
+ * @brief 关闭端点的套接字并释放字符串（可作为 GArray 清理函数）
+ *
+ * @param data 端点指针
+ */
+void udpjson_endpoint_clear(gpointer data);
+
+G_END_DECLS
+
+#endif /* __GST_UDPJSON_META_INGEST_H__ */
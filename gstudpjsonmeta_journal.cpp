@@ -0,0 +1,381 @@
+#include "gstudpjsonmeta_journal.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <gst/gst.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+/* 环形缓冲中的回绕标记：其后到缓冲末尾的字节不用 */
+#define UDPJSON_JOURNAL_WRAP G_MAXUINT32
+/* 刷写线程的轮询间隔(毫秒) */
+#define UDPJSON_JOURNAL_FLUSH_INTERVAL_MS 10
+/* 环形缓冲的最小长度 */
+#define UDPJSON_JOURNAL_MIN_RING_SIZE (64 * 1024)
+
+struct _UdpJsonJournal
+{
+    /* 写入线程独占 */
+    guint64 head __attribute__((aligned(64))); /* 已发布的字节偏移 */
+    guint32 dropped_pending;  /* 上一条成功追加后丢弃的记录数 */
+
+    /* 刷写线程独占 */
+    guint64 tail __attribute__((aligned(64))); /* 已刷写的字节偏移 */
+    gint fd;                  /* 当前日志文件，-1 表示尚未打开 */
+    guint8 *map;              /* 当前文件的映射 */
+    gsize file_used;          /* 当前文件已写入的长度 */
+    guint64 file_seq;         /* 当前文件序号 */
+    GQueue *files;            /* 保留的文件路径，最旧的在队首 */
+    gboolean open_failed;     /* 上次打开文件失败（只告警一次） */
+    guint64 written;          /* 写入文件的记录数 */
+    guint64 lost;             /* 文件打不开而丢弃的记录数 */
+
+    /* 创建后只读 */
+    guint8 *ring;             /* 环形缓冲 */
+    gsize ring_size;          /* 环形缓冲大小（2 的幂） */
+    gsize max_record;         /* 单条记录的最大长度（含记录头） */
+    gchar *dir;               /* 日志目录 */
+    gchar *prefix;            /* 文件名前缀 */
+    gsize file_size;          /* 单个文件长度 */
+    guint max_files;          /* 最多保留的文件数 */
+
+    GThread *thread;          /* 刷写线程 */
+    GMutex lock;              /* 保护 stop，配合 cond 唤醒刷写线程 */
+    GCond cond;
+    gboolean stop;            /* 停止刷写线程 */
+};
+
+struct _UdpJsonJournalReader
+{
+    GMappedFile *file;        /* 映射的日志文件 */
+    const guint8 *data;       /* 文件内容 */
+    gsize size;               /* 文件长度 */
+    gsize pos;                /* 当前读取偏移 */
+    UdpJsonJournalHeader header; /* 文件头 */
+};
+
+/**
+ * @brief 读取时钟(纳秒)
+ */
+static guint64 udpjson_journal_clock_ns(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (guint64)ts.tv_sec * 1000000000ull + (guint64)ts.tv_nsec;
+}
+
+/**
+ * @brief 关闭当前文件：解除映射并截去未用部分（刷写线程调用）
+ */
+static void udpjson_journal_close_file(UdpJsonJournal *journal)
+{
+    if (journal->fd < 0)
+        return;
+    munmap(journal->map, journal->file_size);
+    if (ftruncate(journal->fd, (off_t)journal->file_used) < 0)
+        GST_WARNING("Failed to truncate journal file: %s", strerror(errno));
+    close(journal->fd);
+    journal->fd = -1;
+    journal->map = NULL;
+}
+
+/**
+ * @brief 创建并映射下一个文件，删除超出 max_files 的旧文件（刷写线程调用）
+ *
+ * @return 成功返回 TRUE
+ */
+static gboolean udpjson_journal_open_file(UdpJsonJournal *journal)
+{
+    UdpJsonJournalHeader header; /* 文件头 */
+    gchar *name = g_strdup_printf("%s-%06" G_GUINT64_FORMAT ".ujj", journal->prefix,
+                                  journal->file_seq + 1);
+    gchar *path = g_build_filename(journal->dir, name, NULL);
+    gint fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    void *map = MAP_FAILED;
+
+    g_free(name);
+    if (fd >= 0 && ftruncate(fd, (off_t)journal->file_size) == 0)
+        map = mmap(NULL, journal->file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED)
+    {
+        if (!journal->open_failed)
+            GST_ERROR("Failed to create journal file %s: %s", path, strerror(errno));
+        journal->open_failed = TRUE;
+        if (fd >= 0)
+        {
+            close(fd);
+            unlink(path);
+        }
+        g_free(path);
+        return FALSE;
+    }
+
+    journal->open_failed = FALSE;
+    journal->file_seq++;
+    journal->fd = fd;
+    journal->map = (guint8 *)map;
+
+    memset(&header, 0, sizeof(header));
+    header.magic = UDPJSON_JOURNAL_MAGIC;
+    header.version = UDPJSON_JOURNAL_VERSION;
+    header.header_size = sizeof(UdpJsonJournalHeader);
+    header.record_size = sizeof(UdpJsonJournalRecordHeader);
+    header.seq = journal->file_seq;
+    header.start_mono_ns = udpjson_journal_clock_ns(CLOCK_MONOTONIC);
+    header.start_real_ns = udpjson_journal_clock_ns(CLOCK_REALTIME);
+    memcpy(journal->map, &header, sizeof(header));
+    journal->file_used = sizeof(header);
+
+    g_queue_push_tail(journal->files, path);
+    while (journal->files->length > journal->max_files)
+    {
+        gchar *old = (gchar *)g_queue_pop_head(journal->files);
+        if (unlink(old) < 0 && errno != ENOENT)
+            GST_WARNING("Failed to remove old journal file %s: %s", old, strerror(errno));
+        g_free(old);
+    }
+    GST_INFO("Journal file %s opened", path);
+    return TRUE;
+}
+
+/**
+ * @brief 把环形缓冲中已发布的记录写入文件（刷写线程调用）
+ */
+static void udpjson_journal_drain(UdpJsonJournal *journal)
+{
+    guint64 head = __atomic_load_n(&journal->head, __ATOMIC_ACQUIRE); /* 已发布的偏移 */
+    guint64 tail = journal->tail; /* 已刷写的偏移 */
+    gsize mask = journal->ring_size - 1;
+
+    while (tail < head)
+    {
+        gsize off = (gsize)(tail & mask);
+        const guint8 *src = journal->ring + off;
+        guint32 len = 0;
+        gsize rec = 0;
+
+        memcpy(&len, src, sizeof(len));
+        if (len == UDPJSON_JOURNAL_WRAP)
+        {
+            tail += journal->ring_size - off;
+            continue;
+        }
+        rec = UDPJSON_JOURNAL_ALIGN(sizeof(UdpJsonJournalRecordHeader) + len);
+
+        if (journal->fd >= 0 && journal->file_used + rec > journal->file_size)
+            udpjson_journal_close_file(journal);
+        if (journal->fd < 0 && !udpjson_journal_open_file(journal))
+        {
+            journal->lost++;
+            tail += rec;
+            continue;
+        }
+
+        /* 长度最后写入：刷写线程中途退出时读取方在上一条处停止 */
+        memcpy(journal->map + journal->file_used + sizeof(len), src + sizeof(len),
+               rec - sizeof(len));
+        __atomic_store_n((guint32 *)(journal->map + journal->file_used), len, __ATOMIC_RELEASE);
+        journal->file_used += rec;
+        journal->written++;
+        tail += rec;
+    }
+    __atomic_store_n(&journal->tail, tail, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 刷写线程入口：每 UDPJSON_JOURNAL_FLUSH_INTERVAL_MS 刷写一次，停止前再刷写一次
+ */
+static gpointer udpjson_journal_thread(gpointer data)
+{
+    UdpJsonJournal *journal = (UdpJsonJournal *)data;
+
+    g_mutex_lock(&journal->lock);
+    while (!journal->stop)
+    {
+        gint64 deadline = g_get_monotonic_time() + UDPJSON_JOURNAL_FLUSH_INTERVAL_MS * 1000;
+        while (!journal->stop && g_cond_wait_until(&journal->cond, &journal->lock, deadline))
+            ;
+        g_mutex_unlock(&journal->lock);
+        udpjson_journal_drain(journal);
+        g_mutex_lock(&journal->lock);
+    }
+    g_mutex_unlock(&journal->lock);
+    udpjson_journal_drain(journal);
+    return NULL;
+}
+
+UdpJsonJournal *udpjson_journal_new(const gchar *dir, const gchar *name, gsize file_size,
+                                    guint max_files, gsize ring_size)
+{
+    UdpJsonJournal *journal = NULL;
+    gsize ring = UDPJSON_JOURNAL_MIN_RING_SIZE; /* 实际环形缓冲大小 */
+    gint64 now_us = g_get_real_time(); /* 系统时间 */
+    time_t secs = (time_t)(now_us / G_USEC_PER_SEC);
+    struct tm tm_now;
+    gchar stamp[32]; /* 时间戳 */
+
+    if (!dir || !*dir || access(dir, W_OK) < 0)
+    {
+        GST_ERROR("Journal directory %s is not writable", dir ? dir : "(null)");
+        return NULL;
+    }
+
+    while (ring < ring_size && ring < ((gsize)1 << 30))
+        ring <<= 1;
+    localtime_r(&secs, &tm_now);
+    strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm_now);
+
+    journal = (UdpJsonJournal *)g_malloc0(sizeof(UdpJsonJournal));
+    journal->fd = -1;
+    journal->files = g_queue_new();
+    journal->ring = (guint8 *)g_malloc(ring);
+    journal->ring_size = ring;
+    journal->dir = g_strdup(dir);
+    journal->prefix = g_strdup_printf("udpjsonmeta-%s-%s", name ? name : "ingest", stamp);
+    journal->file_size = UDPJSON_JOURNAL_ALIGN(MAX(file_size, (gsize)UDPJSON_JOURNAL_MIN_FILE_SIZE));
+    journal->max_files = MAX(max_files, 1u);
+    /* 一条记录不超过半个环形缓冲，且放得进一个空文件 */
+    journal->max_record = MIN(ring / 2, journal->file_size - sizeof(UdpJsonJournalHeader));
+    g_mutex_init(&journal->lock);
+    g_cond_init(&journal->cond);
+    journal->thread = g_thread_new("udpjson-journal", udpjson_journal_thread, journal);
+    return journal;
+}
+
+void udpjson_journal_free(UdpJsonJournal *journal)
+{
+    if (!journal)
+        return;
+
+    g_mutex_lock(&journal->lock);
+    journal->stop = TRUE;
+    g_cond_signal(&journal->cond);
+    g_mutex_unlock(&journal->lock);
+    g_thread_join(journal->thread);
+    udpjson_journal_close_file(journal);
+
+    GST_INFO("Journal %s: %" G_GUINT64_FORMAT " records in %" G_GUINT64_FORMAT
+             " files, %" G_GUINT64_FORMAT " lost",
+             journal->prefix, journal->written, journal->file_seq, journal->lost);
+    g_queue_free_full(journal->files, g_free);
+    g_mutex_clear(&journal->lock);
+    g_cond_clear(&journal->cond);
+    g_free(journal->ring);
+    g_free(journal->dir);
+    g_free(journal->prefix);
+    g_free(journal);
+}
+
+gboolean udpjson_journal_append(UdpJsonJournal *journal, guint socket, guint64 ts_ns,
+                                guint32 sender_ip, guint16 sender_port, const gchar *data,
+                                gsize len)
+{
+    UdpJsonJournalRecordHeader hdr; /* 记录头 */
+    gsize rec = UDPJSON_JOURNAL_ALIGN(sizeof(hdr) + len); /* 记录长度 */
+    guint64 head = journal->head;
+    guint64 tail = __atomic_load_n(&journal->tail, __ATOMIC_ACQUIRE);
+    gsize off = (gsize)(head & (journal->ring_size - 1));
+    gsize to_end = journal->ring_size - off;
+    gsize need = rec <= to_end ? rec : to_end + rec; /* 含回绕跳过的字节 */
+
+    g_return_val_if_fail(len > 0, FALSE);
+    if (rec > journal->max_record || head - tail + need > journal->ring_size)
+    {
+        journal->dropped_pending++;
+        return FALSE;
+    }
+
+    if (rec > to_end)
+    {
+        guint32 wrap = UDPJSON_JOURNAL_WRAP;
+        memcpy(journal->ring + off, &wrap, sizeof(wrap));
+        head += to_end;
+        off = 0;
+    }
+
+    hdr.len = (guint32)len;
+    hdr.socket = (guint8)socket;
+    hdr.reserved = 0;
+    hdr.sender_port = sender_port;
+    hdr.sender_ip = sender_ip;
+    hdr.dropped = journal->dropped_pending;
+    hdr.ts_ns = ts_ns;
+    memcpy(journal->ring + off, &hdr, sizeof(hdr));
+    memcpy(journal->ring + off + sizeof(hdr), data, len);
+    __atomic_store_n(&journal->head, head + rec, __ATOMIC_RELEASE);
+    journal->dropped_pending = 0;
+    return TRUE;
+}
+
+UdpJsonJournalReader *udpjson_journal_reader_open(const gchar *path)
+{
+    GMappedFile *file = g_mapped_file_new(path, FALSE, NULL);
+    UdpJsonJournalReader *reader = NULL;
+
+    if (!file)
+    {
+        GST_WARNING("Cannot open journal file %s", path);
+        return NULL;
+    }
+
+    reader = (UdpJsonJournalReader *)g_malloc0(sizeof(UdpJsonJournalReader));
+    reader->file = file;
+    reader->data = (const guint8 *)g_mapped_file_get_contents(file);
+    reader->size = g_mapped_file_get_length(file);
+    if (reader->size < sizeof(UdpJsonJournalHeader))
+        goto invalid;
+    memcpy(&reader->header, reader->data, sizeof(reader->header));
+    if (reader->header.magic != UDPJSON_JOURNAL_MAGIC ||
+        reader->header.version != UDPJSON_JOURNAL_VERSION ||
+        reader->header.header_size < sizeof(UdpJsonJournalHeader) ||
+        reader->header.header_size > reader->size ||
+        reader->header.record_size != sizeof(UdpJsonJournalRecordHeader))
+        goto invalid;
+    reader->pos = reader->header.header_size;
+    return reader;
+
+invalid:
+    GST_WARNING("%s is not a udpjsonmeta journal file", path);
+    udpjson_journal_reader_close(reader);
+    return NULL;
+}
+
+void udpjson_journal_reader_close(UdpJsonJournalReader *reader)
+{
+    if (!reader)
+        return;
+    g_mapped_file_unref(reader->file);
+    g_free(reader);
+}
+
+const UdpJsonJournalHeader *udpjson_journal_reader_header(UdpJsonJournalReader *reader)
+{
+    return &reader->header;
+}
+
+gboolean udpjson_journal_reader_next(UdpJsonJournalReader *reader, UdpJsonJournalRecord *record)
+{
+    UdpJsonJournalRecordHeader hdr; /* 记录头 */
+
+    if (reader->size - reader->pos < sizeof(hdr))
+        return FALSE;
+    memcpy(&hdr, reader->data + reader->pos, sizeof(hdr));
+    if (hdr.len == 0 || hdr.len > reader->size - reader->pos - sizeof(hdr))
+        return FALSE;
+
+    record->ts_ns = hdr.ts_ns;
+    record->socket = hdr.socket;
+    record->sender_ip = hdr.sender_ip;
+    record->sender_port = hdr.sender_port;
+    record->dropped = hdr.dropped;
+    record->payload = (const gchar *)reader->data + reader->pos + sizeof(hdr);
+    record->len = hdr.len;
+    reader->pos += MIN(UDPJSON_JOURNAL_ALIGN(sizeof(hdr) + hdr.len), reader->size - reader->pos);
+    return TRUE;
+}
+
+void udpjson_journal_reader_rewind(UdpJsonJournalReader *reader)
+{
+    reader->pos = reader->header.header_size;
+}
@@ -0,0 +1,151 @@
+#ifndef __GST_UDPJSON_META_JOURNAL_H__
+#define __GST_UDPJSON_META_JOURNAL_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* 日志文件魔数 "UJJL" 与版本 */
+#define UDPJSON_JOURNAL_MAGIC 0x4C4A4A55u
+#define UDPJSON_JOURNAL_VERSION 1
+/* 记录按 8 字节对齐 */
+#define UDPJSON_JOURNAL_ALIGN(n) (((n) + 7) & ~(gsize)7)
+/* 单个日志文件的最小长度 */
+#define UDPJSON_JOURNAL_MIN_FILE_SIZE (64 * 1024)
+
+/**
+ * @brief 日志文件头（64 字节），后跟连续的记录，len 为 0 的记录或文件末尾表示结束
+ */
+typedef struct
+{
+    guint32 magic;            /* UDPJSON_JOURNAL_MAGIC */
+    guint32 version;          /* UDPJSON_JOURNAL_VERSION */
+    guint32 header_size;      /* sizeof(UdpJsonJournalHeader) */
+    guint32 record_size;      /* sizeof(UdpJsonJournalRecordHeader) */
+    guint64 seq;              /* 文件序号，从 1 开始 */
+    guint64 start_mono_ns;    /* 创建时的单调时钟，用于换算记录时间 */
+    guint64 start_real_ns;    /* 创建时的系统时间(纳秒) */
+    guint8 reserved[24];
+} UdpJsonJournalHeader;
+
+/**
+ * @brief 记录头（24 字节），后跟 len 字节原始报文，补齐到 8 字节
+ */
+typedef struct
+{
+    guint32 len;              /* 报文长度，0 表示文件结束 */
+    guint8 socket;            /* UdpJsonFlightSocket */
+    guint8 reserved;
+    guint16 sender_port;      /* 发送方端口(主机字节序) */
+    guint32 sender_ip;        /* 发送方 IPv4 地址(网络字节序) */
+    guint32 dropped;          /* 本条之前因环形缓冲满丢弃的记录数 */
+    guint64 ts_ns;            /* 接收时间(单调时钟，纳秒) */
+} UdpJsonJournalRecordHeader;
+
+/**
+ * @brief 接收日志写入端
+ *
+ * 接收线程调用 udpjson_journal_append() 把报文复制进单生产者单消费者的
+ * 环形缓冲，不加锁、不做系统调用；后台刷写线程周期性地把缓冲内容复制到
+ * 内存映射的日志文件中。文件写满后轮转，目录中最多保留 max_files 个文件。
+ * 映射为 MAP_SHARED，进程崩溃时已刷写的记录仍在页缓存中，不会丢失。
+ */
+typedef struct _UdpJsonJournal UdpJsonJournal;
+
+/**
+ * @brief 创建日志写入端并启动刷写线程（首个文件在有数据时创建）
+ *
+ * @param dir 日志目录
+ * @param name 文件名中的实例名
+ * @param file_size 单个文件长度，不小于 UDPJSON_JOURNAL_MIN_FILE_SIZE
+ * @param max_files 最多保留的文件数（含正在写的文件）
+ * @param ring_size 环形缓冲大小，向上取整为 2 的幂
+ * @return 写入端，目录不可写时返回 NULL
+ */
+UdpJsonJournal *udpjson_journal_new(const gchar *dir, const gchar *name, gsize file_size,
+                                    guint max_files, gsize ring_size);
+
+/**
+ * @brief 刷写剩余记录、关闭当前文件并释放写入端（调用前须停止写入线程）
+ *
+ * @param journal 写入端（可为 NULL）
+ */
+void udpjson_journal_free(UdpJsonJournal *journal);
+
+/**
+ * @brief 追加一条报文（只能由单一写入线程调用）
+ *
+ * @param journal 写入端
+ * @param socket 来源套接字 (UdpJsonFlightSocket)
+ * @param ts_ns 接收时间(udpjson_now_ns)
+ * @param sender_ip 发送方地址(网络字节序)
+ * @param sender_port 发送方端口(主机字节序)
+ * @param data 报文数据
+ * @param len 报文长度，大于 0
+ * @return 写入环形缓冲返回 TRUE，缓冲已满而丢弃返回 FALSE
+ */
+gboolean udpjson_journal_append(UdpJsonJournal *journal, guint socket, guint64 ts_ns,
+                                guint32 sender_ip, guint16 sender_port, const gchar *data,
+                                gsize len);
+
+/**
+ * @brief 日志文件中的一条记录（payload 指向映射的文件内容）
+ */
+typedef struct
+{
+    guint64 ts_ns;            /* 接收时间(单调时钟，纳秒) */
+    guint socket;             /* UdpJsonFlightSocket */
+    guint32 sender_ip;        /* 发送方 IPv4 地址(网络字节序) */
+    guint16 sender_port;      /* 发送方端口(主机字节序) */
+    guint32 dropped;          /* 本条之前丢弃的记录数 */
+    const gchar *payload;     /* 原始报文 */
+    gsize len;                /* 报文长度 */
+} UdpJsonJournalRecord;
+
+/**
+ * @brief 日志文件读取器
+ */
+typedef struct _UdpJsonJournalReader UdpJsonJournalReader;
+
+/**
+ * @brief 打开日志文件（应为已关闭的文件，正在写入的文件关闭时会截短）
+ *
+ * @param path 文件路径
+ * @return 读取器，文件无法读取或不是日志文件时返回 NULL
+ */
+UdpJsonJournalReader *udpjson_journal_reader_open(const gchar *path);
+
+/**
+ * @brief 关闭读取器
+ *
+ * @param reader 读取器（可为 NULL）
+ */
+void udpjson_journal_reader_close(UdpJsonJournalReader *reader);
+
+/**
+ * @brief 获取文件头
+ *
+ * @param reader 读取器
+ * @return 文件头，在读取器关闭前有效
+ */
+const UdpJsonJournalHeader *udpjson_journal_reader_header(UdpJsonJournalReader *reader);
+
+/**
+ * @brief 读取下一条记录
+ *
+ * @param reader 读取器
+ * @param record 输出记录，负载在读取器关闭前有效
+ * @return 读到记录返回 TRUE，文件结束或记录不完整返回 FALSE
+ */
+gboolean udpjson_journal_reader_next(UdpJsonJournalReader *reader, UdpJsonJournalRecord *record);
+
+/**
+ * @brief 回到第一条记录
+ *
+ * @param reader 读取器
+ */
+void udpjson_journal_reader_rewind(UdpJsonJournalReader *reader);
+
+G_END_DECLS
+
+#endif /* __GST_UDPJSON_META_JOURNAL_H__ */
@@ -0,0 +1,329 @@
+#include "gstudpjsonmeta_metrics.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <gst/gst.h>
+#include <netinet/in.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* 连接的发送缓冲，保证整份指标文本可非阻塞写完 */
+#define UDPJSON_METRICS_SNDBUF (256 * 1024)
+
+/**
+ * @brief 一个指标连接
+ */
+typedef struct
+{
+    gint fd;                  /* 连接套接字，-1 表示空闲 */
+    gint64 accept_us;         /* 接受时间(单调时钟，微秒) */
+} UdpJsonMetricsClient;
+
+struct _UdpJsonMetricsServer
+{
+    gint listen_fd;                                           /* 监听套接字 */
+    gchar *unix_path;                                         /* Unix 域套接字路径，关闭时删除 */
+    UdpJsonMetricsClient clients[UDPJSON_METRICS_MAX_CLIENTS]; /* 连接 */
+};
+
+/**
+ * @brief 设置非阻塞
+ */
+static gboolean udpjson_metrics_set_nonblock(gint fd)
+{
+    gint flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/**
+ * @brief 创建 Unix 域监听套接字
+ */
+static gint udpjson_metrics_listen_unix(const gchar *path)
+{
+    struct sockaddr_un addr; /* 监听地址 */
+    gint fd = -1;
+
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        GST_ERROR("Metrics socket path too long: %s", path);
+        return -1;
+    }
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        GST_ERROR("Failed to create metrics socket: %s", strerror(errno));
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    /* 清理上次异常退出留下的套接字文件 */
+    unlink(path);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        GST_ERROR("Failed to bind metrics socket %s: %s", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief 创建 127.0.0.1 上的 TCP 监听套接字
+ */
+static gint udpjson_metrics_listen_tcp(guint port)
+{
+    struct sockaddr_in addr; /* 监听地址 */
+    gint reuse = 1;
+    gint fd = -1;
+
+    if (port == 0 || port > 65535)
+    {
+        GST_ERROR("Invalid metrics port %u", port);
+        return -1;
+    }
+
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        GST_ERROR("Failed to create metrics socket: %s", strerror(errno));
+        return -1;
+    }
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((guint16)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        GST_ERROR("Failed to bind metrics port %u: %s", port, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+UdpJsonMetricsServer *udpjson_metrics_server_new(const gchar *endpoint)
+{
+    UdpJsonMetricsServer *server = NULL;
+    gint fd = -1;
+
+    if (!endpoint || !*endpoint)
+        return NULL;
+
+    if (g_str_has_prefix(endpoint, "unix:"))
+    {
+        fd = udpjson_metrics_listen_unix(endpoint + 5);
+    }
+    else
+    {
+        const gchar *port_str = g_str_has_prefix(endpoint, "tcp:") ? endpoint + 4 : endpoint;
+        gchar *end = NULL;
+        guint64 port = g_ascii_strtoull(port_str, &end, 10);
+
+        if (end == port_str || *end != '\0')
+        {
+            GST_ERROR("Invalid metrics endpoint '%s'", endpoint);
+            return NULL;
+        }
+        fd = udpjson_metrics_listen_tcp((guint)port);
+    }
+    if (fd < 0)
+        return NULL;
+
+    if (listen(fd, UDPJSON_METRICS_MAX_CLIENTS) < 0 || !udpjson_metrics_set_nonblock(fd))
+    {
+        GST_ERROR("Failed to listen on metrics endpoint %s: %s", endpoint, strerror(errno));
+        close(fd);
+        return NULL;
+    }
+
+    server = (UdpJsonMetricsServer *)g_malloc0(sizeof(UdpJsonMetricsServer));
+    server->listen_fd = fd;
+    if (g_str_has_prefix(endpoint, "unix:"))
+        server->unix_path = g_strdup(endpoint + 5);
+    for (guint i = 0; i < UDPJSON_METRICS_MAX_CLIENTS; i++)
+        server->clients[i].fd = -1;
+    GST_INFO("Serving Prometheus metrics on %s", endpoint);
+    return server;
+}
+
+void udpjson_metrics_server_free(UdpJsonMetricsServer *server)
+{
+    if (!server)
+        return;
+    for (guint i = 0; i < UDPJSON_METRICS_MAX_CLIENTS; i++)
+    {
+        if (server->clients[i].fd >= 0)
+            close(server->clients[i].fd);
+    }
+    close(server->listen_fd);
+    if (server->unix_path)
+    {
+        unlink(server->unix_path);
+        g_free(server->unix_path);
+    }
+    g_free(server);
+}
+
+guint udpjson_metrics_server_fill_pollfds(UdpJsonMetricsServer *server, struct pollfd *pfds,
+                                          guint max)
+{
+    guint n = 0;
+
+    if (!server || max == 0)
+        return 0;
+
+    pfds[n].fd = server->listen_fd;
+    pfds[n].events = POLLIN;
+    pfds[n].revents = 0;
+    n++;
+    for (guint i = 0; i < UDPJSON_METRICS_MAX_CLIENTS && n < max; i++)
+    {
+        if (server->clients[i].fd < 0)
+            continue;
+        pfds[n].fd = server->clients[i].fd;
+        pfds[n].events = POLLIN;
+        pfds[n].revents = 0;
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief 非阻塞写出一块文本
+ */
+static gboolean udpjson_metrics_write(const gchar *data, gsize len, gpointer user_data)
+{
+    gint fd = GPOINTER_TO_INT(user_data);
+
+    while (len > 0)
+    {
+        ssize_t n = send(fd, data, len, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return FALSE;
+        }
+        data += n;
+        len -= (gsize)n;
+    }
+    return TRUE;
+}
+
+/**
+ * @brief 输出指标并关闭连接
+ *
+ * @param client 连接
+ * @param http 是否先输出 HTTP 响应头
+ * @param stats 计数器集合
+ */
+static void udpjson_metrics_respond(UdpJsonMetricsClient *client, gboolean http,
+                                    UdpJsonStats *stats)
+{
+    static const gchar http_header[] =
+        "HTTP/1.0 200 OK\r\n"
+        "Content-Type: text/plain; version=0.0.4\r\n"
+        "Connection: close\r\n\r\n";
+    gboolean ok = TRUE;
+
+    if (http)
+        ok = udpjson_metrics_write(http_header, sizeof(http_header) - 1,
+                                   GINT_TO_POINTER(client->fd));
+    if (ok)
+        ok = udpjson_stats_write_prometheus(stats, udpjson_metrics_write,
+                                            GINT_TO_POINTER(client->fd));
+    if (!ok)
+        GST_DEBUG("Metrics client write failed: %s", strerror(errno));
+
+    shutdown(client->fd, SHUT_WR);
+    close(client->fd);
+    client->fd = -1;
+}
+
+void udpjson_metrics_server_dispatch(UdpJsonMetricsServer *server, const struct pollfd *pfds,
+                                     guint n_pfds, UdpJsonStats *stats)
+{
+    gint64 now_us = 0; /* 当前时间 */
+
+    if (!server)
+        return;
+    now_us = g_get_monotonic_time();
+
+    /* 已有连接：收到请求即回复，对端关闭则释放 */
+    for (guint k = 1; k < n_pfds; k++)
+    {
+        UdpJsonMetricsClient *client = NULL;
+        gchar req[512]; /* 请求内容，只看方法名 */
+        ssize_t n = 0;
+
+        if (!(pfds[k].revents & (POLLIN | POLLHUP | POLLERR)))
+            continue;
+        for (guint i = 0; i < UDPJSON_METRICS_MAX_CLIENTS; i++)
+        {
+            if (server->clients[i].fd == pfds[k].fd)
+                client = &server->clients[i];
+        }
+        if (!client)
+            continue;
+
+        n = recv(client->fd, req, sizeof(req), MSG_DONTWAIT);
+        if (n <= 0)
+        {
+            if (n < 0 && (errno == EAGAIN || errno == EINTR))
+                continue;
+            close(client->fd);
+            client->fd = -1;
+            continue;
+        }
+        udpjson_metrics_respond(client,
+                                n >= 4 && (memcmp(req, "GET ", 4) == 0 ||
+                                           memcmp(req, "HEAD", 4) == 0),
+                                stats);
+    }
+
+    /* 超时未发请求的连接按纯文本输出 */
+    for (guint i = 0; i < UDPJSON_METRICS_MAX_CLIENTS; i++)
+    {
+        UdpJsonMetricsClient *client = &server->clients[i];
+        if (client->fd >= 0 &&
+            now_us - client->accept_us > (gint64)UDPJSON_METRICS_REQUEST_TIMEOUT_MS * 1000)
+            udpjson_metrics_respond(client, FALSE, stats);
+    }
+
+    if (n_pfds == 0 || !(pfds[0].revents & POLLIN))
+        return;
+
+    for (;;)
+    {
+        gint sndbuf = UDPJSON_METRICS_SNDBUF;
+        gint fd = accept(server->listen_fd, NULL, NULL);
+        guint slot = UDPJSON_METRICS_MAX_CLIENTS;
+
+        if (fd < 0)
+            break;
+        for (guint i = 0; i < UDPJSON_METRICS_MAX_CLIENTS; i++)
+        {
+            if (server->clients[i].fd < 0)
+            {
+                slot = i;
+                break;
+            }
+        }
+        if (slot == UDPJSON_METRICS_MAX_CLIENTS || !udpjson_metrics_set_nonblock(fd))
+        {
+            close(fd);
+            continue;
+        }
+        setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+        server->clients[slot].fd = fd;
+        server->clients[slot].accept_us = now_us;
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef __GST_UDPJSON_META_METRICS_H__
+#define __GST_UDPJSON_META_METRICS_H__
+
+#include <glib.h>
+#include <poll.h>
+#include "gstudpjsonmeta_stats.h"
+
+G_BEGIN_DECLS
+
+/* 同时服务的最大连接数，超出时新连接直接关闭 */
+#define UDPJSON_METRICS_MAX_CLIENTS 4
+/* 连接后未发来 HTTP 请求的等待时间(毫秒)，超时按纯文本输出 */
+#define UDPJSON_METRICS_REQUEST_TIMEOUT_MS 500
+
+/**
+ * @brief Prometheus 文本指标服务（不透明类型）
+ *
+ * 不创建线程：监听套接字与连接由接收线程的 poll 循环一起等待，
+ * 收到请求后用 udpjson_stats_write_prometheus() 分块写出并关闭连接。
+ * 支持 HTTP GET（Prometheus 抓取）和不发请求的纯文本读取（nc/socat）。
+ */
+typedef struct _UdpJsonMetricsServer UdpJsonMetricsServer;
+
+/**
+ * @brief 创建指标服务并开始监听
+ *
+ * endpoint 格式："unix:/path/to.sock" 为 Unix 域套接字；
+ * "tcp:9464" 或 "9464" 为 127.0.0.1 上的 TCP 端口。
+ *
+ * @param endpoint 监听地址
+ * @return 指标服务，失败返回 NULL
+ */
+UdpJsonMetricsServer *udpjson_metrics_server_new(const gchar *endpoint);
+
+/**
+ * @brief 关闭全部连接与监听套接字并释放
+ *
+ * @param server 指标服务（可为 NULL）
+ */
+void udpjson_metrics_server_free(UdpJsonMetricsServer *server);
+
+/**
+ * @brief 填写需要 poll 的套接字
+ *
+ * @param server 指标服务（可为 NULL）
+ * @param pfds 输出数组
+ * @param max 数组容量，至少 1 + UDPJSON_METRICS_MAX_CLIENTS
+ * @return 填写的数量
+ */
+guint udpjson_metrics_server_fill_pollfds(UdpJsonMetricsServer *server, struct pollfd *pfds,
+                                          guint max);
+
+/**
+ * @brief 处理 poll 结果：接受连接、读取请求、输出指标、关闭超时连接
+ *
+ * 每次 poll 返回（包括超时）都应调用，pfds 为 fill_pollfds 填写的部分。
+ *
+ * @param server 指标服务（可为 NULL）
+ * @param pfds poll 结果
+ * @param n_pfds fill_pollfds 的返回值
+ * @param stats 输出的计数器集合
+ */
+void udpjson_metrics_server_dispatch(UdpJsonMetricsServer *server, const struct pollfd *pfds,
+                                     guint n_pfds, UdpJsonStats *stats);
+
+G_END_DECLS
+
+#endif /* __GST_UDPJSON_META_METRICS_H__ */
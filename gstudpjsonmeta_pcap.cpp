@@ -0,0 +1,389 @@
+#include "gstudpjsonmeta_pcap.h"
+#include <gst/gst.h>
+#include <string.h>
+
+/* pcap 文件头魔数：微秒 / 纳秒时间戳 */
+#define UDPJSON_PCAP_MAGIC_US 0xA1B2C3D4u
+#define UDPJSON_PCAP_MAGIC_NS 0xA1B23C4Du
+/* pcapng 块类型与字节序魔数 */
+#define UDPJSON_PCAPNG_SHB 0x0A0D0D0Au
+#define UDPJSON_PCAPNG_IDB 0x00000001u
+#define UDPJSON_PCAPNG_SPB 0x00000003u
+#define UDPJSON_PCAPNG_EPB 0x00000006u
+#define UDPJSON_PCAPNG_BYTE_ORDER 0x1A2B3C4Du
+/* pcapng IDB 选项 if_tsresol */
+#define UDPJSON_PCAPNG_OPT_TSRESOL 9
+/* 一个 pcapng 段内最多记录的接口数 */
+#define UDPJSON_PCAP_MAX_INTERFACES 64
+
+/* 链路层类型 (LINKTYPE_*) */
+#define UDPJSON_LINKTYPE_NULL 0
+#define UDPJSON_LINKTYPE_ETHERNET 1
+#define UDPJSON_LINKTYPE_RAW 101
+#define UDPJSON_LINKTYPE_LOOP 108
+#define UDPJSON_LINKTYPE_LINUX_SLL 113
+#define UDPJSON_LINKTYPE_IPV4 228
+#define UDPJSON_LINKTYPE_LINUX_SLL2 276
+
+struct _UdpJsonPcapReader
+{
+    GMappedFile *file;        /* 映射的抓包文件 */
+    const guint8 *data;       /* 文件内容 */
+    gsize size;               /* 文件长度 */
+    gsize start;              /* 第一条记录（pcap）或第一个块（pcapng）的偏移 */
+    gsize pos;                /* 当前读取偏移 */
+    gboolean ng;              /* pcapng 格式 */
+    gboolean swap;            /* 文件字节序与本机相反 */
+    guint32 linktype;         /* pcap 链路层类型 */
+    gboolean nanosecond;      /* pcap 时间戳为纳秒 */
+    guint n_ifaces;           /* 当前 pcapng 段的接口数 */
+    guint16 if_linktype[UDPJSON_PCAP_MAX_INTERFACES]; /* 各接口链路层类型 */
+    guint8 if_tsresol[UDPJSON_PCAP_MAX_INTERFACES];   /* 各接口时间戳精度 */
+    guint64 last_ts_ns;       /* 上一个报文的时间（SPB 无时间戳时沿用） */
+    UdpJsonPcapStats stats;   /* 读取统计 */
+};
+
+/**
+ * @brief 按文件字节序读取 16 位整数
+ */
+static inline guint16 udpjson_pcap_u16(const UdpJsonPcapReader *reader, const guint8 *p)
+{
+    guint16 v;
+    memcpy(&v, p, sizeof(v));
+    return reader->swap ? GUINT16_SWAP_LE_BE(v) : v;
+}
+
+/**
+ * @brief 按文件字节序读取 32 位整数
+ */
+static inline guint32 udpjson_pcap_u32(const UdpJsonPcapReader *reader, const guint8 *p)
+{
+    guint32 v;
+    memcpy(&v, p, sizeof(v));
+    return reader->swap ? GUINT32_SWAP_LE_BE(v) : v;
+}
+
+/**
+ * @brief 读取网络字节序 16 位整数
+ */
+static inline guint16 udpjson_pcap_be16(const guint8 *p)
+{
+    return (guint16)((p[0] << 8) | p[1]);
+}
+
+/**
+ * @brief 按 if_tsresol 把 pcapng 时间戳换算为纳秒
+ *
+ * 最高位为 0 时精度为 10^-n 秒，为 1 时为 2^-n 秒；缺省为微秒。
+ */
+static guint64 udpjson_pcapng_ts_ns(guint64 ts, guint8 tsresol)
+{
+    guint n = tsresol & 0x7F;
+
+    if (tsresol & 0x80)
+    {
+        if (n >= 64)
+            return 0;
+        return (ts >> n) * G_GUINT64_CONSTANT(1000000000) +
+               (((ts & ((G_GUINT64_CONSTANT(1) << n) - 1)) * G_GUINT64_CONSTANT(1000000000)) >> n);
+    }
+    if (n <= 9)
+    {
+        for (; n < 9; n++)
+            ts *= 10;
+        return ts;
+    }
+    for (; n > 9; n--)
+        ts /= 10;
+    return ts;
+}
+
+/**
+ * @brief 从链路层帧中取出 IPv4/UDP 负载
+ *
+ * @param reader 读取器（统计）
+ * @param linktype 链路层类型
+ * @param frame 帧数据
+ * @param caplen 抓包长度
+ * @param ts_ns 抓包时间
+ * @param dgram 输出报文
+ * @return 是 UDP 报文返回 TRUE
+ */
+static gboolean udpjson_pcap_decode(UdpJsonPcapReader *reader, guint linktype, const guint8 *frame,
+                                    gsize caplen, guint64 ts_ns, UdpJsonPcapDatagram *dgram)
+{
+    guint16 ethertype = 0x0800; /* 网络层协议 */
+    gsize off = 0; /* IP 头偏移 */
+    const guint8 *ip = NULL;
+    const guint8 *udp = NULL;
+    gsize ihl = 0;
+    gsize udp_len = 0;
+
+    switch (linktype)
+    {
+    case UDPJSON_LINKTYPE_ETHERNET:
+        if (caplen < 14)
+            goto truncated;
+        ethertype = udpjson_pcap_be16(frame + 12);
+        off = 14;
+        /* 802.1Q / 802.1ad 标签 */
+        while ((ethertype == 0x8100 || ethertype == 0x88A8) && caplen >= off + 4)
+        {
+            ethertype = udpjson_pcap_be16(frame + off + 2);
+            off += 4;
+        }
+        break;
+    case UDPJSON_LINKTYPE_LINUX_SLL:
+        if (caplen < 16)
+            goto truncated;
+        ethertype = udpjson_pcap_be16(frame + 14);
+        off = 16;
+        break;
+    case UDPJSON_LINKTYPE_LINUX_SLL2:
+        if (caplen < 20)
+            goto truncated;
+        ethertype = udpjson_pcap_be16(frame);
+        off = 20;
+        break;
+    case UDPJSON_LINKTYPE_NULL:
+    case UDPJSON_LINKTYPE_LOOP:
+        /* 4 字节地址族，NULL 为抓包主机字节序，LOOP 为网络字节序；AF_INET 都是 2 */
+        if (caplen < 4)
+            goto truncated;
+        if (!(frame[0] == 2 && frame[3] == 0) && !(frame[0] == 0 && frame[3] == 2))
+            goto non_udp;
+        off = 4;
+        break;
+    case UDPJSON_LINKTYPE_RAW:
+    case UDPJSON_LINKTYPE_IPV4:
+        break;
+    default:
+        goto non_udp;
+    }
+
+    if (ethertype != 0x0800)
+        goto non_udp;
+    if (caplen < off + 20)
+        goto truncated;
+    ip = frame + off;
+    ihl = (gsize)(ip[0] & 0x0F) * 4;
+    if ((ip[0] >> 4) != 4 || ihl < 20 || ip[9] != 17)
+        goto non_udp;
+    /* MF 标志或片偏移非 0：不重组 */
+    if (udpjson_pcap_be16(ip + 6) & 0x3FFF)
+    {
+        reader->stats.fragments++;
+        return FALSE;
+    }
+    if (caplen < off + ihl + 8)
+        goto truncated;
+    udp = ip + ihl;
+    udp_len = udpjson_pcap_be16(udp + 4);
+    /* 以 UDP 长度为准，忽略以太网填充 */
+    if (udp_len < 8 || caplen < off + ihl + udp_len)
+        goto truncated;
+
+    dgram->ts_ns = ts_ns;
+    memcpy(&dgram->src_addr, ip + 12, sizeof(dgram->src_addr));
+    memcpy(&dgram->dst_addr, ip + 16, sizeof(dgram->dst_addr));
+    dgram->src_port = udpjson_pcap_be16(udp);
+    dgram->dst_port = udpjson_pcap_be16(udp + 2);
+    dgram->payload = (const gchar *)(udp + 8);
+    dgram->len = udp_len - 8;
+    reader->stats.datagrams++;
+    return TRUE;
+
+truncated:
+    reader->stats.truncated++;
+    return FALSE;
+non_udp:
+    reader->stats.non_udp++;
+    return FALSE;
+}
+
+/**
+ * @brief 读取一个 pcapng 块
+ *
+ * @return 文件结束或格式错误返回 FALSE；块不是报文时 *got 为 FALSE
+ */
+static gboolean udpjson_pcapng_block(UdpJsonPcapReader *reader, UdpJsonPcapDatagram *dgram,
+                                     gboolean *got)
+{
+    const guint8 *block = reader->data + reader->pos;
+    const guint8 *body = block + 8;
+    guint32 type = 0;
+    guint32 total = 0;
+
+    *got = FALSE;
+    if (reader->size - reader->pos < 12)
+        return FALSE;
+
+    memcpy(&type, block, sizeof(type));
+    if (type == UDPJSON_PCAPNG_SHB)
+    {
+        /* 新的段：字节序以段内魔数为准，接口表清空 */
+        guint32 bom = 0;
+        memcpy(&bom, body, sizeof(bom));
+        if (bom == UDPJSON_PCAPNG_BYTE_ORDER)
+            reader->swap = FALSE;
+        else if (GUINT32_SWAP_LE_BE(bom) == UDPJSON_PCAPNG_BYTE_ORDER)
+            reader->swap = TRUE;
+        else
+            return FALSE;
+        reader->n_ifaces = 0;
+    }
+    type = udpjson_pcap_u32(reader, block);
+    total = udpjson_pcap_u32(reader, block + 4);
+    if (total < 12 || total % 4 != 0 || total > reader->size - reader->pos)
+        return FALSE;
+
+    if (type == UDPJSON_PCAPNG_IDB && total >= 20 && reader->n_ifaces < UDPJSON_PCAP_MAX_INTERFACES)
+    {
+        const guint8 *opt = body + 8;
+        const guint8 *end = block + total - 4;
+        guint i = reader->n_ifaces++;
+
+        reader->if_linktype[i] = udpjson_pcap_u16(reader, body);
+        reader->if_tsresol[i] = 6;
+        while (opt + 4 <= end)
+        {
+            guint16 code = udpjson_pcap_u16(reader, opt);
+            guint16 len = udpjson_pcap_u16(reader, opt + 2);
+            if (code == 0 || opt + 4 + len > end)
+                break;
+            if (code == UDPJSON_PCAPNG_OPT_TSRESOL && len >= 1)
+                reader->if_tsresol[i] = opt[4];
+            opt += 4 + ((len + 3) & ~3u);
+        }
+    }
+    else if (type == UDPJSON_PCAPNG_EPB && total >= 32)
+    {
+        guint32 iface = udpjson_pcap_u32(reader, body);
+        guint64 ts = ((guint64)udpjson_pcap_u32(reader, body + 4) << 32) |
+                     udpjson_pcap_u32(reader, body + 8);
+        guint32 caplen = udpjson_pcap_u32(reader, body + 12);
+
+        reader->stats.packets++;
+        if (iface >= reader->n_ifaces || caplen > total - 32)
+            reader->stats.truncated++;
+        else
+        {
+            reader->last_ts_ns = udpjson_pcapng_ts_ns(ts, reader->if_tsresol[iface]);
+            *got = udpjson_pcap_decode(reader, reader->if_linktype[iface], body + 20, caplen,
+                                       reader->last_ts_ns, dgram);
+        }
+    }
+    else if (type == UDPJSON_PCAPNG_SPB && total >= 16)
+    {
+        guint32 caplen = MIN(udpjson_pcap_u32(reader, body), total - 16);
+
+        reader->stats.packets++;
+        if (reader->n_ifaces == 0)
+            reader->stats.truncated++;
+        else
+            *got = udpjson_pcap_decode(reader, reader->if_linktype[0], body + 4, caplen,
+                                       reader->last_ts_ns, dgram);
+    }
+
+    reader->pos += total;
+    return TRUE;
+}
+
+UdpJsonPcapReader *udpjson_pcap_open(const gchar *path)
+{
+    UdpJsonPcapReader *reader = NULL;
+    GMappedFile *file = g_mapped_file_new(path, FALSE, NULL);
+    guint32 magic = 0;
+
+    if (!file)
+    {
+        GST_WARNING("Cannot open capture file %s", path);
+        return NULL;
+    }
+
+    reader = (UdpJsonPcapReader *)g_malloc0(sizeof(UdpJsonPcapReader));
+    reader->file = file;
+    reader->data = (const guint8 *)g_mapped_file_get_contents(file);
+    reader->size = g_mapped_file_get_length(file);
+    if (reader->size < 24)
+        goto invalid;
+
+    memcpy(&magic, reader->data, sizeof(magic));
+    if (magic == UDPJSON_PCAPNG_SHB)
+    {
+        reader->ng = TRUE;
+        reader->start = 0;
+    }
+    else
+    {
+        if (magic == GUINT32_SWAP_LE_BE(UDPJSON_PCAP_MAGIC_US) ||
+            magic == GUINT32_SWAP_LE_BE(UDPJSON_PCAP_MAGIC_NS))
+        {
+            reader->swap = TRUE;
+            magic = GUINT32_SWAP_LE_BE(magic);
+        }
+        if (magic != UDPJSON_PCAP_MAGIC_US && magic != UDPJSON_PCAP_MAGIC_NS)
+            goto invalid;
+        reader->nanosecond = magic == UDPJSON_PCAP_MAGIC_NS;
+        reader->linktype = udpjson_pcap_u32(reader, reader->data + 20) & 0x0FFFFFFF;
+        reader->start = 24;
+    }
+    reader->pos = reader->start;
+    return reader;
+
+invalid:
+    GST_WARNING("%s is not a pcap or pcapng file", path);
+    udpjson_pcap_close(reader);
+    return NULL;
+}
+
+void udpjson_pcap_close(UdpJsonPcapReader *reader)
+{
+    if (!reader)
+        return;
+    g_mapped_file_unref(reader->file);
+    g_free(reader);
+}
+
+gboolean udpjson_pcap_next(UdpJsonPcapReader *reader, UdpJsonPcapDatagram *dgram)
+{
+    gboolean got = FALSE;
+
+    while (!got)
+    {
+        if (reader->ng)
+        {
+            if (!udpjson_pcapng_block(reader, dgram, &got))
+                return FALSE;
+        }
+        else
+        {
+            const guint8 *rec = reader->data + reader->pos;
+            guint32 caplen = 0;
+            guint64 ts_ns = 0;
+
+            if (reader->size - reader->pos < 16)
+                return FALSE;
+            caplen = udpjson_pcap_u32(reader, rec + 8);
+            if (caplen > reader->size - reader->pos - 16)
+                return FALSE;
+            ts_ns = (guint64)udpjson_pcap_u32(reader, rec) * G_GUINT64_CONSTANT(1000000000) +
+                    (guint64)udpjson_pcap_u32(reader, rec + 4) * (reader->nanosecond ? 1 : 1000);
+            reader->pos += 16 + (gsize)caplen;
+            reader->stats.packets++;
+            got = udpjson_pcap_decode(reader, reader->linktype, rec + 16, caplen, ts_ns, dgram);
+        }
+    }
+    return TRUE;
+}
+
+void udpjson_pcap_rewind(UdpJsonPcapReader *reader)
+{
+    reader->pos = reader->start;
+    reader->n_ifaces = 0;
+}
+
+void udpjson_pcap_get_stats(UdpJsonPcapReader *reader, UdpJsonPcapStats *stats)
+{
+    *stats = reader->stats;
+}
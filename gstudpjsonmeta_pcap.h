@@ -0,0 +1,84 @@
+#ifndef __GST_UDPJSON_META_PCAP_H__
+#define __GST_UDPJSON_META_PCAP_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief 抓包文件中的一个 UDP 报文（payload 指向映射的文件内容）
+ */
+typedef struct
+{
+    guint64 ts_ns;            /* 抓包时间(纳秒，UNIX 纪元) */
+    guint32 src_addr;         /* 源 IPv4 地址(网络字节序) */
+    guint32 dst_addr;         /* 目的 IPv4 地址(网络字节序) */
+    guint16 src_port;         /* 源端口(主机字节序) */
+    guint16 dst_port;         /* 目的端口(主机字节序) */
+    const gchar *payload;     /* UDP 负载 */
+    gsize len;                /* 负载长度 */
+} UdpJsonPcapDatagram;
+
+/**
+ * @brief 抓包文件读取统计
+ */
+typedef struct
+{
+    guint64 packets;          /* 读到的抓包记录数 */
+    guint64 datagrams;        /* 返回的 UDP 报文数 */
+    guint64 non_udp;          /* 非 IPv4/UDP 记录数 */
+    guint64 fragments;        /* IP 分片（不重组） */
+    guint64 truncated;        /* 抓包长度不足、无法取出完整负载的记录数 */
+} UdpJsonPcapStats;
+
+/**
+ * @brief 抓包文件读取器
+ *
+ * 支持 pcap（微秒/纳秒时间戳，任意字节序）与 pcapng（SHB/IDB/EPB/SPB），
+ * 链路层支持 Ethernet（含 VLAN）、Linux cooked (SLL/SLL2)、BSD loopback 与 raw IP。
+ * 文件整体映射到内存，报文不复制。
+ */
+typedef struct _UdpJsonPcapReader UdpJsonPcapReader;
+
+/**
+ * @brief 打开抓包文件
+ *
+ * @param path 文件路径
+ * @return 读取器，文件无法读取或格式不支持时返回 NULL
+ */
+UdpJsonPcapReader *udpjson_pcap_open(const gchar *path);
+
+/**
+ * @brief 关闭读取器
+ *
+ * @param reader 读取器（可为 NULL）
+ */
+void udpjson_pcap_close(UdpJsonPcapReader *reader);
+
+/**
+ * @brief 读取下一个 UDP 报文（跳过其他记录）
+ *
+ * @param reader 读取器
+ * @param dgram 输出报文，负载在读取器关闭前有效
+ * @return 读到报文返回 TRUE，文件结束或格式错误返回 FALSE
+ */
+gboolean udpjson_pcap_next(UdpJsonPcapReader *reader, UdpJsonPcapDatagram *dgram);
+
+/**
+ * @brief 回到文件开头（统计不清零）
+ *
+ * @param reader 读取器
+ */
+void udpjson_pcap_rewind(UdpJsonPcapReader *reader);
+
+/**
+ * @brief 获取读取统计
+ *
+ * @param reader 读取器
+ * @param stats 输出统计
+ */
+void udpjson_pcap_get_stats(UdpJsonPcapReader *reader, UdpJsonPcapStats *stats);
+
+G_END_DECLS
+
+#endif /* __GST_UDPJSON_META_PCAP_H__ */
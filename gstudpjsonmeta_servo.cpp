@@ -0,0 +1,72 @@
+#include "gstudpjsonmeta_servo.h"
+#include <math.h>
+#include <string.h>
+
+void udpjson_servo_stage_reset(UdpJsonServoStage *stage)
+{
+    if (!stage)
+        return;
+    stage->has_value = FALSE;
+    stage->filt_h = 0;
+    stage->filt_v = 0;
+}
+
+/**
+ * @brief 脱靶量四舍五入并限幅到 gint16
+ */
+static gint16 udpjson_servo_to_pixels(gdouble v)
+{
+    v = round(v);
+    return (gint16)CLAMP(v, (gdouble)G_MININT16, (gdouble)G_MAXINT16);
+}
+
+gboolean udpjson_servo_stage_update(UdpJsonServoStage *stage, gdouble err_h, gdouble err_v,
+                                    gdouble smoothing, gdouble max_rate_hz, guint8 dev_id,
+                                    guint8 mode, guint64 now_us, CUAVServoControl *servo)
+{
+    if (!stage || !servo)
+        return FALSE;
+
+    if (smoothing <= 0 || smoothing > 1)
+        smoothing = 1;
+
+    if (!stage->has_value)
+    {
+        stage->filt_h = err_h;
+        stage->filt_v = err_v;
+        stage->has_value = TRUE;
+    }
+    else
+    {
+        stage->filt_h += smoothing * (err_h - stage->filt_h);
+        stage->filt_v += smoothing * (err_v - stage->filt_v);
+    }
+
+    if (max_rate_hz > 0 && stage->last_send_us > 0 &&
+        (gdouble)(now_us - stage->last_send_us) < 1e6 / max_rate_hz)
+        return FALSE;
+
+    memset(servo, 0, sizeof(CUAVServoControl));
+    servo->dev_id = dev_id;
+    servo->dev_en = 1;
+    servo->ctrl_en = 1;
+    servo->mode_h = mode;
+    servo->mode_v = mode;
+    servo->offset_en = 1;
+    servo->offset_h = udpjson_servo_to_pixels(stage->filt_h);
+    servo->offset_v = udpjson_servo_to_pixels(stage->filt_v);
+
+    stage->last_send_us = now_us;
+    return TRUE;
+}
+
+void udpjson_servo_stage_record_latency(UdpJsonServoStage *stage, guint64 latency_us)
+{
+    if (!stage)
+        return;
+    stage->commands++;
+    stage->last_latency_us = latency_us;
+    stage->sum_latency_us += latency_us;
+    if (latency_us > stage->max_latency_us)
+        stage->max_latency_us = latency_us;
+}
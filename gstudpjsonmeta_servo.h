@@ -0,0 +1,71 @@
+#ifndef __GST_UDPJSON_META_SERVO_H__
+#define __GST_UDPJSON_META_SERVO_H__
+
+#include <glib.h>
+#include "gstudpjsonmeta_cuav.h"
+
+G_BEGIN_DECLS
+
+/* 0x7204 默认控制的设备 dev_id：2=可见光与红外 */
+#define UDPJSON_SERVO_DEFAULT_DEV_ID 2
+
+/* 0x7204 默认水平/垂直控制模式 mode_h/mode_v：1=跟踪 */
+#define UDPJSON_SERVO_DEFAULT_MODE 1
+
+/**
+ * @brief 脱靶量伺服输出级状态
+ *
+ * 对每帧的脱靶量做一阶低通平滑，并按最大速率限制 0x7204 的输出。
+ * 仅在流线程中访问，不加锁。
+ */
+typedef struct
+{
+    gboolean has_value;       /* 滤波器是否已有初值 */
+    gdouble filt_h;           /* 平滑后的水平脱靶量(像素) */
+    gdouble filt_v;           /* 平滑后的垂直脱靶量(像素) */
+    guint64 last_send_us;     /* 上次输出时间(微秒) */
+    guint64 commands;         /* 已输出指令数 */
+    guint64 last_latency_us;  /* 最近一次帧采集到指令发出的延迟(微秒) */
+    guint64 max_latency_us;   /* 最大延迟(微秒) */
+    guint64 sum_latency_us;   /* 延迟累计(微秒)，用于求平均 */
+} UdpJsonServoStage;
+
+/**
+ * @brief 重置输出级（目标丢失时调用），保留统计
+ *
+ * @param stage 输出级
+ */
+void udpjson_servo_stage_reset(UdpJsonServoStage *stage);
+
+/**
+ * @brief 输入一帧脱靶量，判断是否需要输出伺服指令
+ *
+ * 输出的指令上电并使能控制与脱靶量（dev_en、ctrl_en、offset_en 为 1），
+ * 水平与垂直使用同一控制模式，不设置速度与位置。
+ *
+ * @param stage 输出级
+ * @param err_h 水平脱靶量(像素)，右为正
+ * @param err_v 垂直脱靶量(像素)，下为正
+ * @param smoothing 平滑系数 (0,1]，1 表示不平滑
+ * @param max_rate_hz 最大输出频率，0 表示不限
+ * @param dev_id 控制的设备：0=可见光 1=红外 2=两者
+ * @param mode 水平/垂直控制模式：0=手动 1=跟踪
+ * @param now_us 当前时间(微秒)
+ * @param servo 输出的伺服控制
+ * @return 需要发送时返回 TRUE
+ */
+gboolean udpjson_servo_stage_update(UdpJsonServoStage *stage, gdouble err_h, gdouble err_v,
+                                    gdouble smoothing, gdouble max_rate_hz, guint8 dev_id,
+                                    guint8 mode, guint64 now_us, CUAVServoControl *servo);
+
+/**
+ * @brief 记录一次帧采集到指令发出的延迟
+ *
+ * @param stage 输出级
+ * @param latency_us 延迟(微秒)
+ */
+void udpjson_servo_stage_record_latency(UdpJsonServoStage *stage, guint64 latency_us);
+
+G_END_DECLS
+
+#endif /* __GST_UDPJSON_META_SERVO_H__ */
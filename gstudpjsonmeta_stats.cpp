@@ -0,0 +1,372 @@
+#include "gstudpjsonmeta_stats.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief 计数器在统计结构体中的位置
+ */
+typedef struct
+{
+    const gchar *group;       /* 子结构体名 */
+    const gchar *field;       /* 字段名 */
+    const gchar *prom;        /* Prometheus 指标名与标签 */
+} UdpJsonStatDesc;
+
+static const UdpJsonStatDesc udpjson_stat_descs[UDPJSON_STAT_COUNT] = {
+    {"socket-json", "packets", "udpjsonmeta_packets_total{socket=\"json\"}"},
+    {"socket-json", "bytes", "udpjsonmeta_bytes_total{socket=\"json\"}"},
+    {"socket-cuav", "packets", "udpjsonmeta_packets_total{socket=\"cuav\"}"},
+    {"socket-cuav", "bytes", "udpjsonmeta_bytes_total{socket=\"cuav\"}"},
+    {"socket-cuav-ctrl", "packets", "udpjsonmeta_packets_total{socket=\"cuav_ctrl\"}"},
+    {"socket-cuav-ctrl", "bytes", "udpjsonmeta_bytes_total{socket=\"cuav_ctrl\"}"},
+    {"recv", "errors", "udpjsonmeta_recv_errors_total"},
+    {"dedup", "duplicates", "udpjsonmeta_dedup_duplicates_total"},
+    {"parse", "ok", "udpjsonmeta_parse_total{result=\"ok\"}"},
+    {"parse", "failures", "udpjsonmeta_parse_total{result=\"invalid_json\"}"},
+    {"parse", "missing-fields", "udpjsonmeta_parse_total{result=\"missing_fields\"}"},
+    {"parse", "not-in-demand", "udpjsonmeta_parse_total{result=\"not_in_demand\"}"},
+    {"cuav", "parsed", "udpjsonmeta_cuav_parse_total{result=\"ok\"}"},
+    {"cuav", "failures", "udpjsonmeta_cuav_parse_total{result=\"failure\"}"},
+    {"cache", "updates", "udpjsonmeta_cache_updates_total"},
+    {"cache", "evictions", "udpjsonmeta_cache_evictions_total"},
+    {"cache", "evicted-entries", "udpjsonmeta_cache_evicted_entries_total"},
+    {"journal", "records", "udpjsonmeta_journal_records_total{result=\"written\"}"},
+    {"journal", "dropped", "udpjsonmeta_journal_records_total{result=\"dropped\"}"},
+    {"attach", "frames", "udpjsonmeta_frames_total"},
+    {"attach", "objects", "udpjsonmeta_objects_total"},
+    {"attach", "cache-hits", "udpjsonmeta_lookups_total{result=\"hit\"}"},
+    {"attach", "cache-misses", "udpjsonmeta_lookups_total{result=\"miss\"}"},
+    {"attach", "cache-stale", "udpjsonmeta_lookups_total{result=\"stale\"}"},
+    {"attach", "metas", "udpjsonmeta_attached_metas_total{kind=\"object\"}"},
+    {"attach", "eo-metas", "udpjsonmeta_attached_metas_total{kind=\"eo\"}"},
+};
+
+/* 直方图在统计结构体中的子结构体名 */
+static const gchar *udpjson_hist_names[UDPJSON_HIST_COUNT] = {
+    "latency-recv-parse",
+    "latency-parse-publish",
+    "latency-attach-age",
+    "latency-transform",
+};
+
+/* 直方图的 Prometheus stage 标签 */
+static const gchar *udpjson_hist_prom_stages[UDPJSON_HIST_COUNT] = {
+    "recv_parse",
+    "parse_publish",
+    "attach_age",
+    "transform",
+};
+
+UdpJsonStats *udpjson_stats_new(void)
+{
+    void *mem = NULL;
+
+    if (posix_memalign(&mem, UDPJSON_CACHE_LINE, sizeof(UdpJsonStats)) != 0)
+        return NULL;
+    memset(mem, 0, sizeof(UdpJsonStats));
+    g_mutex_init(&((UdpJsonStats *)mem)->reset_lock);
+    return (UdpJsonStats *)mem;
+}
+
+void udpjson_stats_free(UdpJsonStats *stats)
+{
+    if (!stats)
+        return;
+    g_mutex_clear(&stats->reset_lock);
+    free(stats);
+}
+
+/**
+ * @brief 桶内的最大值
+ */
+static guint64 udpjson_hist_bucket_high(guint idx)
+{
+    guint exp;
+    guint64 low;
+
+    if (idx < UDPJSON_HIST_SUB_BUCKETS)
+        return idx;
+    if (idx == UDPJSON_HIST_BUCKETS - 1)
+        return G_MAXUINT64;
+    exp = idx / UDPJSON_HIST_SUB_BUCKETS + UDPJSON_HIST_SUB_BITS - 1;
+    low = (guint64)(UDPJSON_HIST_SUB_BUCKETS + idx % UDPJSON_HIST_SUB_BUCKETS)
+          << (exp - UDPJSON_HIST_SUB_BITS);
+    return low + ((guint64)1 << (exp - UDPJSON_HIST_SUB_BITS)) - 1;
+}
+
+/**
+ * @brief 读取直方图相对清零基线的增量（调用方持有 reset_lock）
+ */
+static guint64 udpjson_hist_delta(UdpJsonStats *stats, UdpJsonHist hist, guint64 *buckets,
+                                  guint64 *sum)
+{
+    UdpJsonHistogram *h = &stats->hists[hist];
+    UdpJsonHistogramBase *base = &stats->hist_base[hist];
+    guint64 count = __atomic_load_n(&h->count, __ATOMIC_ACQUIRE);
+
+    *sum = __atomic_load_n(&h->sum, __ATOMIC_RELAXED) - base->sum;
+    for (guint i = 0; i < UDPJSON_HIST_BUCKETS; i++)
+        buckets[i] = __atomic_load_n(&h->buckets[i], __ATOMIC_RELAXED) - base->buckets[i];
+    return count - base->count;
+}
+
+void udpjson_stats_hist_summary(UdpJsonStats *stats, UdpJsonHist hist,
+                                UdpJsonHistSummary *summary)
+{
+    static const gdouble quantiles[4] = {0.50, 0.90, 0.99, 0.999};
+    guint64 *outs[4] = {&summary->p50, &summary->p90, &summary->p99, &summary->p999};
+    guint64 buckets[UDPJSON_HIST_BUCKETS]; /* 各桶增量 */
+    guint64 sum = 0; /* 样本和增量 */
+    guint64 total = 0; /* 桶计数合计 */
+    guint64 seen = 0; /* 累计计数 */
+    guint q = 0;
+
+    memset(summary, 0, sizeof(*summary));
+    if (!stats)
+        return;
+
+    g_mutex_lock(&stats->reset_lock);
+    /* 接收线程的直方图由共享接收器记录 */
+    if (stats->upstream && hist < UDPJSON_HIST_ATTACH_AGE)
+    {
+        udpjson_stats_hist_summary(stats->upstream, hist, summary);
+        g_mutex_unlock(&stats->reset_lock);
+        return;
+    }
+    summary->count = udpjson_hist_delta(stats, hist, buckets, &sum);
+    g_mutex_unlock(&stats->reset_lock);
+
+    /* 写入方不停止，桶合计可能略大于 count，按桶合计计算分位数 */
+    for (guint i = 0; i < UDPJSON_HIST_BUCKETS; i++)
+        total += buckets[i];
+    if (total == 0)
+        return;
+
+    summary->sum = sum;
+    summary->mean = sum / total;
+    for (guint i = 0; i < UDPJSON_HIST_BUCKETS && q < 4; i++)
+    {
+        seen += buckets[i];
+        while (q < 4 && (gdouble)seen >= quantiles[q] * (gdouble)total)
+            *outs[q++] = udpjson_hist_bucket_high(i);
+    }
+    for (guint i = UDPJSON_HIST_BUCKETS; i > 0; i--)
+    {
+        if (buckets[i - 1])
+        {
+            summary->max = MIN(udpjson_hist_bucket_high(i - 1),
+                               __atomic_load_n(&stats->hists[hist].max, __ATOMIC_RELAXED));
+            break;
+        }
+    }
+}
+
+void udpjson_stats_reset_histograms(UdpJsonStats *stats)
+{
+    if (!stats)
+        return;
+    g_mutex_lock(&stats->reset_lock);
+    for (guint h = 0; h < UDPJSON_HIST_COUNT; h++)
+    {
+        UdpJsonHistogram *hist = &stats->hists[h];
+        UdpJsonHistogramBase *base = &stats->hist_base[h];
+
+        base->count = __atomic_load_n(&hist->count, __ATOMIC_ACQUIRE);
+        base->sum = __atomic_load_n(&hist->sum, __ATOMIC_RELAXED);
+        for (guint i = 0; i < UDPJSON_HIST_BUCKETS; i++)
+            base->buckets[i] = __atomic_load_n(&hist->buckets[i], __ATOMIC_RELAXED);
+    }
+    udpjson_stats_reset_histograms(stats->upstream);
+    g_mutex_unlock(&stats->reset_lock);
+}
+
+void udpjson_stats_set_upstream(UdpJsonStats *stats, UdpJsonStats *upstream)
+{
+    g_mutex_lock(&stats->reset_lock);
+    stats->upstream = upstream;
+    g_mutex_unlock(&stats->reset_lock);
+}
+
+void udpjson_stats_sum(const UdpJsonStats *stats, guint64 *out)
+{
+    GMutex *lock = NULL; /* 保护 upstream */
+
+    memset(out, 0, sizeof(guint64) * UDPJSON_STAT_COUNT);
+    if (!stats)
+        return;
+    for (guint s = 0; s < UDPJSON_STATS_SHARD_COUNT; s++)
+    {
+        for (guint i = 0; i < UDPJSON_STAT_COUNT; i++)
+            out[i] += __atomic_load_n(&stats->shards[s].v[i], __ATOMIC_RELAXED);
+    }
+
+    lock = (GMutex *)&stats->reset_lock;
+    g_mutex_lock(lock);
+    if (stats->upstream)
+    {
+        guint64 up[UDPJSON_STAT_COUNT]; /* 共享接收器的计数 */
+        udpjson_stats_sum(stats->upstream, up);
+        for (guint i = 0; i < UDPJSON_STAT_COUNT; i++)
+            out[i] += up[i];
+    }
+    g_mutex_unlock(lock);
+}
+
+GstStructure *udpjson_stats_to_structure(UdpJsonStats *stats)
+{
+    GstStructure *result = gst_structure_new_empty("udpjsonmeta-stats");
+    guint64 sum[UDPJSON_STAT_COUNT];
+    guint i = 0;
+
+    udpjson_stats_sum(stats, sum);
+
+    /* 同组计数器在枚举中相邻，逐组生成子结构体 */
+    while (i < UDPJSON_STAT_COUNT)
+    {
+        const gchar *group = udpjson_stat_descs[i].group;
+        GstStructure *sub = gst_structure_new_empty(group);
+
+        for (; i < UDPJSON_STAT_COUNT && strcmp(udpjson_stat_descs[i].group, group) == 0; i++)
+            gst_structure_set(sub, udpjson_stat_descs[i].field, G_TYPE_UINT64, sum[i], NULL);
+        gst_structure_set(result, group, GST_TYPE_STRUCTURE, sub, NULL);
+        gst_structure_free(sub);
+    }
+
+    for (guint h = 0; h < UDPJSON_HIST_COUNT; h++)
+    {
+        UdpJsonHistSummary summary;
+        GstStructure *sub = NULL;
+
+        udpjson_stats_hist_summary(stats, (UdpJsonHist)h, &summary);
+        sub = gst_structure_new(udpjson_hist_names[h],
+                                "count", G_TYPE_UINT64, summary.count,
+                                "mean-ns", G_TYPE_UINT64, summary.mean,
+                                "p50-ns", G_TYPE_UINT64, summary.p50,
+                                "p90-ns", G_TYPE_UINT64, summary.p90,
+                                "p99-ns", G_TYPE_UINT64, summary.p99,
+                                "p999-ns", G_TYPE_UINT64, summary.p999,
+                                "max-ns", G_TYPE_UINT64, summary.max, NULL);
+        gst_structure_set(result, udpjson_hist_names[h], GST_TYPE_STRUCTURE, sub, NULL);
+        gst_structure_free(sub);
+    }
+    return result;
+}
+
+/**
+ * @brief Prometheus 文本输出缓冲，写满时交给 write_func
+ */
+typedef struct
+{
+    gchar buf[UDPJSON_PROM_CHUNK];    /* 输出缓冲 */
+    gsize len;                        /* 已用长度 */
+    UdpJsonStatsWriteFunc write_func; /* 输出回调 */
+    gpointer user_data;               /* 回调数据 */
+    gboolean ok;                      /* 回调均成功 */
+} UdpJsonPromWriter;
+
+/**
+ * @brief 追加一行，缓冲不足时先输出已有内容
+ */
+static void udpjson_prom_printf(UdpJsonPromWriter *w, const gchar *fmt, ...) G_GNUC_PRINTF(2, 3);
+
+static void udpjson_prom_printf(UdpJsonPromWriter *w, const gchar *fmt, ...)
+{
+    va_list args;
+    gint n = 0;
+
+    if (!w->ok)
+        return;
+    for (guint attempt = 0; attempt < 2; attempt++)
+    {
+        va_start(args, fmt);
+        n = g_vsnprintf(w->buf + w->len, sizeof(w->buf) - w->len, fmt, args);
+        va_end(args);
+        if (n >= 0 && w->len + (gsize)n < sizeof(w->buf))
+        {
+            w->len += (gsize)n;
+            return;
+        }
+        /* 放不下：输出已有内容后重试，单行超过缓冲时截断 */
+        if (w->len == 0)
+        {
+            w->len = sizeof(w->buf) - 1;
+            return;
+        }
+        w->ok = w->write_func(w->buf, w->len, w->user_data);
+        w->len = 0;
+        if (!w->ok)
+            return;
+    }
+}
+
+/**
+ * @brief 判断两条计数器是否属于同一指标（标签之前的名字相同）
+ */
+static gboolean udpjson_prom_same_metric(const gchar *a, const gchar *b, gsize name_len)
+{
+    return strcspn(a, "{") == name_len && strncmp(a, b, name_len) == 0;
+}
+
+gboolean udpjson_stats_write_prometheus(UdpJsonStats *stats, UdpJsonStatsWriteFunc write_func,
+                                        gpointer user_data)
+{
+    static const gchar *quantile_labels[4] = {"0.5", "0.9", "0.99", "0.999"};
+    UdpJsonPromWriter w; /* 输出缓冲 */
+    guint64 sum[UDPJSON_STAT_COUNT]; /* 计数器汇总 */
+
+    if (!stats || !write_func)
+        return FALSE;
+
+    w.len = 0;
+    w.write_func = write_func;
+    w.user_data = user_data;
+    w.ok = TRUE;
+
+    udpjson_stats_sum(stats, sum);
+    /* 同一指标的样本必须相邻：按指标名首次出现的顺序输出 */
+    for (guint i = 0; i < UDPJSON_STAT_COUNT; i++)
+    {
+        const gchar *prom = udpjson_stat_descs[i].prom;
+        gsize name_len = strcspn(prom, "{");
+        gboolean seen = FALSE;
+
+        for (guint j = 0; j < i && !seen; j++)
+            seen = udpjson_prom_same_metric(udpjson_stat_descs[j].prom, prom, name_len);
+        if (seen)
+            continue;
+
+        udpjson_prom_printf(&w, "# TYPE %.*s counter\n", (gint)name_len, prom);
+        for (guint j = i; j < UDPJSON_STAT_COUNT; j++)
+        {
+            if (udpjson_prom_same_metric(udpjson_stat_descs[j].prom, prom, name_len))
+                udpjson_prom_printf(&w, "%s %" G_GUINT64_FORMAT "\n", udpjson_stat_descs[j].prom,
+                                    sum[j]);
+        }
+    }
+
+    udpjson_prom_printf(&w, "# TYPE udpjsonmeta_latency_seconds summary\n");
+    for (guint h = 0; h < UDPJSON_HIST_COUNT; h++)
+    {
+        UdpJsonHistSummary summary; /* 直方图汇总 */
+        const gchar *stage = udpjson_hist_prom_stages[h];
+
+        udpjson_stats_hist_summary(stats, (UdpJsonHist)h, &summary);
+        const guint64 quantiles[4] = {summary.p50, summary.p90, summary.p99, summary.p999};
+        for (guint q = 0; q < 4; q++)
+        {
+            udpjson_prom_printf(&w,
+                                "udpjsonmeta_latency_seconds{stage=\"%s\",quantile=\"%s\"} %.9f\n",
+                                stage, quantile_labels[q], quantiles[q] / 1e9);
+        }
+        udpjson_prom_printf(&w, "udpjsonmeta_latency_seconds_sum{stage=\"%s\"} %.9f\n", stage,
+                            summary.sum / 1e9);
+        udpjson_prom_printf(&w,
+                            "udpjsonmeta_latency_seconds_count{stage=\"%s\"} %" G_GUINT64_FORMAT "\n",
+                            stage, summary.count);
+    }
+
+    if (w.ok && w.len > 0)
+        w.ok = write_func(w.buf, w.len, user_data);
+    return w.ok;
+}
@@ -0,0 +1,301 @@
+#ifndef __GST_UDPJSON_META_STATS_H__
+#define __GST_UDPJSON_META_STATS_H__
+
+#include <glib.h>
+#include <gst/gst.h>
+#include <time.h>
+
+G_BEGIN_DECLS
+
+/* 缓存行大小，计数分片按此对齐避免伪共享 */
+#define UDPJSON_CACHE_LINE 64
+/* Prometheus 文本分块输出的缓冲大小 */
+#define UDPJSON_PROM_CHUNK 2048
+
+/**
+ * @brief 计数器编号，按所属阶段分组
+ */
+typedef enum
+{
+    /* 套接字 */
+    UDPJSON_STAT_JSON_PACKETS = 0,    /* 目标 JSON 端口收包数 */
+    UDPJSON_STAT_JSON_BYTES,          /* 目标 JSON 端口字节数 */
+    UDPJSON_STAT_CUAV_PACKETS,        /* C-UAV 端口收包数 */
+    UDPJSON_STAT_CUAV_BYTES,          /* C-UAV 端口字节数 */
+    UDPJSON_STAT_CUAV_CTRL_PACKETS,   /* C-UAV 控制端口收包数 */
+    UDPJSON_STAT_CUAV_CTRL_BYTES,     /* C-UAV 控制端口字节数 */
+    UDPJSON_STAT_RECV_ERRORS,         /* recvfrom 出错次数 */
+    UDPJSON_STAT_DEDUP_DUPLICATES,    /* 多路冗余接收中丢弃的重复报文数 */
+    /* 目标 JSON 解析 */
+    UDPJSON_STAT_PARSE_OK,            /* 解析并写入缓存的报文数 */
+    UDPJSON_STAT_PARSE_FAILURES,      /* JSON 语法错误或根不是对象 */
+    UDPJSON_STAT_PARSE_MISSING,       /* 缺少 object_id/value 或取值非法 */
+    UDPJSON_STAT_PARSE_NOT_IN_DEMAND, /* 目标不在需求中而跳过解析的报文数 */
+    /* C-UAV 解析 */
+    UDPJSON_STAT_CUAV_PARSED,         /* 解析成功（含被过滤）的报文数 */
+    UDPJSON_STAT_CUAV_FAILURES,       /* 解析失败的报文数 */
+    /* 缓存 */
+    UDPJSON_STAT_CACHE_UPDATES,       /* 缓存写入次数 */
+    UDPJSON_STAT_CACHE_EVICTIONS,     /* 缓存满整体清空次数 */
+    UDPJSON_STAT_CACHE_EVICTED,       /* 整体清空丢弃的条目数 */
+    /* 接收日志 */
+    UDPJSON_STAT_JOURNAL_RECORDS,     /* 写入日志环形缓冲的报文数 */
+    UDPJSON_STAT_JOURNAL_DROPPED,     /* 环形缓冲满而未记录的报文数 */
+    /* 元数据附加 */
+    UDPJSON_STAT_FRAMES,              /* 处理的帧数 */
+    UDPJSON_STAT_OBJECTS,             /* 查询缓存的已跟踪目标数 */
+    UDPJSON_STAT_CACHE_HITS,          /* 缓存命中且未过期 */
+    UDPJSON_STAT_CACHE_MISSES,        /* 缓存未命中 */
+    UDPJSON_STAT_CACHE_STALE,         /* 命中但超过 cache-ttl-ms */
+    UDPJSON_STAT_ATTACHED_METAS,      /* 附加的目标用户元数据数 */
+    UDPJSON_STAT_EO_METAS,            /* 附加的光电状态帧元数据数 */
+    UDPJSON_STAT_COUNT
+} UdpJsonStat;
+
+/* 直方图每个 2 的幂区间划分的子桶位数（16 个子桶，相对误差约 6%） */
+#define UDPJSON_HIST_SUB_BITS 4
+#define UDPJSON_HIST_SUB_BUCKETS (1u << UDPJSON_HIST_SUB_BITS)
+/* 直方图最大可区分的 2 的幂（2^44 纳秒约 4.9 小时），更大的值记入最后一个桶 */
+#define UDPJSON_HIST_MAX_EXP 44
+#define UDPJSON_HIST_BUCKETS ((UDPJSON_HIST_MAX_EXP - UDPJSON_HIST_SUB_BITS + 2) * UDPJSON_HIST_SUB_BUCKETS)
+
+/**
+ * @brief 时延直方图编号
+ */
+typedef enum
+{
+    UDPJSON_HIST_RECV_PARSE = 0,      /* 收到报文到 JSON 解析完成（接收线程） */
+    UDPJSON_HIST_PARSE_PUBLISH,       /* 解析完成到写入缓存（接收线程） */
+    UDPJSON_HIST_ATTACH_AGE,          /* 附加时缓存值的年龄（流线程） */
+    UDPJSON_HIST_TRANSFORM,           /* transform_ip 每批次耗时（流线程） */
+    UDPJSON_HIST_COUNT
+} UdpJsonHist;
+
+/**
+ * @brief 计数分片编号，每个分片只由一个线程写入
+ */
+typedef enum
+{
+    UDPJSON_STATS_SHARD_RECV = 0,     /* 接收线程 */
+    UDPJSON_STATS_SHARD_STREAM,       /* 流线程 (transform_ip) */
+    UDPJSON_STATS_SHARD_COUNT
+} UdpJsonStatsShardId;
+
+/**
+ * @brief 单个线程的计数分片（独占缓存行）
+ */
+typedef struct __attribute__((aligned(UDPJSON_CACHE_LINE)))
+{
+    guint64 v[UDPJSON_STAT_COUNT];
+} UdpJsonStatsShard;
+
+/**
+ * @brief 对数分桶时延直方图（HDR 风格，单位纳秒）
+ *
+ * 只由一个线程写入；清零时把当前计数复制到 base，读取时减去 base，
+ * 写入方不感知清零。
+ */
+typedef struct __attribute__((aligned(UDPJSON_CACHE_LINE)))
+{
+    guint64 count;                            /* 样本数 */
+    guint64 sum;                              /* 样本和 */
+    guint64 max;                              /* 最大值（不随清零复位） */
+    guint64 buckets[UDPJSON_HIST_BUCKETS];    /* 各桶计数 */
+} UdpJsonHistogram;
+
+/**
+ * @brief 直方图清零基线（只由读取方访问）
+ */
+typedef struct
+{
+    guint64 count;
+    guint64 sum;
+    guint64 buckets[UDPJSON_HIST_BUCKETS];
+} UdpJsonHistogramBase;
+
+/**
+ * @brief 计数器集合
+ *
+ * 写入方只写自己的分片，无原子读改写指令；读取时汇总全部分片，
+ * 读取不加锁，不影响写入方。设置 upstream 后，计数器汇总时加上
+ * upstream 的计数，接收线程的两个直方图改读 upstream。
+ */
+typedef struct _UdpJsonStats
+{
+    UdpJsonStatsShard shards[UDPJSON_STATS_SHARD_COUNT];
+    UdpJsonHistogram hists[UDPJSON_HIST_COUNT];   /* 时延直方图 */
+    GMutex reset_lock;                            /* 串行化读取方的清零、汇总与 upstream 切换 */
+    UdpJsonHistogramBase hist_base[UDPJSON_HIST_COUNT]; /* 清零基线 */
+    struct _UdpJsonStats *upstream;               /* 共享接收器的计数，NULL 表示无 */
+} UdpJsonStats;
+
+/**
+ * @brief 直方图汇总结果（纳秒）
+ */
+typedef struct
+{
+    guint64 count;                /* 样本数 */
+    guint64 sum;                  /* 样本和 */
+    guint64 mean;                 /* 平均值 */
+    guint64 p50;                  /* 50 分位 */
+    guint64 p90;                  /* 90 分位 */
+    guint64 p99;                  /* 99 分位 */
+    guint64 p999;                 /* 99.9 分位 */
+    guint64 max;                  /* 最大值（清零后取最高非空桶的上界） */
+} UdpJsonHistSummary;
+
+/**
+ * @brief 创建按缓存行对齐的计数器集合
+ *
+ * @return 计数器集合，用 udpjson_stats_free() 释放
+ */
+UdpJsonStats *udpjson_stats_new(void);
+
+/**
+ * @brief 释放计数器集合
+ *
+ * @param stats 计数器集合
+ */
+void udpjson_stats_free(UdpJsonStats *stats);
+
+/**
+ * @brief 累加计数（只能由分片所属线程调用）
+ *
+ * @param stats 计数器集合
+ * @param shard 调用线程的分片
+ * @param id 计数器
+ * @param n 增量
+ */
+static inline void udpjson_stats_add(UdpJsonStats *stats, UdpJsonStatsShardId shard,
+                                     UdpJsonStat id, guint64 n)
+{
+    guint64 *c = &stats->shards[shard].v[id];
+    __atomic_store_n(c, __atomic_load_n(c, __ATOMIC_RELAXED) + n, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief 单调时钟（纳秒），与 g_get_monotonic_time() 同源
+ */
+static inline guint64 udpjson_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (guint64)ts.tv_sec * 1000000000ull + (guint64)ts.tv_nsec;
+}
+
+/**
+ * @brief 计算样本所在的桶
+ *
+ * 小于 UDPJSON_HIST_SUB_BUCKETS 的值逐个成桶，之后每个 2 的幂区间分为
+ * UDPJSON_HIST_SUB_BUCKETS 个等宽子桶。
+ */
+static inline guint udpjson_hist_bucket(guint64 v)
+{
+    guint exp;
+    guint idx;
+
+    if (v < UDPJSON_HIST_SUB_BUCKETS)
+        return (guint)v;
+    exp = 63 - (guint)__builtin_clzll(v);
+    if (exp > UDPJSON_HIST_MAX_EXP)
+        return UDPJSON_HIST_BUCKETS - 1;
+    idx = (exp - UDPJSON_HIST_SUB_BITS + 1) * UDPJSON_HIST_SUB_BUCKETS +
+          (guint)((v >> (exp - UDPJSON_HIST_SUB_BITS)) & (UDPJSON_HIST_SUB_BUCKETS - 1));
+    return idx;
+}
+
+/**
+ * @brief 记录一个样本（只能由直方图所属线程调用）
+ *
+ * @param stats 计数器集合
+ * @param hist 直方图
+ * @param v 样本值(纳秒)
+ */
+static inline void udpjson_stats_record(UdpJsonStats *stats, UdpJsonHist hist, guint64 v)
+{
+    UdpJsonHistogram *h = &stats->hists[hist];
+    guint64 *b = &h->buckets[udpjson_hist_bucket(v)];
+
+    __atomic_store_n(b, __atomic_load_n(b, __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&h->sum, __atomic_load_n(&h->sum, __ATOMIC_RELAXED) + v, __ATOMIC_RELAXED);
+    if (v > __atomic_load_n(&h->max, __ATOMIC_RELAXED))
+        __atomic_store_n(&h->max, v, __ATOMIC_RELAXED);
+    /* count 最后写入，读取方以 count 为准时桶计数不会少于样本数 */
+    __atomic_store_n(&h->count, __atomic_load_n(&h->count, __ATOMIC_RELAXED) + 1,
+                     __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 汇总直方图自上次清零以来的样本
+ *
+ * @param stats 计数器集合
+ * @param hist 直方图
+ * @param summary 输出汇总
+ */
+void udpjson_stats_hist_summary(UdpJsonStats *stats, UdpJsonHist hist,
+                                UdpJsonHistSummary *summary);
+
+/**
+ * @brief 清零全部直方图（含 upstream，计数器保持单调递增，不清零）
+ *
+ * @param stats 计数器集合
+ */
+void udpjson_stats_reset_histograms(UdpJsonStats *stats);
+
+/**
+ * @brief 设置或清除共享接收器的计数（upstream 须在清除前保持有效）
+ *
+ * @param stats 计数器集合
+ * @param upstream 共享接收器的计数器集合，NULL 表示清除
+ */
+void udpjson_stats_set_upstream(UdpJsonStats *stats, UdpJsonStats *upstream);
+
+/**
+ * @brief 汇总全部分片（含 upstream）
+ *
+ * @param stats 计数器集合
+ * @param out 输出，长度为 UDPJSON_STAT_COUNT
+ */
+void udpjson_stats_sum(const UdpJsonStats *stats, guint64 *out);
+
+/**
+ * @brief 生成统计结构体
+ *
+ * 结构体名为 "udpjsonmeta-stats"，按套接字和处理阶段分为子结构体
+ * (socket-json、socket-cuav、socket-cuav-ctrl、recv、dedup、parse、cuav、cache、journal、
+ * attach)，
+ * 字段均为 guint64；时延直方图为 latency-recv-parse、latency-parse-publish、
+ * latency-attach-age、latency-transform 子结构体，字段 count/mean-ns/p50-ns/
+ * p90-ns/p99-ns/p999-ns/max-ns。
+ *
+ * @param stats 计数器集合
+ * @return 新的 GstStructure，调用方释放
+ */
+GstStructure *udpjson_stats_to_structure(UdpJsonStats *stats);
+
+/**
+ * @brief 文本输出回调
+ *
+ * @param data 文本
+ * @param len 长度
+ * @param user_data 用户数据
+ * @return 成功返回 TRUE，返回 FALSE 时停止输出
+ */
+typedef gboolean (*UdpJsonStatsWriteFunc)(const gchar *data, gsize len, gpointer user_data);
+
+/**
+ * @brief 按 Prometheus 文本格式输出计数器与时延分位数
+ *
+ * 在固定大小的栈缓冲中逐行生成，缓冲写满即交给 write_func，不分配堆内存。
+ *
+ * @param stats 计数器集合
+ * @param write_func 输出回调
+ * @param user_data 回调数据
+ * @return 全部输出成功返回 TRUE
+ */
+gboolean udpjson_stats_write_prometheus(UdpJsonStats *stats, UdpJsonStatsWriteFunc write_func,
+                                        gpointer user_data);
+
+G_END_DECLS
+
+#endif /* __GST_UDPJSON_META_STATS_H__ */
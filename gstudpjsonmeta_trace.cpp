@@ -0,0 +1,124 @@
+#include "gstudpjsonmeta_trace.h"
+
+gint udpjson_tracer_active = 0;
+
+/* stage 字段取值 */
+static const gchar *udpjson_trace_stage_names[UDPJSON_TRACE_STAGE_COUNT] = {
+    "parse",
+    "publish",
+    "attach-age",
+    "transform",
+};
+
+static GstTracerRecord *udpjson_tr_stage = NULL; /* udpjsonmeta-stage 记录格式 */
+
+/**
+ * @brief udpjsonlatency 追踪器
+ *
+ * 不挂任何 GStreamer 钩子，只标记启用状态；udpjsonmeta 元素在启用时
+ * 把内部阶段耗时作为追踪记录输出。
+ */
+typedef struct
+{
+    GstTracer parent;
+} GstUdpJsonLatencyTracer;
+
+typedef struct
+{
+    GstTracerClass parent_class;
+} GstUdpJsonLatencyTracerClass;
+
+G_DEFINE_TYPE(GstUdpJsonLatencyTracer, gst_udpjson_latency_tracer, GST_TYPE_TRACER);
+
+/**
+ * @brief 释放追踪器实例。
+ *
+ * @param object GObject 指针。
+ */
+static void gst_udpjson_latency_tracer_finalize(GObject *object)
+{
+    g_atomic_int_add(&udpjson_tracer_active, -1);
+    G_OBJECT_CLASS(gst_udpjson_latency_tracer_parent_class)->finalize(object);
+}
+
+/**
+ * @brief 初始化追踪器类并定义记录格式。
+ *
+ * @param klass 类指针。
+ */
+static void gst_udpjson_latency_tracer_class_init(GstUdpJsonLatencyTracerClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass); /* GObject 类 */
+
+    gobject_class->finalize = gst_udpjson_latency_tracer_finalize;
+
+    /* 字段与 proctime/latency 记录保持一致，便于 gst-stats 等工具统一处理 */
+    udpjson_tr_stage = gst_tracer_record_new(
+        "udpjsonmeta-stage.class",
+        "thread-id", GST_TYPE_STRUCTURE,
+        gst_structure_new("scope",
+                          "type", G_TYPE_GTYPE, G_TYPE_UINT64,
+                          "related-to", GST_TYPE_TRACER_VALUE_SCOPE, GST_TRACER_VALUE_SCOPE_THREAD,
+                          NULL),
+        "element-id", GST_TYPE_STRUCTURE,
+        gst_structure_new("scope",
+                          "type", G_TYPE_GTYPE, G_TYPE_STRING,
+                          "related-to", GST_TYPE_TRACER_VALUE_SCOPE, GST_TRACER_VALUE_SCOPE_ELEMENT,
+                          NULL),
+        "element", GST_TYPE_STRUCTURE,
+        gst_structure_new("scope",
+                          "type", G_TYPE_GTYPE, G_TYPE_STRING,
+                          "related-to", GST_TYPE_TRACER_VALUE_SCOPE, GST_TRACER_VALUE_SCOPE_ELEMENT,
+                          NULL),
+        "stage", GST_TYPE_STRUCTURE,
+        gst_structure_new("value",
+                          "type", G_TYPE_GTYPE, G_TYPE_STRING,
+                          "description", G_TYPE_STRING,
+                          "internal stage: parse, publish, attach-age or transform",
+                          NULL),
+        "time", GST_TYPE_STRUCTURE,
+        gst_structure_new("value",
+                          "type", G_TYPE_GTYPE, G_TYPE_UINT64,
+                          "description", G_TYPE_STRING, "stage time in ns",
+                          "flags", GST_TYPE_TRACER_VALUE_FLAGS, GST_TRACER_VALUE_FLAGS_AGGREGATED,
+                          "min", G_TYPE_UINT64, G_GUINT64_CONSTANT(0),
+                          "max", G_TYPE_UINT64, G_MAXUINT64,
+                          NULL),
+        "ts", GST_TYPE_STRUCTURE,
+        gst_structure_new("value",
+                          "type", G_TYPE_GTYPE, G_TYPE_UINT64,
+                          "description", G_TYPE_STRING, "ts when the stage finished",
+                          "min", G_TYPE_UINT64, G_GUINT64_CONSTANT(0),
+                          "max", G_TYPE_UINT64, G_MAXUINT64,
+                          NULL),
+        NULL);
+    GST_OBJECT_FLAG_SET(udpjson_tr_stage, GST_OBJECT_FLAG_MAY_BE_LEAKED);
+}
+
+/**
+ * @brief 初始化追踪器实例。
+ *
+ * @param self 追踪器实例。
+ */
+static void gst_udpjson_latency_tracer_init(GstUdpJsonLatencyTracer *self)
+{
+    g_atomic_int_inc(&udpjson_tracer_active);
+}
+
+void udpjson_trace_stage(GstElement *element, UdpJsonTraceStage stage, guint64 time_ns)
+{
+    gchar element_id[32]; /* 元素地址，与 latency 追踪器的 element-id 相同 */
+
+    if (!udpjson_trace_enabled() || !udpjson_tr_stage || stage >= UDPJSON_TRACE_STAGE_COUNT)
+        return;
+
+    g_snprintf(element_id, sizeof(element_id), "%p", (gpointer)element);
+    gst_tracer_record_log(udpjson_tr_stage, (guint64)(guintptr)g_thread_self(), element_id,
+                          GST_OBJECT_NAME(element), udpjson_trace_stage_names[stage], time_ns,
+                          (guint64)gst_util_get_timestamp());
+}
+
+gboolean udpjson_trace_register(GstPlugin *plugin)
+{
+    return gst_tracer_register(plugin, "udpjsonlatency", gst_udpjson_latency_tracer_get_type());
+}
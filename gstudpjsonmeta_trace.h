@@ -0,0 +1,85 @@
+#ifndef __GST_UDPJSON_META_TRACE_H__
+#define __GST_UDPJSON_META_TRACE_H__
+
+#include <glib.h>
+#include <gst/gst.h>
+
+/*
+ * 静态探针 (USDT/SDT)，provider 为 udpjsonmeta。
+ * 编译时定义 UDPJSON_HAVE_SDT（CMake 选项 UDPJSON_ENABLE_SDT 且找到 sys/sdt.h）
+ * 才生成探针，否则全部为空操作；生成的探针未被 perf/bpftrace 挂载时只是一条 nop。
+ *
+ * 探针及参数：
+ *   recv(socket, len)                        socket: 0=目标 JSON 1=C-UAV 2=C-UAV 控制
+ *   parse_start(len)
+ *   parse_end(ok, source_id, object_id)
+ *   cache_publish(source_id, object_id, entries)
+ *   cache_evict(entries)
+ *   transform_start(n_frames)
+ *   transform_end(n_frames, duration_ns)
+ *   attach(source_id, object_id, age_ns)     按 trace-attach-interval 采样
+ *   cuav_dispatch(msg_id, tx_dev_id, handled)
+ *
+ * 例：bpftrace -e 'usdt:./libudpjsonmeta.so:udpjsonmeta:transform_end { @ = hist(arg1); }'
+ */
+#if defined(UDPJSON_HAVE_SDT)
+#include <sys/sdt.h>
+#define UDPJSON_PROBE1(name, a) DTRACE_PROBE1(udpjsonmeta, name, a)
+#define UDPJSON_PROBE2(name, a, b) DTRACE_PROBE2(udpjsonmeta, name, a, b)
+#define UDPJSON_PROBE3(name, a, b, c) DTRACE_PROBE3(udpjsonmeta, name, a, b, c)
+#else
+#define UDPJSON_PROBE1(name, a) do { } while (0)
+#define UDPJSON_PROBE2(name, a, b) do { } while (0)
+#define UDPJSON_PROBE3(name, a, b, c) do { } while (0)
+#endif
+
+G_BEGIN_DECLS
+
+/**
+ * @brief 内部处理阶段，对应 udpjsonmeta-stage 追踪记录的 stage 字段
+ */
+typedef enum
+{
+    UDPJSON_TRACE_STAGE_PARSE = 0,    /* 收到报文到 JSON 解析完成 */
+    UDPJSON_TRACE_STAGE_PUBLISH,      /* 解析完成到写入缓存 */
+    UDPJSON_TRACE_STAGE_ATTACH_AGE,   /* 附加时缓存值的年龄（采样） */
+    UDPJSON_TRACE_STAGE_TRANSFORM,    /* transform_ip 每批次耗时 */
+    UDPJSON_TRACE_STAGE_COUNT
+} UdpJsonTraceStage;
+
+/* 是否有 udpjsonlatency 追踪器实例，热路径先检查它再调用 udpjson_trace_stage */
+extern gint udpjson_tracer_active;
+
+/**
+ * @brief 判断 udpjsonlatency 追踪器是否启用
+ */
+static inline gboolean udpjson_trace_enabled(void)
+{
+    return g_atomic_int_get(&udpjson_tracer_active) > 0;
+}
+
+/**
+ * @brief 记录一次阶段耗时
+ *
+ * 以 udpjsonmeta-stage 记录输出到 GST_TRACER 日志，与 latency、proctime
+ * 追踪器的记录使用同一时间轴 (ts 为 gst_util_get_timestamp())。
+ *
+ * @param element 元素
+ * @param stage 阶段
+ * @param time_ns 耗时(纳秒)
+ */
+void udpjson_trace_stage(GstElement *element, UdpJsonTraceStage stage, guint64 time_ns);
+
+/**
+ * @brief 注册 udpjsonlatency 追踪器
+ *
+ * 使用：GST_TRACERS="latency;udpjsonlatency" GST_DEBUG="GST_TRACER:7"
+ *
+ * @param plugin 插件
+ * @return 成功返回 TRUE
+ */
+gboolean udpjson_trace_register(GstPlugin *plugin);
+
+G_END_DECLS
+
+#endif /* __GST_UDPJSON_META_TRACE_H__ */
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""
+比较两次 udpjsonmeta_bench 输出（JSON Lines 或 CSV）
+
+按 bench/case 对齐，列出每个用例的 p50 与均值变化；任一用例变慢超过
+阈值时以退出码 1 结束，便于在 CI 中拦截性能回退。udpjsonmeta_replay 的输出
+还带有解析计数与缓存摘要，两边不一致时同样以退出码 1 结束。
+
+用法：
+    python3 python_tools/bench_compare.py old.jsonl new.jsonl [--threshold 10] [--metric p50_ns]
+"""
+
+import argparse
+import csv
+import json
+import sys
+from typing import Dict, Tuple
+
+METRICS = ("mean_ns", "p50_ns", "p90_ns", "p99_ns", "max_ns")
+# 回放结果字段：同一抓包在两个版本上应完全一致
+RESULT_FIELDS = ("parse_ok", "parse_failures", "parse_missing", "cuav_parsed", "cuav_failures",
+                 "cache_updates", "cache_evictions", "cache_entries", "cache_sha1")
+
+
+def load(path: str) -> Dict[Tuple[str, str], Dict[str, object]]:
+    """读取一次基准输出，返回 {(bench, case): 结果}"""
+    results: Dict[Tuple[str, str], Dict[str, object]] = {}
+    with open(path, newline="") as f:
+        first = f.readline()
+        f.seek(0)
+        if first.lstrip().startswith("{"):
+            rows = (json.loads(line) for line in f if line.strip())
+        else:
+            rows = csv.DictReader(f)
+        for row in rows:
+            result: Dict[str, object] = {m: float(row[m]) for m in METRICS}
+            result.update({f: str(row[f]) for f in RESULT_FIELDS if f in row})
+            results[(row["bench"], row["case"])] = result
+    return results
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Compare two udpjsonmeta_bench runs")
+    parser.add_argument("old", help="baseline output")
+    parser.add_argument("new", help="candidate output")
+    parser.add_argument("--metric", default="p50_ns", choices=METRICS,
+                        help="metric used for the regression check (default p50_ns)")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="regression threshold in percent (default 10)")
+    args = parser.parse_args()
+
+    old = load(args.old)
+    new = load(args.new)
+    regressions = 0
+    mismatches = 0
+
+    print(f"{'bench/case':<44} {'old':>12} {'new':>12} {'change':>9}")
+    for key in sorted(set(old) | set(new)):
+        name = "/".join(key)
+        if key not in old or key not in new:
+            print(f"{name:<44} {'(only in ' + ('new' if key in new else 'old') + ')':>35}")
+            continue
+        before = old[key][args.metric]
+        after = new[key][args.metric]
+        change = (after - before) / before * 100.0 if before > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{name:<44} {before:>12.1f} {after:>12.1f} {change:>+8.1f}%{flag}")
+        for field in RESULT_FIELDS:
+            if field in old[key] and field in new[key] and old[key][field] != new[key][field]:
+                print(f"    {field}: {old[key][field]} -> {new[key][field]}  RESULT MISMATCH")
+                mismatches += 1
+
+    if regressions:
+        print(f"\n{regressions} case(s) slower than {args.threshold:.0f}% on {args.metric}")
+    if mismatches:
+        print(f"\n{mismatches} replay result field(s) differ")
+    return 1 if regressions or mismatches else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
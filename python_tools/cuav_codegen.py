@@ -0,0 +1,363 @@
+#!/usr/bin/env python3
+"""
+C-UAV 协议代码生成器
+
+根据 cuav_schema.json 生成:
+- gstudpjsonmeta_cuav_msgs.h / gstudpjsonmeta_cuav_msgs.cpp: C++ 报文结构体与字段描述表
+- python_tools/cuav_protocol.py: Python 报文定义
+
+用法:
+    python3 python_tools/cuav_codegen.py [--check]
+
+--check 只比较生成结果与仓库中的文件是否一致，不一致时返回非零。
+"""
+
+import json
+import os
+import sys
+from typing import Any, Dict, List, Tuple
+
+TOOLS_DIR = os.path.dirname(os.path.abspath(__file__))
+ROOT_DIR = os.path.dirname(TOOLS_DIR)
+SCHEMA_PATH = os.path.join(TOOLS_DIR, "cuav_schema.json")
+
+GEN_NOTE = "由 python_tools/cuav_codegen.py 根据 python_tools/cuav_schema.json 生成，请勿手工修改"
+
+FIELD_TYPE_ENUM = {
+    "u8": "CUAV_FIELD_U8",
+    "u16": "CUAV_FIELD_U16",
+    "i16": "CUAV_FIELD_I16",
+    "u32": "CUAV_FIELD_U32",
+    "i32": "CUAV_FIELD_I32",
+    "f32": "CUAV_FIELD_F32",
+    "f64": "CUAV_FIELD_F64",
+    "str": "CUAV_FIELD_STR",
+}
+
+DEFAULT_DECIMALS = {"f32": 4, "f64": 6}
+
+
+def load_schema() -> Dict[str, Any]:
+    with open(SCHEMA_PATH, encoding="utf-8") as f:
+        schema = json.load(f)
+
+    structs: Dict[str, List[Dict[str, Any]]] = {}
+    for msg in schema["messages"]:
+        msg["msg_id"] = int(msg["id"], 16)
+        name = msg.get("struct")
+        if name and "fields" in msg:
+            if name in structs:
+                raise ValueError(f"struct {name} defined twice")
+            structs[name] = msg["fields"]
+    for msg in schema["messages"]:
+        name = msg.get("struct")
+        if name and name not in structs:
+            raise ValueError(f"struct {name} of 0x{msg['msg_id']:04X} has no fields")
+        msg["fields"] = structs.get(name, []) if name else []
+    schema["structs"] = structs
+    return schema
+
+
+def pad(text: str, width: int) -> str:
+    return text + " " * max(1, width - len(text))
+
+
+def struct_order(schema: Dict[str, Any]) -> List[Tuple[str, Dict[str, Any]]]:
+    """按首次出现顺序返回 (结构体名, 首个使用它的报文)"""
+    seen: Dict[str, Dict[str, Any]] = {}
+    for msg in schema["messages"]:
+        name = msg.get("struct")
+        if name and name not in seen:
+            seen[name] = msg
+    return list(seen.items())
+
+
+def gen_header(schema: Dict[str, Any]) -> str:
+    types = schema["types"]
+    out: List[str] = []
+    w = out.append
+
+    w(f"/* {GEN_NOTE} */")
+    w("#ifndef __GST_UDPJSON_META_CUAV_MSGS_H__")
+    w("#define __GST_UDPJSON_META_CUAV_MSGS_H__")
+    w("")
+    w("#include <glib.h>")
+    w("")
+    w("G_BEGIN_DECLS")
+    w("")
+    w("/**")
+    w(" * @brief C-UAV 报文ID常量定义")
+    w(" */")
+    w("typedef enum")
+    w("{")
+    msgs = schema["messages"]
+    for i, msg in enumerate(msgs):
+        sep = "," if i + 1 < len(msgs) else ""
+        w("    " + pad(f"CUAV_MSG_ID_{msg['enum']} = 0x{msg['msg_id']:04X}{sep}", 34)
+          + f"/* {msg['name']} */")
+    w("} CUAVMessageId;")
+    w("")
+    w("/**")
+    w(" * @brief 报文描述表下标")
+    w(" */")
+    w("typedef enum")
+    w("{")
+    for msg in msgs:
+        w(f"    CUAV_MSG_INDEX_{msg['enum']},")
+    w("    CUAV_MSG_INDEX_COUNT")
+    w("} CUAVMessageIndex;")
+
+    for name, first in struct_order(schema):
+        users = [m for m in msgs if m.get("struct") == name]
+        ids = "/".join(f"0x{m['msg_id']:04X}" for m in users)
+        w("")
+        w("/**")
+        w(f" * @brief {first['name']}结构体 (msg_id = {ids})")
+        w(" */")
+        w("typedef struct")
+        w("{")
+        for field in first["fields"]:
+            ctype = types[field["type"]]
+            count = field.get("count")
+            decl = f"{ctype} {field['name']}" + (f"[{count}]" if count else "") + ";"
+            w("    " + pad(decl, 22) + f"/* {field['desc']} */")
+        w(f"}} {name};")
+
+    w("")
+    w("/**")
+    w(" * @brief 可容纳任一报文结构体的联合体")
+    w(" */")
+    w("typedef union")
+    w("{")
+    for name, first in struct_order(schema):
+        w(f"    {name} {first['enum'].lower()};")
+    w("} CUAVMessageUnion;")
+    w("")
+    w("/**")
+    w(" * @brief 字段类型")
+    w(" */")
+    w("typedef enum")
+    w("{")
+    for key, enum in FIELD_TYPE_ENUM.items():
+        w("    " + pad(f"{enum},", 22) + f"/* {types[key]} */")
+    w("} CUAVFieldType;")
+    w("")
+    w("/**")
+    w(" * @brief 字段描述")
+    w(" */")
+    w("typedef struct")
+    w("{")
+    w("    const gchar *name;        /* JSON 字段名 */")
+    w("    CUAVFieldType type;       /* 字段类型 */")
+    w("    guint16 offset;           /* 结构体内偏移 */")
+    w("    guint16 count;            /* 数组元素数/字符串缓冲区长度，标量为 1 */")
+    w("    guint8 decimals;          /* 编码浮点数的小数位 */")
+    w("    const gchar *desc;        /* 字段说明 */")
+    w("} CUAVFieldDesc;")
+    w("")
+    w("/**")
+    w(" * @brief 报文描述")
+    w(" */")
+    w("typedef struct")
+    w("{")
+    w("    guint16 msg_id;           /* 报文ID */")
+    w("    CUAVMessageIndex index;   /* 描述表下标 */")
+    w("    const gchar *name;        /* 报文名称 */")
+    w("    const gchar *struct_name; /* 结构体名，NULL 表示协议未定义字段（仅报文头） */")
+    w("    gsize size;               /* 结构体大小 */")
+    w("    const CUAVFieldDesc *fields; /* 字段描述 */")
+    w("    guint n_fields;           /* 字段数 */")
+    w("} CUAVMessageDesc;")
+    w("")
+    w("/* 全部报文描述，按 CUAVMessageIndex 排列 */")
+    w("extern const CUAVMessageDesc cuav_message_descs[CUAV_MSG_INDEX_COUNT];")
+    w("")
+    w("/**")
+    w(" * @brief 按 msg_id 查找报文描述（常数时间）")
+    w(" *")
+    w(" * @param msg_id 报文ID")
+    w(" * @return 报文描述，未知报文返回 NULL")
+    w(" */")
+    w("const CUAVMessageDesc *cuav_message_desc_lookup(guint16 msg_id);")
+    w("")
+    w("G_END_DECLS")
+    w("")
+    w("#endif /* __GST_UDPJSON_META_CUAV_MSGS_H__ */")
+    return "\n".join(out) + "\n"
+
+
+def gen_source(schema: Dict[str, Any]) -> str:
+    out: List[str] = []
+    w = out.append
+    msgs = schema["messages"]
+
+    w(f"/* {GEN_NOTE} */")
+    w('#include "gstudpjsonmeta_cuav_msgs.h"')
+    w("")
+    w("#define CUAV_FIELD(st, field, type, count, decimals, desc) \\")
+    w("    {#field, type, (guint16)G_STRUCT_OFFSET(st, field), count, decimals, desc}")
+
+    for name, first in struct_order(schema):
+        w("")
+        w(f"static const CUAVFieldDesc cuav_fields_{name}[] = {{")
+        for field in first["fields"]:
+            ftype = field["type"]
+            count = field.get("count", 1)
+            dec = field.get("decimals", DEFAULT_DECIMALS.get(ftype, 0))
+            desc = field["desc"].replace('"', '\\"')
+            w(f"    CUAV_FIELD({name}, {field['name']}, {FIELD_TYPE_ENUM[ftype]}, "
+              f"{count}, {dec}, \"{desc}\"),")
+        w("};")
+
+    w("")
+    w("const CUAVMessageDesc cuav_message_descs[CUAV_MSG_INDEX_COUNT] = {")
+    for msg in msgs:
+        name = msg.get("struct")
+        if name:
+            w(f"    {{CUAV_MSG_ID_{msg['enum']}, CUAV_MSG_INDEX_{msg['enum']}, \"{msg['name']}\", "
+              f"\"{name}\", sizeof({name}),")
+            w(f"     cuav_fields_{name}, G_N_ELEMENTS(cuav_fields_{name})}},")
+        else:
+            w(f"    {{CUAV_MSG_ID_{msg['enum']}, CUAV_MSG_INDEX_{msg['enum']}, \"{msg['name']}\", "
+              "NULL, 0, NULL, 0},")
+    w("};")
+
+    pages: Dict[int, List[int]] = {}
+    for i, msg in enumerate(msgs):
+        page = pages.setdefault(msg["msg_id"] >> 8, [0] * 256)
+        page[msg["msg_id"] & 0xFF] = i + 1
+    if len(msgs) > 255:
+        raise ValueError("too many messages for guint8 page tables")
+
+    for hi, page in sorted(pages.items()):
+        w("")
+        w(f"/* msg_id 0x{hi:02X}xx: 低字节 -> 描述表下标 + 1（0 表示未知） */")
+        w(f"static const guint8 cuav_desc_page_{hi:02X}[256] = {{")
+        for row in range(0, 256, 16):
+            w("    " + ", ".join(str(v) for v in page[row:row + 16]) + ",")
+        w("};")
+
+    w("")
+    w("const CUAVMessageDesc *cuav_message_desc_lookup(guint16 msg_id)")
+    w("{")
+    w("    const guint8 *page = NULL;")
+    w("    guint8 idx = 0;")
+    w("")
+    w("    switch (msg_id >> 8)")
+    w("    {")
+    for hi in sorted(pages):
+        w(f"    case 0x{hi:02X}:")
+        w(f"        page = cuav_desc_page_{hi:02X};")
+        w("        break;")
+    w("    default:")
+    w("        return NULL;")
+    w("    }")
+    w("")
+    w("    idx = page[msg_id & 0xFF];")
+    w("    return idx ? &cuav_message_descs[idx - 1] : NULL;")
+    w("}")
+    return "\n".join(out) + "\n"
+
+
+def gen_python(schema: Dict[str, Any]) -> str:
+    out: List[str] = []
+    w = out.append
+    msgs = schema["messages"]
+
+    w("#!/usr/bin/env python3")
+    w('"""')
+    w("C-UAV 协议报文定义")
+    w("")
+    w(GEN_NOTE)
+    w('"""')
+    w("")
+    w("from typing import Any, Dict, List, Tuple")
+    w("")
+    w("# 报文ID常量")
+    for msg in msgs:
+        w(pad(f"MSG_ID_{msg['enum']} = 0x{msg['msg_id']:04X}", 29) + f"# {msg['name']}")
+    w("")
+    w("# 报文ID -> 名称")
+    w("MSG_NAMES: Dict[int, str] = {")
+    for msg in msgs:
+        w(f"    MSG_ID_{msg['enum']}: \"{msg['name']}\",")
+    w("}")
+    w("")
+    w("# 报文ID -> 定义，fields 为 (字段名, 类型, 元素数, 说明)")
+    w("MESSAGES: Dict[int, Dict[str, Any]] = {")
+    for msg in msgs:
+        w(f"    MSG_ID_{msg['enum']}: {{")
+        w(f"        \"name\": \"{msg['name']}\",")
+        w(f"        \"struct\": {msg.get('struct')!r},")
+        if msg["fields"]:
+            w("        \"fields\": [")
+            for field in msg["fields"]:
+                w(f"            (\"{field['name']}\", \"{field['type']}\", {field.get('count', 1)}, "
+                  f"\"{field['desc']}\"),")
+            w("        ],")
+        else:
+            w("        \"fields\": [],")
+        w("    },")
+    w("}")
+    w("")
+    w("")
+    w("def get_fields(msg_id: int) -> List[Tuple[str, str, int, str]]:")
+    w('    """获取报文字段定义，未知报文或未定义字段的报文返回空列表"""')
+    w("    msg = MESSAGES.get(msg_id)")
+    w("    return msg[\"fields\"] if msg else []")
+    w("")
+    w("")
+    w("def decode_specific(msg_id: int, raw: Dict[str, Any]) -> Dict[str, Any]:")
+    w('    """按报文定义提取业务字段"""')
+    w("    return {name: raw[name] for name, _type, _count, _desc in get_fields(msg_id) if name in raw}")
+    w("")
+    w("")
+    w("def _field_default(ftype: str, count: int) -> Any:")
+    w("    if ftype == \"str\":")
+    w("        return \"\"")
+    w("    value = 0.0 if ftype.startswith(\"f\") else 0")
+    w("    return [value] * count if count > 1 else value")
+    w("")
+    w("")
+    w("def encode_specific(msg_id: int, values: Dict[str, Any]) -> Dict[str, Any]:")
+    w('    """按报文定义组装业务字段：按定义顺序输出，缺省字段补零，未定义字段抛 KeyError"""')
+    w("    fields = get_fields(msg_id)")
+    w("    unknown = set(values) - {name for name, _type, _count, _desc in fields}")
+    w("    if unknown:")
+    w("        raise KeyError(f\"0x{msg_id:04X} 未定义字段: {', '.join(sorted(unknown))}\")")
+    w("    return {name: values.get(name, _field_default(ftype, count)) for name, ftype, count, _desc in fields}")
+    return "\n".join(out) + "\n"
+
+
+def main() -> int:
+    check = "--check" in sys.argv[1:]
+    schema = load_schema()
+    outputs = {
+        os.path.join(ROOT_DIR, "gstudpjsonmeta_cuav_msgs.h"): gen_header(schema),
+        os.path.join(ROOT_DIR, "gstudpjsonmeta_cuav_msgs.cpp"): gen_source(schema),
+        os.path.join(TOOLS_DIR, "cuav_protocol.py"): gen_python(schema),
+    }
+
+    stale = []
+    for path, text in outputs.items():
+        old = None
+        if os.path.exists(path):
+            with open(path, encoding="utf-8") as f:
+                old = f.read()
+        if old == text:
+            continue
+        stale.append(path)
+        if not check:
+            with open(path, "w", encoding="utf-8") as f:
+                f.write(text)
+            print(f"生成 {os.path.relpath(path, ROOT_DIR)}")
+
+    if check and stale:
+        for path in stale:
+            print(f"过期: {os.path.relpath(path, ROOT_DIR)}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -15,6 +15,17 @@ import time
 from datetime import datetime
 from typing import Any, Callable, Dict, List, Optional
 
+try:
+    from .cuav_protocol import (
+        MSG_ID_DEV_CONFIG, MSG_ID_EO_BIT, MSG_ID_EO_IR, MSG_ID_EO_PT, MSG_ID_EO_SERVO,
+        MSG_ID_EO_SYSTEM, MSG_ID_EO_TRACK, MSG_ID_GUIDANCE, MSG_ID_TARGET1, encode_specific,
+    )
+except ImportError:
+    from cuav_protocol import (
+        MSG_ID_DEV_CONFIG, MSG_ID_EO_BIT, MSG_ID_EO_IR, MSG_ID_EO_PT, MSG_ID_EO_SERVO,
+        MSG_ID_EO_SYSTEM, MSG_ID_EO_TRACK, MSG_ID_GUIDANCE, MSG_ID_TARGET1, encode_specific,
+    )
+
 
 class CUAVEmulator:
     """
@@ -228,16 +239,16 @@ class CUAVEmulator:
             handler(cmd_id, data)
 
         # 根据cmd_id处理
-        if cmd_id == 0x7203:
+        if cmd_id == MSG_ID_EO_TRACK:
             # 光电跟踪控制
             self._handle_tracking_control(data)
-        elif cmd_id == 0x7204:
+        elif cmd_id == MSG_ID_EO_SERVO:
             # 光电伺服控制
             self._handle_servo_control(data)
-        elif cmd_id == 0x7205:
+        elif cmd_id == MSG_ID_EO_PT:
             # 可见光控制
             self._handle_pt_control(data)
-        elif cmd_id == 0x7206:
+        elif cmd_id == MSG_ID_EO_IR:
             # 红外控制
             self._handle_ir_control(data)
 
@@ -260,8 +271,8 @@ class CUAVEmulator:
 
     def _send_device_config(self):
         """发送设备配置参数回馈"""
-        common = self._build_common_header(msg_id=0x7102, msg_type=1)
-        specific = {
+        common = self._build_common_header(msg_id=MSG_ID_DEV_CONFIG, msg_type=1)
+        specific = encode_specific(MSG_ID_DEV_CONFIG, {
             "sys_set": 2,  # 查询反馈
             "lon": self.config["lon"],
             "lat": self.config["lat"],
@@ -284,13 +295,13 @@ class CUAVEmulator:
             "trk_set": 2,
             "fb_set": 2,
             "version": self.config["version"]
-        }
+        })
         self._send_feedback(common, specific)
 
     def _send_bit_status(self):
         """发送BIT状态回馈"""
-        common = self._build_common_header(msg_id=0x7202, msg_type=1)
-        specific = {
+        common = self._build_common_header(msg_id=MSG_ID_EO_BIT, msg_type=1)
+        specific = encode_specific(MSG_ID_EO_BIT, {
             "sv_stat_h": 1,
             "sv_stat_v": 1,
             "sv_pwr": 1,
@@ -313,7 +324,7 @@ class CUAVEmulator:
             "wiper_stat": 0,
             "defrost_stat": 0,
             "ofr_stat": 0
-        }
+        })
         self._send_feedback(common, specific)
 
     def _send_module_status(self, cmd_coef1: int):
@@ -322,8 +333,8 @@ class CUAVEmulator:
             self._send_bit_status()
         elif cmd_coef1 == 2:
             # 伺服控制状态
-            common = self._build_common_header(msg_id=0x7204, msg_type=1)
-            specific = {"mode_h": 0, "mode_v": 0, "speed_h": 100, "speed_v": 100}
+            common = self._build_common_header(msg_id=MSG_ID_EO_SERVO, msg_type=1)
+            specific = encode_specific(MSG_ID_EO_SERVO, {"mode_h": 0, "mode_v": 0, "speed_h": 100, "speed_v": 100})
             self._send_feedback(common, specific)
 
     def _send_guidance_ack(self):
@@ -381,7 +392,7 @@ class CUAVEmulator:
                     msg_type = common.get("msg_type", -1)
                     msg_id = common.get("msg_id", -1)
 
-                    if msg_type == 0 and msg_id == 0x7111:
+                    if msg_type == 0 and msg_id == MSG_ID_GUIDANCE:
                         # 引导信息 (优先级最高，因为msg_type也是0)
                         specific = self._parse_specific(raw_data)
                         self._handle_guidance(specific)
@@ -613,12 +624,12 @@ class CUAVEmulatorWithTargetStream(CUAVEmulator):
             servo_v = self.servo_pos_v
 
         common = self._build_common_header(
-            msg_id=0x7201,
+            msg_id=MSG_ID_EO_SYSTEM,
             msg_type=3,  # 数据流
             cont_type=0,
             cont_sum=1
         )
-        specific = {
+        specific = encode_specific(MSG_ID_EO_SYSTEM, {
             "sv_stat": 1,  # 正常
             "sv_err": 0,
             "st_mode_h": 1 if tracking else 0,  # 跟踪模式
@@ -647,17 +658,11 @@ class CUAVEmulatorWithTargetStream(CUAVEmulator):
             "trk_mod": 0,
             "det_trk": 1,
             "trk_stat": 1 if tracking else 0,
-            "pt_trk_link": 1 if self.tracking else 0,
-            "ir_trk_link": 1 if self.tracking else 0,
-            "trk_str": 1 if self.tracking else 0,
-            "trk_mod": 0,
-            "det_trk": 1,
-            "trk_stat": 1 if self.tracking else 0,
             "pt_zoom": 0,
             "ir_zoom": 0,
             "pt_focus_mode": 0,
             "ir_focus_mode": 0
-        }
+        })
 
         msg = dict(common)
         msg.update(specific)
@@ -714,7 +719,7 @@ class CUAVEmulatorWithTargetStream(CUAVEmulator):
         now = datetime.now()
 
         common = {
-            "msg_id": 0x7112,
+            "msg_id": MSG_ID_TARGET1,
             "msg_sn": self._get_msg_sn(),
             "msg_type": 3,  # 数据流
             "tx_sys_id": self.config["sys_id"],
@@ -736,7 +741,7 @@ class CUAVEmulatorWithTargetStream(CUAVEmulator):
             "cont_sum": 1
         }
 
-        specific = {
+        specific = encode_specific(MSG_ID_TARGET1, {
             "yr": now.year,
             "mo": now.month,
             "dy": now.day,
@@ -767,7 +772,7 @@ class CUAVEmulatorWithTargetStream(CUAVEmulator):
             "lon": self.config["lon"],
             "lat": self.config["lat"],
             "alt": self.config["alt"]
-        }
+        })
 
         msg = dict(common)
         msg.update(specific)
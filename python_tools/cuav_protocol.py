@@ -0,0 +1,359 @@
+#!/usr/bin/env python3
+"""
+C-UAV 协议报文定义
+
+由 python_tools/cuav_codegen.py 根据 python_tools/cuav_schema.json 生成，请勿手工修改
+"""
+
+from typing import Any, Dict, List, Tuple
+
+# 报文ID常量
+MSG_ID_CMD = 0x7101          # 指令
+MSG_ID_DEV_CONFIG = 0x7102   # 设备配置参数
+MSG_ID_GUIDANCE = 0x7111     # 引导信息
+MSG_ID_TARGET1 = 0x7112      # 目标信息1
+MSG_ID_TARGET2 = 0x7113      # 目标信息2
+MSG_ID_EO_SYSTEM = 0x7201    # 光电系统参数
+MSG_ID_EO_BIT = 0x7202       # 光电BIT状态
+MSG_ID_EO_TRACK = 0x7203     # 光电跟踪控制
+MSG_ID_EO_SERVO = 0x7204     # 光电伺服控制
+MSG_ID_EO_PT = 0x7205        # 可见光控制
+MSG_ID_EO_IR = 0x7206        # 红外控制
+MSG_ID_EO_DM = 0x7207        # 光电测距控制
+MSG_ID_EO_BOX = 0x7208       # 手框目标区
+MSG_ID_EO_REC = 0x7209       # 光电录像
+MSG_ID_EO_AUX = 0x720A       # 配套控制
+MSG_ID_EO_IMG = 0x720B       # 图像控制
+
+# 报文ID -> 名称
+MSG_NAMES: Dict[int, str] = {
+    MSG_ID_CMD: "指令",
+    MSG_ID_DEV_CONFIG: "设备配置参数",
+    MSG_ID_GUIDANCE: "引导信息",
+    MSG_ID_TARGET1: "目标信息1",
+    MSG_ID_TARGET2: "目标信息2",
+    MSG_ID_EO_SYSTEM: "光电系统参数",
+    MSG_ID_EO_BIT: "光电BIT状态",
+    MSG_ID_EO_TRACK: "光电跟踪控制",
+    MSG_ID_EO_SERVO: "光电伺服控制",
+    MSG_ID_EO_PT: "可见光控制",
+    MSG_ID_EO_IR: "红外控制",
+    MSG_ID_EO_DM: "光电测距控制",
+    MSG_ID_EO_BOX: "手框目标区",
+    MSG_ID_EO_REC: "光电录像",
+    MSG_ID_EO_AUX: "配套控制",
+    MSG_ID_EO_IMG: "图像控制",
+}
+
+# 报文ID -> 定义，fields 为 (字段名, 类型, 元素数, 说明)
+MESSAGES: Dict[int, Dict[str, Any]] = {
+    MSG_ID_CMD: {
+        "name": "指令",
+        "struct": 'CUAVCommand',
+        "fields": [
+            ("cmd_id", "u16", 1, "指令ID"),
+            ("cmd_coef1", "u16", 1, "指令参数1"),
+        ],
+    },
+    MSG_ID_DEV_CONFIG: {
+        "name": "设备配置参数",
+        "struct": 'CUAVDevConfig',
+        "fields": [
+            ("sys_set", "u8", 1, "系统设置: 1=设置 2=查询反馈"),
+            ("lon", "f64", 1, "经度"),
+            ("lat", "f64", 1, "纬度"),
+            ("alt", "f64", 1, "高度"),
+            ("sys_id", "u16", 1, "系统号"),
+            ("dev_type", "u16", 1, "设备类型"),
+            ("dev_id", "u16", 1, "设备编号"),
+            ("subdev_id", "u16", 1, "分系统编号"),
+            ("net_set", "u8", 1, "网络设置"),
+            ("loc_ip", "str", 16, "本机IP"),
+            ("loc_port", "u16", 1, "本机端口"),
+            ("bit_mas_ip", "str", 16, "BIT主机IP"),
+            ("bit_mas_port", "u16", 1, "BIT主机端口"),
+            ("mas_ip", "str", 16, "主机IP"),
+            ("mas_port", "u16", 1, "主机端口"),
+            ("proc_set", "u8", 1, "处理设置"),
+            ("nor_agle", "f32", 1, "北向角(度)"),
+            ("azi_agle", "f32", 1, "方位安装角(度)"),
+            ("elv_agle", "f32", 1, "俯仰安装角(度)"),
+            ("trk_set", "u8", 1, "跟踪设置"),
+            ("fb_set", "u8", 1, "回馈设置"),
+            ("version", "str", 32, "软件版本"),
+        ],
+    },
+    MSG_ID_GUIDANCE: {
+        "name": "引导信息",
+        "struct": 'CUAVGuidanceInfo',
+        "fields": [
+            ("yr", "u16", 1, "年"),
+            ("mo", "u8", 1, "月"),
+            ("dy", "u8", 1, "日"),
+            ("h", "u8", 1, "时"),
+            ("min", "u8", 1, "分"),
+            ("sec", "u8", 1, "秒"),
+            ("msec", "f32", 1, "毫秒"),
+            ("tar_id", "u32", 1, "引导批号"),
+            ("tar_category", "u16", 1, "目标类别"),
+            ("guid_stat", "u8", 1, "目标状态: 0=取消 1=正常 2=外推"),
+            ("ecef_x", "f64", 1, "地心坐标 X"),
+            ("ecef_y", "f64", 1, "地心坐标 Y"),
+            ("ecef_z", "f64", 1, "地心坐标 Z"),
+            ("ecef_vx", "f64", 1, "速度 X"),
+            ("ecef_vy", "f64", 1, "速度 Y"),
+            ("ecef_vz", "f64", 1, "速度 Z"),
+            ("h_dvi_pct", "f32", 1, "水平偏差百分比"),
+            ("v_dvi_pct", "f32", 1, "垂直偏差百分比"),
+            ("enu_r", "f64", 1, "目标距离"),
+            ("enu_a", "f64", 1, "目标方位"),
+            ("enu_e", "f64", 1, "目标俯仰"),
+            ("enu_v", "f64", 1, "目标速度"),
+            ("enu_h", "f64", 1, "目标相对高度"),
+            ("lon", "f64", 1, "经度"),
+            ("lat", "f64", 1, "纬度"),
+            ("alt", "f64", 1, "高度"),
+        ],
+    },
+    MSG_ID_TARGET1: {
+        "name": "目标信息1",
+        "struct": 'CUAVTargetInfo',
+        "fields": [
+            ("yr", "u16", 1, "年"),
+            ("mo", "u8", 1, "月"),
+            ("dy", "u8", 1, "日"),
+            ("h", "u8", 1, "时"),
+            ("min", "u8", 1, "分"),
+            ("sec", "u8", 1, "秒"),
+            ("msec", "f32", 1, "毫秒"),
+            ("dev_id", "u8", 1, "探测设备: 0=可见光 1=红外"),
+            ("guid_id", "u32", 1, "关联的引导批号"),
+            ("tar_id", "u32", 1, "目标批号"),
+            ("trk_stat", "u8", 1, "目标状态: 0=丢失 1=正常 2=外推"),
+            ("trk_mod", "u8", 1, "跟踪模式: 0=自动 1=半自动 2=手动"),
+            ("tar_a", "f64", 1, "目标方位(度)"),
+            ("tar_e", "f64", 1, "目标俯仰(度)"),
+            ("tar_av", "f32", 1, "方位角速度(度/秒)"),
+            ("tar_ev", "f32", 1, "俯仰角速度(度/秒)"),
+            ("tar_rng", "f64", 1, "目标距离(米)"),
+            ("tar_rv", "f32", 1, "径向速度(米/秒)"),
+            ("tar_category", "u16", 1, "目标类别"),
+            ("tar_iden", "str", 16, "目标识别结果"),
+            ("tar_cfid", "f32", 1, "置信度"),
+            ("offset_h", "i16", 1, "水平脱靶量(像素)"),
+            ("offset_v", "i16", 1, "垂直脱靶量(像素)"),
+            ("tar_rect", "i32", 4, "目标框 x,y,w,h (像素)"),
+            ("fov_h", "f32", 1, "水平视场/指向"),
+            ("fov_v", "f32", 1, "垂直视场/指向"),
+            ("tar_sum", "u16", 1, "目标总数"),
+            ("lon", "f64", 1, "经度"),
+            ("lat", "f64", 1, "纬度"),
+            ("alt", "f64", 1, "高度"),
+        ],
+    },
+    MSG_ID_TARGET2: {
+        "name": "目标信息2",
+        "struct": 'CUAVTargetInfo',
+        "fields": [
+            ("yr", "u16", 1, "年"),
+            ("mo", "u8", 1, "月"),
+            ("dy", "u8", 1, "日"),
+            ("h", "u8", 1, "时"),
+            ("min", "u8", 1, "分"),
+            ("sec", "u8", 1, "秒"),
+            ("msec", "f32", 1, "毫秒"),
+            ("dev_id", "u8", 1, "探测设备: 0=可见光 1=红外"),
+            ("guid_id", "u32", 1, "关联的引导批号"),
+            ("tar_id", "u32", 1, "目标批号"),
+            ("trk_stat", "u8", 1, "目标状态: 0=丢失 1=正常 2=外推"),
+            ("trk_mod", "u8", 1, "跟踪模式: 0=自动 1=半自动 2=手动"),
+            ("tar_a", "f64", 1, "目标方位(度)"),
+            ("tar_e", "f64", 1, "目标俯仰(度)"),
+            ("tar_av", "f32", 1, "方位角速度(度/秒)"),
+            ("tar_ev", "f32", 1, "俯仰角速度(度/秒)"),
+            ("tar_rng", "f64", 1, "目标距离(米)"),
+            ("tar_rv", "f32", 1, "径向速度(米/秒)"),
+            ("tar_category", "u16", 1, "目标类别"),
+            ("tar_iden", "str", 16, "目标识别结果"),
+            ("tar_cfid", "f32", 1, "置信度"),
+            ("offset_h", "i16", 1, "水平脱靶量(像素)"),
+            ("offset_v", "i16", 1, "垂直脱靶量(像素)"),
+            ("tar_rect", "i32", 4, "目标框 x,y,w,h (像素)"),
+            ("fov_h", "f32", 1, "水平视场/指向"),
+            ("fov_v", "f32", 1, "垂直视场/指向"),
+            ("tar_sum", "u16", 1, "目标总数"),
+            ("lon", "f64", 1, "经度"),
+            ("lat", "f64", 1, "纬度"),
+            ("alt", "f64", 1, "高度"),
+        ],
+    },
+    MSG_ID_EO_SYSTEM: {
+        "name": "光电系统参数",
+        "struct": 'CUAVEOSystemParam',
+        "fields": [
+            ("sv_stat", "u8", 1, "伺服状态: 0=无效 1=正常 2=自检 3=预热 4=错误"),
+            ("sv_err", "u16", 1, "伺服错误代码"),
+            ("st_mode_h", "u8", 1, "伺服水平模式: 0=手动 1=跟踪"),
+            ("st_mode_v", "u8", 1, "伺服垂直模式: 0=手动 1=跟踪"),
+            ("st_loc_h", "f32", 1, "伺服水平指向(度) [0,360]"),
+            ("st_loc_v", "f32", 1, "伺服垂直指向(度) [-90,90]"),
+            ("pt_stat", "u8", 1, "可见光状态"),
+            ("pt_err", "u16", 1, "可见光错误代码"),
+            ("pt_focal", "f32", 1, "可见光焦距 [134-16298]"),
+            ("pt_focus", "u16", 1, "可见光聚焦"),
+            ("pt_fov_h", "f32", 1, "可见光水平视场"),
+            ("pt_fov_v", "f32", 1, "可见光垂直视场"),
+            ("ir_stat", "u8", 1, "红外状态"),
+            ("ir_err", "u16", 1, "红外错误代码"),
+            ("ir_focal", "f32", 1, "红外焦距 [851-1223]"),
+            ("ir_focus", "u16", 1, "红外聚焦"),
+            ("ir_fov_h", "f32", 1, "红外水平视场"),
+            ("ir_fov_v", "f32", 1, "红外垂直视场"),
+            ("dm_stat", "u8", 1, "测距状态"),
+            ("dm_err", "u16", 1, "测距错误代码"),
+            ("dm_dev", "u8", 1, "测距设备"),
+            ("trk_dev", "u8", 1, "跟踪设备: 0=可见光 1=红外 3=多传感器联动"),
+            ("pt_trk_link", "u8", 1, "光电联动: 0=停止 1=开始"),
+            ("ir_trk_link", "u8", 1, "红外联动: 0=停止 1=开始"),
+            ("trk_str", "u8", 1, "跟踪开关: 0=停止 1=开始"),
+            ("trk_mod", "u8", 1, "跟踪模式: 0=自动 1=半自动 2=手动"),
+            ("det_trk", "u8", 1, "检测跟踪: 0=检测 1=识别"),
+            ("trk_stat", "u8", 1, "目标状态: 0=非跟踪 1=跟踪正常 3=失锁 4=丢失"),
+            ("pt_zoom", "u8", 1, "可见光自动变倍: 0=不自动 1=自动"),
+            ("ir_zoom", "u8", 1, "红外自动变倍: 0=不自动 1=自动"),
+            ("pt_focus_mode", "u8", 1, "可见光聚焦模式: 0=自动 1=手动"),
+            ("ir_focus_mode", "u8", 1, "红外聚焦模式: 0=自动 1=手动"),
+        ],
+    },
+    MSG_ID_EO_BIT: {
+        "name": "光电BIT状态",
+        "struct": 'CUAVEOBitStatus',
+        "fields": [
+            ("sv_stat_h", "u8", 1, "水平伺服状态"),
+            ("sv_stat_v", "u8", 1, "垂直伺服状态"),
+            ("sv_pwr", "u8", 1, "伺服供电"),
+            ("sv_max_t", "f32", 1, "伺服最高温度"),
+            ("pt_stat", "u8", 1, "可见光状态"),
+            ("pt_err", "u16", 1, "可见光错误代码"),
+            ("pt_pwr", "u8", 1, "可见光供电"),
+            ("pt_max_t", "f32", 1, "可见光最高温度"),
+            ("pt_avg_t", "f32", 1, "可见光平均温度"),
+            ("ir_stat", "u8", 1, "红外状态"),
+            ("ir_err", "u16", 1, "红外错误代码"),
+            ("ir_pwr", "u8", 1, "红外供电"),
+            ("ir_max_t", "f32", 1, "红外最高温度"),
+            ("ir_avg_t", "f32", 1, "红外平均温度"),
+            ("laster_stat", "u8", 1, "激光状态（协议字段名如此）"),
+            ("laster_err", "u16", 1, "激光错误代码（协议字段名如此）"),
+            ("laser_pwr", "u8", 1, "激光供电"),
+            ("laser_max_t", "f32", 1, "激光最高温度"),
+            ("laser_avg_t", "f32", 1, "激光平均温度"),
+            ("wiper_stat", "u8", 1, "雨刷状态"),
+            ("defrost_stat", "u8", 1, "除霜状态"),
+            ("ofr_stat", "u8", 1, "其他状态"),
+        ],
+    },
+    MSG_ID_EO_TRACK: {
+        "name": "光电跟踪控制",
+        "struct": 'CUAVTrackControl',
+        "fields": [
+            ("trk_end", "u8", 1, "跟踪模块开关: 0=关闭 1=开启"),
+            ("pt_trk_link", "u8", 1, "可见光联动: 0=停止 1=开始"),
+            ("ir_trk_link", "u8", 1, "红外联动: 0=停止 1=开始"),
+            ("trk_str", "u8", 1, "跟踪开关: 0=停止 1=开始"),
+            ("trk_dev", "u8", 1, "跟踪设备: 0=可见光 1=红外 3=多传感器联动"),
+            ("trk_mod", "u8", 1, "跟踪模式: 0=自动 1=半自动 2=手动"),
+            ("det_trk", "u8", 1, "检测跟踪: 0=检测 1=识别"),
+        ],
+    },
+    MSG_ID_EO_SERVO: {
+        "name": "光电伺服控制",
+        "struct": 'CUAVServoControl',
+        "fields": [
+            ("dev_id", "u8", 1, "设备类型: 0=可见光 1=红外 2=两者"),
+            ("dev_en", "u8", 1, "使能: 0=关闭 1=上电"),
+            ("ctrl_en", "u8", 1, "控制使能: 0=无效 1=有效"),
+            ("mode_h", "u8", 1, "水平控制模式: 0=手动 1=跟踪"),
+            ("mode_v", "u8", 1, "垂直控制模式: 0=手动 1=跟踪"),
+            ("speed_en_h", "u8", 1, "水平速度使能: 0=无效 1=设置 2=获取 3=增加 4=减小"),
+            ("speed_h", "u8", 1, "水平速度 [1,200]"),
+            ("speed_en_v", "u8", 1, "垂直速度使能"),
+            ("speed_v", "u8", 1, "垂直速度 [1,200]"),
+            ("loc_en_h", "u8", 1, "水平位置使能: 0=无效 1=设置 2=获取 3=增加 4=减小"),
+            ("loc_h", "f32", 1, "水平位置(度)"),
+            ("loc_en_v", "u8", 1, "垂直位置使能"),
+            ("loc_v", "f32", 1, "垂直位置(度)"),
+            ("offset_en", "u8", 1, "脱靶量使能"),
+            ("offset_h", "i16", 1, "水平脱靶量(像素)"),
+            ("offset_v", "i16", 1, "垂直脱靶量(像素)"),
+        ],
+    },
+    MSG_ID_EO_PT: {
+        "name": "可见光控制",
+        "struct": 'CUAVPTControl',
+        "fields": [
+            ("pt_focal_en", "u8", 1, "焦距使能: 0=无效 1=设置 2=获取 3=增加 4=减小"),
+            ("pt_focal", "f32", 1, "可见光焦距"),
+        ],
+    },
+    MSG_ID_EO_IR: {
+        "name": "红外控制",
+        "struct": 'CUAVIRControl',
+        "fields": [
+            ("ir_focal_en", "u8", 1, "焦距使能: 0=无效 1=设置 2=获取 3=增加 4=减小"),
+            ("ir_focal", "f32", 1, "红外焦距"),
+        ],
+    },
+    MSG_ID_EO_DM: {
+        "name": "光电测距控制",
+        "struct": None,
+        "fields": [],
+    },
+    MSG_ID_EO_BOX: {
+        "name": "手框目标区",
+        "struct": None,
+        "fields": [],
+    },
+    MSG_ID_EO_REC: {
+        "name": "光电录像",
+        "struct": None,
+        "fields": [],
+    },
+    MSG_ID_EO_AUX: {
+        "name": "配套控制",
+        "struct": None,
+        "fields": [],
+    },
+    MSG_ID_EO_IMG: {
+        "name": "图像控制",
+        "struct": None,
+        "fields": [],
+    },
+}
+
+
+def get_fields(msg_id: int) -> List[Tuple[str, str, int, str]]:
+    """获取报文字段定义，未知报文或未定义字段的报文返回空列表"""
+    msg = MESSAGES.get(msg_id)
+    return msg["fields"] if msg else []
+
+
+def decode_specific(msg_id: int, raw: Dict[str, Any]) -> Dict[str, Any]:
+    """按报文定义提取业务字段"""
+    return {name: raw[name] for name, _type, _count, _desc in get_fields(msg_id) if name in raw}
+
+
+def _field_default(ftype: str, count: int) -> Any:
+    if ftype == "str":
+        return ""
+    value = 0.0 if ftype.startswith("f") else 0
+    return [value] * count if count > 1 else value
+
+
+def encode_specific(msg_id: int, values: Dict[str, Any]) -> Dict[str, Any]:
+    """按报文定义组装业务字段：按定义顺序输出，缺省字段补零，未定义字段抛 KeyError"""
+    fields = get_fields(msg_id)
+    unknown = set(values) - {name for name, _type, _count, _desc in fields}
+    if unknown:
+        raise KeyError(f"0x{msg_id:04X} 未定义字段: {', '.join(sorted(unknown))}")
+    return {name: values.get(name, _field_default(ftype, count)) for name, ftype, count, _desc in fields}
@@ -13,6 +13,15 @@ from abc import ABC, abstractmethod
 from datetime import datetime
 from typing import Any, Callable, Dict, List, Optional, Set
 
+try:
+    from .cuav_protocol import (
+        MSG_ID_EO_SYSTEM, MSG_ID_GUIDANCE, MSG_ID_TARGET1, MSG_ID_TARGET2, MSG_NAMES,
+    )
+except ImportError:
+    from cuav_protocol import (
+        MSG_ID_EO_SYSTEM, MSG_ID_GUIDANCE, MSG_ID_TARGET1, MSG_ID_TARGET2, MSG_NAMES,
+    )
+
 
 class CUAVMessageParser:
     """C-UAV 报文解析器"""
@@ -25,24 +34,6 @@ class CUAVMessageParser:
         "cont_type", "cont_sum",
     }
 
-    # 报文ID常量
-    MSG_ID_CMD = 0x7101          # 指令
-    MSG_ID_DEV_CONFIG = 0x7102   # 设备配置参数
-    MSG_ID_GUIDANCE = 0x7111     # 引导信息
-    MSG_ID_TARGET1 = 0x7112      # 目标信息1
-    MSG_ID_TARGET2 = 0x7113      # 目标信息2
-    MSG_ID_EO_SYSTEM = 0x7201    # 光电系统参数
-    MSG_ID_EO_BIT = 0x7202       # 光电BIT状态
-    MSG_ID_EO_TRACK = 0x7203     # 光电跟踪控制
-    MSG_ID_EO_SERVO = 0x7204     # 光电伺服控制
-    MSG_ID_EO_PT = 0x7205        # 可见光控制
-    MSG_ID_EO_IR = 0x7206        # 红外控制
-    MSG_ID_EO_DM = 0x7207        # 光电测距控制
-    MSG_ID_EO_BOX = 0x7208       # 手框目标区
-    MSG_ID_EO_REC = 0x7209       # 光电录像
-    MSG_ID_EO_AUX = 0x720A       # 配套控制
-    MSG_ID_EO_IMG = 0x720B       # 图像控制
-
     # 报文类型
     MSG_TYPE_CTRL = 0        # 控制
     MSG_TYPE_FEEDBACK = 1    # 回馈
@@ -166,25 +157,7 @@ class CUAVMessageParser:
 
     def get_msg_id_name(self, msg_id: int) -> str:
         """获取报文ID名称"""
-        names = {
-            self.MSG_ID_CMD: "指令",
-            self.MSG_ID_DEV_CONFIG: "设备配置参数",
-            self.MSG_ID_GUIDANCE: "引导信息",
-            self.MSG_ID_TARGET1: "目标信息1",
-            self.MSG_ID_TARGET2: "目标信息2",
-            self.MSG_ID_EO_SYSTEM: "光电系统参数",
-            self.MSG_ID_EO_BIT: "光电BIT状态",
-            self.MSG_ID_EO_TRACK: "光电跟踪控制",
-            self.MSG_ID_EO_SERVO: "光电伺服控制",
-            self.MSG_ID_EO_PT: "可见光控制",
-            self.MSG_ID_EO_IR: "红外控制",
-            self.MSG_ID_EO_DM: "光电测距控制",
-            self.MSG_ID_EO_BOX: "手框目标区",
-            self.MSG_ID_EO_REC: "光电录像",
-            self.MSG_ID_EO_AUX: "配套控制",
-            self.MSG_ID_EO_IMG: "图像控制"
-        }
-        return names.get(msg_id, f"未知(0x{msg_id:04X})")
+        return MSG_NAMES.get(msg_id, f"未知(0x{msg_id:04X})")
 
     def get_target_type_name(self, target_type: int) -> str:
         """获取目标类型名称"""
@@ -498,7 +471,7 @@ def print_message_handler(result: Dict[str, Any], addr: tuple):
 def guidance_handler(result: Dict[str, Any], addr: tuple):
     """引导信息处理器"""
     parser = CUAVMessageParser()
-    if result.get("msg_id") != parser.MSG_ID_GUIDANCE:
+    if result.get("msg_id") != MSG_ID_GUIDANCE:
         return
 
     specific = result.get("specific", {})
@@ -514,7 +487,7 @@ def target_handler(result: Dict[str, Any], addr: tuple):
     """目标信息处理器"""
     parser = CUAVMessageParser()
     msg_id = result.get("msg_id")
-    if msg_id not in (parser.MSG_ID_TARGET1, parser.MSG_ID_TARGET2):
+    if msg_id not in (MSG_ID_TARGET1, MSG_ID_TARGET2):
         return
 
     specific = result.get("specific", {})
@@ -534,7 +507,7 @@ def target_handler(result: Dict[str, Any], addr: tuple):
 def eo_status_handler(result: Dict[str, Any], addr: tuple):
     """光电状态处理器"""
     parser = CUAVMessageParser()
-    if result.get("msg_id") != parser.MSG_ID_EO_SYSTEM:
+    if result.get("msg_id") != MSG_ID_EO_SYSTEM:
         return
 
     specific = result.get("specific", {})
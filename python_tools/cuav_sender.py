@@ -11,6 +11,15 @@ import time
 from datetime import datetime
 from typing import Any, Dict, List, Optional
 
+try:
+    from .cuav_protocol import (
+        MSG_ID_CMD, MSG_ID_EO_SERVO, MSG_ID_EO_TRACK, MSG_ID_GUIDANCE, encode_specific,
+    )
+except ImportError:
+    from cuav_protocol import (
+        MSG_ID_CMD, MSG_ID_EO_SERVO, MSG_ID_EO_TRACK, MSG_ID_GUIDANCE, encode_specific,
+    )
+
 
 class CUAVMulticastSender:
     """C-UAV 协议 UDP 组播发送器"""
@@ -25,13 +34,6 @@ class CUAVMulticastSender:
         "cont_type", "cont_sum",
     }
 
-    # 报文ID常量
-    MSG_ID_CMD = 0x7101          # 指令
-    MSG_ID_DEV_CONFIG = 0x7102   # 设备配置参数
-    MSG_ID_GUIDANCE = 0x7111     # 引导信息
-    MSG_ID_TARGET1 = 0x7112      # 目标信息1
-    MSG_ID_TARGET2 = 0x7113      # 目标信息2
-
     # 报文类型
     MSG_TYPE_CTRL = 0        # 控制
     MSG_TYPE_FEEDBACK = 1    # 回馈
@@ -178,12 +180,12 @@ class CUAVMulticastSender:
             发送的字节数
         """
         common = self._build_common_header(
-            self.MSG_ID_CMD,
+            MSG_ID_CMD,
             self.MSG_TYPE_CTRL,
             rx_dev_type=rx_dev_type,
             rx_dev_id=rx_dev_id
         )
-        specific = {"cmd_id": cmd_id, "cmd_coef1": cmd_coef1}
+        specific = encode_specific(MSG_ID_CMD, {"cmd_id": cmd_id, "cmd_coef1": cmd_coef1})
         return self.send(common, specific)
 
     def send_query(
@@ -206,12 +208,12 @@ class CUAVMulticastSender:
             发送的字节数
         """
         common = self._build_common_header(
-            self.MSG_ID_CMD,
+            MSG_ID_CMD,
             self.MSG_TYPE_QUERY,
             rx_dev_type=rx_dev_type,
             rx_dev_id=rx_dev_id
         )
-        specific = {"cmd_id": cmd_id, "cmd_coef1": cmd_coef1}
+        specific = encode_specific(MSG_ID_CMD, {"cmd_id": cmd_id, "cmd_coef1": cmd_coef1})
         return self.send(common, specific)
 
     def send_guidance(
@@ -251,14 +253,14 @@ class CUAVMulticastSender:
             发送的字节数
         """
         common = self._build_common_header(
-            self.MSG_ID_GUIDANCE,
+            MSG_ID_GUIDANCE,
             self.MSG_TYPE_CTRL,
             rx_sys_id=rx_sys_id,
             rx_dev_type=rx_dev_type,
             rx_dev_id=rx_dev_id,
             cont_type=1
         )
-        specific = {
+        specific = encode_specific(MSG_ID_GUIDANCE, {
             **self._get_timestamp(),
             "tar_id": tar_id,
             "tar_category": tar_category,
@@ -275,7 +277,7 @@ class CUAVMulticastSender:
             "lon": lon,
             "lat": lat,
             "alt": alt
-        }
+        })
         return self.send(common, specific, cont_type=1)
 
     def send_tracking_control(
@@ -307,22 +309,23 @@ class CUAVMulticastSender:
             发送的字节数
         """
         common = self._build_common_header(
-            self.MSG_ID_CMD,  # 使用CMD报文ID
+            MSG_ID_CMD,  # 使用CMD报文ID
             self.MSG_TYPE_CTRL,
             rx_sys_id=rx_sys_id,
             rx_dev_type=rx_dev_type,
             rx_dev_id=rx_dev_id
         )
         specific = {
-            "cmd_id": 0x7203,  # 跟踪控制报文ID
-            "cmd_coef1": 0,
-            "trk_end": trk_end,
-            "pt_trk_link": pt_trk_link,
-            "ir_trk_link": ir_trk_link,
-            "trk_str": trk_str,
-            "trk_dev": trk_dev,
-            "trk_mod": trk_mod,
-            "det_trk": det_trk
+            **encode_specific(MSG_ID_CMD, {"cmd_id": MSG_ID_EO_TRACK}),
+            **encode_specific(MSG_ID_EO_TRACK, {
+                "trk_end": trk_end,
+                "pt_trk_link": pt_trk_link,
+                "ir_trk_link": ir_trk_link,
+                "trk_str": trk_str,
+                "trk_dev": trk_dev,
+                "trk_mod": trk_mod,
+                "det_trk": det_trk
+            })
         }
         return self.send(common, specific)
 
@@ -356,29 +359,30 @@ class CUAVMulticastSender:
             发送的字节数
         """
         common = self._build_common_header(
-            self.MSG_ID_CMD,
+            MSG_ID_CMD,
             self.MSG_TYPE_CTRL,
             rx_sys_id=rx_sys_id,
             rx_dev_type=rx_dev_type,
             rx_dev_id=rx_dev_id
         )
         specific = {
-            "cmd_id": 0x7204,
-            "cmd_coef1": 0,
-            "dev_id": dev_id,
-            "dev_en": dev_en,
-            "ctrl_en": ctrl_en,
-            "mode_h": mode_h,
-            "mode_v": mode_v,
-            "speed_en_h": 3,  # 增加
-            "speed_h": speed_h,
-            "speed_en_v": 3,
-            "speed_v": speed_v,
-            "loc_en_h": 1,  # 设置
-            "loc_h": loc_h,
-            "loc_en_v": 1,
-            "loc_v": loc_v,
-            "offset_en": 0
+            **encode_specific(MSG_ID_CMD, {"cmd_id": MSG_ID_EO_SERVO}),
+            **encode_specific(MSG_ID_EO_SERVO, {
+                "dev_id": dev_id,
+                "dev_en": dev_en,
+                "ctrl_en": ctrl_en,
+                "mode_h": mode_h,
+                "mode_v": mode_v,
+                "speed_en_h": 3,  # 增加
+                "speed_h": speed_h,
+                "speed_en_v": 3,
+                "speed_v": speed_v,
+                "loc_en_h": 1,  # 设置
+                "loc_h": loc_h,
+                "loc_en_v": 1,
+                "loc_v": loc_v,
+                "offset_en": 0
+            })
         }
         return self.send(common, specific)
 
@@ -11,6 +11,8 @@ import struct
 import time
 from datetime import datetime
 
+from cuav_protocol import MSG_ID_GUIDANCE
+
 # C-UAV 协议配置
 MULTICAST_ADDR = "230.1.88.51"   # C-UAV 组播地址
 CTRL_PORT = 8003                # 控制端口
@@ -37,7 +39,7 @@ def send_guidance(sock, tar_id=1, tar_category=9, guid_stat=1,
     ts = get_timestamp()
 
     msg = {
-        "msg_id": 0x7111,
+        "msg_id": MSG_ID_GUIDANCE,
         "msg_sn": int(time.time() * 1000) % 10000,
         "msg_type": 0,  # 控制
         "tx_sys_id": 3,
@@ -25,15 +25,13 @@ import time
 import sys
 from datetime import datetime
 
+from cuav_protocol import MSG_ID_CMD, MSG_ID_EO_SERVO, MSG_ID_EO_SYSTEM, MSG_ID_GUIDANCE
+
 # C-UAV 协议常量
 MULTICAST_ADDR = "230.1.88.51"
 CTRL_PORT = 8003      # 指控中心发送控制指令的端口
 FEEDBACK_PORT = 8013  # 光电设备发送反馈的端口
 
-MSG_ID_GUIDANCE = 0x7111
-MSG_ID_EO_SYSTEM = 0x7201
-MSG_ID_EO_SERVO = 0x7204
-
 MSG_TYPE_CTRL = 0
 MSG_TYPE_STREAM = 3
 
@@ -199,7 +197,7 @@ class CUAVTestSender:
     def send_servo_control(self, loc_h=90.0, loc_v=45.0):
         """发送伺服控制"""
         msg = {
-            "msg_id": 0x7101,
+            "msg_id": MSG_ID_CMD,
             "msg_sn": self._get_msg_sn(),
             "msg_type": MSG_TYPE_CTRL,
             "tx_sys_id": 3, "tx_dev_type": 3, "tx_dev_id": 1, "tx_subdev_id": 999,
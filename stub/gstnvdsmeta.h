@@ -0,0 +1,42 @@
+/*
+ * DeepStream gstnvdsmeta.h 的最小替身（仅用于无 DeepStream 的 CPU 构建）
+ */
+#ifndef __UDPJSON_STUB_GSTNVDSMETA_H__
+#define __UDPJSON_STUB_GSTNVDSMETA_H__
+
+#include <gst/gst.h>
+#include "nvdsmeta.h"
+
+G_BEGIN_DECLS
+
+/* GstBuffer 上 NvDsMeta 的类型 */
+typedef enum
+{
+    NVDS_GST_INVALID_META = -1,
+    NVDS_BATCH_GST_META = 0x100,
+    NVDS_START_USER_GST_META = 0x1000
+} GstNvDsMetaType;
+
+typedef gpointer (*GstNvDsMetaCopyFunc)(gpointer data, gpointer user_data);
+typedef void (*GstNvDsMetaReleaseFunc)(gpointer data, gpointer user_data);
+
+/* 挂在 GstBuffer 上的 DeepStream 元数据 */
+typedef struct
+{
+    GstMeta meta; /* GStreamer 元数据头 */
+    gpointer meta_data; /* 元数据（NVDS_BATCH_GST_META 时为 NvDsBatchMeta*） */
+    gpointer user_data; /* 回调用户数据 */
+    gint meta_type; /* GstNvDsMetaType */
+    GstNvDsMetaCopyFunc copyfunc; /* 复制回调 */
+    GstNvDsMetaReleaseFunc freefunc; /* 释放回调 */
+} NvDsMeta;
+
+GType nvds_meta_api_get_type(void);
+NvDsMeta *gst_buffer_add_nvds_meta(GstBuffer *buffer, gpointer meta_data, gpointer user_data,
+                                   GstNvDsMetaCopyFunc copy_func,
+                                   GstNvDsMetaReleaseFunc release_func);
+NvDsBatchMeta *gst_buffer_get_nvds_batch_meta(GstBuffer *buffer);
+
+G_END_DECLS
+
+#endif /* __UDPJSON_STUB_GSTNVDSMETA_H__ */
@@ -0,0 +1,219 @@
+/*
+ * DeepStream 元数据接口的最小 CPU 实现（UDPJSON_NVDS_STUB 构建使用）
+ *
+ * 元数据池退化为逐个分配，批次销毁时按 DeepStream 语义对每个用户元数据
+ * 调用 release_func(NvDsUserMeta*, NULL)。用于在没有 DeepStream 的机器上
+ * 构建、运行插件与微基准，不追求与真实库的性能或 ABI 一致。
+ */
+#include "gstnvdsmeta.h"
+#include "nvdsmeta.h"
+
+/* 保护用户元数据类型表 */
+static GMutex nvds_stub_type_lock;
+/* 类型描述 -> NvDsMetaType */
+static GHashTable *nvds_stub_types = NULL;
+/* 下一个分配的用户元数据类型 */
+static gint nvds_stub_next_type = NVDS_START_USER_META;
+
+/**
+ * @brief 释放用户元数据列表（先调用各自的 release_func）
+ *
+ * @param list 用户元数据列表
+ */
+static void nvds_stub_release_user_meta_list(NvDsMetaList *list)
+{
+    for (NvDsMetaList *l = list; l; l = l->next)
+    {
+        NvDsUserMeta *user_meta = (NvDsUserMeta *)l->data;
+        if (user_meta->base_meta.release_func)
+            user_meta->base_meta.release_func(user_meta, NULL);
+        g_free(user_meta);
+    }
+    g_list_free(list);
+}
+
+NvDsBatchMeta *nvds_create_batch_meta(guint max_batch_size)
+{
+    NvDsBatchMeta *batch_meta = g_new0(NvDsBatchMeta, 1);
+
+    batch_meta->base_meta.batch_meta = batch_meta;
+    batch_meta->base_meta.meta_type = NVDS_BATCH_META;
+    batch_meta->max_frames_in_batch = max_batch_size;
+    return batch_meta;
+}
+
+gboolean nvds_destroy_batch_meta(NvDsBatchMeta *batch_meta)
+{
+    if (!batch_meta)
+        return FALSE;
+
+    for (NvDsMetaList *l = batch_meta->frame_meta_list; l; l = l->next)
+    {
+        NvDsFrameMeta *frame_meta = (NvDsFrameMeta *)l->data;
+        for (NvDsMetaList *o = frame_meta->obj_meta_list; o; o = o->next)
+        {
+            NvDsObjectMeta *obj_meta = (NvDsObjectMeta *)o->data;
+            nvds_stub_release_user_meta_list(obj_meta->obj_user_meta_list);
+            g_free(obj_meta);
+        }
+        g_list_free(frame_meta->obj_meta_list);
+        nvds_stub_release_user_meta_list(frame_meta->frame_user_meta_list);
+        g_free(frame_meta);
+    }
+    g_list_free(batch_meta->frame_meta_list);
+    nvds_stub_release_user_meta_list(batch_meta->batch_user_meta_list);
+    g_free(batch_meta);
+    return TRUE;
+}
+
+NvDsFrameMeta *nvds_acquire_frame_meta_from_pool(NvDsBatchMeta *batch_meta)
+{
+    NvDsFrameMeta *frame_meta = g_new0(NvDsFrameMeta, 1);
+
+    frame_meta->base_meta.batch_meta = batch_meta;
+    frame_meta->base_meta.meta_type = NVDS_FRAME_META;
+    return frame_meta;
+}
+
+NvDsObjectMeta *nvds_acquire_obj_meta_from_pool(NvDsBatchMeta *batch_meta)
+{
+    NvDsObjectMeta *obj_meta = g_new0(NvDsObjectMeta, 1);
+
+    obj_meta->base_meta.batch_meta = batch_meta;
+    obj_meta->base_meta.meta_type = NVDS_OBJ_META;
+    obj_meta->object_id = UNTRACKED_OBJECT_ID;
+    return obj_meta;
+}
+
+NvDsUserMeta *nvds_acquire_user_meta_from_pool(NvDsBatchMeta *batch_meta)
+{
+    NvDsUserMeta *user_meta = g_new0(NvDsUserMeta, 1);
+
+    user_meta->base_meta.batch_meta = batch_meta;
+    user_meta->base_meta.meta_type = NVDS_USER_META;
+    return user_meta;
+}
+
+void nvds_add_frame_meta_to_batch(NvDsBatchMeta *batch_meta, NvDsFrameMeta *frame_meta)
+{
+    frame_meta->batch_id = batch_meta->num_frames_in_batch++;
+    batch_meta->frame_meta_list = g_list_append(batch_meta->frame_meta_list, frame_meta);
+}
+
+void nvds_add_obj_meta_to_frame(NvDsFrameMeta *frame_meta, NvDsObjectMeta *obj_meta,
+                                NvDsObjectMeta *obj_parent)
+{
+    frame_meta->obj_meta_list = g_list_prepend(frame_meta->obj_meta_list, obj_meta);
+    frame_meta->num_obj_meta++;
+}
+
+void nvds_add_user_meta_to_frame(NvDsFrameMeta *frame_meta, NvDsUserMeta *user_meta)
+{
+    frame_meta->frame_user_meta_list = g_list_prepend(frame_meta->frame_user_meta_list, user_meta);
+}
+
+void nvds_add_user_meta_to_obj(NvDsObjectMeta *obj_meta, NvDsUserMeta *user_meta)
+{
+    obj_meta->obj_user_meta_list = g_list_prepend(obj_meta->obj_user_meta_list, user_meta);
+}
+
+NvDsMetaType nvds_get_user_meta_type(gchar *meta_descriptor)
+{
+    gint type = 0;
+
+    g_mutex_lock(&nvds_stub_type_lock);
+    if (!nvds_stub_types)
+        nvds_stub_types = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    type = GPOINTER_TO_INT(g_hash_table_lookup(nvds_stub_types, meta_descriptor));
+    if (type == 0)
+    {
+        type = nvds_stub_next_type++;
+        g_hash_table_insert(nvds_stub_types, g_strdup(meta_descriptor), GINT_TO_POINTER(type));
+    }
+    g_mutex_unlock(&nvds_stub_type_lock);
+    return (NvDsMetaType)type;
+}
+
+/**
+ * @brief 初始化 NvDsMeta
+ */
+static gboolean nvds_stub_meta_init(GstMeta *meta, gpointer params, GstBuffer *buffer)
+{
+    NvDsMeta *nvds_meta = (NvDsMeta *)meta;
+
+    nvds_meta->meta_data = NULL;
+    nvds_meta->user_data = NULL;
+    nvds_meta->meta_type = NVDS_GST_INVALID_META;
+    nvds_meta->copyfunc = NULL;
+    nvds_meta->freefunc = NULL;
+    return TRUE;
+}
+
+/**
+ * @brief 随 GstBuffer 释放 NvDsMeta
+ */
+static void nvds_stub_meta_free(GstMeta *meta, GstBuffer *buffer)
+{
+    NvDsMeta *nvds_meta = (NvDsMeta *)meta;
+
+    if (nvds_meta->freefunc)
+        nvds_meta->freefunc(nvds_meta->meta_data, nvds_meta->user_data);
+}
+
+/**
+ * @brief NvDsMeta 的注册信息
+ */
+static const GstMetaInfo *nvds_stub_meta_get_info(void)
+{
+    static const GstMetaInfo *info = NULL;
+
+    if (g_once_init_enter(&info))
+    {
+        const GstMetaInfo *registered =
+            gst_meta_register(nvds_meta_api_get_type(), "NvDsMeta", sizeof(NvDsMeta),
+                              nvds_stub_meta_init, nvds_stub_meta_free, NULL);
+        g_once_init_leave(&info, registered);
+    }
+    return info;
+}
+
+GType nvds_meta_api_get_type(void)
+{
+    static gsize type = 0;
+
+    if (g_once_init_enter(&type))
+    {
+        static const gchar *tags[] = {NULL};
+        g_once_init_leave(&type, gst_meta_api_type_register("NvDsMetaAPI", tags));
+    }
+    return (GType)type;
+}
+
+NvDsMeta *gst_buffer_add_nvds_meta(GstBuffer *buffer, gpointer meta_data, gpointer user_data,
+                                   GstNvDsMetaCopyFunc copy_func,
+                                   GstNvDsMetaReleaseFunc release_func)
+{
+    NvDsMeta *nvds_meta = (NvDsMeta *)gst_buffer_add_meta(buffer, nvds_stub_meta_get_info(), NULL);
+
+    if (!nvds_meta)
+        return NULL;
+    nvds_meta->meta_data = meta_data;
+    nvds_meta->user_data = user_data;
+    nvds_meta->copyfunc = copy_func;
+    nvds_meta->freefunc = release_func;
+    return nvds_meta;
+}
+
+NvDsBatchMeta *gst_buffer_get_nvds_batch_meta(GstBuffer *buffer)
+{
+    gpointer state = NULL;
+    GstMeta *meta = NULL;
+
+    while ((meta = gst_buffer_iterate_meta_filtered(buffer, &state, nvds_meta_api_get_type())))
+    {
+        NvDsMeta *nvds_meta = (NvDsMeta *)meta;
+        if (nvds_meta->meta_type == NVDS_BATCH_GST_META)
+            return (NvDsBatchMeta *)nvds_meta->meta_data;
+    }
+    return NULL;
+}
@@ -0,0 +1,111 @@
+/*
+ * DeepStream nvdsmeta.h 的最小替身（仅用于无 DeepStream 的 CPU 构建）
+ *
+ * 只声明 udpjsonmeta 与微基准用到的类型和函数，字段名与 DeepStream 一致，
+ * 布局不保证相同；元数据池退化为 g_new0/g_free，不可与真实 DeepStream 库混用。
+ */
+#ifndef __UDPJSON_STUB_NVDSMETA_H__
+#define __UDPJSON_STUB_NVDSMETA_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* 未跟踪目标的 object_id */
+#define UNTRACKED_OBJECT_ID 0xFFFFFFFFFFFFFFFF
+
+typedef GList NvDsMetaList;
+typedef struct _NvDsBatchMeta NvDsBatchMeta;
+
+/* 元数据类型，用户类型从 NVDS_START_USER_META 起由 nvds_get_user_meta_type 分配 */
+typedef enum
+{
+    NVDS_INVALID_META = -1,
+    NVDS_BATCH_META = 1,
+    NVDS_FRAME_META,
+    NVDS_OBJ_META,
+    NVDS_USER_META = 0x1000,
+    NVDS_START_USER_META = 0x1000 + 0x1000,
+    NVDS_FORCE32_META = 0x7FFFFFFF
+} NvDsMetaType;
+
+typedef gpointer (*NvDsMetaCopyFunc)(gpointer data, gpointer user_data);
+typedef void (*NvDsMetaReleaseFunc)(gpointer data, gpointer user_data);
+
+/* 元数据公共头 */
+typedef struct
+{
+    NvDsBatchMeta *batch_meta; /* 所属批次 */
+    NvDsMetaType meta_type; /* 元数据类型 */
+    gpointer uContext; /* 用户上下文 */
+    NvDsMetaCopyFunc copy_func; /* 复制回调，参数为 NvDsUserMeta* */
+    NvDsMetaReleaseFunc release_func; /* 释放回调，参数为 NvDsUserMeta* */
+} NvDsBaseMeta;
+
+/* 用户元数据 */
+typedef struct
+{
+    NvDsBaseMeta base_meta; /* 公共头 */
+    gpointer user_meta_data; /* 用户数据 */
+} NvDsUserMeta;
+
+/* 目标框 */
+typedef struct
+{
+    float left, top, width, height; /* 像素坐标 */
+} NvOSD_RectParams;
+
+/* 目标元数据 */
+typedef struct
+{
+    NvDsBaseMeta base_meta; /* 公共头 */
+    gint unique_component_id; /* 生成该目标的组件ID */
+    gint class_id; /* 类别 */
+    guint64 object_id; /* 跟踪ID */
+    float confidence; /* 置信度 */
+    NvOSD_RectParams rect_params; /* 目标框 */
+    NvDsMetaList *obj_user_meta_list; /* 目标用户元数据 */
+} NvDsObjectMeta;
+
+/* 帧元数据 */
+typedef struct
+{
+    NvDsBaseMeta base_meta; /* 公共头 */
+    guint pad_index; /* 输入 pad 序号 */
+    guint batch_id; /* 批内序号 */
+    gint frame_num; /* 帧号 */
+    guint64 buf_pts; /* PTS */
+    guint64 ntp_timestamp; /* NTP 时间戳(纳秒) */
+    guint source_id; /* 源ID */
+    guint num_obj_meta; /* 目标数 */
+    NvDsMetaList *obj_meta_list; /* 目标元数据 */
+    NvDsMetaList *frame_user_meta_list; /* 帧用户元数据 */
+    guint source_frame_width, source_frame_height; /* 源分辨率 */
+    guint pipeline_width, pipeline_height; /* 管线分辨率 */
+} NvDsFrameMeta;
+
+/* 批次元数据 */
+struct _NvDsBatchMeta
+{
+    NvDsBaseMeta base_meta; /* 公共头 */
+    guint max_frames_in_batch; /* 最大帧数 */
+    guint num_frames_in_batch; /* 当前帧数 */
+    NvDsMetaList *frame_meta_list; /* 帧元数据 */
+    NvDsMetaList *batch_user_meta_list; /* 批次用户元数据 */
+};
+
+NvDsBatchMeta *nvds_create_batch_meta(guint max_batch_size);
+gboolean nvds_destroy_batch_meta(NvDsBatchMeta *batch_meta);
+NvDsFrameMeta *nvds_acquire_frame_meta_from_pool(NvDsBatchMeta *batch_meta);
+NvDsObjectMeta *nvds_acquire_obj_meta_from_pool(NvDsBatchMeta *batch_meta);
+NvDsUserMeta *nvds_acquire_user_meta_from_pool(NvDsBatchMeta *batch_meta);
+void nvds_add_frame_meta_to_batch(NvDsBatchMeta *batch_meta, NvDsFrameMeta *frame_meta);
+void nvds_add_obj_meta_to_frame(NvDsFrameMeta *frame_meta, NvDsObjectMeta *obj_meta,
+                                NvDsObjectMeta *obj_parent);
+void nvds_add_user_meta_to_frame(NvDsFrameMeta *frame_meta, NvDsUserMeta *user_meta);
+void nvds_add_user_meta_to_obj(NvDsObjectMeta *obj_meta, NvDsUserMeta *user_meta);
+NvDsMetaType nvds_get_user_meta_type(gchar *meta_descriptor);
+
+G_END_DECLS
+
+#endif /* __UDPJSON_STUB_NVDSMETA_H__ */
@@ -0,0 +1,863 @@
+/*
+ * udpjsonmeta 核心模块单元测试（GLib 测试框架，不依赖 DeepStream 与网络）
+ *
+ *   ./udpjsonmeta_tests              运行全部用例
+ *   ./udpjsonmeta_tests -p /dedup    只运行一组
+ *
+ * CMake 中每组注册为一个 CTest 用例，ctest 运行。
+ */
+#include "gstudpjsonmeta_cuav.h"
+#include "gstudpjsonmeta_cuav_msgs.h"
+#include "gstudpjsonmeta_cuav_sender.h"
+#include "gstudpjsonmeta_dedup.h"
+#include "gstudpjsonmeta_demand.h"
+#include "gstudpjsonmeta_fusion.h"
+#include "gstudpjsonmeta_ingest.h"
+#include "gstudpjsonmeta_journal.h"
+#include "gstudpjsonmeta_pcap.h"
+#ifdef UDPJSON_NVDS_STUB
+#include "nvdsmeta.h"
+#endif
+
+#include <arpa/inet.h>
+#include <glib/gstdio.h>
+#include <string.h>
+
+#ifdef UDPJSON_NVDS_STUB
+/* ---------------------------------------------------------------------------------------- */
+/* nvds-stub                                                                                */
+/* ---------------------------------------------------------------------------------------- */
+
+/* release_func 收到的用户元数据数 */
+static guint test_nvds_released = 0;
+
+/**
+ * @brief 用户元数据释放回调：参数应为 NvDsUserMeta 本身
+ */
+static void test_nvds_release(gpointer data, gpointer user_data)
+{
+    NvDsUserMeta *user_meta = (NvDsUserMeta *)data;
+
+    g_assert_cmpstr((const gchar *)user_meta->user_meta_data, ==, "payload");
+    g_free(user_meta->user_meta_data);
+    user_meta->user_meta_data = NULL;
+    test_nvds_released++;
+}
+
+/**
+ * @brief 挂一条测试用户元数据
+ */
+static NvDsUserMeta *test_nvds_user_meta(NvDsBatchMeta *batch, NvDsMetaType type)
+{
+    NvDsUserMeta *user_meta = nvds_acquire_user_meta_from_pool(batch);
+
+    user_meta->user_meta_data = g_strdup("payload");
+    user_meta->base_meta.meta_type = type;
+    user_meta->base_meta.release_func = test_nvds_release;
+    return user_meta;
+}
+
+/**
+ * @brief 替身的用户元数据类型分配，以及销毁批次时按 DeepStream 语义调用 release_func
+ */
+static void test_nvds_stub_user_meta(void)
+{
+    NvDsBatchMeta *batch = nvds_create_batch_meta(1);
+    NvDsFrameMeta *frame = nvds_acquire_frame_meta_from_pool(batch);
+    NvDsObjectMeta *obj = nvds_acquire_obj_meta_from_pool(batch);
+    NvDsMetaType type = nvds_get_user_meta_type((gchar *)"UDPJSON_TEST_META");
+
+    g_assert_cmpint(type, >=, NVDS_START_USER_META);
+    g_assert_cmpint(nvds_get_user_meta_type((gchar *)"UDPJSON_TEST_META"), ==, type);
+    g_assert_cmpint(nvds_get_user_meta_type((gchar *)"UDPJSON_TEST_OTHER"), !=, type);
+
+    nvds_add_frame_meta_to_batch(batch, frame);
+    nvds_add_obj_meta_to_frame(frame, obj, NULL);
+    g_assert_cmpuint(batch->num_frames_in_batch, ==, 1);
+    g_assert_cmpuint(frame->num_obj_meta, ==, 1);
+    nvds_add_user_meta_to_frame(frame, test_nvds_user_meta(batch, type));
+    nvds_add_user_meta_to_obj(obj, test_nvds_user_meta(batch, type));
+
+    test_nvds_released = 0;
+    g_assert_true(nvds_destroy_batch_meta(batch));
+    g_assert_cmpuint(test_nvds_released, ==, 2);
+}
+#endif /* UDPJSON_NVDS_STUB */
+
+/* ---------------------------------------------------------------------------------------- */
+/* demand                                                                                   */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 尚未发布、发布停滞与超出跟踪范围的源一律放行
+ */
+static void test_demand_pass_through(void)
+{
+    UdpJsonDemand *demand = udpjson_demand_new(1);
+    gint64 now_us = 10 * G_USEC_PER_SEC;
+
+    g_assert_true(udpjson_demand_wanted(demand, 0, 3, now_us));
+
+    udpjson_demand_add(demand, 0, 10);
+    udpjson_demand_batch_done(demand, now_us);
+    g_assert_false(udpjson_demand_wanted(demand, 0, 3, now_us));
+    g_assert_true(udpjson_demand_wanted(demand, UDPJSON_DEMAND_MAX_SOURCES, 3, now_us));
+    g_assert_true(udpjson_demand_wanted(demand, 0, 3, now_us + UDPJSON_DEMAND_STALE_US + 1));
+    udpjson_demand_free(demand);
+}
+
+/**
+ * @brief 发布最近两个周期的并集，高水位以上的新目标放行
+ */
+static void test_demand_publish(void)
+{
+    UdpJsonDemand *demand = udpjson_demand_new(2);
+    gint64 now_us = 10 * G_USEC_PER_SEC;
+
+    udpjson_demand_add(demand, 1, 5);
+    udpjson_demand_batch_done(demand, now_us);
+    /* 未满 interval 个批次，尚未发布 */
+    g_assert_true(udpjson_demand_wanted(demand, 1, 2, now_us));
+    udpjson_demand_add(demand, 1, 2);
+    udpjson_demand_batch_done(demand, now_us);
+
+    g_assert_true(udpjson_demand_wanted(demand, 1, 5, now_us));
+    g_assert_true(udpjson_demand_wanted(demand, 1, 2, now_us));
+    g_assert_false(udpjson_demand_wanted(demand, 1, 4, now_us));
+    g_assert_true(udpjson_demand_wanted(demand, 1, 6, now_us));
+    /* 其他源没有高水位，全部视为新目标 */
+    g_assert_true(udpjson_demand_wanted(demand, 2, 4, now_us));
+
+    /* 第二周期只见到 2：5 仍在上一周期中 */
+    udpjson_demand_add(demand, 1, 2);
+    udpjson_demand_batch_done(demand, now_us);
+    udpjson_demand_batch_done(demand, now_us);
+    g_assert_true(udpjson_demand_wanted(demand, 1, 5, now_us));
+
+    /* 连续两个周期未见，低于高水位的目标视为已离开 */
+    udpjson_demand_add(demand, 1, 2);
+    udpjson_demand_batch_done(demand, now_us);
+    udpjson_demand_batch_done(demand, now_us);
+    g_assert_false(udpjson_demand_wanted(demand, 1, 5, now_us));
+    g_assert_true(udpjson_demand_wanted(demand, 1, 2, now_us));
+    udpjson_demand_free(demand);
+}
+
+/**
+ * @brief 顶层 source_id/object_id 的快速提取
+ */
+static void test_demand_scan_ids(void)
+{
+    static const gchar *rejected[] = {
+        "{\"source_id\":1,\"value\":1}",
+        "{\"object_id\":-1,\"value\":1}",
+        "{\"object_id\":1.5,\"value\":1}",
+        "{\"value\":{\"object_id\":2}}",
+        "{\"object_id\":1,\"object_id\":2}",
+        "{\"object_id\":1,\"source_id\":\"x\"}",
+        "{\"object_id\":1,\"name\":\"unterminated",
+    };
+    const gchar *msg = "{\"source_id\": 3, \"object_id\":\"42\",\"value\":{\"conf\":0.9}}";
+    guint source_id = 99;
+    guint64 object_id = 0;
+
+    g_assert_true(udpjson_demand_scan_ids(msg, strlen(msg), &source_id, &object_id));
+    g_assert_cmpuint(source_id, ==, 3);
+    g_assert_cmpuint(object_id, ==, 42);
+
+    msg = "{\"object_id\":7,\"value\":1}";
+    source_id = 99;
+    g_assert_true(udpjson_demand_scan_ids(msg, strlen(msg), &source_id, &object_id));
+    g_assert_cmpuint(source_id, ==, 99);
+    g_assert_cmpuint(object_id, ==, 7);
+
+    /* 嵌套对象和字符串取值中的同名键不影响顶层取值 */
+    msg = "{\"value\":{\"object_id\":2,\"source_id\":5},\"note\":\"\\\"object_id\\\":3\","
+          "\"object_id\":1}";
+    source_id = 99;
+    g_assert_true(udpjson_demand_scan_ids(msg, strlen(msg), &source_id, &object_id));
+    g_assert_cmpuint(source_id, ==, 99);
+    g_assert_cmpuint(object_id, ==, 1);
+
+    for (guint i = 0; i < G_N_ELEMENTS(rejected); i++)
+        g_assert_false(udpjson_demand_scan_ids(rejected[i], strlen(rejected[i]), &source_id,
+                                               &object_id));
+}
+
+/* ---------------------------------------------------------------------------------------- */
+/* dedup                                                                                    */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 首个副本采用，其他路径的副本丢弃并记录领先时间
+ */
+static void test_dedup_first_copy(void)
+{
+    UdpJsonDedup *dedup = udpjson_dedup_new(10);
+    UdpJsonDedupPathStats stats;
+    const gchar *msg = "{\"object_id\":1}";
+
+    g_assert_true(udpjson_dedup_check(dedup, 1, msg, strlen(msg), 1000000));
+    g_assert_false(udpjson_dedup_check(dedup, 0, msg, strlen(msg), 1250000));
+    g_assert_true(udpjson_dedup_check(dedup, 0, "{\"object_id\":2}", 15, 1300000));
+
+    udpjson_dedup_get_path_stats(dedup, 1, &stats);
+    g_assert_cmpuint(stats.first, ==, 1);
+    g_assert_cmpuint(stats.late, ==, 0);
+    g_assert_cmpuint(stats.lead_count, ==, 1);
+    g_assert_cmpuint(stats.lead_sum_ns, ==, 250000);
+    g_assert_cmpuint(stats.lead_max_ns, ==, 250000);
+    udpjson_dedup_get_path_stats(dedup, 0, &stats);
+    g_assert_cmpuint(stats.first, ==, 1);
+    g_assert_cmpuint(stats.late, ==, 1);
+    g_assert_cmpuint(stats.lead_count, ==, 0);
+
+    udpjson_dedup_get_path_stats(dedup, UDPJSON_DEDUP_MAX_PATHS, &stats);
+    g_assert_cmpuint(stats.first, ==, 0);
+    udpjson_dedup_free(dedup);
+}
+
+/**
+ * @brief 同一路径的重发照常处理且重新开始去重，窗口过期后其他路径的相同报文重新采用
+ */
+static void test_dedup_resend_and_expiry(void)
+{
+    UdpJsonDedup *dedup = udpjson_dedup_new(10);
+    UdpJsonDedupPathStats stats;
+    const gchar *msg = "{\"object_id\":1}";
+    guint64 t0 = 1000000;
+
+    g_assert_true(udpjson_dedup_check(dedup, 0, msg, strlen(msg), t0));
+    g_assert_true(udpjson_dedup_check(dedup, 0, msg, strlen(msg), t0 + 5000000));
+    /* 重发重新计时：距首次到达已超过窗口，但距重发仍在窗口内 */
+    g_assert_false(udpjson_dedup_check(dedup, 1, msg, strlen(msg), t0 + 12000000));
+    g_assert_true(udpjson_dedup_check(dedup, 1, msg, strlen(msg), t0 + 30000000));
+    /* 路径 1 再次送达：重发，路径 0 上这次重发的副本丢弃 */
+    g_assert_true(udpjson_dedup_check(dedup, 1, msg, strlen(msg), t0 + 31000000));
+    g_assert_false(udpjson_dedup_check(dedup, 0, msg, strlen(msg), t0 + 31500000));
+
+    udpjson_dedup_get_path_stats(dedup, 0, &stats);
+    g_assert_cmpuint(stats.first, ==, 2);
+    g_assert_cmpuint(stats.late, ==, 1);
+    udpjson_dedup_get_path_stats(dedup, 1, &stats);
+    g_assert_cmpuint(stats.first, ==, 2);
+    g_assert_cmpuint(stats.late, ==, 1);
+    g_assert_cmpuint(stats.lead_count, ==, 1);
+    g_assert_cmpuint(stats.lead_sum_ns, ==, 500000);
+    udpjson_dedup_free(dedup);
+}
+
+/**
+ * @brief 两条路径都已送达后，重发先从原先较慢的路径到达时照常采用
+ */
+static void test_dedup_resend_other_path_first(void)
+{
+    UdpJsonDedup *dedup = udpjson_dedup_new(10);
+    UdpJsonDedupPathStats stats;
+    const gchar *msg = "{\"object_id\":1}";
+    guint64 t0 = 1000000;
+
+    g_assert_true(udpjson_dedup_check(dedup, 0, msg, strlen(msg), t0));
+    g_assert_false(udpjson_dedup_check(dedup, 1, msg, strlen(msg), t0 + 200000));
+    /* 重发：路径 1 先到，路径 0 的副本丢弃，领先时间记在路径 1 */
+    g_assert_true(udpjson_dedup_check(dedup, 1, msg, strlen(msg), t0 + 2000000));
+    g_assert_false(udpjson_dedup_check(dedup, 0, msg, strlen(msg), t0 + 2300000));
+
+    udpjson_dedup_get_path_stats(dedup, 0, &stats);
+    g_assert_cmpuint(stats.first, ==, 1);
+    g_assert_cmpuint(stats.late, ==, 1);
+    g_assert_cmpuint(stats.lead_sum_ns, ==, 200000);
+    udpjson_dedup_get_path_stats(dedup, 1, &stats);
+    g_assert_cmpuint(stats.first, ==, 1);
+    g_assert_cmpuint(stats.late, ==, 1);
+    g_assert_cmpuint(stats.lead_sum_ns, ==, 300000);
+    udpjson_dedup_free(dedup);
+}
+
+/* ---------------------------------------------------------------------------------------- */
+/* cuav                                                                                     */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 按发送方与序号送入一条最小的 C-UAV 报文
+ */
+static void test_cuav_feed(CUAVParser *parser, guint16 tx_dev_id, guint32 msg_sn)
+{
+    gchar *msg = g_strdup_printf("{\"msg_id\":29185,\"msg_type\":1,\"msg_sn\":%u,"
+                                 "\"tx_sys_id\":999,\"tx_dev_type\":1,\"tx_dev_id\":%u}",
+                                 msg_sn, tx_dev_id);
+
+    cuav_parser_parse(parser, msg, (gssize)strlen(msg));
+    g_free(msg);
+}
+
+/**
+ * @brief 序号窗口：丢失、迟到补齐、重复与发送方重启
+ */
+static void test_cuav_seq_window(void)
+{
+    static const guint32 sns[] = {1, 2, 5, 3, 3, 5, 4, 5000};
+    CUAVParser *parser = cuav_parser_new();
+    CUAVSeqStats stats;
+
+    for (guint i = 0; i < G_N_ELEMENTS(sns); i++)
+        test_cuav_feed(parser, 3, sns[i]);
+    cuav_parser_get_seq_stats(parser, &stats);
+    g_assert_cmpuint(stats.received, ==, 8);
+    g_assert_cmpuint(stats.lost, ==, 0);
+    g_assert_cmpuint(stats.reordered, ==, 2);
+    g_assert_cmpuint(stats.duplicates, ==, 2);
+    g_assert_cmpuint(stats.resets, ==, 1);
+    g_assert_cmpuint(stats.senders, ==, 1);
+
+    /* 第二个发送方单独编号；跳过的序号计为丢失 */
+    test_cuav_feed(parser, 4, 1);
+    test_cuav_feed(parser, 4, 4);
+    cuav_parser_get_seq_stats(parser, &stats);
+    g_assert_cmpuint(stats.senders, ==, 2);
+    g_assert_cmpuint(stats.lost, ==, 2);
+
+    /* 序号检查在预过滤之前：被 msg_id 过滤的报文不计为丢失 */
+    {
+        guint16 accept = 0x7202;
+
+        cuav_parser_set_msg_id_filter(parser, &accept, 1);
+        test_cuav_feed(parser, 4, 5);
+        test_cuav_feed(parser, 4, 6);
+        cuav_parser_get_seq_stats(parser, &stats);
+        g_assert_cmpuint(stats.lost, ==, 2);
+        g_assert_cmpuint(stats.received, ==, 12);
+    }
+
+    /* 早于发送方首个报文的序号迟到：计为乱序，不扣减其他发送方的丢失 */
+    test_cuav_feed(parser, 5, 10);
+    test_cuav_feed(parser, 5, 8);
+    cuav_parser_get_seq_stats(parser, &stats);
+    g_assert_cmpuint(stats.lost, ==, 2);
+    g_assert_cmpuint(stats.reordered, ==, 3);
+    cuav_parser_free(parser);
+}
+
+/**
+ * @brief 原始报文回调收到的报文头
+ */
+typedef struct
+{
+    CUAVCommonHeader headers[CUAV_MSG_INDEX_COUNT];
+    guint count;
+} TestCuavRawCapture;
+
+static void test_cuav_on_raw(const CUAVCommonHeader *header, CUAVRawMessage *msg,
+                             gpointer user_data)
+{
+    TestCuavRawCapture *capture = (TestCuavRawCapture *)user_data;
+    gsize len = 0;
+
+    g_assert_nonnull(cuav_raw_message_get_data(msg, &len));
+    g_assert_cmpuint(len, >, 0);
+    if (capture->count < G_N_ELEMENTS(capture->headers))
+        capture->headers[capture->count] = *header;
+    capture->count++;
+}
+
+/**
+ * @brief 生成的编码器输出的每种报文都能被解析器识别，报文头字段一致
+ */
+static void test_cuav_encode_round_trip(void)
+{
+    CUAVAddressing addressing = {999, 1, 17, 2, 999, 3, 18, 4};
+    CUAVEncoder *encoder = cuav_encoder_new(&addressing);
+    CUAVParser *parser = cuav_parser_new();
+    TestCuavRawCapture capture;
+    CUAVSeqStats seq;
+    guint encoded = 0;
+
+    memset(&capture, 0, sizeof(capture));
+    cuav_parser_set_raw_forward_only(parser, TRUE);
+    cuav_parser_set_raw_callback(parser, test_cuav_on_raw, &capture);
+    for (guint i = 0; i < CUAV_MSG_INDEX_COUNT; i++)
+    {
+        const CUAVMessageDesc *desc = &cuav_message_descs[i];
+        CUAVMessageUnion msg;
+        gchar buf[4096];
+        gsize len = 0;
+
+        g_assert_cmpuint(desc->index, ==, i);
+        g_assert_true(cuav_message_desc_lookup(desc->msg_id) == desc);
+        memset(&msg, 0, sizeof(msg));
+        len = cuav_encode_message(encoder, desc->msg_id, CUAV_MSG_TYPE_STREAM, &msg, buf,
+                                  sizeof(buf));
+        g_assert_cmpuint(len, >, 0);
+        cuav_parser_parse(parser, buf, (gssize)len);
+        encoded++;
+
+        g_assert_cmpuint(capture.count, ==, encoded);
+        g_assert_cmpuint(capture.headers[i].msg_id, ==, desc->msg_id);
+        g_assert_cmpuint(capture.headers[i].msg_sn, ==, encoded);
+        g_assert_cmpuint(capture.headers[i].msg_type, ==, CUAV_MSG_TYPE_STREAM);
+        g_assert_cmpuint(capture.headers[i].tx_dev_id, ==, 17);
+        g_assert_cmpuint(capture.headers[i].tx_subdev_id, ==, 2);
+        g_assert_cmpuint(capture.headers[i].rx_dev_type, ==, 3);
+        g_assert_cmpuint(capture.headers[i].rx_dev_id, ==, 18);
+    }
+    cuav_parser_get_seq_stats(parser, &seq);
+    g_assert_cmpuint(seq.received, ==, encoded);
+    g_assert_cmpuint(seq.lost, ==, 0);
+    g_assert_cmpuint(seq.duplicates, ==, 0);
+
+    cuav_parser_free(parser);
+    cuav_encoder_free(encoder);
+}
+
+/* ---------------------------------------------------------------------------------------- */
+/* fusion                                                                                   */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 以设备 tx_dev_id 的批号 tar_id 送入一条位于 (x, 0, 0) 的引导信息
+ */
+static guint32 test_fusion_feed(CUAVFusion *fusion, guint16 tx_dev_id, guint32 tar_id, gdouble x,
+                                guint64 ts_us, gboolean *primary)
+{
+    CUAVCommonHeader header;
+    CUAVGuidanceInfo guidance;
+
+    memset(&header, 0, sizeof(header));
+    memset(&guidance, 0, sizeof(guidance));
+    header.tx_sys_id = 999;
+    header.tx_dev_id = tx_dev_id;
+    header.recv_ts_us = ts_us;
+    guidance.tar_id = tar_id;
+    guidance.guid_stat = 1;
+    guidance.ecef_x = x;
+    return cuav_fusion_update(fusion, &header, &guidance, primary);
+}
+
+/**
+ * @brief 门限内的不同传感器航迹共享融合批号，同一传感器和门限外的航迹不共享
+ */
+static void test_fusion_associate(void)
+{
+    CUAVFusionConfig config = {50.0, 0, CUAV_FUSION_DEFAULT_TIMEOUT_MS};
+    CUAVFusion *fusion = cuav_fusion_new(&config);
+    CUAVFusionStats stats;
+    gboolean primary = FALSE;
+    guint32 a = test_fusion_feed(fusion, 1, 10, 0, 1000, &primary);
+
+    g_assert_cmpuint(a, !=, 0);
+    g_assert_true(primary);
+    g_assert_cmpuint(test_fusion_feed(fusion, 2, 20, 30, 2000, &primary), ==, a);
+    g_assert_false(primary);
+    g_assert_cmpuint(test_fusion_feed(fusion, 1, 11, -30, 3000, NULL), !=, a);
+    g_assert_cmpuint(test_fusion_feed(fusion, 3, 30, 500, 4000, NULL), !=, a);
+    g_assert_cmpuint(cuav_fusion_lookup(fusion, 999, 2, 20), ==, a);
+
+    cuav_fusion_get_stats(fusion, &stats);
+    g_assert_cmpuint(stats.tracks, ==, 4);
+    g_assert_cmpuint(stats.fused_tracks, ==, 3);
+    g_assert_cmpuint(stats.merges, ==, 1);
+    cuav_fusion_free(fusion);
+}
+
+/**
+ * @brief 已融合航迹在 1.5 倍门限内保持批号（成员相隔两个格子也一样），超出后拆分
+ */
+static void test_fusion_hysteresis(void)
+{
+    CUAVFusionConfig config = {50.0, 0, CUAV_FUSION_DEFAULT_TIMEOUT_MS};
+    CUAVFusion *fusion = cuav_fusion_new(&config);
+    CUAVFusionStats stats;
+    guint32 a = test_fusion_feed(fusion, 1, 10, 49, 1000, NULL);
+
+    g_assert_cmpuint(test_fusion_feed(fusion, 2, 20, 60, 2000, NULL), ==, a);
+    /* 相距 61 米：超出关联门限但在释放门限内，对方在 0 号格子、本航迹在 2 号格子 */
+    g_assert_cmpuint(test_fusion_feed(fusion, 2, 20, 110, 3000, NULL), ==, a);
+    cuav_fusion_get_stats(fusion, &stats);
+    g_assert_cmpuint(stats.splits, ==, 0);
+
+    /* 相距 81 米：超出释放门限 */
+    g_assert_cmpuint(test_fusion_feed(fusion, 2, 20, 130, 4000, NULL), !=, a);
+    cuav_fusion_get_stats(fusion, &stats);
+    g_assert_cmpuint(stats.splits, ==, 1);
+    g_assert_cmpuint(stats.fused_tracks, ==, 2);
+    cuav_fusion_free(fusion);
+}
+
+/**
+ * @brief gate_m 为 0 表示关闭融合：清空航迹且不再分配批号，重新开启后正常工作
+ */
+static void test_fusion_disabled(void)
+{
+    CUAVFusionConfig config = {50.0, 0, CUAV_FUSION_DEFAULT_TIMEOUT_MS};
+    CUAVFusion *fusion = cuav_fusion_new(NULL);
+    CUAVFusionStats stats;
+
+    g_assert_cmpuint(test_fusion_feed(fusion, 1, 10, 0, 1000, NULL), ==, 0);
+    cuav_fusion_set_config(fusion, &config);
+    g_assert_cmpuint(test_fusion_feed(fusion, 1, 10, 0, 2000, NULL), !=, 0);
+
+    config.gate_m = 0;
+    cuav_fusion_set_config(fusion, &config);
+    g_assert_cmpuint(test_fusion_feed(fusion, 1, 10, 0, 3000, NULL), ==, 0);
+    g_assert_cmpuint(cuav_fusion_lookup(fusion, 999, 1, 10), ==, 0);
+    cuav_fusion_get_stats(fusion, &stats);
+    g_assert_cmpuint(stats.tracks, ==, 0);
+    g_assert_cmpuint(stats.updates, ==, 1);
+    cuav_fusion_free(fusion);
+}
+
+/* ---------------------------------------------------------------------------------------- */
+/* pointing                                                                                 */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 由编码器生成一条 0x7201 送入解析器，四个视场都取 fov
+ */
+static void test_pointing_feed(CUAVParser *parser, CUAVEncoder *encoder, gfloat loc_h,
+                               gfloat loc_v, gfloat fov)
+{
+    CUAVMessageUnion msg;
+    gchar buf[4096];
+    gsize len = 0;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.eo_system.st_loc_h = loc_h;
+    msg.eo_system.st_loc_v = loc_v;
+    msg.eo_system.pt_fov_h = fov;
+    msg.eo_system.pt_fov_v = fov;
+    msg.eo_system.ir_fov_h = fov;
+    msg.eo_system.ir_fov_v = fov;
+    len = cuav_encode_message(encoder, CUAV_MSG_ID_EO_SYSTEM, CUAV_MSG_TYPE_STREAM, &msg, buf,
+                              sizeof(buf));
+    g_assert_cmpuint(len, >, 0);
+    g_assert_true(cuav_parser_parse(parser, buf, (gssize)len));
+}
+
+/**
+ * @brief 两个采样之间按球面插值（跨越 0/360 度），范围外取端点
+ */
+static void test_pointing_interpolate(void)
+{
+    CUAVAddressing addressing = {999, 1, 17, 2, 999, 3, 18, 4};
+    CUAVEncoder *encoder = cuav_encoder_new(&addressing);
+    CUAVParser *parser = cuav_parser_new();
+    gint slot = cuav_parser_register_device(parser, 17);
+    CUAVPointingSample out;
+    gint64 t0 = 0;
+    gint64 t1 = 0;
+    gint64 t2 = 0;
+    gint64 t3 = 0;
+
+    g_assert_cmpint(slot, >=, 0);
+    g_assert_cmpint(cuav_parser_interpolate_pointing(parser, slot, 0, &out), ==,
+                    CUAV_POINTING_NONE);
+
+    /* 采样时间是接收时的单调时钟，只能由前后两次取时确定范围 */
+    t0 = g_get_monotonic_time() * 1000;
+    test_pointing_feed(parser, encoder, 350.0f, 0.0f, 10.0f);
+    t1 = g_get_monotonic_time() * 1000;
+    g_usleep(2000);
+    t2 = g_get_monotonic_time() * 1000;
+    test_pointing_feed(parser, encoder, 10.0f, 20.0f, 20.0f);
+    t3 = g_get_monotonic_time() * 1000;
+
+    g_assert_cmpint(cuav_parser_interpolate_pointing(parser, slot, (t1 + t2) / 2, &out), ==,
+                    CUAV_POINTING_INTERPOLATED);
+    g_assert_cmpint(out.ts_ns, ==, (t1 + t2) / 2);
+    g_assert_true(out.loc_h > 350.0f || out.loc_h < 10.0f);
+    g_assert_true(out.loc_v > 0.0f && out.loc_v < 20.0f);
+    g_assert_true(out.pt_fov_h > 10.0f && out.pt_fov_h < 20.0f);
+    g_assert_true(out.ir_fov_v == out.pt_fov_h);
+
+    g_assert_cmpint(cuav_parser_interpolate_pointing(parser, slot, t0 - 1000000, &out), ==,
+                    CUAV_POINTING_CLAMPED);
+    g_assert_true(out.loc_h == 350.0f && out.pt_fov_h == 10.0f);
+    g_assert_cmpint(cuav_parser_interpolate_pointing(parser, slot, t3 + 1000000000, &out), ==,
+                    CUAV_POINTING_CLAMPED);
+    g_assert_true(out.loc_h == 10.0f && out.pt_fov_h == 20.0f);
+
+    cuav_parser_free(parser);
+    cuav_encoder_free(encoder);
+}
+
+/* 覆盖竞争用例中读线程的状态 */
+typedef struct
+{
+    CUAVParser *parser;
+    gint slot;
+    gint stop;
+    guint reads;
+    guint torn;
+} TestPointingRace;
+
+static gpointer test_pointing_reader(gpointer data)
+{
+    TestPointingRace *race = (TestPointingRace *)data;
+
+    while (!g_atomic_int_get(&race->stop))
+    {
+        /* 写入很快，64 个采样只覆盖最近几百微秒，查询落在最旧的采样附近 */
+        gint64 ts = (g_get_monotonic_time() - g_random_int_range(0, 400)) * 1000;
+        CUAVPointingSample out;
+
+        if (cuav_parser_interpolate_pointing(race->parser, race->slot, ts, &out) ==
+            CUAV_POINTING_NONE)
+            continue;
+        race->reads++;
+        /* 同一采样的四个视场相同，插值后仍相同；读到半写的采样会不同 */
+        if (out.pt_fov_h != out.pt_fov_v || out.pt_fov_h != out.ir_fov_h ||
+            out.pt_fov_h != out.ir_fov_v)
+            race->torn++;
+    }
+    return NULL;
+}
+
+/**
+ * @brief 写入方不断覆盖历史环时，读取方不会读到半写或已被覆盖的采样
+ */
+static void test_pointing_overwrite_race(void)
+{
+    CUAVAddressing addressing = {999, 1, 17, 2, 999, 3, 18, 4};
+    CUAVEncoder *encoder = cuav_encoder_new(&addressing);
+    TestPointingRace race;
+    GThread *reader = NULL;
+
+    memset(&race, 0, sizeof(race));
+    race.parser = cuav_parser_new();
+    race.slot = cuav_parser_register_device(race.parser, 17);
+    test_pointing_feed(race.parser, encoder, 0.0f, 0.0f, 1.0f);
+    reader = g_thread_new("pointing-reader", test_pointing_reader, &race);
+    for (guint i = 2; i < 20000; i++)
+        test_pointing_feed(race.parser, encoder, (gfloat)(i % 360), 0.0f, (gfloat)i);
+    g_atomic_int_set(&race.stop, 1);
+    g_thread_join(reader);
+
+    g_assert_cmpuint(race.reads, >, 0);
+    g_assert_cmpuint(race.torn, ==, 0);
+    cuav_parser_free(race.parser);
+    cuav_encoder_free(encoder);
+}
+
+/* ---------------------------------------------------------------------------------------- */
+/* ingest                                                                                   */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief endpoints 条目 "group:port[@iface][=source_id]" 的解析
+ */
+static void test_ingest_parse_endpoint(void)
+{
+    static const gchar *invalid[] = {
+        "239.0.0.1", ":8000", "239.0.0.1:", "239.0.0.1:0", "239.0.0.1:65536",
+        "239.0.0.1:80x", "239.0.0.1:8000=", "239.0.0.1:8000=abc",
+    };
+    UdpJsonEndpoint ep;
+    gchar *entry = g_strdup("239.0.0.1:8000@eth1=0x10");
+
+    memset(&ep, 0, sizeof(ep));
+    g_assert_true(udpjson_parse_endpoint(entry, &ep));
+    g_assert_cmpstr(ep.multicast_ip, ==, "239.0.0.1");
+    g_assert_cmpuint(ep.port, ==, 8000);
+    g_assert_cmpstr(ep.iface, ==, "eth1");
+    g_assert_cmpuint(ep.source_id, ==, 16);
+    g_assert_cmpint(ep.fd, ==, -1);
+    udpjson_endpoint_clear(&ep);
+    g_free(entry);
+
+    entry = g_strdup("239.0.0.2:9000@");
+    memset(&ep, 0, sizeof(ep));
+    g_assert_true(udpjson_parse_endpoint(entry, &ep));
+    g_assert_cmpstr(ep.multicast_ip, ==, "239.0.0.2");
+    g_assert_null(ep.iface);
+    g_assert_cmpuint(ep.source_id, ==, 0);
+    udpjson_endpoint_clear(&ep);
+    g_free(entry);
+
+    for (guint i = 0; i < G_N_ELEMENTS(invalid); i++)
+    {
+        entry = g_strdup(invalid[i]);
+        memset(&ep, 0, sizeof(ep));
+        g_assert_false(udpjson_parse_endpoint(entry, &ep));
+        g_free(entry);
+    }
+}
+
+/* ---------------------------------------------------------------------------------------- */
+/* pcap                                                                                     */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 追加一条 pcap 记录：以太网 + IPv4 + UDP（ethertype 非 IPv4 时只写以太网头）
+ */
+static void test_pcap_append(GByteArray *file, guint32 ts_sec, guint32 ts_usec, guint16 ethertype,
+                             guint16 dst_port, const gchar *payload)
+{
+    gsize plen = payload ? strlen(payload) : 0;
+    guint32 caplen = ethertype == 0x0800 ? (guint32)(14 + 20 + 8 + plen) : 14 + 28;
+    guint32 rec[4] = {ts_sec, ts_usec, caplen, caplen};
+    guint16 udp_len = (guint16)(8 + plen);
+    guint8 eth[14] = {0};
+    /* IPv4 头：192.168.1.7 -> 239.0.0.1，UDP 40000 -> dst_port */
+    guint8 ip[20] = {0x45, 0, 0, 0, 0, 0, 0, 0, 64, 17, 0, 0, 192, 168, 1, 7, 239, 0, 0, 1};
+    guint8 udp[8] = {0x9C, 0x40, (guint8)(dst_port >> 8), (guint8)dst_port,
+                     (guint8)(udp_len >> 8), (guint8)udp_len, 0, 0};
+    guint8 pad[28] = {0};
+
+    g_byte_array_append(file, (const guint8 *)rec, sizeof(rec));
+    eth[12] = (guint8)(ethertype >> 8);
+    eth[13] = (guint8)ethertype;
+    g_byte_array_append(file, eth, sizeof(eth));
+    if (ethertype != 0x0800)
+    {
+        g_byte_array_append(file, pad, sizeof(pad));
+        return;
+    }
+    g_byte_array_append(file, ip, sizeof(ip));
+    g_byte_array_append(file, udp, sizeof(udp));
+    g_byte_array_append(file, (const guint8 *)payload, (guint)plen);
+}
+
+/**
+ * @brief 读取经典 pcap：UDP 负载、地址端口、时间戳，跳过非 IPv4 记录
+ */
+static void test_pcap_read(void)
+{
+    guint32 global[6] = {0xA1B2C3D4u, 0x00040002u, 0, 0, 65535, 1};
+    GByteArray *file = g_byte_array_new();
+    gchar *dir = g_dir_make_tmp("udpjsonmeta-test-XXXXXX", NULL);
+    gchar *path = NULL;
+    UdpJsonPcapReader *reader = NULL;
+    UdpJsonPcapDatagram dgram;
+    UdpJsonPcapStats stats;
+
+    g_assert_nonnull(dir);
+    path = g_build_filename(dir, "capture.pcap", NULL);
+    g_byte_array_append(file, (const guint8 *)global, sizeof(global));
+    test_pcap_append(file, 100, 250, 0x0800, 8000, "{\"object_id\":1}");
+    test_pcap_append(file, 100, 500, 0x0806, 0, NULL);
+    test_pcap_append(file, 101, 0, 0x0800, 8001, "{\"msg_id\":29185}");
+    g_assert_true(g_file_set_contents(path, (const gchar *)file->data, file->len, NULL));
+
+    reader = udpjson_pcap_open(path);
+    g_assert_nonnull(reader);
+    g_assert_true(udpjson_pcap_next(reader, &dgram));
+    g_assert_cmpuint(dgram.ts_ns, ==, G_GUINT64_CONSTANT(100000250000));
+    g_assert_cmpuint(dgram.src_addr, ==, htonl(0xC0A80107));
+    g_assert_cmpuint(dgram.dst_addr, ==, htonl(0xEF000001));
+    g_assert_cmpuint(dgram.src_port, ==, 40000);
+    g_assert_cmpuint(dgram.dst_port, ==, 8000);
+    g_assert_cmpuint(dgram.len, ==, strlen("{\"object_id\":1}"));
+    g_assert_true(memcmp(dgram.payload, "{\"object_id\":1}", dgram.len) == 0);
+    g_assert_true(udpjson_pcap_next(reader, &dgram));
+    g_assert_cmpuint(dgram.dst_port, ==, 8001);
+    g_assert_false(udpjson_pcap_next(reader, &dgram));
+
+    udpjson_pcap_get_stats(reader, &stats);
+    g_assert_cmpuint(stats.packets, ==, 3);
+    g_assert_cmpuint(stats.datagrams, ==, 2);
+    g_assert_cmpuint(stats.non_udp, ==, 1);
+
+    udpjson_pcap_rewind(reader);
+    g_assert_true(udpjson_pcap_next(reader, &dgram));
+    g_assert_cmpuint(dgram.dst_port, ==, 8000);
+    udpjson_pcap_close(reader);
+
+    g_unlink(path);
+    g_assert_null(udpjson_pcap_open(path));
+    g_rmdir(dir);
+    g_free(path);
+    g_free(dir);
+    g_byte_array_unref(file);
+}
+
+/* ---------------------------------------------------------------------------------------- */
+/* journal                                                                                  */
+/* ---------------------------------------------------------------------------------------- */
+
+/**
+ * @brief 接收日志写入后用读取器逐条读回
+ */
+static void test_journal_round_trip(void)
+{
+    static const gchar *payloads[] = {"{\"object_id\":1}", "{\"msg_id\":29185,\"msg_sn\":7}",
+                                      "x"};
+    gchar *dir = g_dir_make_tmp("udpjsonmeta-test-XXXXXX", NULL);
+    UdpJsonJournal *journal = NULL;
+    UdpJsonJournalReader *reader = NULL;
+    UdpJsonJournalRecord record;
+    GDir *listing = NULL;
+    const gchar *name = NULL;
+    gchar *path = NULL;
+
+    g_assert_nonnull(dir);
+    journal = udpjson_journal_new(dir, "test", UDPJSON_JOURNAL_MIN_FILE_SIZE, 2, 4096);
+    g_assert_nonnull(journal);
+    for (guint i = 0; i < G_N_ELEMENTS(payloads); i++)
+        g_assert_true(udpjson_journal_append(journal, i, 1000 + i, htonl(0x0A000001 + i),
+                                             (guint16)(5000 + i), payloads[i],
+                                             strlen(payloads[i])));
+    udpjson_journal_free(journal);
+
+    listing = g_dir_open(dir, 0, NULL);
+    g_assert_nonnull(listing);
+    name = g_dir_read_name(listing);
+    g_assert_nonnull(name);
+    g_assert_true(g_str_has_suffix(name, ".ujj"));
+    path = g_build_filename(dir, name, NULL);
+    g_assert_null(g_dir_read_name(listing));
+    g_dir_close(listing);
+
+    reader = udpjson_journal_reader_open(path);
+    g_assert_nonnull(reader);
+    g_assert_cmpuint(udpjson_journal_reader_header(reader)->magic, ==, UDPJSON_JOURNAL_MAGIC);
+    g_assert_cmpuint(udpjson_journal_reader_header(reader)->seq, ==, 1);
+    for (guint pass = 0; pass < 2; pass++)
+    {
+        for (guint i = 0; i < G_N_ELEMENTS(payloads); i++)
+        {
+            g_assert_true(udpjson_journal_reader_next(reader, &record));
+            g_assert_cmpuint(record.ts_ns, ==, 1000 + i);
+            g_assert_cmpuint(record.socket, ==, i);
+            g_assert_cmpuint(record.sender_ip, ==, htonl(0x0A000001 + i));
+            g_assert_cmpuint(record.sender_port, ==, 5000 + i);
+            g_assert_cmpuint(record.dropped, ==, 0);
+            g_assert_cmpuint(record.len, ==, strlen(payloads[i]));
+            g_assert_true(memcmp(record.payload, payloads[i], record.len) == 0);
+        }
+        g_assert_false(udpjson_journal_reader_next(reader, &record));
+        udpjson_journal_reader_rewind(reader);
+    }
+    udpjson_journal_reader_close(reader);
+
+    g_unlink(path);
+    g_rmdir(dir);
+    g_free(path);
+    g_free(dir);
+}
+
+int main(int argc, char *argv[])
+{
+    g_test_init(&argc, &argv, NULL);
+
+#ifdef UDPJSON_NVDS_STUB
+    g_test_add_func("/nvds-stub/user-meta", test_nvds_stub_user_meta);
+#endif
+    g_test_add_func("/demand/pass-through", test_demand_pass_through);
+    g_test_add_func("/demand/publish", test_demand_publish);
+    g_test_add_func("/demand/scan-ids", test_demand_scan_ids);
+    g_test_add_func("/dedup/first-copy", test_dedup_first_copy);
+    g_test_add_func("/dedup/resend-and-expiry", test_dedup_resend_and_expiry);
+    g_test_add_func("/dedup/resend-other-path-first", test_dedup_resend_other_path_first);
+    g_test_add_func("/cuav/seq-window", test_cuav_seq_window);
+    g_test_add_func("/cuav/encode-round-trip", test_cuav_encode_round_trip);
+    g_test_add_func("/fusion/associate", test_fusion_associate);
+    g_test_add_func("/fusion/hysteresis", test_fusion_hysteresis);
+    g_test_add_func("/fusion/disabled", test_fusion_disabled);
+    g_test_add_func("/pointing/interpolate", test_pointing_interpolate);
+    g_test_add_func("/pointing/overwrite-race", test_pointing_overwrite_race);
+    g_test_add_func("/ingest/parse-endpoint", test_ingest_parse_endpoint);
+    g_test_add_func("/pcap/read", test_pcap_read);
+    g_test_add_func("/journal/round-trip", test_journal_round_trip);
+
+    return g_test_run();
+}